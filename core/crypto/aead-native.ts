@@ -0,0 +1,80 @@
+// core/crypto/aead-native.ts
+
+import { EncryptionScheme } from '../interfaces/crypto';
+import { AESGCM } from './aes';
+import {
+    hasNativeBindings,
+    nativeBindings,
+} from '../../hydra_compression/src/uDTLS-PQ/src/lib/bindings';
+
+const IV_BYTES = 12;
+const TAG_BYTES = 16;
+
+export interface DisposableEncryptionScheme extends EncryptionScheme {
+    /** Releases native key material; the scheme must not be used afterwards. */
+    dispose(): void;
+}
+
+/**
+ * AES‑256‑GCM through the `openssl_pq` addon. The key is handed to native
+ * code once, which keeps its prepared cipher contexts, so each message costs
+ * one synchronous call instead of a WebCrypto round trip. Frames are
+ * `iv || ciphertext || tag`, the same layout `subtleEncrypt` produces, so
+ * either side may use either implementation.
+ */
+export class NativeAESGCM implements DisposableEncryptionScheme {
+    private handle: Promise<{ id: number }> | null = null;
+
+    constructor(private readonly key: CryptoKey) {}
+
+    private keyHandle(): Promise<{ id: number }> {
+        if (!this.handle) {
+            this.handle = crypto.subtle
+                .exportKey('raw', this.key)
+                .then((raw) => nativeBindings.createAeadKey(Buffer.from(raw), 'aes-256-gcm'));
+        }
+        return this.handle;
+    }
+
+    async encrypt(plaintext: Uint8Array): Promise<Uint8Array> {
+        const handle = await this.keyHandle();
+        const frame = Buffer.allocUnsafe(IV_BYTES + plaintext.length + TAG_BYTES);
+        const iv = frame.subarray(0, IV_BYTES);
+        crypto.getRandomValues(iv);
+        nativeBindings.aeadSealInto(handle, iv, plaintext, frame.subarray(IV_BYTES));
+        return frame;
+    }
+
+    async decrypt(ciphertext: Uint8Array): Promise<Uint8Array> {
+        if (ciphertext.length < IV_BYTES + TAG_BYTES) throw new Error('Ciphertext too short');
+        const handle = await this.keyHandle();
+        const plaintext = nativeBindings.aeadOpen(
+            handle,
+            ciphertext.subarray(0, IV_BYTES),
+            ciphertext.subarray(IV_BYTES)
+        );
+        if (!plaintext) throw new Error('AES-GCM authentication failed');
+        return plaintext;
+    }
+
+    dispose(): void {
+        const handle = this.handle;
+        this.handle = null;
+        handle?.then((h) => nativeBindings.freeAeadKey(h)).catch(() => {});
+    }
+}
+
+/**
+ * Native AES‑GCM when the addon is loaded and the key can be exported,
+ * otherwise the WebCrypto `AESGCM`.
+ */
+export function createAesScheme(key: CryptoKey): DisposableEncryptionScheme {
+    if (hasNativeBindings && key.extractable) return new NativeAESGCM(key);
+    const scheme = new AESGCM(key);
+    return {
+        encrypt: (plaintext) => scheme.encrypt(plaintext),
+        // @ts-ignore – AESGCM.decrypt reads the IV from the frame itself
+        decrypt: (ciphertext) => scheme.decrypt(ciphertext),
+        dispose: () => {},
+    };
+}
@@ -1,4 +1,124 @@
-import { blake3 } from '@noble/hashes/blake3';
+import { createRequire } from 'module';
+import { blake3 as nobleBlake3 } from '@noble/hashes/blake3';
+import type { NativeBindings } from '../../hydra_compression/src/uDTLS-PQ/src/lib/bindings';
+
+/** The part of the `openssl_pq` addon this module hashes with. */
+export type Blake3Addon = Pick<
+  NativeBindings,
+  'blake3' | 'blake3Batch' | 'blake3Create' | 'blake3Update' | 'blake3Digest' | 'blake3Free'
+>;
+
+// undefined until the first hash tries to load it; null once that failed
+let addon: Blake3Addon | null | undefined;
+
+/** Hashes through `bindings` from now on; null pins the @noble/hashes path. */
+export function setBlake3Addon(bindings: Blake3Addon | null): void {
+  addon = bindings;
+}
+
+/**
+ * The addon, required on first use rather than at import so that browser
+ * bundles and hosts without the build stay quiet and keep @noble/hashes.
+ */
+function native(): Blake3Addon | null {
+  if (addon === undefined) {
+    try {
+      // Browser bundles map 'module' to an empty stub, so this throws there
+      const loaded = createRequire(import.meta.url)('../../hydra_compression/src/uDTLS-PQ/build/Release/openssl_pq.node');
+      // Builds that predate the BLAKE3 exports count as no addon
+      addon = typeof loaded.blake3Create === 'function' ? loaded : null;
+    } catch {
+      addon = null;
+    }
+  }
+  return addon ?? null;
+}
+
+export interface Blake3Options {
+  /** 32-byte key for keyed hashing (MACs). */
+  key?: Uint8Array;
+  /** derive_key context string. */
+  context?: string;
+  /** Output length in bytes (default 32). */
+  dkLen?: number;
+}
+
+export interface Blake3Stream {
+  update(data: Uint8Array | string): Blake3Stream;
+  /** Digest of everything written so far; more data may follow. */
+  digest(dkLen?: number): Uint8Array;
+  /** Releases the native hasher; the stream must not be used afterwards. */
+  dispose(): void;
+}
+
+function toBuffer(data: Uint8Array): Buffer {
+  return Buffer.isBuffer(data) ? data : Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+}
+
+function nativeOptions(opts?: Blake3Options) {
+  return opts?.key ? { ...opts, key: toBuffer(opts.key) } : (opts as { context?: string; dkLen?: number });
+}
+
+/**
+ * BLAKE3 through the `openssl_pq` addon (SIMD lanes, no JS string
+ * encoding) when it is loaded, otherwise `@noble/hashes`.
+ */
+export function blake3(data: Uint8Array | string, opts?: Blake3Options): Uint8Array {
+  const bindings = native();
+  if (bindings) {
+    return bindings.blake3(typeof data === 'string' ? data : toBuffer(data), nativeOptions(opts));
+  }
+  return nobleBlake3(typeof data === 'string' ? new TextEncoder().encode(data) : data, opts);
+}
+
+/**
+ * Hashes every input with the same options in one native call; small
+ * inputs such as segment ids are compressed many to a SIMD pass.
+ */
+export function blake3Batch(inputs: (Uint8Array | string)[], opts?: Blake3Options): Uint8Array[] {
+  const dkLen = opts?.dkLen ?? 32;
+  const bindings = native();
+  if (!bindings) return inputs.map((input) => blake3(input, opts));
+  const digests = bindings.blake3Batch(
+    inputs.map((input) => (typeof input === 'string' ? input : toBuffer(input))),
+    nativeOptions(opts)
+  );
+  return inputs.map((_, i) => digests.subarray(i * dkLen, (i + 1) * dkLen));
+}
+
+/** Incremental BLAKE3 for content too large or too scattered to hash at once. */
+export function createBlake3(opts?: Omit<Blake3Options, 'dkLen'>): Blake3Stream {
+  const bindings = native();
+  if (bindings) {
+    const handle = bindings.blake3Create(nativeOptions(opts));
+    const stream: Blake3Stream = {
+      update: (data) => {
+        bindings.blake3Update(handle, typeof data === 'string' ? data : toBuffer(data));
+        return stream;
+      },
+      digest: (dkLen) => bindings.blake3Digest(handle, dkLen),
+      dispose: () => {
+        bindings.blake3Free(handle);
+      },
+    };
+    return stream;
+  }
+  const hasher = nobleBlake3.create(opts ?? {});
+  const stream: Blake3Stream = {
+    update: (data) => {
+      hasher.update(typeof data === 'string' ? new TextEncoder().encode(data) : data);
+      return stream;
+    },
+    digest: (dkLen) => {
+      if (dkLen === undefined) return hasher.clone().digest();
+      const out = new Uint8Array(dkLen);
+      hasher.clone().xofInto(out);
+      return out;
+    },
+    dispose: () => hasher.destroy(),
+  };
+  return stream;
+}
 
 export interface HashResult {
   readonly hash: Uint8Array;
@@ -18,8 +138,7 @@ export class Blake3 implements HashResult {
   readonly base64: string;
 
   constructor(input: string, context?: string, key?: Uint8Array) {
-    const inputBytes = new TextEncoder().encode(input);
-    this.hash = blake3(inputBytes);
+    this.hash = blake3(input);
 
     this.hex = Buffer.from(this.hash).toString('hex');
     this.base64 = Buffer.from(this.hash).toString('base64');
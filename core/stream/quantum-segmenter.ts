@@ -1,4 +1,4 @@
-import { Blake3 } from '../crypto/hash';
+import { blake3 } from '../crypto/hash';
 import Falcon from '../crypto/falcon';
 import { IVirtualFileSystem, FileMode } from '../vfs/types';
 
@@ -19,7 +19,7 @@ export class QuantumEdgeSegmenter {
     }
 
     private createMetadataTag(segmentId: string): Uint8Array {
-        const hash = Blake3.from(segmentId).hex;
+        const hash = Buffer.from(blake3(segmentId)).toString('hex');
         return new TextEncoder().encode(`#Q-SEG:${segmentId}|${hash}|ARCHI\n`);
     }
 
@@ -14,12 +14,21 @@ export class OSTPackReader {
             config: any;
             binSequence: string[];
             bins: string[];
+            index?: boolean;
         };
 
+        // Indexed packs end in u64 indexOffset | "OSTI"; the bins stop there.
+        let end = pack.length;
+        if (header.index) {
+            const t = end - 12;
+            end = ((pack[t] << 24) | (pack[t + 1] << 16) | (pack[t + 2] << 8) | pack[t + 3]) * 2 ** 32 +
+                (((pack[t + 4] << 24) | (pack[t + 5] << 16) | (pack[t + 6] << 8) | pack[t + 7]) >>> 0);
+        }
+
         const compressedBins = new Map<string, Uint8Array>();
         let offset = 8 + headerLen;
 
-        while (offset < pack.length) {
+        while (offset < end) {
             const labelLen = (pack[offset] << 8) | pack[offset + 1];
             const label = new TextDecoder().decode(
                 pack.slice(offset + 2, offset + 2 + labelLen)
@@ -1,13 +1,14 @@
 // core/transports/secure-memory-transport.ts
 
 import { Transport, TransportOptions } from '../interfaces/transport';
-import { AESGCM, generateAesKey } from '../crypto/aes';
+import { generateAesKey } from '../crypto/aes';
+import { createAesScheme, DisposableEncryptionScheme } from '../crypto/aead-native';
 import { TransportContext, TransportSession } from '../interfaces/context';
 import { createCryptoBundle } from '../crypto/factory';
 
 /**
- * In‑process transport that encrypts payloads with AES‑GCM and authenticates
- * both peers via a Falcon‑signed nonce.  No actual sockets are used – the peer
+ * In‑process transport that encrypts payloads with AES‑GCM (native when the
+ * addon is available) and authenticates both peers via a Falcon‑signed nonce.  No actual sockets are used – the peer
  * instance is linked directly through `pairWith()`.
  */
 export class SecureMemoryTransport implements Transport {
@@ -19,7 +20,7 @@ export class SecureMemoryTransport implements Transport {
     private readonly options: TransportOptions;
     private context: TransportContext | null = null;
     private session: TransportSession | null = null;
-    private aes: AESGCM | null = null;
+    private aes: DisposableEncryptionScheme | null = null;
 
     constructor(options: TransportOptions) {
         this.options = options;
@@ -41,7 +42,7 @@ export class SecureMemoryTransport implements Transport {
 
         // Symmetric key for payload encryption
         this.key = await generateAesKey();
-        this.aes = new AESGCM(this.key);
+        this.aes = createAesScheme(this.key);
 
         // Handshake artefacts
         const challenge = globalThis.crypto.getRandomValues(new Uint8Array(32));
@@ -120,11 +121,13 @@ export class SecureMemoryTransport implements Transport {
 
                 // Establish bidirectional link and share symmetric key
                 const sharedKey = this.key!;            // reuse initiator’s key
-                this.aes = new AESGCM(sharedKey);
+                this.aes?.dispose();
+                this.aes = createAesScheme(sharedKey);
                 this.key = sharedKey;
 
                 peer.key = sharedKey;                   // ⬅ always set
-                peer.aes = new AESGCM(sharedKey);       // ⬅ rebuild AES
+                peer.aes?.dispose();
+                peer.aes = createAesScheme(sharedKey);  // ⬅ rebuild AES
                 this.peer = peer;
                 peer.peer = this;
                 if (!peer.key && this.key) peer.key = this.key;
@@ -170,6 +173,8 @@ export class SecureMemoryTransport implements Transport {
     close(): void {
         console.warn('[SecureMemoryTransport] Closing session…');
         this.peer = null;
+        this.aes?.dispose();
+        this.aes = null;
         this.key = null;
         this.session = null;
         this.context = null;
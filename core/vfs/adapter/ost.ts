@@ -16,6 +16,11 @@
  *
  * The adapter is *stateless* – it stores the OST blob as a single file next to
  * an optional detached Falcon signature ( “<file>.sig” – left to the caller ).
+ *
+ * With the native addon loaded, packs are written with a window index and
+ * files opened for reading are served by **OSTPackFile**: only the windows a
+ * read overlaps are decoded, and when `hostPath` maps the virtual path to a
+ * real file the pack is memory‑mapped instead of read in.
  */
 
 import {
@@ -28,6 +33,50 @@ import {
 import {OSTPackWriter} from '../../transports/ost/OSTPackWriter';
 import {OSTPackReader} from '../../transports/ost/OSTPackReader';
 import {OSTConfig} from '../../transports/ost/types';
+import {OSTPackFile} from '../../../hydra_compression/src/ost/OSTPackFile';
+import {OSTPackWriter as IndexedPackWriter} from '../../../hydra_compression/src/ost/OSTPackWriter';
+import {hasNativeBindings} from '../../../hydra_compression/src/uDTLS-PQ/src/lib/bindings';
+
+export interface OstVfsOptions {
+    /** Host file behind a virtual path, if any, so packs can be mapped. */
+    hostPath?: (path: string) => string | undefined;
+}
+
+/** Read side of an indexed pack; a read decodes only what it covers. */
+class OstPackedFile implements IVirtualFile {
+    private position = 0;
+
+    constructor(
+        private readonly pack: OSTPackFile,
+        private readonly base: IVirtualFileSystem,
+        private readonly path: string
+    ) {}
+
+    async read(buffer: Uint8Array, length: number): Promise<number> {
+        const n = this.pack.readInto(buffer.subarray(0, Math.min(length, buffer.length)), this.position);
+        this.position += n;
+        return n;
+    }
+
+    async write(): Promise<number> {
+        throw new Error('OST pack opened for reading');
+    }
+
+    async seek(offset: number, whence: 'SET' | 'CUR' | 'END'): Promise<void> {
+        const from = whence === 'SET' ? 0 : whence === 'CUR' ? this.position : this.pack.size;
+        this.position = Math.max(0, from + offset);
+    }
+
+    async flush(): Promise<void> {}
+
+    async close(): Promise<void> {
+        this.pack.close();
+    }
+
+    async getInfo(): Promise<FileInfo> {
+        return { ...(await this.base.info(this.path)), size: this.pack.size };
+    }
+}
 
 export class OstVfsAdapter implements IVirtualFileSystem {
     readonly prefix: string = '/';
@@ -35,10 +84,49 @@ export class OstVfsAdapter implements IVirtualFileSystem {
 
     constructor(
         private readonly base: IVirtualFileSystem,
-        private readonly config: Partial<OSTConfig> = {}
+        private readonly config: Partial<OSTConfig> = {},
+        private readonly options: OstVfsOptions = {}
     ) {
     }
 
+    /** Indexed packs need the addon, which writes huffman and raw bins. */
+    private get indexed(): boolean {
+        const method = this.config.compressionMethod ?? 'huffman';
+        return hasNativeBindings && (method === 'huffman' || method === 'raw');
+    }
+
+    /**
+     * null when the file is not an indexed pack. Only the OST1 prefix and
+     * header are read to tell; a pack with a host file is then mapped, any
+     * other is read in once.
+     */
+    private async openIndexed(path: string): Promise<OSTPackFile | null> {
+        let file: IVirtualFile | null = null;
+        try {
+            file = await this.base.open(path, FileMode.READ);
+            const prefix = await readFully(file, 8);
+            if (prefix.length < 8 || new TextDecoder().decode(prefix.subarray(0, 4)) !== 'OST1') return null;
+            const headerLen = new DataView(prefix.buffer, prefix.byteOffset, 8).getUint32(4);
+            const header = await readFully(file, headerLen);
+            if (header.length < headerLen || JSON.parse(new TextDecoder().decode(header)).index !== true) return null;
+
+            const host = this.options.hostPath?.(path);
+            if (host) return OSTPackFile.open(host);
+
+            const { size } = await file.getInfo();
+            const pack = new Uint8Array(size);
+            pack.set(prefix);
+            pack.set(header, 8);
+            const rest = await readFully(file, size - 8 - headerLen);
+            pack.set(rest, 8 + headerLen);
+            return OSTPackFile.open(pack.subarray(0, 8 + headerLen + rest.length));
+        } catch {
+            return null;
+        } finally {
+            await file?.close();
+        }
+    }
+
 
 
     getscheme(): string | undefined {
@@ -68,6 +156,11 @@ export class OstVfsAdapter implements IVirtualFileSystem {
     /* ----------------------------------------------------------- */
 
     async open(path: string, mode: FileMode): Promise<IVirtualFile> {
+        if (mode === FileMode.READ && hasNativeBindings) {
+            const pack = await this.openIndexed(path);
+            if (pack) return new OstPackedFile(pack, this.base, path);
+        }
+
         // We only wrap READ / WRITE – everything else is delegated.
         const file = await this.base.open(path, mode);
 
@@ -92,8 +185,9 @@ export class OstVfsAdapter implements IVirtualFileSystem {
 
             async write(data: Uint8Array): Promise<number> {
                 // Compress using OST
-                const plain = new TextDecoder().decode(data);
-                const packed = await OSTPackWriter.createPack(plain, self.config);
+                const packed = self.indexed
+                    ? IndexedPackWriter.createIndexedPack(data, self.config)
+                    : await OSTPackWriter.createPack(new TextDecoder().decode(data), self.config);
                 return file.write(packed);
             },
 
@@ -118,10 +212,23 @@ export class OstVfsAdapter implements IVirtualFileSystem {
     rmdir   = (p: string, r?: boolean | undefined) => this.base.rmdir(p, r);
 }
 
+/** Reads up to `length` bytes, stopping early only at the end of the file. */
+async function readFully(file: IVirtualFile, length: number): Promise<Uint8Array> {
+    const out = new Uint8Array(length);
+    let filled = 0;
+    while (filled < length) {
+        const n = await file.read(out.subarray(filled), length - filled);
+        if (n <= 0) break;
+        filled += n;
+    }
+    return out.subarray(0, filled);
+}
+
 /* ------------------------------------------------------------------ */
 /* Factory helper – sugar for one‑liners                               */
 /* ------------------------------------------------------------------ */
 export const createOstVFS = (
     base: IVirtualFileSystem,
-    cfg: Partial<OSTConfig> = {}
-): IVirtualFileSystem => new OstVfsAdapter(base, cfg);
+    cfg: Partial<OSTConfig> = {},
+    options: OstVfsOptions = {}
+): IVirtualFileSystem => new OstVfsAdapter(base, cfg, options);
@@ -12,6 +12,10 @@ import {
     decompress as lz4Decompress
 } from "@nick/lz4/_dist/mod";
 import { init, compress as zstdCompress, decompress as zstdDecompress } from '@bokuweb/zstd-wasm';
+import { hasNativeBindings, nativeBindings, UniversalCode } from '../uDTLS-PQ/src/lib/bindings';
+
+// Bin methods the native addon compresses and decompresses itself.
+const NATIVE_BIN_METHODS = new Set(['huffman', 'raw', 'brotli', 'zstd', 'lz4']);
 
 
 
@@ -115,6 +119,17 @@ export class OSTCompression {
         // Step 4: Compress each bin
         const compressedBins = new Map<string, Uint8Array>();
 
+        if (this.usesNativeBins()) {
+            // One call for every bin, fanned out over the native worker pool
+            const labels = Array.from(bins.keys());
+            const packed = nativeBindings.ostCompressBins(
+                labels.map(label => bins.get(label)!.getData()),
+                this.config.compressionMethod
+            );
+            labels.forEach((label, i) => compressedBins.set(label, packed[i]));
+            return { compressedBins, metadata: { config: this.config } };
+        }
+
         for (const [label, bin] of bins.entries()) {
             const compressedData = this.compressBin(bin);
             compressedBins.set(label, await compressedData);
@@ -154,7 +169,17 @@ export class OSTCompression {
         // Decompress each bin
         const decompressedBins = new Map<string, string>();
 
+        if (this.usesNativeBins()) {
+            const labels = Array.from(compressedBins.keys());
+            const bins = nativeBindings.ostDecompressBins(
+                labels.map(label => Buffer.from(compressedBins.get(label)!)),
+                this.config.compressionMethod
+            );
+            labels.forEach((label, i) => decompressedBins.set(label, bins[i].toString('utf8')));
+        }
+
         for (const [label, compressedBin] of compressedBins.entries()) {
+            if (decompressedBins.has(label)) continue;
             const decompressedData = await this.decompressBin(compressedBin);
             decompressedBins.set(label, decompressedData);
         }
@@ -166,6 +191,13 @@ export class OSTCompression {
         return "Decompression process would reconstruct the original data here";
     }
 
+    /**
+     * Whether bins go through the native addon's batch calls
+     */
+    private usesNativeBins(): boolean {
+        return hasNativeBindings && NATIVE_BIN_METHODS.has(this.config.compressionMethod);
+    }
+
     /**
      * Divides the input data into windows of specified length
      *
@@ -346,6 +378,8 @@ export class OSTCompression {
                 return brotliCompress(data);
             case 'zstd':
                 return zstdCompress(data);
+            case 'lz4':
+                return lz4Compress(data);
             case 'raw':
             default:
                 return data;
@@ -368,6 +402,8 @@ export class OSTCompression {
                 return new TextDecoder().decode(await brotliDecompress(compressedData));
             case 'zstd':
                 return new TextDecoder().decode(await zstdDecompress(compressedData));
+            case 'lz4':
+                return new TextDecoder().decode(lz4Decompress(compressedData));
             case 'raw':
             default:
                 return new TextDecoder().decode(compressedData);
@@ -657,6 +693,57 @@ export const OSTHelper = {
             default:
                 throw new Error(`Unsupported universal code type: ${type}`);
         }
+    },
+
+    /**
+     * Encodes a whole array with a universal code, packed MSB-first
+     * @param type The type of universal code to use
+     * @param values Positive integers
+     * @returns The packed codes and their length in bits
+     */
+    encodeUniversal(type: UniversalCode, values: ArrayLike<number>): { data: Uint8Array, bits: number } {
+        if (hasNativeBindings) return nativeBindings.universalEncode(type, values);
+
+        const codec = OSTHelper.createUniversalCodec(type);
+        const bits = Array.from(values, n => codec.encode(n)).join('');
+        const data = new Uint8Array(Math.ceil(bits.length / 8));
+        for (let i = 0; i < bits.length; i++) {
+            if (bits[i] === '1') data[i >> 3] |= 0x80 >> (i & 7);
+        }
+        return { data, bits: bits.length };
+    },
+
+    /**
+     * Decodes codes written by encodeUniversal
+     * @param type The type of universal code to use
+     * @param data The packed codes
+     * @param bits How many bits of data hold codes (default: all of them)
+     * @param count How many values to decode (default: until the bits run out)
+     */
+    decodeUniversal(type: UniversalCode, data: Uint8Array, bits = data.length * 8, count = Infinity): {
+        values: number[],
+        bitsRead: number
+    } {
+        if (hasNativeBindings) {
+            const buf = Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+            const result = nativeBindings.universalDecode(type, buf, bits, count === Infinity ? undefined : count);
+            return { values: Array.from(result.values), bitsRead: result.bitsRead };
+        }
+
+        const codec = OSTHelper.createUniversalCodec(type);
+        let str = '';
+        for (let i = 0; i < bits; i++) str += (data[i >> 3] >> (7 - (i & 7))) & 1;
+        const values: number[] = [];
+        let bitsRead = 0;
+        while (bitsRead < bits && values.length < count) {
+            const decoded = codec.decode(str.slice(bitsRead));
+            values.push(decoded.value);
+            bitsRead += decoded.bitsRead;
+        }
+        if (count !== Infinity && values.length < count) {
+            throw new Error('Not enough bits for the requested count');
+        }
+        return { values, bitsRead };
     }
 };
 
@@ -0,0 +1,53 @@
+import { hasNativeBindings, nativeBindings, OstPackInfo } from '../uDTLS-PQ/src/lib/bindings';
+
+/**
+ * Random access into a pack written by OSTPackWriter.createIndexedPack.
+ * Files are memory‑mapped by the addon and only the windows a read overlaps
+ * are decoded, so opening is cheap however large the pack and a read costs
+ * about its own length.
+ */
+export class OSTPackFile {
+    private handle: { id: number } | null;
+    readonly info: OstPackInfo;
+
+    private constructor(handle: { id: number }) {
+        this.handle = handle;
+        this.info = nativeBindings.ostPackInfo(handle);
+    }
+
+    /** `source` is a file path to map, or the pack bytes (copied). */
+    static open(source: string | Uint8Array): OSTPackFile {
+        if (!hasNativeBindings) throw new Error('Indexed OST packs need the native addon');
+        const pack = typeof source === 'string'
+            ? source
+            : Buffer.from(source.buffer, source.byteOffset, source.byteLength);
+        return new OSTPackFile(nativeBindings.ostOpenPack(pack));
+    }
+
+    /** UTF‑8 length of the packed text. */
+    get size(): number {
+        return this.info.size;
+    }
+
+    read(position: number, length: number): Buffer {
+        return nativeBindings.ostPackRead(this.live(), position, length);
+    }
+
+    /** Fills `target` from `position`; returns the bytes read (0 at the end). */
+    readInto(target: Uint8Array, position: number): number {
+        const view = Buffer.isBuffer(target)
+            ? target
+            : Buffer.from(target.buffer, target.byteOffset, target.byteLength);
+        return nativeBindings.ostPackReadInto(this.live(), view, position);
+    }
+
+    close(): void {
+        if (this.handle) nativeBindings.ostClosePack(this.handle);
+        this.handle = null;
+    }
+
+    private live(): { id: number } {
+        if (!this.handle) throw new Error('OST pack is closed');
+        return this.handle;
+    }
+}
@@ -1,4 +1,5 @@
 import { OSTCompression } from './OSTCompression';
+import { hasNativeBindings, nativeBindings } from '../uDTLS-PQ/src/lib/bindings';
 
 export class OSTPackReader {
     static async extractPack(pack: Uint8Array): Promise<string> {
@@ -14,12 +15,33 @@ export class OSTPackReader {
             config: any;
             binSequence: string[];
             bins: string[];
+            index?: boolean;
+            stream?: boolean;
         };
 
+        // Packs written with recordOrder carry the window order the native
+        // decoder needs to rebuild the input.
+        const method = header.config?.compressionMethod ?? 'huffman';
+        if (hasNativeBindings && ['huffman', 'raw', 'brotli', 'zstd', 'lz4'].includes(method)) {
+            const buf = Buffer.from(pack.buffer, pack.byteOffset, pack.byteLength);
+            const { data } = nativeBindings.ostDecode(buf);
+            if (data) return data.toString('utf8');
+        }
+        // Streamed packs repeat labels and carry order records between bins.
+        if (header.stream) throw new Error('Streamed OST packs need the native addon');
+
+        // Indexed packs end in u64 indexOffset | "OSTI"; the bins stop there.
+        let end = pack.length;
+        if (header.index) {
+            const t = end - 12;
+            end = ((pack[t] << 24) | (pack[t + 1] << 16) | (pack[t + 2] << 8) | pack[t + 3]) * 2 ** 32 +
+                (((pack[t + 4] << 24) | (pack[t + 5] << 16) | (pack[t + 6] << 8) | pack[t + 7]) >>> 0);
+        }
+
         const compressedBins = new Map<string, Uint8Array>();
         let offset = 8 + headerLen;
 
-        while (offset < pack.length) {
+        while (offset < end) {
             const labelLen = (pack[offset] << 8) | pack[offset + 1];
             const label = new TextDecoder().decode(
                 pack.slice(offset + 2, offset + 2 + labelLen)
@@ -0,0 +1,37 @@
+import { hasNativeBindings, nativeBindings, OstStreamOptions } from '../uDTLS-PQ/src/lib/bindings';
+
+/**
+ * Builds an OST pack from input that arrives in pieces, for logs and
+ * archives too large to hold as one string. Windows are binned as chunks
+ * come in and bins are compressed in blocks, so memory stays near
+ * `memoryLimit` whatever the input size. Each call returns the pack bytes
+ * it completed; write them out in order. OSTPackReader reads the result.
+ */
+export class OSTPackStream {
+    private handle: { id: number } | null;
+
+    constructor(options: OstStreamOptions = {}) {
+        if (!hasNativeBindings) throw new Error('Streamed OST packs need the native addon');
+        this.handle = nativeBindings.ostStreamCreate(options);
+    }
+
+    /** UTF‑8 chunks may split a character; the rest is taken from the next one. */
+    write(chunk: string | Uint8Array): Buffer {
+        const data = typeof chunk === 'string' || Buffer.isBuffer(chunk)
+            ? chunk
+            : Buffer.from(chunk.buffer, chunk.byteOffset, chunk.byteLength);
+        return nativeBindings.ostStreamWrite(this.live(), data);
+    }
+
+    /** The last pack bytes; the stream cannot be written after this. */
+    end(): Buffer {
+        const tail = nativeBindings.ostStreamEnd(this.live());
+        this.handle = null;
+        return tail;
+    }
+
+    private live(): { id: number } {
+        if (!this.handle) throw new Error('OST stream has ended');
+        return this.handle;
+    }
+}
@@ -1,10 +1,22 @@
 import { OSTCompression } from './OSTCompression';
 import {OSTConfig} from "./types";
+import { hasNativeBindings, nativeBindings } from '../uDTLS-PQ/src/lib/bindings';
+
+// Methods the native codec writes itself; the rest go through OSTCompression.
+const NATIVE_METHODS = new Set(['huffman', 'raw', 'brotli', 'zstd', 'lz4']);
+// Bins the window index can address; it points into Huffman code streams
+// and raw UTF-8, not into general-purpose compressed blocks.
+const INDEXABLE_METHODS = new Set(['huffman', 'raw']);
 
 export class OSTPackWriter {
     static async createPack(data: string, config: Partial<OSTConfig> = {}): Promise<Uint8Array> {
+        // Same bytes as the path below, without building the bins as JS strings
+        if (hasNativeBindings && NATIVE_METHODS.has(config.compressionMethod ?? 'huffman')) {
+            return nativeBindings.ostEncode(data, config);
+        }
+
         const compressor = new OSTCompression(config);
-        const { compressedBins, metadata } = compressor.encode(data);
+        const { compressedBins, metadata } = await compressor.encode(data);
 
         const binSequence = Array.from(compressedBins.keys());
         const headerJson = JSON.stringify({
@@ -55,4 +67,18 @@ export class OSTPackWriter {
 
         return result;
     }
+
+    /**
+     * An OST1 pack with a window index appended, for OSTPackFile's ranged
+     * reads. The bins are the same as createPack's; readers that predate the
+     * index stop at the `index` header flag.
+     */
+    static createIndexedPack(data: string | Uint8Array, config: Partial<OSTConfig> = {}): Uint8Array {
+        if (!hasNativeBindings) throw new Error('Indexed OST packs need the native addon');
+        if (!INDEXABLE_METHODS.has(config.compressionMethod ?? 'huffman')) {
+            throw new Error(`compressionMethod '${config.compressionMethod}' cannot be indexed`);
+        }
+        const input = typeof data === 'string' ? data : Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+        return nativeBindings.ostEncode(input, { ...config, index: true });
+    }
 }
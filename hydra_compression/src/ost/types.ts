@@ -2,7 +2,7 @@ export interface OSTConfig {
     windowLength: number;
     labelLength: number;
     variableWindow?: boolean;
-    compressionMethod: 'huffman' | 'brotli' | 'zstd' | 'raw';
+    compressionMethod: 'huffman' | 'brotli' | 'zstd' | 'lz4' | 'raw';
     subBinning?: boolean;
     subBinningDepth?: number;
 }
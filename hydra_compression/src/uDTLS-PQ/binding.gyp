@@ -4,11 +4,48 @@
       "target_name": "openssl_pq",
       "sources": [
         "src/bindings/openssl.cpp",
-        "src/bindings/pq_crypto.cpp"
+        "src/bindings/dtls_core.cpp",
+        "src/bindings/pq_crypto.cpp",
+        "src/bindings/kem_registry.cpp",
+        "src/bindings/sig_registry.cpp",
+        "src/bindings/worker_pool.cpp",
+        "src/bindings/kem_pool.cpp",
+        "src/bindings/secret_arena.cpp",
+        "src/bindings/dgram_bio.cpp",
+        "src/bindings/udp_socket.cpp",
+        "src/bindings/dtls_server.cpp",
+        "src/bindings/session_cache.cpp",
+        "src/bindings/cookie_exchange.cpp",
+        "src/bindings/identity_cache.cpp",
+        "src/bindings/context_pool.cpp",
+        "src/bindings/aead.cpp",
+        "src/bindings/ost_codec.cpp",
+        "src/bindings/ost_pack.cpp",
+        "src/bindings/ost_stream.cpp",
+        "src/bindings/universal_codec.cpp",
+        "src/bindings/blake3.cpp",
+        "src/bindings/bin_compress.cpp",
+        "src/bindings/metrics.cpp"
       ],
 
       "cflags_cc": ["-std=c++17"],
-      "libraries": ["-lssl", "-lcrypto", "-loqs"]
+      "libraries": ["-lssl", "-lcrypto", "-loqs", "-lbrotlienc", "-lbrotlidec", "-lzstd", "-llz4"]
+    },
+    {
+      "target_name": "openssl_pq_bench",
+      "type": "executable",
+      "sources": [
+        "src/bench/openssl_pq_bench.cpp",
+        "src/bindings/dtls_core.cpp",
+        "src/bindings/kem_registry.cpp",
+        "src/bindings/dgram_bio.cpp",
+        "src/bindings/session_cache.cpp",
+        "src/bindings/cookie_exchange.cpp",
+        "src/bindings/identity_cache.cpp"
+      ],
+
+      "cflags_cc": ["-std=c++17", "-O2"],
+      "libraries": ["-lssl", "-lcrypto", "-loqs", "-lpthread"]
     }
   ]
 }
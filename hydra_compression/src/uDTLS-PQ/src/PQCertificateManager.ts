@@ -59,9 +59,8 @@ export class PQCertificateManager {
     private generatePQKeys(alg: PQAlgorithm): HybridKeyPair {
         switch (alg) {
             case PQAlgorithm.DILITHIUM2:
-                return nativeBindings.generateDilithiumKeyPair();
             case PQAlgorithm.DILITHIUM3:
-                return nativeBindings.generateDilithiumKeyPair();
+                return nativeBindings.generateDilithiumKeyPair(alg);
             default:
                 throw new Error(`Unsupported PQ algorithm: ${alg}`);
         }
@@ -0,0 +1,325 @@
+// src/bench/openssl_pq_bench.cpp
+// Native micro-benchmark for the primitives behind the openssl_pq addon:
+// Kyber keygen/encaps/decaps for every level and a full in-memory DTLS
+// handshake over the record path, each at several thread counts. Prints one
+// JSON document to stdout.
+//
+//   openssl_pq_bench [--iterations N] [--handshakes N] [--threads 1,2,8]
+//                    [--cert server.crt --key server.key]
+//
+// Without --cert/--key a throwaway P-256 certificate is generated.
+#include "../bindings/openssl.h"
+#include "../bindings/kem_registry.h"
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+  std::string name;
+  std::string algorithm;
+  int threads;
+  size_t ops;
+  double opsPerSec;
+  double meanUs, p50Us, p99Us;
+};
+
+// makeWorker runs once per thread, untimed, and returns the op that is timed.
+struct BenchCase {
+  std::string name;
+  std::string algorithm;
+  std::function<std::function<bool()>()> makeWorker;
+};
+
+static double percentile(std::vector<double>& v, double p) {
+  if (v.empty()) return 0;
+  size_t k = static_cast<size_t>(p * (v.size() - 1));
+  std::nth_element(v.begin(), v.begin() + k, v.end());
+  return v[k];
+}
+
+static bool run_case(const BenchCase& c, int threads, size_t iterations, BenchResult& out) {
+  std::vector<std::vector<double>> latencies(threads);
+  std::vector<char> failed(threads, 0);
+  std::vector<std::function<bool()>> ops;
+  for (int t = 0; t < threads; t++) ops.push_back(c.makeWorker());
+
+  auto start = Clock::now();
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; t++) {
+    pool.emplace_back([&, t] {
+      latencies[t].reserve(iterations);
+      for (size_t i = 0; i < iterations; i++) {
+        auto t0 = Clock::now();
+        if (!ops[t]()) { failed[t] = 1; return; }
+        latencies[t].push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+      }
+    });
+  }
+  for (auto& th : pool) th.join();
+  double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end()) return false;
+
+  std::vector<double> all;
+  for (auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+  double sum = 0;
+  for (double x : all) sum += x;
+
+  out.name = c.name;
+  out.algorithm = c.algorithm;
+  out.threads = threads;
+  out.ops = all.size();
+  out.opsPerSec = wall > 0 ? all.size() / wall : 0;
+  out.meanUs = all.empty() ? 0 : sum / all.size();
+  out.p50Us = percentile(all, 0.50);
+  out.p99Us = percentile(all, 0.99);
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// KEM cases
+// ---------------------------------------------------------------------------
+
+static void add_kem_cases(std::vector<BenchCase>& cases) {
+  for (int h = 0; h < KEM_COUNT; h++) {
+    const OQS_KEM* kem = get_kem(h);
+    if (!kem) continue;
+
+    cases.push_back({ "kem.keypair", KEM_TABLE[h].name, [kem] {
+      auto pk = std::make_shared<std::vector<uint8_t>>(kem->length_public_key);
+      auto sk = std::make_shared<std::vector<uint8_t>>(kem->length_secret_key);
+      return std::function<bool()>([kem, pk, sk] {
+        return OQS_KEM_keypair(kem, pk->data(), sk->data()) == OQS_SUCCESS;
+      });
+    } });
+
+    cases.push_back({ "kem.encaps", KEM_TABLE[h].name, [kem] {
+      auto pk = std::make_shared<std::vector<uint8_t>>(kem->length_public_key);
+      auto sk = std::make_shared<std::vector<uint8_t>>(kem->length_secret_key);
+      auto ct = std::make_shared<std::vector<uint8_t>>(kem->length_ciphertext);
+      auto ss = std::make_shared<std::vector<uint8_t>>(kem->length_shared_secret);
+      OQS_KEM_keypair(kem, pk->data(), sk->data());
+      return std::function<bool()>([kem, pk, ct, ss] {
+        return OQS_KEM_encaps(kem, ct->data(), ss->data(), pk->data()) == OQS_SUCCESS;
+      });
+    } });
+
+    cases.push_back({ "kem.decaps", KEM_TABLE[h].name, [kem] {
+      auto pk = std::make_shared<std::vector<uint8_t>>(kem->length_public_key);
+      auto sk = std::make_shared<std::vector<uint8_t>>(kem->length_secret_key);
+      auto ct = std::make_shared<std::vector<uint8_t>>(kem->length_ciphertext);
+      auto ss = std::make_shared<std::vector<uint8_t>>(kem->length_shared_secret);
+      OQS_KEM_keypair(kem, pk->data(), sk->data());
+      OQS_KEM_encaps(kem, ct->data(), ss->data(), pk->data());
+      return std::function<bool()>([kem, sk, ct, ss] {
+        return OQS_KEM_decaps(kem, ss->data(), ct->data(), sk->data()) == OQS_SUCCESS;
+      });
+    } });
+  }
+}
+
+// ---------------------------------------------------------------------------
+// DTLS handshake case
+// ---------------------------------------------------------------------------
+
+// Self-signed P-256 certificate so the benchmark runs without fixtures.
+static bool use_generated_cert(SSL_CTX* ctx) {
+  EVP_PKEY* pkey = EVP_EC_gen("P-256");
+  X509* cert = X509_new();
+  bool ok = pkey && cert;
+  if (ok) {
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, pkey);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("openssl-pq-bench"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    ok = X509_sign(cert, pkey, EVP_sha256()) > 0 &&
+         SSL_CTX_use_certificate(ctx, cert) == 1 &&
+         SSL_CTX_use_PrivateKey(ctx, pkey) == 1;
+  }
+  X509_free(cert);
+  EVP_PKEY_free(pkey);
+  return ok;
+}
+
+// Runs both ends of one handshake through dtls_step until both finish.
+static bool handshake_once(SSL_CTX* server_ctx, SSL_CTX* client_ctx) {
+  SSLSessionWrapper server(server_ctx), client(client_ctx);
+  if (!server.get() || !client.get()) return false;
+  // Same default as createSession(); the BIO has no socket to query.
+  for (SSL* ssl : { server.get(), client.get() }) {
+    SSL_set_mtu(ssl, 1400);
+    DTLS_set_link_mtu(ssl, 1400);
+  }
+  SSL_set_accept_state(server.get());
+  SSL_set_connect_state(client.get());
+
+  DtlsStepResult first;
+  dtls_step(client, nullptr, 0, first);
+  std::vector<std::vector<uint8_t>> to_server = std::move(first.datagrams), to_client;
+
+  for (int round = 0; round < 16; round++) {
+    std::vector<std::vector<uint8_t>> next_to_client, next_to_server;
+
+    for (auto& d : to_server) {
+      DtlsStepResult r;
+      dtls_step(server, d.data(), d.size(), r);
+      if (!r.error.empty()) return false;
+      for (auto& out : r.datagrams) next_to_client.push_back(std::move(out));
+    }
+    for (auto& d : to_client) {
+      DtlsStepResult r;
+      dtls_step(client, d.data(), d.size(), r);
+      if (!r.error.empty()) return false;
+      for (auto& out : r.datagrams) next_to_server.push_back(std::move(out));
+    }
+
+    if (SSL_is_init_finished(server.get()) && SSL_is_init_finished(client.get())) return true;
+    to_client = std::move(next_to_client);
+    to_server = std::move(next_to_server);
+    if (to_client.empty() && to_server.empty()) break;
+  }
+  return false;
+}
+
+static bool add_handshake_case(std::vector<BenchCase>& cases, const std::string& cert,
+                               const std::string& key, std::string& error) {
+  // Shared across threads like the addon's contexts; never freed before exit.
+  static std::shared_ptr<SSLContextWrapper> server_ctx, client_ctx;
+  server_ctx = std::make_shared<SSLContextWrapper>(create_dtls_context(true));
+  client_ctx = std::make_shared<SSLContextWrapper>(create_dtls_context(false));
+  if (!server_ctx->get() || !client_ctx->get()) {
+    error = "Failed to create DTLS contexts";
+    return false;
+  }
+
+  bool ok = cert.empty() ? use_generated_cert(server_ctx->get())
+                         : set_certificates(server_ctx->get(), cert.c_str(), key.c_str());
+  if (!ok) {
+    error = "Failed to load server certificate";
+    return false;
+  }
+  // Full handshakes only: no resumption from an earlier iteration.
+  SSL_CTX_set_session_cache_mode(server_ctx->get(), SSL_SESS_CACHE_OFF);
+  SSL_CTX_set_options(server_ctx->get(), SSL_OP_NO_TICKET);
+
+  SSL_CTX* s = server_ctx->get();
+  SSL_CTX* c = client_ctx->get();
+  cases.push_back({ "dtls.handshake", "DTLS", [s, c] {
+    return std::function<bool()>([s, c] { return handshake_once(s, c); });
+  } });
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+
+static std::vector<int> parse_threads(const char* arg) {
+  std::vector<int> out;
+  for (const char* p = arg; *p;) {
+    int n = std::atoi(p);
+    if (n > 0 && std::find(out.begin(), out.end(), n) == out.end()) out.push_back(n);
+    const char* comma = std::strchr(p, ',');
+    if (!comma) break;
+    p = comma + 1;
+  }
+  return out;
+}
+
+static void print_json_string(const std::string& s) {
+  std::putchar('"');
+  for (char ch : s) {
+    if (ch == '"' || ch == '\\') std::putchar('\\');
+    std::putchar(ch);
+  }
+  std::putchar('"');
+}
+
+int main(int argc, char** argv) {
+  size_t iterations = 2000;
+  size_t handshakes = 200;
+  std::string cert, key;
+  int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<int> threads = { 1 };
+  if (hw > 1) threads.push_back(hw);
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if      (a == "--iterations" && v) { iterations = std::strtoul(v, nullptr, 10); i++; }
+    else if (a == "--handshakes" && v) { handshakes = std::strtoul(v, nullptr, 10); i++; }
+    else if (a == "--threads" && v)    { threads = parse_threads(v); i++; }
+    else if (a == "--cert" && v)       { cert = v; i++; }
+    else if (a == "--key" && v)        { key = v; i++; }
+    else {
+      std::fprintf(stderr, "usage: %s [--iterations N] [--handshakes N] [--threads 1,2,8] "
+                           "[--cert file --key file]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (threads.empty() || (cert.empty() != key.empty())) {
+    std::fprintf(stderr, "invalid --threads or --cert/--key\n");
+    return 2;
+  }
+
+  init_openssl();
+  init_kem_registry();
+
+  std::vector<BenchCase> kem_cases, dtls_cases;
+  add_kem_cases(kem_cases);
+  std::string handshake_error;
+  add_handshake_case(dtls_cases, cert, key, handshake_error);
+
+  std::vector<BenchResult> results;
+  std::vector<std::string> errors;
+  if (!handshake_error.empty()) errors.push_back(handshake_error);
+
+  auto run_all = [&](const std::vector<BenchCase>& cases, size_t n) {
+    for (const auto& c : cases) {
+      for (int t : threads) {
+        BenchResult r;
+        if (run_case(c, t, n, r)) results.push_back(r);
+        else errors.push_back(c.name + " " + c.algorithm + " failed at " + std::to_string(t) + " threads");
+      }
+    }
+  };
+  run_all(kem_cases, iterations);
+  run_all(dtls_cases, handshakes);
+
+  std::printf("{\n  \"openssl\": ");
+  print_json_string(OpenSSL_version(OPENSSL_VERSION));
+  std::printf(",\n  \"liboqs\": ");
+  print_json_string(OQS_version());
+  std::printf(",\n  \"hardwareConcurrency\": %d,\n  \"results\": [", hw);
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& r = results[i];
+    std::printf("%s\n    { \"name\": ", i ? "," : "");
+    print_json_string(r.name);
+    std::printf(", \"algorithm\": ");
+    print_json_string(r.algorithm);
+    std::printf(", \"threads\": %d, \"ops\": %zu, \"opsPerSec\": %.1f, "
+                "\"meanUs\": %.2f, \"p50Us\": %.2f, \"p99Us\": %.2f }",
+                r.threads, r.ops, r.opsPerSec, r.meanUs, r.p50Us, r.p99Us);
+  }
+  std::printf("\n  ],\n  \"errors\": [");
+  for (size_t i = 0; i < errors.size(); i++) {
+    std::printf("%s", i ? ", " : "");
+    print_json_string(errors[i]);
+  }
+  std::printf("]\n}\n");
+  return errors.empty() ? 0 : 1;
+}
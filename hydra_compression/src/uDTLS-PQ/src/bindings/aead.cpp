@@ -0,0 +1,684 @@
+// src/bindings/aead.cpp
+#include "aead.h"
+#include "handle_table.h"
+#include "metrics.h"
+#include "worker_pool.h"
+#include <openssl/crypto.h>
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstring>
+#include <string>
+
+// Contexts beyond this many per key and direction are freed, not kept.
+static constexpr size_t AEAD_IDLE_CONTEXTS = 64;
+
+static const EVP_CIPHER* cipher_of(AeadAlgorithm alg) {
+  return alg == AeadAlgorithm::AES_256_GCM ? EVP_aes_256_gcm() : EVP_chacha20_poly1305();
+}
+
+std::shared_ptr<AeadKey> AeadKey::create(AeadAlgorithm alg, const uint8_t* key, size_t len) {
+  if (!key || len != AEAD_KEY_BYTES) return nullptr;
+  SecretPtr copy = make_secret(len);
+  if (!copy) return nullptr;
+  std::memcpy(copy.get(), key, len);
+  return std::shared_ptr<AeadKey>(new AeadKey(alg, std::move(copy)));
+}
+
+// EVP_CIPHER_CTX_free wipes the expanded key schedule.
+AeadKey::~AeadKey() {
+  for (auto& list : idle_)
+    for (EVP_CIPHER_CTX* ctx : list) EVP_CIPHER_CTX_free(ctx);
+}
+
+bool AeadKey::matches(AeadAlgorithm alg, const uint8_t* key, size_t len) const {
+  return alg == alg_ && len == AEAD_KEY_BYTES && CRYPTO_memcmp(key_.get(), key, len) == 0;
+}
+
+EVP_CIPHER_CTX* AeadKey::acquire(bool encrypt) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    std::vector<EVP_CIPHER_CTX*>& list = idle_[encrypt];
+    if (!list.empty()) {
+      EVP_CIPHER_CTX* ctx = list.back();
+      list.pop_back();
+      return ctx;
+    }
+  }
+  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+  if (ctx && EVP_CipherInit_ex(ctx, cipher_of(alg_), nullptr, key_.get(), nullptr, encrypt) == 1)
+    return ctx;
+  EVP_CIPHER_CTX_free(ctx);
+  return nullptr;
+}
+
+void AeadKey::recycle(EVP_CIPHER_CTX* ctx, bool encrypt) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    std::vector<EVP_CIPHER_CTX*>& list = idle_[encrypt];
+    if (list.size() < AEAD_IDLE_CONTEXTS) {
+      list.push_back(ctx);
+      return;
+    }
+  }
+  EVP_CIPHER_CTX_free(ctx);
+}
+
+// Passing only the IV to CipherInit keeps the key schedule from acquire().
+bool AeadKey::seal(const uint8_t* iv, const uint8_t* aad, size_t aad_len,
+                   const uint8_t* in, size_t len, uint8_t* out, uint8_t* tag) {
+  if (len > INT_MAX || aad_len > INT_MAX) return false;
+  EVP_CIPHER_CTX* ctx = acquire(true);
+  if (!ctx) return false;
+
+  int n = 0, fin = 0;
+  bool ok = EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) == 1 &&
+            (aad_len == 0 || EVP_EncryptUpdate(ctx, nullptr, &n, aad, static_cast<int>(aad_len)) == 1) &&
+            (n = 0, len == 0 || EVP_EncryptUpdate(ctx, out, &n, in, static_cast<int>(len)) == 1) &&
+            EVP_EncryptFinal_ex(ctx, out + n, &fin) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, AEAD_TAG_BYTES, tag) == 1;
+
+  if (ok) recycle(ctx, true);
+  else EVP_CIPHER_CTX_free(ctx);
+  return ok;
+}
+
+bool AeadKey::open(const uint8_t* iv, const uint8_t* aad, size_t aad_len,
+                   const uint8_t* in, size_t len, const uint8_t* tag, uint8_t* out) {
+  if (len > INT_MAX || aad_len > INT_MAX) return false;
+  EVP_CIPHER_CTX* ctx = acquire(false);
+  if (!ctx) return false;
+
+  // SET_TAG wants a mutable pointer, and the tag may sit right after an
+  // in-place output.
+  uint8_t expected[AEAD_TAG_BYTES];
+  std::memcpy(expected, tag, sizeof(expected));
+
+  int n = 0, fin = 0;
+  bool ready = EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) == 1 &&
+               (aad_len == 0 || EVP_DecryptUpdate(ctx, nullptr, &n, aad, static_cast<int>(aad_len)) == 1) &&
+               (n = 0, len == 0 || EVP_DecryptUpdate(ctx, out, &n, in, static_cast<int>(len)) == 1) &&
+               EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, AEAD_TAG_BYTES, expected) == 1;
+  bool ok = ready && EVP_DecryptFinal_ex(ctx, out + n, &fin) > 0;
+
+  // A failed tag check leaves the context reusable; errors before it drop it.
+  if (ready) recycle(ctx, false);
+  else EVP_CIPHER_CTX_free(ctx);
+  if (!ok && len) OPENSSL_cleanse(out, len);
+  return ok;
+}
+
+// --- Argument helpers ---
+static HandleTable<AeadKey> g_aead_keys;
+
+static bool get_buffer_arg(napi_env env, napi_value v, uint8_t** data, size_t* len) {
+  bool is_buffer = false;
+  napi_is_buffer(env, v, &is_buffer);
+  if (!is_buffer) return false;
+  void* ptr;
+  napi_get_buffer_info(env, v, &ptr, len);
+  *data = static_cast<uint8_t*>(ptr);
+  return true;
+}
+
+// undefined / null / missing leave data empty; anything else must be a Buffer.
+static bool get_optional_buffer(napi_env env, size_t argc, napi_value* args, size_t index,
+                                uint8_t** data, size_t* len) {
+  *data = nullptr;
+  *len = 0;
+  if (argc <= index) return true;
+  napi_valuetype t;
+  napi_typeof(env, args[index], &t);
+  if (t == napi_undefined || t == napi_null) return true;
+  return get_buffer_arg(env, args[index], data, len);
+}
+
+static bool get_iv_arg(napi_env env, napi_value v, uint8_t** iv) {
+  size_t len = 0;
+  return get_buffer_arg(env, v, iv, &len) && len == AEAD_IV_BYTES;
+}
+
+static bool get_algorithm(napi_env env, size_t argc, napi_value* args, size_t index, AeadAlgorithm* alg) {
+  *alg = AeadAlgorithm::AES_256_GCM;
+  if (argc <= index) return true;
+  napi_valuetype t;
+  napi_typeof(env, args[index], &t);
+  if (t == napi_undefined) return true;
+  char buf[32];
+  size_t len = 0;
+  if (napi_get_value_string_utf8(env, args[index], buf, sizeof(buf), &len) != napi_ok) return false;
+  std::string name(buf, len);
+  if (name == "aes-256-gcm") return true;
+  if (name == "chacha20-poly1305") {
+    *alg = AeadAlgorithm::CHACHA20_POLY1305;
+    return true;
+  }
+  return false;
+}
+
+// Raw key Buffers are AES-256-GCM. The last few keys seen on this thread keep
+// their prepared contexts (each worker_thread env runs on its own thread),
+// so callers that never create a handle still skip the key schedule.
+static std::shared_ptr<AeadKey> raw_key(const uint8_t* key, size_t len) {
+  thread_local std::array<std::shared_ptr<AeadKey>, 8> recent;
+  thread_local size_t next = 0;
+  for (auto& k : recent)
+    if (k && k->matches(AeadAlgorithm::AES_256_GCM, key, len)) return k;
+  std::shared_ptr<AeadKey> created = AeadKey::create(AeadAlgorithm::AES_256_GCM, key, len);
+  if (created) {
+    recent[next] = created;
+    next = (next + 1) % recent.size();
+  }
+  return created;
+}
+
+// A { id } from createAeadKey or a raw 32-byte key Buffer.
+static std::shared_ptr<AeadKey> get_key_or_throw(napi_env env, napi_value v) {
+  uint8_t* data;
+  size_t len;
+  if (get_buffer_arg(env, v, &data, &len)) {
+    std::shared_ptr<AeadKey> key = raw_key(data, len);
+    if (!key) napi_throw_error(env, nullptr, "Key must be 32 bytes");
+    return key;
+  }
+
+  napi_value id_value;
+  int id = 0;
+  if (napi_get_named_property(env, v, "id", &id_value) == napi_ok)
+    napi_get_value_int32(env, id_value, &id);
+  std::shared_ptr<AeadKey> key = g_aead_keys.get(id);
+  if (!key) napi_throw_error(env, nullptr, "Invalid AEAD key");
+  return key;
+}
+
+// Empty Buffers come back without storage; they get a scratch byte so a
+// null result still means the allocation failed.
+static uint8_t* new_buffer(napi_env env, size_t len, napi_value* out) {
+  static uint8_t empty;
+  void* data = nullptr;
+  if (napi_create_buffer(env, len, &data, out) != napi_ok) return nullptr;
+  return len ? static_cast<uint8_t*>(data) : &empty;
+}
+
+// In-place is fine; an output that starts elsewhere inside the input is not.
+static bool partially_overlaps(const uint8_t* a, size_t a_len, const uint8_t* b, size_t b_len) {
+  return a != b && a < b + b_len && b < a + a_len;
+}
+
+// --- Keys ---
+napi_value CreateAeadKey(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, algorithm?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  uint8_t* key;
+  size_t key_len;
+  AeadAlgorithm alg;
+  if (argc < 1 || !get_buffer_arg(env, args[0], &key, &key_len) || key_len != AEAD_KEY_BYTES) {
+    napi_throw_error(env, nullptr, "Key must be a 32-byte buffer");
+    return nullptr;
+  }
+  if (!get_algorithm(env, argc, args, 1, &alg)) {
+    napi_throw_error(env, nullptr, "Algorithm must be 'aes-256-gcm' or 'chacha20-poly1305'");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> aead = AeadKey::create(alg, key, key_len);
+  int id = aead ? g_aead_keys.insert(aead) : 0;
+  if (!id) {
+    napi_throw_error(env, nullptr, "Failed to create AEAD key");
+    return nullptr;
+  }
+
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  return result;
+}
+
+napi_value FreeAeadKey(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  int id = 0;
+  napi_value id_value;
+  if (argc > 0 && napi_get_named_property(env, args[0], "id", &id_value) == napi_ok)
+    napi_get_value_int32(env, id_value, &id);
+
+  // Batches already running keep their own reference.
+  napi_value result;
+  napi_get_boolean(env, g_aead_keys.remove(id) != nullptr, &result);
+  return result;
+}
+
+// --- Single messages ---
+napi_value AeadSeal(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, iv, plaintext, aad?] -> ciphertext || tag
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> key = get_key_or_throw(env, args[0]);
+  if (!key) return nullptr;
+  uint8_t *iv, *pt, *aad;
+  size_t pt_len, aad_len;
+  if (!get_iv_arg(env, args[1], &iv)) {
+    napi_throw_error(env, nullptr, "IV must be a 12-byte buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[2], &pt, &pt_len) || !get_optional_buffer(env, argc, args, 3, &aad, &aad_len)) {
+    napi_throw_error(env, nullptr, "Plaintext and AAD must be buffers");
+    return nullptr;
+  }
+
+  napi_value result;
+  uint8_t* out = new_buffer(env, pt_len + AEAD_TAG_BYTES, &result);
+  if (!out || !key->seal(iv, aad, aad_len, pt, pt_len, out, out + pt_len)) {
+    napi_throw_error(env, nullptr, "Encryption failed");
+    return nullptr;
+  }
+  return result;
+}
+
+napi_value AeadOpen(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, iv, ciphertext || tag, aad?] -> plaintext, or null
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> key = get_key_or_throw(env, args[0]);
+  if (!key) return nullptr;
+  uint8_t *iv, *in, *aad;
+  size_t in_len, aad_len;
+  if (!get_iv_arg(env, args[1], &iv)) {
+    napi_throw_error(env, nullptr, "IV must be a 12-byte buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[2], &in, &in_len) || !get_optional_buffer(env, argc, args, 3, &aad, &aad_len)) {
+    napi_throw_error(env, nullptr, "Ciphertext and AAD must be buffers");
+    return nullptr;
+  }
+
+  napi_value result;
+  if (in_len < AEAD_TAG_BYTES) {
+    napi_get_null(env, &result);
+    return result;
+  }
+  size_t ct_len = in_len - AEAD_TAG_BYTES;
+  uint8_t* out = new_buffer(env, ct_len, &result);
+  if (!out) {
+    napi_throw_error(env, nullptr, "Failed to allocate result buffer");
+    return nullptr;
+  }
+  if (!key->open(iv, aad, aad_len, in, ct_len, in + ct_len, out)) napi_get_null(env, &result);
+  return result;
+}
+
+napi_value AeadSealInto(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, iv, plaintext, out, aad?] -> bytes written
+  // out may be plaintext itself when it has AEAD_TAG_BYTES to spare.
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 4) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> key = get_key_or_throw(env, args[0]);
+  if (!key) return nullptr;
+  uint8_t *iv, *pt, *out, *aad;
+  size_t pt_len, out_len, aad_len;
+  if (!get_iv_arg(env, args[1], &iv)) {
+    napi_throw_error(env, nullptr, "IV must be a 12-byte buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[2], &pt, &pt_len) || !get_buffer_arg(env, args[3], &out, &out_len) ||
+      !get_optional_buffer(env, argc, args, 4, &aad, &aad_len)) {
+    napi_throw_error(env, nullptr, "Plaintext, output and AAD must be buffers");
+    return nullptr;
+  }
+  if (out_len < pt_len + AEAD_TAG_BYTES) {
+    napi_throw_error(env, nullptr, "Output must have room for the plaintext and a 16-byte tag");
+    return nullptr;
+  }
+  if (partially_overlaps(pt, pt_len, out, out_len)) {
+    napi_throw_error(env, nullptr, "Output must be the plaintext itself or not overlap it");
+    return nullptr;
+  }
+
+  if (!key->seal(iv, aad, aad_len, pt, pt_len, out, out + pt_len)) {
+    napi_throw_error(env, nullptr, "Encryption failed");
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, static_cast<uint32_t>(pt_len + AEAD_TAG_BYTES), &result);
+  return result;
+}
+
+napi_value AeadOpenInto(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, iv, ciphertext || tag, out, aad?] -> plaintext length, or -1
+  // out may be the input itself.
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 4) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> key = get_key_or_throw(env, args[0]);
+  if (!key) return nullptr;
+  uint8_t *iv, *in, *out, *aad;
+  size_t in_len, out_len, aad_len;
+  if (!get_iv_arg(env, args[1], &iv)) {
+    napi_throw_error(env, nullptr, "IV must be a 12-byte buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[2], &in, &in_len) || !get_buffer_arg(env, args[3], &out, &out_len) ||
+      !get_optional_buffer(env, argc, args, 4, &aad, &aad_len)) {
+    napi_throw_error(env, nullptr, "Ciphertext, output and AAD must be buffers");
+    return nullptr;
+  }
+
+  napi_value result;
+  if (in_len < AEAD_TAG_BYTES) {
+    napi_create_int32(env, -1, &result);
+    return result;
+  }
+  size_t ct_len = in_len - AEAD_TAG_BYTES;
+  if (out_len < ct_len) {
+    napi_throw_error(env, nullptr, "Output is smaller than the plaintext");
+    return nullptr;
+  }
+  if (partially_overlaps(in, in_len, out, out_len)) {
+    napi_throw_error(env, nullptr, "Output must be the input itself or not overlap it");
+    return nullptr;
+  }
+
+  bool ok = key->open(iv, aad, aad_len, in, ct_len, in + ct_len, out);
+  napi_create_double(env, ok ? static_cast<double>(ct_len) : -1, &result);
+  return result;
+}
+
+// --- Batches ---
+// Synchronous: one N-API crossing for the whole batch. Above
+// AEAD_PARALLEL_BYTES the messages are split across the WorkerPool in chunks
+// of roughly AEAD_CHUNK_BYTES, with the JS thread working alongside.
+static constexpr size_t AEAD_PARALLEL_BYTES = 256 * 1024;
+static constexpr size_t AEAD_CHUNK_BYTES = 64 * 1024;
+
+struct AeadItem {
+  const uint8_t* in = nullptr;
+  size_t len = 0;        // plaintext / ciphertext length, tag excluded
+  const uint8_t* aad = nullptr;
+  size_t aadLen = 0;
+  uint8_t* out = nullptr;
+  bool ok = false;
+};
+
+template <typename Fn>
+static void run_aead_batch(size_t count, size_t total_bytes, Fn fn) {
+  if (count < 2 || total_bytes < AEAD_PARALLEL_BYTES) {
+    fn(0, count);
+    return;
+  }
+  size_t grain = std::max<size_t>(1, count * AEAD_CHUNK_BYTES / total_bytes);
+  WorkerPool::shared().parallelFor(count, grain, fn);
+}
+
+// Shared arguments of both batch calls: [key, ivs (N * 12 bytes), messages[], aad? (Buffer | Buffer[])].
+// Fills items with inputs and AAD; returns the message array length or -1 after throwing.
+static int64_t get_batch_args(napi_env env, size_t argc, napi_value* args, std::shared_ptr<AeadKey>& key,
+                              uint8_t** ivs, std::vector<AeadItem>& items, std::vector<napi_value>& messages) {
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return -1;
+  }
+  key = get_key_or_throw(env, args[0]);
+  if (!key) return -1;
+
+  bool is_array = false;
+  napi_is_array(env, args[2], &is_array);
+  if (!is_array) {
+    napi_throw_error(env, nullptr, "Messages must be an array of buffers");
+    return -1;
+  }
+  uint32_t count = 0;
+  napi_get_array_length(env, args[2], &count);
+
+  size_t ivs_len = 0;
+  if (!get_buffer_arg(env, args[1], ivs, &ivs_len) || ivs_len != size_t(count) * AEAD_IV_BYTES) {
+    napi_throw_error(env, nullptr, "IVs must be one packed 12-byte nonce per message");
+    return -1;
+  }
+
+  // aad: one Buffer for every message, or an array with one per message
+  uint8_t* shared_aad = nullptr;
+  size_t shared_aad_len = 0;
+  napi_value aad_array = nullptr;
+  if (argc > 3) {
+    bool aad_is_array = false;
+    napi_is_array(env, args[3], &aad_is_array);
+    if (aad_is_array) aad_array = args[3];
+    else if (!get_optional_buffer(env, argc, args, 3, &shared_aad, &shared_aad_len)) {
+      napi_throw_error(env, nullptr, "AAD must be a buffer or an array of buffers");
+      return -1;
+    }
+  }
+
+  items.resize(count);
+  messages.resize(count);
+  for (uint32_t i = 0; i < count; i++) {
+    uint8_t* data;
+    napi_get_element(env, args[2], i, &messages[i]);
+    if (!get_buffer_arg(env, messages[i], &data, &items[i].len)) {
+      napi_throw_error(env, nullptr, "Messages must be an array of buffers");
+      return -1;
+    }
+    items[i].in = data;
+    items[i].aad = shared_aad;
+    items[i].aadLen = shared_aad_len;
+    if (aad_array) {
+      napi_value a;
+      uint8_t* aad = nullptr;
+      napi_get_element(env, aad_array, i, &a);
+      napi_valuetype t;
+      napi_typeof(env, a, &t);
+      if (t != napi_undefined && t != napi_null && !get_buffer_arg(env, a, &aad, &items[i].aadLen)) {
+        napi_throw_error(env, nullptr, "AAD must be a buffer or an array of buffers");
+        return -1;
+      }
+      items[i].aad = aad;
+    }
+  }
+  return count;
+}
+
+napi_value AeadSealBatch(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, ivs, plaintexts[], aad?] -> (ciphertext || tag)[]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  std::shared_ptr<AeadKey> key;
+  uint8_t* ivs;
+  std::vector<AeadItem> items;
+  std::vector<napi_value> messages;
+  int64_t count = get_batch_args(env, argc, args, key, &ivs, items, messages);
+  if (count < 0) return nullptr;
+
+  napi_value result;
+  napi_create_array_with_length(env, static_cast<size_t>(count), &result);
+  size_t total = 0;
+  for (int64_t i = 0; i < count; i++) {
+    napi_value buf;
+    items[i].out = new_buffer(env, items[i].len + AEAD_TAG_BYTES, &buf);
+    if (!items[i].out) {
+      napi_throw_error(env, nullptr, "Failed to allocate result buffers");
+      return nullptr;
+    }
+    napi_set_element(env, result, static_cast<uint32_t>(i), buf);
+    total += items[i].len;
+  }
+
+  run_aead_batch(items.size(), total, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      AeadItem& it = items[i];
+      it.ok = key->seal(ivs + i * AEAD_IV_BYTES, it.aad, it.aadLen, it.in, it.len, it.out, it.out + it.len);
+    }
+  });
+
+  for (const AeadItem& it : items) {
+    if (!it.ok) {
+      napi_throw_error(env, nullptr, "Encryption failed");
+      return nullptr;
+    }
+  }
+  return result;
+}
+
+napi_value AeadOpenBatch(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, ivs, sealed[], aad?] -> (plaintext | null)[]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  std::shared_ptr<AeadKey> key;
+  uint8_t* ivs;
+  std::vector<AeadItem> items;
+  std::vector<napi_value> messages;
+  int64_t count = get_batch_args(env, argc, args, key, &ivs, items, messages);
+  if (count < 0) return nullptr;
+
+  napi_value result;
+  napi_create_array_with_length(env, static_cast<size_t>(count), &result);
+  std::vector<napi_value> outputs(items.size());
+  size_t total = 0;
+  for (int64_t i = 0; i < count; i++) {
+    AeadItem& it = items[i];
+    if (it.len < AEAD_TAG_BYTES) {
+      it.in = nullptr;  // too short to carry a tag; stays null
+      continue;
+    }
+    it.len -= AEAD_TAG_BYTES;
+    it.out = new_buffer(env, it.len, &outputs[i]);
+    if (!it.out) {
+      napi_throw_error(env, nullptr, "Failed to allocate result buffers");
+      return nullptr;
+    }
+    total += it.len;
+  }
+
+  run_aead_batch(items.size(), total, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      AeadItem& it = items[i];
+      if (it.in) it.ok = key->open(ivs + i * AEAD_IV_BYTES, it.aad, it.aadLen, it.in, it.len, it.in + it.len, it.out);
+    }
+  });
+
+  napi_value null_value;
+  napi_get_null(env, &null_value);
+  for (int64_t i = 0; i < count; i++)
+    napi_set_element(env, result, static_cast<uint32_t>(i), items[i].ok ? outputs[i] : null_value);
+  return result;
+}
+
+// --- Split ciphertext / tag ---
+napi_value AesGcmSeal(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, iv, plaintext, aad?] -> { ciphertext, tag }
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> key = get_key_or_throw(env, args[0]);
+  if (!key) return nullptr;
+  uint8_t *iv, *pt, *aad;
+  size_t pt_len, aad_len;
+  if (!get_iv_arg(env, args[1], &iv)) {
+    napi_throw_error(env, nullptr, "IV must be a 12-byte buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[2], &pt, &pt_len) || !get_optional_buffer(env, argc, args, 3, &aad, &aad_len)) {
+    napi_throw_error(env, nullptr, "Plaintext and AAD must be buffers");
+    return nullptr;
+  }
+
+  napi_value ct_buf, tag_buf, result;
+  uint8_t* ct = new_buffer(env, pt_len, &ct_buf);
+  uint8_t* tag = new_buffer(env, AEAD_TAG_BYTES, &tag_buf);
+  if (!ct || !tag || !key->seal(iv, aad, aad_len, pt, pt_len, ct, tag)) {
+    napi_throw_error(env, nullptr, "Encryption failed");
+    return nullptr;
+  }
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "ciphertext", ct_buf);
+  napi_set_named_property(env, result, "tag", tag_buf);
+  return result;
+}
+
+napi_value AesGcmOpen(napi_env env, napi_callback_info info) {
+  // Parse arguments: [key, iv, ciphertext, tag, aad?] -> plaintext; throws if the tag does not verify
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 4) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<AeadKey> key = get_key_or_throw(env, args[0]);
+  if (!key) return nullptr;
+  uint8_t *iv, *ct, *tag, *aad;
+  size_t ct_len, tag_len, aad_len;
+  if (!get_iv_arg(env, args[1], &iv)) {
+    napi_throw_error(env, nullptr, "IV must be a 12-byte buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[2], &ct, &ct_len) || !get_buffer_arg(env, args[3], &tag, &tag_len) ||
+      tag_len != AEAD_TAG_BYTES || !get_optional_buffer(env, argc, args, 4, &aad, &aad_len)) {
+    napi_throw_error(env, nullptr, "Ciphertext, 16-byte tag and AAD must be buffers");
+    return nullptr;
+  }
+
+  napi_value result;
+  uint8_t* out = new_buffer(env, ct_len, &result);
+  if (!out || !key->open(iv, aad, aad_len, ct, ct_len, tag, out)) {
+    napi_throw_error(env, nullptr, "Authentication failed");
+    return nullptr;
+  }
+  return result;
+}
+
+napi_value InitAead(napi_env env, napi_value exports) {
+  napi_property_descriptor descs[] = {
+    { "createAeadKey", nullptr, CreateAeadKey, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "freeAeadKey",   nullptr, FreeAeadKey,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aeadSeal",      nullptr, AeadSeal,      nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aeadOpen",      nullptr, AeadOpen,      nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aeadSealInto",  nullptr, AeadSealInto,  nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aeadOpenInto",  nullptr, AeadOpenInto,  nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aeadSealBatch", nullptr, AeadSealBatch, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aeadOpenBatch", nullptr, AeadOpenBatch, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aesGcmSeal",    nullptr, AesGcmSeal,    nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "aesGcmOpen",    nullptr, AesGcmOpen,    nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(descs, sizeof(descs) / sizeof(*descs));
+  napi_define_properties(env, exports, sizeof(descs) / sizeof(*descs), descs);
+  return exports;
+}
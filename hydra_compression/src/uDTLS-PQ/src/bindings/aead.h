@@ -0,0 +1,74 @@
+// src/bindings/aead.h
+#ifndef AEAD_H
+#define AEAD_H
+
+#include "secret_arena.h"
+#include <node_api.h>
+#include <openssl/evp.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+enum class AeadAlgorithm { AES_256_GCM, CHACHA20_POLY1305 };
+
+static constexpr size_t AEAD_KEY_BYTES = 32;
+static constexpr size_t AEAD_IV_BYTES = 12;
+static constexpr size_t AEAD_TAG_BYTES = 16;
+
+// One symmetric key and its prepared cipher contexts. Each EVP_CIPHER_CTX
+// runs the key schedule once and afterwards only takes a fresh IV, so a
+// message costs no allocation and no key setup. A context is checked out
+// for a single operation, which lets batch work use one key from several
+// threads. The key itself lives in SecretArena memory.
+class AeadKey {
+public:
+  // nullptr unless key is AEAD_KEY_BYTES long.
+  static std::shared_ptr<AeadKey> create(AeadAlgorithm alg, const uint8_t* key, size_t len);
+  ~AeadKey();
+
+  AeadAlgorithm algorithm() const { return alg_; }
+  bool matches(AeadAlgorithm alg, const uint8_t* key, size_t len) const;
+
+  // iv is AEAD_IV_BYTES, tag AEAD_TAG_BYTES. out receives len bytes and may
+  // be the same memory as in.
+  bool seal(const uint8_t* iv, const uint8_t* aad, size_t aad_len,
+            const uint8_t* in, size_t len, uint8_t* out, uint8_t* tag);
+  // On an authentication failure out is wiped and false returned.
+  bool open(const uint8_t* iv, const uint8_t* aad, size_t aad_len,
+            const uint8_t* in, size_t len, const uint8_t* tag, uint8_t* out);
+
+private:
+  AeadKey(AeadAlgorithm alg, SecretPtr key) : alg_(alg), key_(std::move(key)) {}
+  EVP_CIPHER_CTX* acquire(bool encrypt);
+  void recycle(EVP_CIPHER_CTX* ctx, bool encrypt);
+
+  AeadAlgorithm alg_;
+  SecretPtr key_;
+  std::mutex mu_;
+  std::vector<EVP_CIPHER_CTX*> idle_[2];  // [decrypt, encrypt]
+};
+
+// ** Keys: createAeadKey(key, algorithm?) -> { id }, freeAeadKey({ id }) **
+napi_value CreateAeadKey(napi_env env, napi_callback_info info);
+napi_value FreeAeadKey  (napi_env env, napi_callback_info info);
+
+// ** Single messages; key is a handle or a raw AES-256-GCM key Buffer **
+napi_value AeadSeal    (napi_env env, napi_callback_info info);
+napi_value AeadOpen    (napi_env env, napi_callback_info info);
+napi_value AeadSealInto(napi_env env, napi_callback_info info);
+napi_value AeadOpenInto(napi_env env, napi_callback_info info);
+
+// ** Many messages in one call, spread over the WorkerPool when large **
+napi_value AeadSealBatch(napi_env env, napi_callback_info info);
+napi_value AeadOpenBatch(napi_env env, napi_callback_info info);
+
+// ** Split ciphertext/tag AES-GCM, as used by DTLSConnection **
+napi_value AesGcmSeal(napi_env env, napi_callback_info info);
+napi_value AesGcmOpen(napi_env env, napi_callback_info info);
+
+// Module initialization function (called from openssl.cpp)
+napi_value InitAead(napi_env env, napi_value exports);
+
+#endif // AEAD_H
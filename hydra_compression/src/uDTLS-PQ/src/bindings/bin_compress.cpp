@@ -0,0 +1,174 @@
+// src/bindings/bin_compress.cpp
+#include "bin_compress.h"
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#include <lz4.h>
+#include <zstd.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+bool bin_codec_from_name(const std::string& name, BinCodec& codec) {
+  if (name == "brotli") codec = BinCodec::Brotli;
+  else if (name == "zstd") codec = BinCodec::Zstd;
+  else if (name == "lz4") codec = BinCodec::Lz4;
+  else return false;
+  return true;
+}
+
+// --- brotli ---
+static bool brotli_compress(int level, const uint8_t* in, size_t len,
+                            std::vector<uint8_t>& out, std::string& error) {
+  size_t size = BrotliEncoderMaxCompressedSize(len);
+  if (!size) {
+    error = "Bin too large for brotli";
+    return false;
+  }
+  out.resize(size);
+  const int quality = level > 0 ? std::min(level, BROTLI_MAX_QUALITY) : BROTLI_DEFAULT_QUALITY;
+  if (!BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, len, in, &size, out.data())) {
+    error = "brotli compression failed";
+    return false;
+  }
+  out.resize(size);
+  return true;
+}
+
+static bool brotli_decompress(const uint8_t* in, size_t len, std::vector<uint8_t>& out, std::string& error) {
+  std::unique_ptr<BrotliDecoderState, void (*)(BrotliDecoderState*)> state(
+      BrotliDecoderCreateInstance(nullptr, nullptr, nullptr), BrotliDecoderDestroyInstance);
+  if (!state) {
+    error = "Out of memory";
+    return false;
+  }
+  out.resize(std::max<size_t>(len * 4, 4096));
+  size_t avail_in = len, produced = 0;
+  const uint8_t* next_in = in;
+  for (;;) {
+    size_t avail_out = out.size() - produced;
+    uint8_t* next_out = out.data() + produced;
+    const BrotliDecoderResult r =
+        BrotliDecoderDecompressStream(state.get(), &avail_in, &next_in, &avail_out, &next_out, nullptr);
+    produced = out.size() - avail_out;
+    if (r == BROTLI_DECODER_RESULT_SUCCESS && !avail_in) break;
+    if (r == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+      out.resize(out.size() * 2);
+      continue;
+    }
+    error = "Invalid brotli bin";
+    return false;
+  }
+  out.resize(produced);
+  return true;
+}
+
+// --- zstd ---
+static bool zstd_compress(int level, const uint8_t* in, size_t len,
+                          std::vector<uint8_t>& out, std::string& error) {
+  out.resize(ZSTD_compressBound(len));
+  const size_t n = ZSTD_compress(out.data(), out.size(), in, len,
+                                 level > 0 ? std::min(level, ZSTD_maxCLevel()) : ZSTD_CLEVEL_DEFAULT);
+  if (ZSTD_isError(n)) {
+    error = std::string("zstd compression failed: ") + ZSTD_getErrorName(n);
+    return false;
+  }
+  out.resize(n);
+  return true;
+}
+
+// Streaming, so frames without a content size and concatenated frames
+// decode too.
+static bool zstd_decompress(const uint8_t* in, size_t len, std::vector<uint8_t>& out, std::string& error) {
+  std::unique_ptr<ZSTD_DStream, size_t (*)(ZSTD_DStream*)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+  if (!stream) {
+    error = "Out of memory";
+    return false;
+  }
+  const unsigned long long hint = ZSTD_getFrameContentSize(in, len);
+  out.resize(hint < (1ULL << 32) ? std::max<size_t>(size_t(hint), 1) : std::max<size_t>(len * 4, 4096));
+  ZSTD_inBuffer input = { in, len, 0 };
+  ZSTD_outBuffer output = { out.data(), out.size(), 0 };
+  for (;;) {
+    if (output.pos == output.size) {
+      out.resize(out.size() * 2);
+      output.dst = out.data();
+      output.size = out.size();
+    }
+    const size_t before = input.pos + output.pos;
+    const size_t r = ZSTD_decompressStream(stream.get(), &output, &input);
+    if (ZSTD_isError(r)) {
+      error = std::string("Invalid zstd bin: ") + ZSTD_getErrorName(r);
+      return false;
+    }
+    // 0: a frame is complete and flushed; go on if another one follows.
+    if (r == 0 && input.pos == input.size) break;
+    // Nothing consumed or produced with room to spare: the input is cut short.
+    if (input.pos + output.pos == before && output.pos < output.size) {
+      error = "Truncated zstd bin";
+      return false;
+    }
+  }
+  out.resize(output.pos);
+  return true;
+}
+
+// --- lz4 ---
+static bool lz4_compress(const uint8_t* in, size_t len, std::vector<uint8_t>& out, std::string& error) {
+  if (len > LZ4_MAX_INPUT_SIZE) {
+    error = "Bin too large for lz4";
+    return false;
+  }
+  const int src = static_cast<int>(len);
+  out.resize(4 + size_t(LZ4_compressBound(src)));
+  for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(len >> (8 * i));
+  const int n = LZ4_compress_default(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out.data() + 4),
+                                     src, static_cast<int>(out.size() - 4));
+  if (n <= 0 && len) {
+    error = "lz4 compression failed";
+    return false;
+  }
+  out.resize(4 + size_t(n));
+  return true;
+}
+
+static bool lz4_decompress(const uint8_t* in, size_t len, std::vector<uint8_t>& out, std::string& error) {
+  if (len < 4) {
+    error = "Truncated lz4 bin";
+    return false;
+  }
+  const uint32_t size = uint32_t(in[0]) | (uint32_t(in[1]) << 8) | (uint32_t(in[2]) << 16) | (uint32_t(in[3]) << 24);
+  // A block expands at most 255:1.
+  if (size > LZ4_MAX_INPUT_SIZE || size > 255 * uint64_t(len)) {
+    error = "Invalid lz4 bin";
+    return false;
+  }
+  out.resize(size);
+  const int n = LZ4_decompress_safe(reinterpret_cast<const char*>(in + 4), reinterpret_cast<char*>(out.data()),
+                                    static_cast<int>(std::min<size_t>(len - 4, LZ4_MAX_INPUT_SIZE)),
+                                    static_cast<int>(size));
+  if (n != static_cast<int>(size)) {
+    error = "Invalid lz4 bin";
+    return false;
+  }
+  return true;
+}
+
+bool bin_compress(BinCodec codec, int level, const uint8_t* in, size_t len,
+                  std::vector<uint8_t>& out, std::string& error) {
+  switch (codec) {
+    case BinCodec::Brotli: return brotli_compress(level, in, len, out, error);
+    case BinCodec::Zstd:   return zstd_compress(level, in, len, out, error);
+    case BinCodec::Lz4:    return lz4_compress(in, len, out, error);
+  }
+  return false;
+}
+
+bool bin_decompress(BinCodec codec, const uint8_t* in, size_t len,
+                    std::vector<uint8_t>& out, std::string& error) {
+  switch (codec) {
+    case BinCodec::Brotli: return brotli_decompress(in, len, out, error);
+    case BinCodec::Zstd:   return zstd_decompress(in, len, out, error);
+    case BinCodec::Lz4:    return lz4_decompress(in, len, out, error);
+  }
+  return false;
+}
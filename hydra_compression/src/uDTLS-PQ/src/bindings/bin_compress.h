@@ -0,0 +1,27 @@
+// src/bindings/bin_compress.h
+#ifndef BIN_COMPRESS_H
+#define BIN_COMPRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// General-purpose byte compressors for OST bins, on the system brotli, zstd
+// and lz4 libraries. Each call is one-shot and keeps no shared state, so
+// any number of bins can be (de)compressed concurrently.
+//
+//   brotli, zstd  standard streams, as brotli-wasm / zstd-wasm produce
+//   lz4           u32 little-endian uncompressed length | LZ4 block
+enum class BinCodec { Brotli, Zstd, Lz4 };
+
+// False if name is not one of "brotli", "zstd", "lz4".
+bool bin_codec_from_name(const std::string& name, BinCodec& codec);
+
+// level 0 picks the library default (brotli 11, zstd 3); lz4 ignores it.
+bool bin_compress(BinCodec codec, int level, const uint8_t* in, size_t len,
+                  std::vector<uint8_t>& out, std::string& error);
+bool bin_decompress(BinCodec codec, const uint8_t* in, size_t len,
+                    std::vector<uint8_t>& out, std::string& error);
+
+#endif // BIN_COMPRESS_H
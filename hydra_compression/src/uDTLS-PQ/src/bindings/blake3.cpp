@@ -0,0 +1,813 @@
+// src/bindings/blake3.cpp
+#include "blake3.h"
+#include "handle_table.h"
+#include "metrics.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// The lane kernels use GCC/Clang vector extensions, compiled per ISA with
+// target attributes so the addon still loads on CPUs without them.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BLAKE3_X86 1
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BLAKE3_NEON 1
+#endif
+
+#if defined(__GNUC__)
+#define BLAKE3_INLINE inline __attribute__((always_inline))
+#else
+#define BLAKE3_INLINE inline
+#endif
+
+static constexpr size_t BLAKE3_MAX_OUT = 1u << 30;
+// Below this, spreading chunks or batch inputs over the worker pool costs
+// more than it saves.
+static constexpr size_t BLAKE3_PARALLEL_MIN_BYTES = 256 * 1024;
+static constexpr size_t BLAKE3_PARALLEL_GRAIN = 64;
+// Largest subtree hashed in one go; bounds the job list of huge updates.
+static constexpr unsigned BLAKE3_MAX_SUBTREE_LEVEL = 12;
+
+namespace {
+
+const uint32_t IV[8] = {
+  0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+const uint8_t MSG_SCHEDULE[7][16] = {
+  { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+  { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+  { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+  { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+  { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+  { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+  { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 },
+};
+
+const uint8_t ZERO_BLOCK[BLAKE3_BLOCK_LEN] = {};
+
+inline uint32_t load32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline void store32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+  p[2] = static_cast<uint8_t>(v >> 16);
+  p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+// --- Compression function ---
+// Written once over the lane type V: uint32_t for a single block, or a
+// vector whose lane i holds the state word of the i-th block in flight.
+struct ShiftRotate {
+  template <int R, typename V> static BLAKE3_INLINE void rotr(V& x) {
+    x = (x >> R) | (x << (32 - R));
+  }
+};
+
+template <typename Rot, typename V>
+BLAKE3_INLINE void g(V& a, V& b, V& c, V& d, const V& x, const V& y) {
+  a = a + b + x;
+  d ^= a;
+  Rot::template rotr<16>(d);
+  c = c + d;
+  b ^= c;
+  Rot::template rotr<12>(b);
+  a = a + b + y;
+  d ^= a;
+  Rot::template rotr<8>(d);
+  c = c + d;
+  b ^= c;
+  Rot::template rotr<7>(b);
+}
+
+template <typename Rot, typename V>
+BLAKE3_INLINE void rounds(V v[16], const V m[16]) {
+  for (int r = 0; r < 7; r++) {
+    const uint8_t* s = MSG_SCHEDULE[r];
+    g<Rot>(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+    g<Rot>(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+    g<Rot>(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+    g<Rot>(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+    g<Rot>(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+    g<Rot>(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+    g<Rot>(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+    g<Rot>(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+  }
+}
+
+// One block; out gets all 16 words (the first 8 are the chaining value).
+void compress(const uint32_t cv[8], const uint8_t block[BLAKE3_BLOCK_LEN], uint32_t block_len,
+              uint64_t counter, uint32_t flags, uint32_t out[16]) {
+  uint32_t m[16], v[16];
+  for (int i = 0; i < 16; i++) m[i] = load32(block + 4 * i);
+  for (int i = 0; i < 8; i++) v[i] = cv[i];
+  for (int i = 0; i < 4; i++) v[8 + i] = IV[i];
+  v[12] = static_cast<uint32_t>(counter);
+  v[13] = static_cast<uint32_t>(counter >> 32);
+  v[14] = block_len;
+  v[15] = flags;
+  rounds<ShiftRotate>(v, m);
+  for (int i = 0; i < 8; i++) {
+    out[i] = v[i] ^ v[i + 8];
+    out[i + 8] = v[i + 8] ^ cv[i];
+  }
+}
+
+void parent_cv(const uint32_t left[8], const uint32_t right[8], const Blake3Mode& mode, uint32_t out[8]) {
+  uint8_t block[BLAKE3_BLOCK_LEN];
+  for (int i = 0; i < 8; i++) {
+    store32(block + 4 * i, left[i]);
+    store32(block + 32 + 4 * i, right[i]);
+  }
+  uint32_t words[16];
+  compress(mode.key, block, BLAKE3_BLOCK_LEN, 0, mode.flags | BLAKE3_PARENT, words);
+  std::memcpy(out, words, 8 * sizeof(uint32_t));
+}
+
+// A run of blocks hashed in one lane: a chunk (first_flags CHUNK_START,
+// last_flags CHUNK_END, plus ROOT for a whole small input) or a parent.
+struct Job {
+  const uint8_t* data;
+  size_t len;                           // at most a chunk; 0 hashes one empty block
+  uint64_t counter;
+  uint32_t flags;
+  uint32_t first_flags;
+  uint32_t last_flags;
+  uint32_t cv[8];                       // result
+};
+
+inline size_t job_blocks(const Job& job) {
+  return job.len ? (job.len + BLAKE3_BLOCK_LEN - 1) / BLAKE3_BLOCK_LEN : 1;
+}
+
+void hash_job(const uint32_t key[8], Job& job) {
+  const size_t blocks = job_blocks(job);
+  uint32_t cv[8], out[16];
+  std::memcpy(cv, key, sizeof(cv));
+  for (size_t k = 0; k < blocks; k++) {
+    const size_t off = k * BLAKE3_BLOCK_LEN;
+    const size_t len = std::min(BLAKE3_BLOCK_LEN, job.len - off);
+    uint8_t pad[BLAKE3_BLOCK_LEN] = {};
+    const uint8_t* block = pad;
+    if (len == BLAKE3_BLOCK_LEN) block = job.data + off;
+    else if (len) std::memcpy(pad, job.data + off, len);
+    uint32_t flags = job.flags;
+    if (k == 0) flags |= job.first_flags;
+    if (k + 1 == blocks) flags |= job.last_flags;
+    compress(cv, block, static_cast<uint32_t>(len), job.counter, flags, out);
+    std::memcpy(cv, out, sizeof(cv));
+  }
+  std::memcpy(job.cv, cv, sizeof(cv));
+}
+
+void hash_jobs_portable(const uint32_t key[8], Job* jobs, size_t n) {
+  for (size_t i = 0; i < n; i++) hash_job(key, jobs[i]);
+}
+
+#if defined(BLAKE3_X86) || defined(BLAKE3_NEON)
+// --- Lane kernels ---
+// Rotations by 16 and 8 are byte shuffles (pshufb/tbl), cheaper than two
+// shifts and an or where there is no vector rotate instruction.
+template <typename B>
+struct ShuffleRotate {
+  template <int R, typename V, size_t... K>
+  static BLAKE3_INLINE void rotr_bytes(V& x, std::index_sequence<K...>) {
+    B b = reinterpret_cast<B&>(x);
+    b = __builtin_shufflevector(b, b, ((K & ~size_t(3)) | ((K + R / 8) & 3))...);
+    x = reinterpret_cast<V&>(b);
+  }
+  template <int R, typename V> static BLAKE3_INLINE void rotr(V& x) {
+    if constexpr (R % 8 == 0) rotr_bytes<R>(x, std::make_index_sequence<sizeof(V)>());
+    else x = (x >> R) | (x << (32 - R));
+  }
+};
+
+// Swaps index bit B between row and column; every bit swapped transposes.
+template <typename V, size_t N, size_t B, size_t... K>
+BLAKE3_INLINE void transpose_stage(V rows[N], std::index_sequence<K...>) {
+  for (size_t i = 0; i < N; i++) {
+    if (i & B) continue;
+    const V a = rows[i], c = rows[i + B];
+    rows[i] = __builtin_shufflevector(a, c, ((K & B) ? N + K - B : K)...);
+    rows[i + B] = __builtin_shufflevector(a, c, ((K & B) ? N + K : K + B)...);
+  }
+}
+
+template <typename V, size_t N, size_t B = N / 2>
+BLAKE3_INLINE void transpose(V rows[N]) {
+  transpose_stage<V, N, B>(rows, std::make_index_sequence<N>());
+  if constexpr (B > 1) transpose<V, N, B / 2>(rows);
+}
+
+// Up to N jobs side by side. Lanes whose job has fewer blocks than the
+// longest hash a zero block until the others finish and are not read.
+template <typename V, typename Rot, size_t N>
+BLAKE3_INLINE void hash_lanes(const uint32_t key[8], Job* jobs, size_t n) {
+  size_t blocks[N], max_blocks = 0;
+  for (size_t l = 0; l < N; l++) {
+    blocks[l] = l < n ? job_blocks(jobs[l]) : 0;
+    max_blocks = std::max(max_blocks, blocks[l]);
+  }
+
+  V cv[8];
+  for (int i = 0; i < 8; i++) cv[i] = V{} + key[i];
+  alignas(64) uint8_t pad[N][BLAKE3_BLOCK_LEN];
+  alignas(64) uint32_t lo[N], hi[N], lens[N], flags[N];
+  for (size_t k = 0; k < max_blocks; k++) {
+    const uint8_t* ptr[N];
+    bool done = false;
+    for (size_t l = 0; l < N; l++) {
+      if (k >= blocks[l]) {
+        ptr[l] = ZERO_BLOCK;
+        lo[l] = hi[l] = lens[l] = flags[l] = 0;
+        continue;
+      }
+      const Job& job = jobs[l];
+      const size_t off = k * BLAKE3_BLOCK_LEN;
+      const size_t len = std::min(BLAKE3_BLOCK_LEN, job.len - off);
+      ptr[l] = job.data + off;
+      if (len < BLAKE3_BLOCK_LEN) {
+        std::memset(pad[l], 0, BLAKE3_BLOCK_LEN);
+        if (len) std::memcpy(pad[l], job.data + off, len);
+        ptr[l] = pad[l];
+      }
+      lo[l] = static_cast<uint32_t>(job.counter);
+      hi[l] = static_cast<uint32_t>(job.counter >> 32);
+      lens[l] = static_cast<uint32_t>(len);
+      flags[l] = job.flags;
+      if (k == 0) flags[l] |= job.first_flags;
+      if (k + 1 == blocks[l]) {
+        flags[l] |= job.last_flags;
+        done = true;
+      }
+    }
+
+    // Each block's 16 words arrive as 16 / N vectors; transposing N
+    // blocks' worth at a time leaves word j of every lane in m[j].
+    V m[16];
+    for (size_t w = 0; w < 16; w += N) {
+      V rows[N];
+      for (size_t l = 0; l < N; l++) std::memcpy(&rows[l], ptr[l] + 4 * w, sizeof(V));
+      transpose<V, N>(rows);
+      for (size_t l = 0; l < N; l++) m[w + l] = rows[l];
+    }
+
+    V v[16];
+    for (int i = 0; i < 8; i++) v[i] = cv[i];
+    for (int i = 0; i < 4; i++) v[8 + i] = V{} + IV[i];
+    std::memcpy(&v[12], lo, sizeof(V));
+    std::memcpy(&v[13], hi, sizeof(V));
+    std::memcpy(&v[14], lens, sizeof(V));
+    std::memcpy(&v[15], flags, sizeof(V));
+    rounds<Rot>(v, m);
+    for (int i = 0; i < 8; i++) cv[i] = v[i] ^ v[i + 8];
+
+    if (!done) continue;
+    alignas(64) uint32_t words[8][N];
+    std::memcpy(words, cv, sizeof(words));
+    for (size_t l = 0; l < n; l++) {
+      if (k + 1 != blocks[l]) continue;
+      for (int i = 0; i < 8; i++) jobs[l].cv[i] = words[i][l];
+    }
+  }
+}
+#endif
+
+#if defined(BLAKE3_X86)
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef uint32_t u32x8 __attribute__((vector_size(32)));
+typedef uint32_t u32x16 __attribute__((vector_size(64)));
+typedef uint8_t u8x16 __attribute__((vector_size(16)));
+typedef uint8_t u8x32 __attribute__((vector_size(32)));
+
+__attribute__((target("sse4.1")))
+void hash_jobs_sse41(const uint32_t key[8], Job* jobs, size_t n) {
+  hash_lanes<u32x4, ShuffleRotate<u8x16>, 4>(key, jobs, n);
+}
+
+__attribute__((target("avx2")))
+void hash_jobs_avx2(const uint32_t key[8], Job* jobs, size_t n) {
+  hash_lanes<u32x8, ShuffleRotate<u8x32>, 8>(key, jobs, n);
+}
+
+// AVX-512 has a rotate instruction (vprord) for the plain shift form.
+__attribute__((target("avx512f,avx512vl")))
+void hash_jobs_avx512(const uint32_t key[8], Job* jobs, size_t n) {
+  hash_lanes<u32x16, ShiftRotate, 16>(key, jobs, n);
+}
+#elif defined(BLAKE3_NEON)
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef uint8_t u8x16 __attribute__((vector_size(16)));
+
+void hash_jobs_neon(const uint32_t key[8], Job* jobs, size_t n) {
+  hash_lanes<u32x4, ShuffleRotate<u8x16>, 4>(key, jobs, n);
+}
+#endif
+
+struct Kernel {
+  size_t lanes;
+  void (*run)(const uint32_t key[8], Job* jobs, size_t n);
+};
+
+// Available kernels, narrowest first; the portable one is always there.
+const std::vector<Kernel>& kernels() {
+  static const std::vector<Kernel> list = [] {
+    std::vector<Kernel> k{ { 1, hash_jobs_portable } };
+#if defined(BLAKE3_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) k.push_back({ 4, hash_jobs_sse41 });
+    if (__builtin_cpu_supports("avx2")) k.push_back({ 8, hash_jobs_avx2 });
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+      k.push_back({ 16, hash_jobs_avx512 });
+#elif defined(BLAKE3_NEON)
+    k.push_back({ 4, hash_jobs_neon });
+#endif
+    return k;
+  }();
+  return list;
+}
+
+// Runs jobs through the widest kernel they fill, finishing a ragged tail
+// on narrower ones; a partly idle pass still beats one block at a time.
+void hash_jobs(const uint32_t key[8], Job* jobs, size_t n) {
+  const std::vector<Kernel>& list = kernels();
+  while (n) {
+    const Kernel* k = &list[0];
+    for (const Kernel& c : list)
+      if (c.lanes <= n) k = &c;
+    if (k->lanes == 1 && n > 1 && list.size() > 1) k = &list[1];
+    const size_t take = std::min(k->lanes, n);
+    k->run(key, jobs, take);
+    jobs += take;
+    n -= take;
+  }
+}
+
+void hash_jobs_parallel(const uint32_t key[8], Job* jobs, size_t n, size_t bytes) {
+  if (bytes < BLAKE3_PARALLEL_MIN_BYTES || n <= BLAKE3_PARALLEL_GRAIN) {
+    hash_jobs(key, jobs, n);
+    return;
+  }
+  WorkerPool::shared().parallelFor(n, BLAKE3_PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+    hash_jobs(key, jobs + begin, end - begin);
+  });
+}
+
+} // namespace
+
+// --- Modes ---
+Blake3Mode Blake3Mode::hash() {
+  Blake3Mode mode;
+  std::memcpy(mode.key, IV, sizeof(IV));
+  return mode;
+}
+
+Blake3Mode Blake3Mode::keyed(const uint8_t key[BLAKE3_KEY_LEN]) {
+  Blake3Mode mode;
+  for (int i = 0; i < 8; i++) mode.key[i] = load32(key + 4 * i);
+  mode.flags = BLAKE3_KEYED_HASH;
+  return mode;
+}
+
+Blake3Mode Blake3Mode::derive_key(const uint8_t* context, size_t len) {
+  Blake3Mode context_mode = hash();
+  context_mode.flags = BLAKE3_DERIVE_KEY_CONTEXT;
+  Blake3Hasher hasher(context_mode);
+  hasher.update(context, len);
+  uint8_t key[BLAKE3_KEY_LEN];
+  hasher.finalize(key, sizeof(key));
+  Blake3Mode mode = keyed(key);
+  mode.flags = BLAKE3_DERIVE_KEY_MATERIAL;
+  return mode;
+}
+
+// --- Hasher ---
+// The chunk tree is built as in the BLAKE3 reference: a stack of subtree
+// CVs merged whenever a subtree completes, with the last chunk held back
+// so it can be finalized as the root or a right child.
+Blake3Hasher::Blake3Hasher(const Blake3Mode& mode) : mode_(mode) {
+  std::memcpy(cv_, mode_.key, sizeof(cv_));
+}
+
+void Blake3Hasher::compress_buffered() {
+  uint32_t out[16];
+  const uint32_t flags = mode_.flags | (blocks_ ? 0 : BLAKE3_CHUNK_START);
+  compress(cv_, block_, BLAKE3_BLOCK_LEN, chunks_, flags, out);
+  std::memcpy(cv_, out, sizeof(cv_));
+  blocks_++;
+  block_len_ = 0;
+}
+
+// Adds the CV of 2^level chunks starting at chunk chunks_, which must be a
+// multiple of 2^level, merging every subtree it completes.
+void Blake3Hasher::push_subtree(const uint32_t cv[8], unsigned level) {
+  uint32_t merged[8];
+  std::memcpy(merged, cv, sizeof(merged));
+  chunks_ += uint64_t(1) << level;
+  for (uint64_t total = chunks_ >> level; !(total & 1); total >>= 1) {
+    parent_cv(&stack_[stack_.size() - 8], merged, mode_, merged);
+    stack_.resize(stack_.size() - 8);
+  }
+  stack_.insert(stack_.end(), merged, merged + 8);
+}
+
+// Whole chunks at data, none of them the last of the input: hashed in
+// lanes, then reduced level by level (parents in lanes too) into the
+// largest aligned subtrees.
+void Blake3Hasher::hash_chunks(const uint8_t* data, size_t chunks) {
+  std::vector<Job> jobs;
+  std::vector<uint8_t> cvs;
+  while (chunks) {
+    unsigned level = std::min(63u - static_cast<unsigned>(__builtin_clzll(chunks)), BLAKE3_MAX_SUBTREE_LEVEL);
+    if (chunks_) level = std::min(level, static_cast<unsigned>(__builtin_ctzll(chunks_)));
+    const size_t count = size_t(1) << level;
+
+    jobs.resize(count);
+    for (size_t i = 0; i < count; i++)
+      jobs[i] = Job{ data + i * BLAKE3_CHUNK_LEN, BLAKE3_CHUNK_LEN, chunks_ + i, mode_.flags,
+                     BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, {} };
+    hash_jobs_parallel(mode_.key, jobs.data(), count, count * BLAKE3_CHUNK_LEN);
+
+    cvs.resize(count * BLAKE3_OUT_LEN);
+    for (size_t n = count; n > 1; n /= 2) {
+      for (size_t i = 0; i < n; i++)
+        for (int w = 0; w < 8; w++) store32(&cvs[i * BLAKE3_OUT_LEN + 4 * w], jobs[i].cv[w]);
+      for (size_t i = 0; i < n / 2; i++)
+        jobs[i] = Job{ &cvs[2 * i * BLAKE3_OUT_LEN], BLAKE3_BLOCK_LEN, 0, mode_.flags | BLAKE3_PARENT, 0, 0, {} };
+      hash_jobs(mode_.key, jobs.data(), n / 2);
+    }
+    push_subtree(jobs[0].cv, level);
+
+    data += count * BLAKE3_CHUNK_LEN;
+    chunks -= count;
+  }
+}
+
+void Blake3Hasher::update(const uint8_t* data, size_t len) {
+  while (len) {
+    const size_t in_chunk = blocks_ * BLAKE3_BLOCK_LEN + block_len_;
+    if (in_chunk == BLAKE3_CHUNK_LEN) {
+      // More input follows, so the buffered chunk is not the last one.
+      uint32_t out[16];
+      compress(cv_, block_, BLAKE3_BLOCK_LEN, chunks_, mode_.flags | BLAKE3_CHUNK_END, out);
+      push_subtree(out, 0);
+      std::memcpy(cv_, mode_.key, sizeof(cv_));
+      blocks_ = 0;
+      block_len_ = 0;
+      continue;
+    }
+    if (in_chunk == 0 && len > BLAKE3_CHUNK_LEN) {
+      const size_t chunks = (len - 1) / BLAKE3_CHUNK_LEN;
+      hash_chunks(data, chunks);
+      data += chunks * BLAKE3_CHUNK_LEN;
+      len -= chunks * BLAKE3_CHUNK_LEN;
+      continue;
+    }
+    if (block_len_ == BLAKE3_BLOCK_LEN) compress_buffered();
+    const size_t take = std::min(BLAKE3_BLOCK_LEN - block_len_, len);
+    std::memcpy(block_ + block_len_, data, take);
+    block_len_ += take;
+    data += take;
+    len -= take;
+  }
+}
+
+void Blake3Hasher::finalize(uint8_t* out, size_t len) const {
+  // The output node starts as the buffered chunk's last block and climbs
+  // the stack, each parent taking the node below it as its right child.
+  uint32_t cv[8];
+  uint8_t block[BLAKE3_BLOCK_LEN] = {};
+  std::memcpy(cv, cv_, sizeof(cv));
+  std::memcpy(block, block_, block_len_);
+  uint32_t block_len = static_cast<uint32_t>(block_len_);
+  uint64_t counter = chunks_;
+  uint32_t flags = mode_.flags | BLAKE3_CHUNK_END | (blocks_ ? 0 : BLAKE3_CHUNK_START);
+
+  uint32_t words[16];
+  for (size_t i = stack_.size(); i > 0; i -= 8) {
+    compress(cv, block, block_len, counter, flags, words);
+    for (int w = 0; w < 8; w++) {
+      store32(block + 4 * w, stack_[i - 8 + w]);
+      store32(block + 32 + 4 * w, words[w]);
+    }
+    std::memcpy(cv, mode_.key, sizeof(cv));
+    block_len = BLAKE3_BLOCK_LEN;
+    counter = 0;
+    flags = mode_.flags | BLAKE3_PARENT;
+  }
+
+  // Extendable output: the root block recompressed with counters 0, 1, ...
+  for (uint64_t n = 0; len; n++) {
+    compress(cv, block, block_len, n, flags | BLAKE3_ROOT, words);
+    uint8_t bytes[BLAKE3_BLOCK_LEN];
+    for (int w = 0; w < 16; w++) store32(bytes + 4 * w, words[w]);
+    const size_t take = std::min(len, sizeof(bytes));
+    std::memcpy(out, bytes, take);
+    out += take;
+    len -= take;
+  }
+}
+
+// --- Batch ---
+void blake3_batch(const Blake3Mode& mode, const uint8_t* const* inputs, const size_t* lens,
+                  size_t count, uint8_t* out, size_t out_len) {
+  // Single-chunk inputs are roots of one chunk; grouping them by block
+  // count keeps the lanes of a pass finishing together.
+  std::vector<size_t> order, by_blocks[BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN + 1];
+  size_t bytes = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (lens[i] > BLAKE3_CHUNK_LEN || out_len > BLAKE3_OUT_LEN) {
+      Blake3Hasher hasher(mode);
+      hasher.update(inputs[i], lens[i]);
+      hasher.finalize(out + i * out_len, out_len);
+      continue;
+    }
+    by_blocks[(lens[i] + BLAKE3_BLOCK_LEN - 1) / BLAKE3_BLOCK_LEN].push_back(i);
+    bytes += lens[i];
+  }
+  for (const std::vector<size_t>& group : by_blocks) order.insert(order.end(), group.begin(), group.end());
+
+  std::vector<Job> jobs(order.size());
+  for (size_t j = 0; j < order.size(); j++)
+    jobs[j] = Job{ inputs[order[j]], lens[order[j]], 0, mode.flags, BLAKE3_CHUNK_START,
+                   BLAKE3_CHUNK_END | BLAKE3_ROOT, {} };
+  hash_jobs_parallel(mode.key, jobs.data(), jobs.size(), bytes);
+
+  for (size_t j = 0; j < order.size(); j++) {
+    uint8_t digest[BLAKE3_OUT_LEN];
+    for (int w = 0; w < 8; w++) store32(digest + 4 * w, jobs[j].cv[w]);
+    std::memcpy(out + order[j] * out_len, digest, out_len);
+  }
+}
+
+// --- N-API layer ---
+struct Blake3Stream {
+  std::mutex mu;
+  Blake3Hasher hasher;
+  explicit Blake3Stream(const Blake3Mode& mode) : hasher(mode) {}
+};
+
+static HandleTable<Blake3Stream> g_blake3_streams;
+
+static int get_handle_id(napi_env env, napi_value v) {
+  napi_value id_value;
+  int id = 0;
+  if (napi_get_named_property(env, v, "id", &id_value) == napi_ok)
+    napi_get_value_int32(env, id_value, &id);
+  return id;
+}
+
+// Buffer bytes in place, or a string's UTF-8 copied into storage.
+static bool get_bytes(napi_env env, napi_value v, std::string& storage, const uint8_t** data, size_t* len) {
+  bool is_buffer = false;
+  napi_valuetype type = napi_undefined;
+  napi_is_buffer(env, v, &is_buffer);
+  if (is_buffer) {
+    void* p;
+    napi_get_buffer_info(env, v, &p, len);
+    *data = static_cast<const uint8_t*>(p);
+    return true;
+  }
+  if (napi_typeof(env, v, &type) != napi_ok || type != napi_string) return false;
+  size_t n = 0;
+  napi_get_value_string_utf8(env, v, nullptr, 0, &n);
+  storage.resize(n + 1);
+  napi_get_value_string_utf8(env, v, &storage[0], n + 1, &n);
+  storage.resize(n);
+  *data = reinterpret_cast<const uint8_t*>(storage.data());
+  *len = n;
+  return true;
+}
+
+// Leaves *out alone when v is undefined; false if it is not an output length.
+static bool get_dk_len(napi_env env, napi_value v, size_t* out) {
+  napi_valuetype type;
+  if (!v || napi_typeof(env, v, &type) != napi_ok || type == napi_undefined) return true;
+  int64_t n;
+  if (type != napi_number || napi_get_value_int64(env, v, &n) != napi_ok || n < 0 ||
+      static_cast<uint64_t>(n) > BLAKE3_MAX_OUT)
+    return false;
+  *out = static_cast<size_t>(n);
+  return true;
+}
+
+static napi_value get_option(napi_env env, napi_value options, const char* name) {
+  napi_valuetype type;
+  napi_value v;
+  if (!options || napi_typeof(env, options, &type) != napi_ok || type != napi_object ||
+      napi_get_named_property(env, options, name, &v) != napi_ok ||
+      napi_typeof(env, v, &type) != napi_ok || type == napi_undefined)
+    return nullptr;
+  return v;
+}
+
+// Reads { key?, context?, dkLen? }; throws and returns false on bad options.
+static bool get_mode(napi_env env, napi_value options, Blake3Mode& mode, size_t* dk_len) {
+  napi_value key = get_option(env, options, "key");
+  napi_value context = get_option(env, options, "context");
+  if (key && context) {
+    napi_throw_error(env, nullptr, "Pass either key or context, not both");
+    return false;
+  }
+  mode = Blake3Mode::hash();
+  if (key) {
+    bool is_buffer = false;
+    void* data = nullptr;
+    size_t len = 0;
+    napi_is_buffer(env, key, &is_buffer);
+    if (is_buffer) napi_get_buffer_info(env, key, &data, &len);
+    if (!is_buffer || len != BLAKE3_KEY_LEN) {
+      napi_throw_error(env, nullptr, "key must be a 32-byte buffer");
+      return false;
+    }
+    mode = Blake3Mode::keyed(static_cast<const uint8_t*>(data));
+  }
+  if (context) {
+    napi_valuetype type;
+    napi_typeof(env, context, &type);
+    if (type != napi_string) {
+      napi_throw_error(env, nullptr, "context must be a string");
+      return false;
+    }
+    std::string storage;
+    const uint8_t* data;
+    size_t len;
+    get_bytes(env, context, storage, &data, &len);
+    mode = Blake3Mode::derive_key(data, len);
+  }
+  if (dk_len && !get_dk_len(env, get_option(env, options, "dkLen"), dk_len)) {
+    napi_throw_error(env, nullptr, "dkLen must be a non-negative integer up to 2^30");
+    return false;
+  }
+  return true;
+}
+
+static napi_value new_digest(napi_env env, const Blake3Hasher& hasher, size_t len) {
+  napi_value result;
+  void* out;
+  if (napi_create_buffer(env, len, &out, &result) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate buffer");
+    return nullptr;
+  }
+  hasher.finalize(static_cast<uint8_t*>(out), len);
+  return result;
+}
+
+// --- Exports ---
+napi_value Blake3Hash(napi_env env, napi_callback_info info) {
+  // Parse arguments: [data: Buffer | string, options?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  std::string storage;
+  const uint8_t* data = nullptr;
+  size_t len = 0;
+  if (argc < 1 || !get_bytes(env, args[0], storage, &data, &len)) {
+    napi_throw_error(env, nullptr, "Data must be a buffer or a string");
+    return nullptr;
+  }
+  Blake3Mode mode;
+  size_t dk_len = BLAKE3_OUT_LEN;
+  if (!get_mode(env, argc > 1 ? args[1] : nullptr, mode, &dk_len)) return nullptr;
+
+  Blake3Hasher hasher(mode);
+  hasher.update(data, len);
+  return new_digest(env, hasher, dk_len);
+}
+
+napi_value Blake3Create(napi_env env, napi_callback_info info) {
+  // Parse arguments: [options?]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  Blake3Mode mode;
+  if (!get_mode(env, argc > 0 ? args[0] : nullptr, mode, nullptr)) return nullptr;
+  int id = g_blake3_streams.insert(std::make_shared<Blake3Stream>(mode));
+  if (!id) {
+    napi_throw_error(env, nullptr, "Too many open BLAKE3 hashers");
+    return nullptr;
+  }
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  return result;
+}
+
+napi_value Blake3Update(napi_env env, napi_callback_info info) {
+  // Parse arguments: [hasher, data: Buffer | string]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<Blake3Stream> stream = argc > 0 ? g_blake3_streams.get(get_handle_id(env, args[0])) : nullptr;
+  if (!stream) {
+    napi_throw_error(env, nullptr, "Invalid BLAKE3 hasher handle");
+    return nullptr;
+  }
+
+  std::string storage;
+  const uint8_t* data = nullptr;
+  size_t len = 0;
+  if (argc < 2 || !get_bytes(env, args[1], storage, &data, &len)) {
+    napi_throw_error(env, nullptr, "Data must be a buffer or a string");
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(stream->mu);
+  stream->hasher.update(data, len);
+  return nullptr;
+}
+
+napi_value Blake3Digest(napi_env env, napi_callback_info info) {
+  // Parse arguments: [hasher, dkLen?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<Blake3Stream> stream = argc > 0 ? g_blake3_streams.get(get_handle_id(env, args[0])) : nullptr;
+  if (!stream) {
+    napi_throw_error(env, nullptr, "Invalid BLAKE3 hasher handle");
+    return nullptr;
+  }
+  size_t dk_len = BLAKE3_OUT_LEN;
+  if (!get_dk_len(env, argc > 1 ? args[1] : nullptr, &dk_len)) {
+    napi_throw_error(env, nullptr, "dkLen must be a non-negative integer up to 2^30");
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(stream->mu);
+  return new_digest(env, stream->hasher, dk_len);
+}
+
+napi_value Blake3Free(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  bool removed = argc > 0 && g_blake3_streams.remove(get_handle_id(env, args[0])) != nullptr;
+  napi_value result;
+  napi_get_boolean(env, removed, &result);
+  return result;
+}
+
+napi_value Blake3Batch(napi_env env, napi_callback_info info) {
+  // Parse arguments: [inputs: (Buffer | string)[], options?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  bool is_array = false;
+  if (argc > 0) napi_is_array(env, args[0], &is_array);
+  if (!is_array) {
+    napi_throw_error(env, nullptr, "Inputs must be an array of buffers or strings");
+    return nullptr;
+  }
+  Blake3Mode mode;
+  size_t dk_len = BLAKE3_OUT_LEN;
+  if (!get_mode(env, argc > 1 ? args[1] : nullptr, mode, &dk_len)) return nullptr;
+
+  uint32_t count = 0;
+  napi_get_array_length(env, args[0], &count);
+  if (dk_len && count > SIZE_MAX / dk_len) {
+    napi_throw_error(env, nullptr, "Batch output too large");
+    return nullptr;
+  }
+  std::vector<const uint8_t*> inputs(count);
+  std::vector<size_t> lens(count);
+  std::vector<std::string> strings(count);
+  for (uint32_t i = 0; i < count; i++) {
+    napi_value item;
+    napi_get_element(env, args[0], i, &item);
+    if (!get_bytes(env, item, strings[i], &inputs[i], &lens[i])) {
+      napi_throw_error(env, nullptr, "Inputs must be an array of buffers or strings");
+      return nullptr;
+    }
+  }
+
+  napi_value result;
+  void* out;
+  if (napi_create_buffer(env, count * dk_len, &out, &result) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate buffer");
+    return nullptr;
+  }
+  blake3_batch(mode, inputs.data(), lens.data(), count, static_cast<uint8_t*>(out), dk_len);
+  return result;
+}
+
+napi_value InitBlake3(napi_env env, napi_value exports) {
+  napi_property_descriptor descs[] = {
+    { "blake3",       nullptr, Blake3Hash,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "blake3Create", nullptr, Blake3Create, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "blake3Update", nullptr, Blake3Update, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "blake3Digest", nullptr, Blake3Digest, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "blake3Free",   nullptr, Blake3Free,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "blake3Batch",  nullptr, Blake3Batch,  nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(descs, sizeof(descs) / sizeof(*descs));
+  napi_define_properties(env, exports, sizeof(descs) / sizeof(*descs), descs);
+  return exports;
+}
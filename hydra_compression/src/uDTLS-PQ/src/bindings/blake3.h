@@ -0,0 +1,92 @@
+// src/bindings/blake3.h
+#ifndef BLAKE3_H
+#define BLAKE3_H
+
+#include <node_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// BLAKE3 (hash, keyed hash and key derivation, with extendable output) as
+// @noble/hashes/blake3 computes it. Independent compressions run side by
+// side in SIMD lanes: the chunks of one large input, the parents above
+// them, or many small inputs at once (blake3_batch). The widest of
+// AVX-512 (16 lanes), AVX2 (8) and SSE4.1 (4) the CPU supports is picked
+// at runtime; NEON gives 4 lanes on arm64 and other targets run the
+// portable compression function.
+
+static constexpr size_t BLAKE3_KEY_LEN = 32;
+static constexpr size_t BLAKE3_OUT_LEN = 32;
+static constexpr size_t BLAKE3_BLOCK_LEN = 64;
+static constexpr size_t BLAKE3_CHUNK_LEN = 1024;
+
+// Domain flags; the key words and flags together select the mode.
+static constexpr uint32_t BLAKE3_CHUNK_START = 1 << 0;
+static constexpr uint32_t BLAKE3_CHUNK_END = 1 << 1;
+static constexpr uint32_t BLAKE3_PARENT = 1 << 2;
+static constexpr uint32_t BLAKE3_ROOT = 1 << 3;
+static constexpr uint32_t BLAKE3_KEYED_HASH = 1 << 4;
+static constexpr uint32_t BLAKE3_DERIVE_KEY_CONTEXT = 1 << 5;
+static constexpr uint32_t BLAKE3_DERIVE_KEY_MATERIAL = 1 << 6;
+
+struct Blake3Mode {
+  uint32_t key[8];
+  uint32_t flags = 0;
+
+  static Blake3Mode hash();
+  static Blake3Mode keyed(const uint8_t key[BLAKE3_KEY_LEN]);
+  static Blake3Mode derive_key(const uint8_t* context, size_t len);
+};
+
+// Incremental hasher. Whole chunks are hashed in lanes as soon as they
+// arrive (across the worker pool for large updates); only the last,
+// possibly partial, chunk is buffered, so finalize can be called at any
+// point and hashing may continue afterwards.
+class Blake3Hasher {
+public:
+  explicit Blake3Hasher(const Blake3Mode& mode = Blake3Mode::hash());
+
+  void update(const uint8_t* data, size_t len);
+  // Writes len bytes of output; the first 32 are the digest.
+  void finalize(uint8_t* out, size_t len) const;
+
+private:
+  void compress_buffered();
+  void push_subtree(const uint32_t cv[8], unsigned level);
+  void hash_chunks(const uint8_t* data, size_t chunks);
+
+  Blake3Mode mode_;
+  uint64_t chunks_ = 0;                 // chunks pushed onto the stack so far
+  uint32_t cv_[8];                      // chaining value of the current chunk
+  uint8_t block_[BLAKE3_BLOCK_LEN];
+  size_t block_len_ = 0;
+  size_t blocks_ = 0;                   // blocks of the current chunk compressed
+  std::vector<uint32_t> stack_;         // subtree CVs, 8 words each, largest first
+};
+
+// Hashes inputs[i] (lens[i] bytes) into out + i * out_len. Inputs up to a
+// chunk long, the usual case, are hashed 4-16 per compression pass.
+void blake3_batch(const Blake3Mode& mode, const uint8_t* const* inputs, const size_t* lens,
+                  size_t count, uint8_t* out, size_t out_len);
+
+// ** blake3(data: Buffer | string, options?) -> Buffer **
+// options: { key?: Buffer (32 bytes), context?: string, dkLen?: number (default 32) }
+napi_value Blake3Hash(napi_env env, napi_callback_info info);
+
+// ** blake3Create(options?) -> { id }, blake3Update({ id }, data),
+//    blake3Digest({ id }, dkLen?) -> Buffer, blake3Free({ id }) -> boolean **
+// Digest does not end the stream; free releases the handle.
+napi_value Blake3Create(napi_env env, napi_callback_info info);
+napi_value Blake3Update(napi_env env, napi_callback_info info);
+napi_value Blake3Digest(napi_env env, napi_callback_info info);
+napi_value Blake3Free  (napi_env env, napi_callback_info info);
+
+// ** blake3Batch(inputs: (Buffer | string)[], options?) -> Buffer **
+// The inputs' digests back to back, dkLen bytes each.
+napi_value Blake3Batch(napi_env env, napi_callback_info info);
+
+// Module initialization function (called from openssl.cpp)
+napi_value InitBlake3(napi_env env, napi_value exports);
+
+#endif // BLAKE3_H
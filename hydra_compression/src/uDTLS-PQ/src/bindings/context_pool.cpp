@@ -0,0 +1,124 @@
+// src/bindings/context_pool.cpp
+#include "context_pool.h"
+#include <openssl/err.h>
+#include <openssl/evp.h>
+
+namespace {
+// Length-prefixed fields fed straight into the digest, so the key bytes are
+// never copied and no field can run into the next.
+struct Fingerprint {
+  EVP_MD_CTX* md = EVP_MD_CTX_new();
+  Fingerprint() { EVP_DigestInit_ex(md, EVP_sha256(), nullptr); }
+  ~Fingerprint() { EVP_MD_CTX_free(md); }
+
+  void u64(uint64_t v) {
+    unsigned char b[8];
+    for (int i = 0; i < 8; i++) b[i] = static_cast<unsigned char>(v >> (8 * i));
+    EVP_DigestUpdate(md, b, sizeof(b));
+  }
+  void bytes(const void* data, size_t len) {
+    u64(len);
+    if (len) EVP_DigestUpdate(md, data, len);
+  }
+  void str(const std::string& s) { bytes(s.data(), s.size()); }
+
+  std::string finish() {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int len = 0;
+    EVP_DigestFinal_ex(md, digest, &len);
+    return std::string(reinterpret_cast<const char*>(digest), len);
+  }
+};
+}
+
+std::string ContextConfig::fingerprint() const {
+  Fingerprint f;
+  f.u64(isServer);
+  f.bytes(cert, cert ? certLen : 0);
+  f.bytes(key, key ? keyLen : 0);
+  f.u64(ciphers.size());
+  for (const std::string& c : ciphers) f.str(c);
+  f.str(pqSuite);
+  f.u64(static_cast<uint32_t>(minVersion));
+  f.u64(static_cast<uint32_t>(maxVersion));
+  f.u64(static_cast<uint32_t>(verifyMode));
+  // Helper options only count when the helper is actually installed.
+  bool cache = isServer && sessionCache;
+  f.u64(cache);
+  if (cache) {
+    const SessionCacheOptions& o = sessionCacheOptions;
+    f.u64(o.capacity);
+    f.u64(static_cast<uint64_t>(o.ttlSeconds));
+    f.u64(o.shards);
+    f.u64(o.tickets);
+    f.u64(static_cast<uint64_t>(o.ticketRotateSeconds));
+  }
+  bool cookies = isServer && cookieExchange;
+  f.u64(cookies);
+  if (cookies) f.u64(static_cast<uint64_t>(cookieOptions.rotateSeconds));
+  return f.finish();
+}
+
+ContextPool& ContextPool::shared() {
+  static ContextPool* pool = new ContextPool();  // never destroyed, like IdentityCache
+  return *pool;
+}
+
+std::shared_ptr<SSLContextWrapper> ContextPool::build(const ContextConfig& config, std::string& error) {
+  SSL_CTX* ctx = create_dtls_context(config.isServer);
+  if (!ctx) {
+    error = "Failed to create DTLS context";
+    return nullptr;
+  }
+  auto wrapper = std::make_shared<SSLContextWrapper>(ctx);
+
+  if (config.cert && config.key &&
+      !set_certificates_from_memory(ctx, config.cert, config.certLen, config.key, config.keyLen)) {
+    error = "Failed to set certificates";
+    return nullptr;
+  }
+  set_cipher_list(ctx, config.ciphers);
+  if (!config.pqSuite.empty()) {
+    if (const char* err = set_pq_suite(ctx, config.pqSuite)) {
+      error = err;
+      return nullptr;
+    }
+  }
+  if ((config.minVersion && SSL_CTX_set_min_proto_version(ctx, config.minVersion) != 1) ||
+      (config.maxVersion && SSL_CTX_set_max_proto_version(ctx, config.maxVersion) != 1)) {
+    error = "Unsupported protocol version";
+    return nullptr;
+  }
+  if (config.verifyMode >= 0) SSL_CTX_set_verify(ctx, config.verifyMode, nullptr);
+
+  if (config.isServer && config.sessionCache && !wrapper->enableSessionCache(config.sessionCacheOptions)) {
+    error = "Failed to set up session cache";
+    return nullptr;
+  }
+  if (config.isServer && config.cookieExchange && !wrapper->enableCookieExchange(config.cookieOptions)) {
+    error = "Failed to set up cookie exchange";
+    return nullptr;
+  }
+
+  wrapper->freeze();
+  return wrapper;
+}
+
+std::shared_ptr<SSLContextWrapper> ContextPool::acquire(const ContextConfig& config, std::string& error,
+                                                        bool* reused) {
+  bool hit = false;
+  std::shared_ptr<SSLContextWrapper> ctx = entries_.getOrCreate(config.fingerprint(), [&] {
+    std::shared_ptr<SSLContextWrapper> built = build(config, error);
+    if (!built) ERR_clear_error();
+    return built;
+  }, &hit);
+  if (reused) *reused = hit;
+  if (!ctx) stats_.buildErrors++;
+  else if (hit) stats_.hits++;
+  else stats_.misses++;
+  return ctx;
+}
+
+size_t ContextPool::size() const {
+  return entries_.size();
+}
@@ -0,0 +1,66 @@
+// src/bindings/context_pool.h
+#ifndef CONTEXT_POOL_H
+#define CONTEXT_POOL_H
+
+#include "openssl.h"
+#include "session_cache.h"
+#include "cookie_exchange.h"
+#include "weak_cache.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Everything that goes into a configured SSL_CTX. cert/key are borrowed for
+// the duration of acquire() only.
+struct ContextConfig {
+  bool isServer = false;
+  const uint8_t* cert = nullptr;
+  size_t certLen = 0;
+  const uint8_t* key = nullptr;
+  size_t keyLen = 0;
+  std::vector<std::string> ciphers;
+  std::string pqSuite;          // setPQCipherSuites vocabulary, empty for none
+  int minVersion = 0;           // 0 leaves the method default
+  int maxVersion = 0;
+  int verifyMode = -1;          // -1 leaves SSL_VERIFY_NONE
+  bool sessionCache = false;    // server only, like createContext
+  SessionCacheOptions sessionCacheOptions;
+  bool cookieExchange = false;  // server only
+  CookieExchangeOptions cookieOptions;
+
+  // SHA-256 over a canonical encoding of every field above (including the
+  // cert/key bytes), so equal settings map to the same pool entry.
+  std::string fingerprint() const;
+};
+
+// Fully configured, frozen contexts shared by every caller asking for the
+// same ContextConfig. Entries are held weakly: a context lives as long as
+// some JS handle or server engine holds it, and the next acquire() after
+// that builds a fresh one. Frozen contexts reject the per-setting exports,
+// so nothing can change under connections that already share them.
+class ContextPool {
+public:
+  struct Stats {
+    std::atomic<uint64_t> hits{0}, misses{0}, buildErrors{0};
+  };
+
+  static ContextPool& shared();
+
+  // nullptr with error set when the configuration cannot be applied.
+  // reused reports whether an existing context was returned.
+  std::shared_ptr<SSLContextWrapper> acquire(const ContextConfig& config, std::string& error,
+                                             bool* reused = nullptr);
+
+  const Stats& stats() const { return stats_; }
+  size_t size() const;  // live contexts
+
+private:
+  static std::shared_ptr<SSLContextWrapper> build(const ContextConfig& config, std::string& error);
+
+  WeakCache<SSLContextWrapper> entries_;
+  Stats stats_;
+};
+
+#endif // CONTEXT_POOL_H
@@ -0,0 +1,168 @@
+// src/bindings/cookie_exchange.cpp
+#include "cookie_exchange.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <cstring>
+
+CookieExchange::CookieExchange(const CookieExchangeOptions& opts) : opts_(opts) {
+  if (opts_.rotateSeconds <= 0) opts_.rotateSeconds = 60;
+  current_.epoch = 0;
+}
+
+CookieExchange::~CookieExchange() {
+  OPENSSL_cleanse(&current_, sizeof(current_));
+  OPENSSL_cleanse(&previous_, sizeof(previous_));
+}
+
+int CookieExchange::exIndex() {
+  static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, &CookieExchange::freeExData);
+  return index;
+}
+
+void CookieExchange::freeExData(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<CookieExchange*>(ptr);
+}
+
+CookieExchange* CookieExchange::attach(SSL_CTX* ctx, const CookieExchangeOptions& opts) {
+  if (CookieExchange* existing = of(ctx)) return existing;
+
+  CookieExchange* cookies = new CookieExchange(opts);
+  if (!cookies->rotate()) {
+    delete cookies;
+    return nullptr;
+  }
+  SSL_CTX_set_ex_data(ctx, exIndex(), cookies);
+
+  SSL_CTX_set_options(ctx, SSL_OP_COOKIE_EXCHANGE);
+  SSL_CTX_set_cookie_generate_cb(ctx, &CookieExchange::onGenerate);
+  SSL_CTX_set_cookie_verify_cb(ctx, &CookieExchange::onVerify);
+  return cookies;
+}
+
+CookieExchange* CookieExchange::of(SSL_CTX* ctx) {
+  return static_cast<CookieExchange*>(SSL_CTX_get_ex_data(ctx, exIndex()));
+}
+
+// Caller holds mu_ (or is attach()).
+bool CookieExchange::rotate() {
+  Secret next;
+  if (RAND_priv_bytes(next.key, sizeof(next.key)) != 1) return false;
+  next.epoch = current_.epoch + 1;
+  next.created = Clock::now();
+
+  if (next.epoch > 1) {
+    previous_ = current_;
+    hasPrevious_ = true;
+    stats_.rotations++;
+  }
+  current_ = next;
+  OPENSSL_cleanse(&next, sizeof(next));
+  return true;
+}
+
+// The peer is reduced to family, address and port so the MAC does not
+// depend on sockaddr padding.
+static size_t peer_bytes(SSL* ssl, unsigned char* out) {
+  sockaddr_storage addr;
+  std::memset(&addr, 0, sizeof(addr));
+  if (BIO_dgram_get_peer(SSL_get_rbio(ssl), &addr) <= 0) return 0;
+
+  size_t n = 0;
+  out[n++] = static_cast<unsigned char>(addr.ss_family);
+  if (addr.ss_family == AF_INET6) {
+    auto* v6 = reinterpret_cast<const sockaddr_in6*>(&addr);
+    std::memcpy(out + n, &v6->sin6_addr, sizeof(v6->sin6_addr)); n += sizeof(v6->sin6_addr);
+    std::memcpy(out + n, &v6->sin6_port, sizeof(v6->sin6_port)); n += sizeof(v6->sin6_port);
+  } else if (addr.ss_family == AF_INET) {
+    auto* v4 = reinterpret_cast<const sockaddr_in*>(&addr);
+    std::memcpy(out + n, &v4->sin_addr, sizeof(v4->sin_addr)); n += sizeof(v4->sin_addr);
+    std::memcpy(out + n, &v4->sin_port, sizeof(v4->sin_port)); n += sizeof(v4->sin_port);
+  } else {
+    return 0;
+  }
+  return n;
+}
+
+bool CookieExchange::mac(const Secret& secret, const unsigned char* peer, size_t peerLen,
+                         unsigned char* out) const {
+  unsigned char msg[4 + 32];
+  msg[0] = static_cast<unsigned char>(secret.epoch >> 24);
+  msg[1] = static_cast<unsigned char>(secret.epoch >> 16);
+  msg[2] = static_cast<unsigned char>(secret.epoch >> 8);
+  msg[3] = static_cast<unsigned char>(secret.epoch);
+  std::memcpy(msg + 4, peer, peerLen);
+
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_len = 0;
+  if (!HMAC(EVP_sha256(), secret.key, sizeof(secret.key), msg, 4 + peerLen, digest, &digest_len))
+    return false;
+  std::memcpy(out, msg, 4);
+  std::memcpy(out + 4, digest, COOKIE_LEN - 4);
+  return true;
+}
+
+bool CookieExchange::generate(SSL* ssl, unsigned char* cookie, unsigned int* len) {
+  unsigned char peer[32];
+  size_t peer_len = peer_bytes(ssl, peer);
+  if (peer_len == 0) return false;
+
+  Secret secret;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (Clock::now() - current_.created >= std::chrono::seconds(opts_.rotateSeconds)) rotate();
+    secret = current_;
+  }
+
+  bool ok = mac(secret, peer, peer_len, cookie);
+  OPENSSL_cleanse(&secret, sizeof(secret));
+  if (!ok) return false;
+  *len = COOKIE_LEN;
+  stats_.issued++;
+  return true;
+}
+
+bool CookieExchange::verify(SSL* ssl, const unsigned char* cookie, unsigned int len) {
+  unsigned char peer[32];
+  size_t peer_len = peer_bytes(ssl, peer);
+  if (len != COOKIE_LEN || peer_len == 0) {
+    stats_.rejected++;
+    return false;
+  }
+
+  uint32_t epoch = (uint32_t(cookie[0]) << 24) | (uint32_t(cookie[1]) << 16) |
+                   (uint32_t(cookie[2]) << 8) | uint32_t(cookie[3]);
+  Secret secret;
+  bool known = false;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (epoch == current_.epoch) { secret = current_; known = true; }
+    else if (hasPrevious_ && epoch == previous_.epoch) { secret = previous_; known = true; }
+    // Rotation only happens when cookies are issued, so a secret can outlive
+    // its two periods on a quiet server; its cookies are at most this old.
+    if (known && Clock::now() - secret.created >= std::chrono::seconds(2 * opts_.rotateSeconds))
+      known = false;
+  }
+
+  unsigned char expected[COOKIE_LEN];
+  bool ok = known && mac(secret, peer, peer_len, expected) &&
+            CRYPTO_memcmp(expected, cookie, COOKIE_LEN) == 0;
+  OPENSSL_cleanse(&secret, sizeof(secret));
+
+  if (ok) stats_.verified++;
+  else    stats_.rejected++;
+  return ok;
+}
+
+int CookieExchange::onGenerate(SSL* ssl, unsigned char* cookie, unsigned int* len) {
+  CookieExchange* cookies = of(SSL_get_SSL_CTX(ssl));
+  return cookies && cookies->generate(ssl, cookie, len) ? 1 : 0;
+}
+
+int CookieExchange::onVerify(SSL* ssl, const unsigned char* cookie, unsigned int len) {
+  CookieExchange* cookies = of(SSL_get_SSL_CTX(ssl));
+  return cookies && cookies->verify(ssl, cookie, len) ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+// src/bindings/cookie_exchange.h
+#ifndef COOKIE_EXCHANGE_H
+#define COOKIE_EXCHANGE_H
+
+#include <openssl/ssl.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+struct CookieExchangeOptions {
+  long rotateSeconds = 60;  // cookies stay valid for up to two periods
+};
+
+// Stateless DTLS cookies for one SSL_CTX (RFC 6347 4.2.1). A cookie is
+//   epoch (4 bytes) || HMAC-SHA256(secret[epoch], epoch || peer address)[0..16)
+// so verification needs only the two live secrets, never per-peer state.
+// Like SessionCache, the object is owned by the SSL_CTX's ex_data.
+class CookieExchange {
+public:
+  static const size_t COOKIE_LEN = 20;
+
+  struct Stats {
+    std::atomic<uint64_t> issued{0}, verified{0}, rejected{0};
+    std::atomic<uint64_t> rotations{0};
+  };
+
+  // Installs the callbacks and SSL_OP_COOKIE_EXCHANGE; nullptr if no secret could be generated.
+  static CookieExchange* attach(SSL_CTX* ctx, const CookieExchangeOptions& opts);
+  static CookieExchange* of(SSL_CTX* ctx);
+
+  const Stats& stats() const { return stats_; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Secret {
+    uint32_t epoch;
+    unsigned char key[32];
+    Clock::time_point created;
+  };
+
+  explicit CookieExchange(const CookieExchangeOptions& opts);
+  ~CookieExchange();
+
+  bool rotate();
+  bool mac(const Secret& secret, const unsigned char* peer, size_t peerLen, unsigned char* out) const;
+  bool generate(SSL* ssl, unsigned char* cookie, unsigned int* len);
+  bool verify(SSL* ssl, const unsigned char* cookie, unsigned int len);
+
+  static int onGenerate(SSL* ssl, unsigned char* cookie, unsigned int* len);
+  static int onVerify(SSL* ssl, const unsigned char* cookie, unsigned int len);
+  static int exIndex();
+  static void freeExData(void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  CookieExchangeOptions opts_;
+  std::mutex mu_;
+  Secret current_;
+  Secret previous_;
+  bool hasPrevious_ = false;
+  Stats stats_;
+};
+
+#endif // COOKIE_EXCHANGE_H
@@ -0,0 +1,173 @@
+// src/bindings/dgram_bio.cpp
+#include "dgram_bio.h"
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace {
+
+struct DgramState {
+  std::deque<std::vector<uint8_t>> inbound;
+  std::deque<std::vector<uint8_t>> outbound;
+  size_t outbound_bytes = 0;
+  sockaddr_storage peer{};
+  socklen_t peer_len = 0;
+};
+
+DgramState* state_of(BIO* bio) {
+  return static_cast<DgramState*>(BIO_get_data(bio));
+}
+
+int dgram_write(BIO* bio, const char* buf, int len) {
+  DgramState* s = state_of(bio);
+  if (!s || len < 0) return -1;
+  BIO_clear_retry_flags(bio);
+  s->outbound.emplace_back(reinterpret_cast<const uint8_t*>(buf),
+                           reinterpret_cast<const uint8_t*>(buf) + len);
+  s->outbound_bytes += static_cast<size_t>(len);
+  return len;
+}
+
+// Returns one datagram per call; a datagram longer than the caller's buffer
+// is truncated, as recv() on a UDP socket would do.
+int dgram_read(BIO* bio, char* buf, int len) {
+  DgramState* s = state_of(bio);
+  if (!s || len < 0) return -1;
+  BIO_clear_retry_flags(bio);
+  if (s->inbound.empty()) {
+    BIO_set_retry_read(bio);
+    return -1;
+  }
+  std::vector<uint8_t>& d = s->inbound.front();
+  int n = d.size() < static_cast<size_t>(len) ? static_cast<int>(d.size()) : len;
+  std::memcpy(buf, d.data(), static_cast<size_t>(n));
+  s->inbound.pop_front();
+  return n;
+}
+
+long dgram_ctrl(BIO* bio, int cmd, long num, void* ptr) {
+  DgramState* s = state_of(bio);
+  if (!s) return 0;
+  switch (cmd) {
+    case BIO_CTRL_FLUSH:
+    case BIO_CTRL_DGRAM_SET_CONNECTED:
+      return 1;
+    case BIO_CTRL_PENDING:
+      return s->inbound.empty() ? 0 : static_cast<long>(s->inbound.front().size());
+    case BIO_CTRL_WPENDING:
+      return static_cast<long>(s->outbound_bytes);
+    case BIO_CTRL_DGRAM_GET_PEER: {
+      if (!ptr || s->peer_len == 0) return 0;
+      size_t n = num > 0 && static_cast<size_t>(num) < s->peer_len ? static_cast<size_t>(num) : s->peer_len;
+      std::memcpy(ptr, &s->peer, n);
+      return static_cast<long>(n);
+    }
+    case BIO_CTRL_DGRAM_SET_PEER:
+      if (ptr) {
+        const sockaddr* sa = static_cast<const sockaddr*>(ptr);
+        socklen_t n = sa->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+        std::memcpy(&s->peer, ptr, n);
+        s->peer_len = n;
+      }
+      return 1;
+    case BIO_CTRL_DGRAM_GET_MTU_OVERHEAD:
+      return s->peer.ss_family == AF_INET6 ? 48 : 28;  // IP + UDP headers
+    default:
+      // MTU queries, timeouts and the like have no meaning without a socket.
+      return 0;
+  }
+}
+
+int dgram_create(BIO* bio) {
+  BIO_set_data(bio, new DgramState());
+  BIO_set_init(bio, 1);
+  return 1;
+}
+
+int dgram_destroy(BIO* bio) {
+  if (!bio) return 0;
+  delete state_of(bio);
+  BIO_set_data(bio, nullptr);
+  BIO_set_init(bio, 0);
+  return 1;
+}
+
+BIO_METHOD* dgram_method() {
+  static BIO_METHOD* method = nullptr;
+  static std::once_flag once;
+  std::call_once(once, [] {
+    method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "udtls datagram memory");
+    BIO_meth_set_write(method, dgram_write);
+    BIO_meth_set_read(method, dgram_read);
+    BIO_meth_set_ctrl(method, dgram_ctrl);
+    BIO_meth_set_create(method, dgram_create);
+    BIO_meth_set_destroy(method, dgram_destroy);
+  });
+  return method;
+}
+
+} // namespace
+
+BIO* dgram_bio_new() {
+  return BIO_new(dgram_method());
+}
+
+void dgram_bio_push_inbound(BIO* bio, const uint8_t* data, size_t len) {
+  DgramState* s = state_of(bio);
+  if (s) s->inbound.emplace_back(data, data + len);
+}
+
+void dgram_bio_take_outbound(BIO* bio, std::vector<std::vector<uint8_t>>& out) {
+  DgramState* s = state_of(bio);
+  if (!s) return;
+  for (auto& d : s->outbound) out.push_back(std::move(d));
+  s->outbound.clear();
+  s->outbound_bytes = 0;
+}
+
+size_t dgram_bio_outbound_count(BIO* bio) {
+  DgramState* s = state_of(bio);
+  return s ? s->outbound.size() : 0;
+}
+
+void dgram_bio_set_peer(BIO* bio, const sockaddr* addr, socklen_t len) {
+  DgramState* s = state_of(bio);
+  if (!s || len > sizeof(s->peer)) return;
+  std::memcpy(&s->peer, addr, len);
+  s->peer_len = len;
+}
+
+bool parse_peer_address(const std::string& host, int port, sockaddr_storage& addr, socklen_t& len) {
+  std::memset(&addr, 0, sizeof(addr));
+  auto* v4 = reinterpret_cast<sockaddr_in*>(&addr);
+  auto* v6 = reinterpret_cast<sockaddr_in6*>(&addr);
+  if (inet_pton(AF_INET, host.c_str(), &v4->sin_addr) == 1) {
+    v4->sin_family = AF_INET;
+    v4->sin_port = htons(static_cast<uint16_t>(port));
+    len = sizeof(sockaddr_in);
+    return true;
+  }
+  if (inet_pton(AF_INET6, host.c_str(), &v6->sin6_addr) == 1) {
+    v6->sin6_family = AF_INET6;
+    v6->sin6_port = htons(static_cast<uint16_t>(port));
+    len = sizeof(sockaddr_in6);
+    return true;
+  }
+  return false;
+}
+
+std::string format_peer_address(const sockaddr_storage& addr, int* port) {
+  char host[INET6_ADDRSTRLEN] = "";
+  if (addr.ss_family == AF_INET6) {
+    auto* v6 = reinterpret_cast<const sockaddr_in6*>(&addr);
+    inet_ntop(AF_INET6, &v6->sin6_addr, host, sizeof(host));
+    if (port) *port = ntohs(v6->sin6_port);
+  } else {
+    auto* v4 = reinterpret_cast<const sockaddr_in*>(&addr);
+    inet_ntop(AF_INET, &v4->sin_addr, host, sizeof(host));
+    if (port) *port = ntohs(v4->sin_port);
+  }
+  return host;
+}
@@ -0,0 +1,35 @@
+// src/bindings/dgram_bio.h
+#ifndef DGRAM_BIO_H
+#define DGRAM_BIO_H
+
+#include <openssl/bio.h>
+#include <sys/socket.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// In-memory BIO that keeps datagram boundaries. Inbound datagrams are queued
+// natively and popped one per BIO_read; every BIO_write from the DTLS record
+// layer becomes one outbound datagram. Using the same BIO as rbio and wbio
+// lets a whole receive/handshake/send step run in one native call without
+// touching a socket.
+BIO* dgram_bio_new();
+
+// Queues one received datagram for the next SSL_read/SSL_do_handshake.
+void dgram_bio_push_inbound(BIO* bio, const uint8_t* data, size_t len);
+
+// Moves every pending outbound datagram into `out` (appending).
+void dgram_bio_take_outbound(BIO* bio, std::vector<std::vector<uint8_t>>& out);
+
+size_t dgram_bio_outbound_count(BIO* bio);
+
+// Peer address reported through BIO_dgram_get_peer (used by cookie callbacks).
+void dgram_bio_set_peer(BIO* bio, const sockaddr* addr, socklen_t len);
+
+// Address helpers shared by the record path and the native UDP sockets.
+// parse_peer_address accepts IPv4/IPv6 literals only (no DNS lookups).
+bool parse_peer_address(const std::string& host, int port, sockaddr_storage& addr, socklen_t& len);
+std::string format_peer_address(const sockaddr_storage& addr, int* port);
+
+#endif // DGRAM_BIO_H
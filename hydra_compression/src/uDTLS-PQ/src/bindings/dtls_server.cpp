@@ -0,0 +1,313 @@
+// src/bindings/dtls_server.cpp
+#include "dtls_server.h"
+#include "handle_table.h"
+#include "metrics.h"
+#include <algorithm>
+#include <thread>
+#include <netinet/in.h>
+
+DtlsServerEngine::DtlsServerEngine(std::shared_ptr<SSLContextWrapper> ctx, const UdpEndpointOptions& opts,
+                                   size_t workers, napi_threadsafe_function onEvents)
+    : ctx_(std::move(ctx)), opts_(opts), onEvents_(onEvents) {
+#ifndef __linux__
+  // Only Linux balances SO_REUSEPORT datagrams across sockets; elsewhere
+  // the last socket bound would get all of them.
+  workers = 1;
+#endif
+  opts_.reusePort = workers > 1;
+  workers_.resize(std::max<size_t>(workers, 1));
+  // Each worker keeps its own peers, so the cap is shared out between them.
+  if (opts_.maxPeers) opts_.maxPeers = (opts_.maxPeers + workers_.size() - 1) / workers_.size();
+}
+
+DtlsServerEngine::~DtlsServerEngine() {
+  stop();
+}
+
+bool DtlsServerEngine::start(std::string& error) {
+  // The first worker may bind an ephemeral port; the rest join it.
+  UdpEndpointOptions opts = opts_;
+  for (size_t i = 0; i < workers_.size(); i++) {
+    if (i > 0) opts.port = port_;
+    workers_[i].reset(new UdpEndpoint(opts, ctx_, onEvents_));
+
+    int index = static_cast<int>(i);
+    workers_[i]->setPeerObserver([this, index](const std::string& key, bool added) {
+      std::lock_guard<std::mutex> lock(ownersMu_);
+      if (added) owners_[key] = index;
+      else       owners_.erase(key);
+    });
+
+    if (!workers_[i]->start(error)) {
+      stop();
+      return false;
+    }
+    if (i == 0) port_ = workers_[0]->localPort();
+  }
+  return true;
+}
+
+void DtlsServerEngine::stop() {
+  for (auto& w : workers_)
+    if (w) w->stop();
+  std::lock_guard<std::mutex> lock(ownersMu_);
+  owners_.clear();
+}
+
+int DtlsServerEngine::ownerOf(const sockaddr_storage& peer) {
+  std::lock_guard<std::mutex> lock(ownersMu_);
+  auto it = owners_.find(udp_peer_key(peer));
+  return it == owners_.end() ? -1 : it->second;
+}
+
+bool DtlsServerEngine::send(const sockaddr_storage& peer, socklen_t len, std::vector<uint8_t> data) {
+  int owner = ownerOf(peer);
+  if (owner < 0) return false;
+  workers_[owner]->send(peer, len, std::move(data));
+  return true;
+}
+
+bool DtlsServerEngine::disconnect(const sockaddr_storage& peer, socklen_t len) {
+  int owner = ownerOf(peer);
+  if (owner < 0) return false;
+  workers_[owner]->disconnect(peer, len);
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// N-API surface. Events use the same batched shape as native UDP sockets;
+// all workers share one thread-safe function.
+// ---------------------------------------------------------------------------
+
+static HandleTable<DtlsServerEngine> g_servers;
+
+static std::shared_ptr<DtlsServerEngine> get_server_arg(napi_env env, napi_value obj) {
+  auto server = g_servers.get(udp_get_id_property(env, obj));
+  if (!server) napi_throw_error(env, nullptr, "Invalid DTLS server");
+  return server;
+}
+
+static bool get_int_option(napi_env env, napi_value obj, const char* name, int32_t* out) {
+  bool has = false;
+  napi_value v;
+  if (napi_has_named_property(env, obj, name, &has) != napi_ok || !has) return false;
+  napi_get_named_property(env, obj, name, &v);
+  return napi_get_value_int32(env, v, out) == napi_ok;
+}
+
+// NAPI implementation for CreateDtlsServer
+napi_value CreateDtlsServer(napi_env env, napi_callback_info info) {
+  // Parse arguments: [context, { address?, port?, workers?, batchSize?, maxDatagram?, mtu?,
+  //                              idleTimeoutMs?, maxPeers? }, onEvents]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  napi_valuetype cb_type = napi_undefined;
+  if (argc >= 3) napi_typeof(env, args[2], &cb_type);
+  if (argc < 3 || cb_type != napi_function) {
+    napi_throw_error(env, nullptr, "Expected (context, options, onEvents)");
+    return nullptr;
+  }
+
+  auto ctx = find_context(udp_get_id_property(env, args[0]));
+  if (!ctx) {
+    napi_throw_error(env, nullptr, "Invalid context");
+    return nullptr;
+  }
+
+  UdpEndpointOptions opts;
+  size_t workers = std::max(1u, std::thread::hardware_concurrency());
+  int32_t n;
+
+  napi_value v;
+  bool has = false;
+  napi_has_named_property(env, args[1], "address", &has);
+  if (has) {
+    char host[INET6_ADDRSTRLEN + 1];
+    size_t host_len = 0;
+    napi_get_named_property(env, args[1], "address", &v);
+    if (napi_get_value_string_utf8(env, v, host, sizeof(host), &host_len) == napi_ok)
+      opts.address.assign(host, host_len);
+  }
+  if (get_int_option(env, args[1], "port", &n)) opts.port = n;
+  if (get_int_option(env, args[1], "workers", &n) && n > 0) workers = std::min(n, 256);
+  if (get_int_option(env, args[1], "batchSize", &n) && n > 0) opts.batchSize = std::min(n, 1024);
+  if (get_int_option(env, args[1], "maxDatagram", &n) && n > 0) opts.maxDatagram = std::min(n, 65535);
+  if (get_int_option(env, args[1], "mtu", &n) && n > 0) opts.mtu = n;
+  if (get_int_option(env, args[1], "idleTimeoutMs", &n) && n > 0) opts.idleTimeoutMs = n;
+  if (get_int_option(env, args[1], "maxPeers", &n) && n > 0) opts.maxPeers = n;
+
+  napi_value name;
+  napi_create_string_utf8(env, "dtlsServerEvents", NAPI_AUTO_LENGTH, &name);
+  napi_threadsafe_function tsfn;
+  if (napi_create_threadsafe_function(env, args[2], nullptr, name, 0, 1, nullptr, nullptr,
+                                      nullptr, udp_call_js_events, &tsfn) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to create event callback");
+    return nullptr;
+  }
+
+  auto server = std::make_shared<DtlsServerEngine>(ctx, opts, workers, tsfn);
+  std::string error;
+  if (!server->start(error)) {
+    napi_release_threadsafe_function(tsfn, napi_tsfn_abort);
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+
+  int id = g_servers.insert(server);
+  if (!id) {
+    server->stop();
+    napi_release_threadsafe_function(tsfn, napi_tsfn_abort);
+    napi_throw_error(env, nullptr, "Too many DTLS servers");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  napi_create_int32(env, server->port(), &v);
+  napi_set_named_property(env, result, "port", v);
+  napi_create_uint32(env, static_cast<uint32_t>(server->workerCount()), &v);
+  napi_set_named_property(env, result, "workers", v);
+  return result;
+}
+
+// Shared by DtlsServerSend/DtlsServerDisconnect: [server, host, port, data?]
+static napi_value server_peer_op(napi_env env, napi_callback_info info, bool is_send) {
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < (is_send ? 4u : 3u)) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto server = get_server_arg(env, args[0]);
+  if (!server) return nullptr;
+
+  sockaddr_storage addr;
+  socklen_t len;
+  if (!udp_get_peer_args(env, args, 1, addr, len)) return nullptr;
+
+  bool ok;
+  if (is_send) {
+    bool is_buffer = false;
+    napi_is_buffer(env, args[3], &is_buffer);
+    if (!is_buffer) {
+      napi_throw_error(env, nullptr, "Data must be a Buffer");
+      return nullptr;
+    }
+    void* data;
+    size_t data_len;
+    napi_get_buffer_info(env, args[3], &data, &data_len);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    ok = server->send(addr, len, std::vector<uint8_t>(bytes, bytes + data_len));
+  } else {
+    ok = server->disconnect(addr, len);
+  }
+
+  napi_value result;
+  napi_get_boolean(env, ok, &result);
+  return result;
+}
+
+// NAPI implementation for DtlsServerSend
+napi_value DtlsServerSend(napi_env env, napi_callback_info info) {
+  return server_peer_op(env, info, true);
+}
+
+// NAPI implementation for DtlsServerDisconnect
+napi_value DtlsServerDisconnect(napi_env env, napi_callback_info info) {
+  return server_peer_op(env, info, false);
+}
+
+// NAPI implementation for CloseDtlsServer
+napi_value CloseDtlsServer(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto server = g_servers.remove(udp_get_id_property(env, args[0]));
+  bool found = server != nullptr;
+  if (found) {
+    // Every worker must be joined before the shared function goes away.
+    server->stop();
+    napi_release_threadsafe_function(server->eventCallback(), napi_tsfn_release);
+  }
+
+  napi_value result;
+  napi_get_boolean(env, found, &result);
+  return result;
+}
+
+// NAPI implementation for GetDtlsServerStats
+// { rxPackets, txPackets, rxBatches, txBatches, dropped, peers, workers: [...] }
+napi_value GetDtlsServerStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto server = get_server_arg(env, args[0]);
+  if (!server) return nullptr;
+
+  static const char* const names[] = { "rxPackets", "txPackets", "rxBatches", "txBatches", "dropped", "peers" };
+  uint64_t totals[6] = {};
+
+  napi_value result, list, v;
+  napi_create_object(env, &result);
+  napi_create_array_with_length(env, server->workerCount(), &list);
+
+  for (size_t i = 0; i < server->workerCount(); i++) {
+    const UdpEndpoint::Stats& s = server->worker(i).stats();
+    const uint64_t values[6] = {
+      s.rxPackets.load(), s.txPackets.load(), s.rxBatches.load(),
+      s.txBatches.load(), s.dropped.load(), s.peers.load(),
+    };
+
+    napi_value worker;
+    napi_create_object(env, &worker);
+    for (int f = 0; f < 6; f++) {
+      totals[f] += values[f];
+      napi_create_double(env, static_cast<double>(values[f]), &v);
+      napi_set_named_property(env, worker, names[f], v);
+    }
+    napi_set_element(env, list, static_cast<uint32_t>(i), worker);
+  }
+
+  for (int f = 0; f < 6; f++) {
+    napi_create_double(env, static_cast<double>(totals[f]), &v);
+    napi_set_named_property(env, result, names[f], v);
+  }
+  napi_set_named_property(env, result, "workers", list);
+  return result;
+}
+
+napi_value InitDtlsServer(napi_env env, napi_value exports) {
+  napi_add_env_cleanup_hook(env, [](void*) {
+    for (auto& server : g_servers.drain()) server->stop();
+  }, nullptr);
+
+  napi_property_descriptor desc[] = {
+    { "createDtlsServer",     nullptr, CreateDtlsServer,     nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "dtlsServerSend",       nullptr, DtlsServerSend,       nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "dtlsServerDisconnect", nullptr, DtlsServerDisconnect, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "closeDtlsServer",      nullptr, CloseDtlsServer,      nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getDtlsServerStats",   nullptr, GetDtlsServerStats,   nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(desc, sizeof(desc) / sizeof(desc[0]));
+  napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc);
+  return exports;
+}
@@ -0,0 +1,58 @@
+// src/bindings/dtls_server.h
+#ifndef DTLS_SERVER_H
+#define DTLS_SERVER_H
+
+#include "udp_socket.h"
+#include <node_api.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Multi-core DTLS termination: N UdpEndpoints bound to the same port with
+// SO_REUSEPORT, one I/O thread and epoll loop each. The kernel hashes every
+// peer onto one socket, so each worker owns its sessions outright and the
+// record path never takes a lock. The owner table below is only touched when
+// a session is created or dropped, to route sends from JS to the right worker.
+class DtlsServerEngine {
+public:
+  DtlsServerEngine(std::shared_ptr<SSLContextWrapper> ctx, const UdpEndpointOptions& opts,
+                   size_t workers, napi_threadsafe_function onEvents);
+  ~DtlsServerEngine();
+
+  bool start(std::string& error);
+  void stop();
+
+  // False if no worker holds a session for the peer.
+  bool send(const sockaddr_storage& peer, socklen_t len, std::vector<uint8_t> data);
+  bool disconnect(const sockaddr_storage& peer, socklen_t len);
+
+  int port() const { return port_; }
+  size_t workerCount() const { return workers_.size(); }
+  const UdpEndpoint& worker(size_t i) const { return *workers_[i]; }
+  napi_threadsafe_function eventCallback() const { return onEvents_; }
+
+private:
+  int ownerOf(const sockaddr_storage& peer);
+
+  std::shared_ptr<SSLContextWrapper> ctx_;
+  UdpEndpointOptions opts_;
+  napi_threadsafe_function onEvents_;
+  std::vector<std::unique_ptr<UdpEndpoint>> workers_;
+  int port_ = 0;
+
+  std::mutex ownersMu_;
+  std::unordered_map<std::string, int> owners_;
+};
+
+// N-API exports
+napi_value CreateDtlsServer     (napi_env, napi_callback_info);
+napi_value DtlsServerSend       (napi_env, napi_callback_info);
+napi_value DtlsServerDisconnect (napi_env, napi_callback_info);
+napi_value CloseDtlsServer      (napi_env, napi_callback_info);
+napi_value GetDtlsServerStats   (napi_env, napi_callback_info);
+
+napi_value InitDtlsServer(napi_env env, napi_value exports);
+
+#endif // DTLS_SERVER_H
@@ -0,0 +1,118 @@
+// src/bindings/handle_table.h
+#ifndef HANDLE_TABLE_H
+#define HANDLE_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Slab of native objects addressed by the int32 ids handed to JS. An id packs
+// a slot index with the slot's generation, so lookups are one vector index
+// plus a compare, and a freed id stops resolving even after its slot is
+// reused. Freed slots are reused oldest first, and a slot whose generation
+// would wrap is retired rather than reused, so no id ever names a second
+// object. The lock only guards the slab itself; callers get a shared_ptr
+// and may use it from any thread.
+template <typename T>
+class HandleTable {
+public:
+  static constexpr int INDEX_BITS = 20;        // up to ~1M slots
+  static constexpr uint32_t GENERATION_MASK = 0x7ff;  // keeps ids positive
+
+  // Returns 0 when the table is full: every slot is live or retired, which
+  // takes about 2^31 inserts in all.
+  int insert(std::shared_ptr<T> value) {
+    std::lock_guard<std::mutex> lock(mu_);
+    uint32_t index;
+    if (!free_.empty()) {
+      index = free_.front();
+      free_.pop_front();
+    } else {
+      if (slots_.size() >= (1u << INDEX_BITS) - 1) return 0;
+      index = static_cast<uint32_t>(slots_.size());
+      slots_.emplace_back();
+    }
+    slots_[index].value = std::move(value);
+    return encode(index, slots_[index].generation);
+  }
+
+  std::shared_ptr<T> get(int id) const {
+    uint32_t index, generation;
+    if (!decode(id, index, generation)) return nullptr;
+    std::lock_guard<std::mutex> lock(mu_);
+    if (index >= slots_.size() || slots_[index].generation != generation) return nullptr;
+    return slots_[index].value;
+  }
+
+  // Detaches the object; the caller decides when the last reference drops.
+  std::shared_ptr<T> remove(int id) {
+    uint32_t index, generation;
+    if (!decode(id, index, generation)) return nullptr;
+    std::lock_guard<std::mutex> lock(mu_);
+    if (index >= slots_.size() || slots_[index].generation != generation ||
+        !slots_[index].value)
+      return nullptr;
+    Slot& slot = slots_[index];
+    std::shared_ptr<T> value = std::move(slot.value);
+    slot.value.reset();
+    release(index);
+    return value;
+  }
+
+  // Empties the table and returns what was in it.
+  std::vector<std::shared_ptr<T>> drain() {
+    std::lock_guard<std::mutex> lock(mu_);
+    std::vector<std::shared_ptr<T>> out;
+    for (uint32_t i = 0; i < slots_.size(); i++) {
+      if (!slots_[i].value) continue;
+      out.push_back(std::move(slots_[i].value));
+      slots_[i].value.reset();
+      release(i);
+    }
+    return out;
+  }
+
+private:
+  struct Slot {
+    uint32_t generation = 0;
+    std::shared_ptr<T> value;
+  };
+
+  // Bumps the generation of an emptied slot and queues it for reuse, unless
+  // the generation is spent (its old ids would start resolving again).
+  void release(uint32_t index) {
+    Slot& slot = slots_[index];
+    if (slot.generation == GENERATION_MASK) {
+      slot.generation = RETIRED;
+      return;
+    }
+    slot.generation++;
+    free_.push_back(index);
+  }
+
+  // Outside GENERATION_MASK, so no id decodes to it.
+  static constexpr uint32_t RETIRED = GENERATION_MASK + 1;
+
+  // Index is stored +1 so that 0 is never a valid id.
+  static int encode(uint32_t index, uint32_t generation) {
+    return static_cast<int>((generation << INDEX_BITS) | (index + 1));
+  }
+
+  static bool decode(int id, uint32_t& index, uint32_t& generation) {
+    if (id <= 0) return false;
+    uint32_t raw = static_cast<uint32_t>(id);
+    uint32_t low = raw & ((1u << INDEX_BITS) - 1);
+    if (low == 0) return false;
+    index = low - 1;
+    generation = raw >> INDEX_BITS;
+    return true;
+  }
+
+  mutable std::mutex mu_;
+  std::vector<Slot> slots_;
+  std::deque<uint32_t> free_;
+};
+
+#endif // HANDLE_TABLE_H
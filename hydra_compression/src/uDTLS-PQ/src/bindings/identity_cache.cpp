@@ -0,0 +1,143 @@
+// src/bindings/identity_cache.cpp
+#include "identity_cache.h"
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+ParsedCertificate::~ParsedCertificate() {
+  X509_free(leaf);
+  if (chain) sk_X509_pop_free(chain, X509_free);
+}
+
+ParsedKey::~ParsedKey() {
+  EVP_PKEY_free(pkey);
+}
+
+static bool looks_like_pem(const uint8_t* data, size_t len) {
+  static const char marker[] = "-----BEGIN";
+  const size_t m = sizeof(marker) - 1;
+  for (size_t i = 0; i + m <= len && i < 4096; i++)
+    if (std::memcmp(data + i, marker, m) == 0) return true;
+  return false;
+}
+
+static std::unique_ptr<ParsedCertificate> parse_certificate(const uint8_t* data, size_t len) {
+  std::unique_ptr<ParsedCertificate> out(new ParsedCertificate());
+  if (looks_like_pem(data, len)) {
+    BIO* bio = BIO_new_mem_buf(data, static_cast<int>(len));
+    if (!bio) return nullptr;
+    out->leaf = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+    if (out->leaf) {
+      out->chain = sk_X509_new_null();
+      while (X509* extra = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr))
+        sk_X509_push(out->chain, extra);
+    }
+    BIO_free(bio);
+  } else {
+    const unsigned char* p = data;
+    out->leaf = d2i_X509(nullptr, &p, static_cast<long>(len));
+  }
+  ERR_clear_error();  // the chain loop always ends on a "no start line" error
+  return out->leaf ? std::move(out) : nullptr;
+}
+
+static std::unique_ptr<ParsedKey> parse_key(const uint8_t* data, size_t len) {
+  std::unique_ptr<ParsedKey> out(new ParsedKey());
+  if (looks_like_pem(data, len)) {
+    BIO* bio = BIO_new_mem_buf(data, static_cast<int>(len));
+    if (!bio) return nullptr;
+    out->pkey = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+    BIO_free(bio);
+  } else {
+    const unsigned char* p = data;
+    out->pkey = d2i_AutoPrivateKey(nullptr, &p, static_cast<long>(len));
+  }
+  ERR_clear_error();
+  return out->pkey ? std::move(out) : nullptr;
+}
+
+static std::string content_hash(const uint8_t* data, size_t len) {
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_len = 0;
+  EVP_Digest(data, len, digest, &digest_len, EVP_sha256(), nullptr);
+  return std::string(reinterpret_cast<const char*>(digest), digest_len);
+}
+
+IdentityCache& IdentityCache::shared() {
+  static IdentityCache* cache = new IdentityCache();  // never destroyed; contexts may outlive statics
+  return *cache;
+}
+
+template <typename T, typename Parse>
+std::shared_ptr<const T> IdentityCache::lookup(WeakCache<const T>& table, const uint8_t* data, size_t len,
+                                               Parse parse) {
+  if (!data || len == 0 || len > INT32_MAX) return nullptr;
+  bool hit = false;
+  std::shared_ptr<const T> found = table.getOrCreate(
+      content_hash(data, len), [&] { return std::shared_ptr<const T>(parse(data, len).release()); }, &hit);
+  if (!found) stats_.parseErrors++;
+  else if (hit) stats_.hits++;
+  else stats_.misses++;
+  return found;
+}
+
+std::shared_ptr<const ParsedCertificate> IdentityCache::certificate(const uint8_t* data, size_t len) {
+  return lookup(certs_, data, len, parse_certificate);
+}
+
+std::shared_ptr<const ParsedKey> IdentityCache::privateKey(const uint8_t* data, size_t len) {
+  return lookup(keys_, data, len, parse_key);
+}
+
+size_t IdentityCache::size() const {
+  return certs_.size() + keys_.size();
+}
+
+namespace {
+struct InstalledIdentity {
+  std::shared_ptr<const ParsedCertificate> cert;
+  std::shared_ptr<const ParsedKey> key;
+};
+}
+
+int IdentityCache::exIndex() {
+  static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, &IdentityCache::freeExData);
+  return index;
+}
+
+void IdentityCache::freeExData(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<InstalledIdentity*>(ptr);
+}
+
+bool IdentityCache::install(SSL_CTX* ctx, std::shared_ptr<const ParsedCertificate> cert,
+                            std::shared_ptr<const ParsedKey> key) {
+  if (!ctx || !cert || !key) return false;
+
+  // Each call takes its own reference on the shared objects.
+  if (SSL_CTX_use_certificate(ctx, cert->leaf) != 1) return false;
+  SSL_CTX_clear_chain_certs(ctx);
+  for (int i = 0; cert->chain && i < sk_X509_num(cert->chain); i++)
+    if (SSL_CTX_add1_chain_cert(ctx, sk_X509_value(cert->chain, i)) != 1) return false;
+  if (SSL_CTX_use_PrivateKey(ctx, key->pkey) != 1) return false;
+  if (SSL_CTX_check_private_key(ctx) != 1) return false;
+
+  delete static_cast<InstalledIdentity*>(SSL_CTX_get_ex_data(ctx, exIndex()));
+  SSL_CTX_set_ex_data(ctx, exIndex(), new InstalledIdentity{ std::move(cert), std::move(key) });
+  return true;
+}
+
+bool read_file_bytes(const char* path, std::vector<uint8_t>& out) {
+  FILE* f = std::fopen(path, "rb");
+  if (!f) return false;
+  out.clear();
+  uint8_t buf[16384];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  bool ok = !std::ferror(f);
+  std::fclose(f);
+  return ok;
+}
@@ -0,0 +1,67 @@
+// src/bindings/identity_cache.h
+#ifndef IDENTITY_CACHE_H
+#define IDENTITY_CACHE_H
+
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "weak_cache.h"
+
+// Leaf certificate plus any chain certificates that followed it in the PEM.
+struct ParsedCertificate {
+  X509* leaf = nullptr;
+  STACK_OF(X509)* chain = nullptr;
+  ~ParsedCertificate();
+};
+
+struct ParsedKey {
+  EVP_PKEY* pkey = nullptr;
+  ~ParsedKey();
+};
+
+// Parsed certificates and private keys shared by every SSL_CTX that loads
+// the same bytes. Entries are keyed by the SHA-256 of the input (PEM or
+// DER) and held weakly: a context installing an identity keeps it alive
+// through its ex_data, and the entry lapses once the last such context is
+// freed. X509 and EVP_PKEY are read-only after parsing, so one object can
+// back any number of contexts on any thread.
+class IdentityCache {
+public:
+  struct Stats {
+    std::atomic<uint64_t> hits{0}, misses{0}, parseErrors{0};
+  };
+
+  static IdentityCache& shared();
+
+  // nullptr if the bytes are neither a PEM certificate nor DER.
+  std::shared_ptr<const ParsedCertificate> certificate(const uint8_t* data, size_t len);
+  // Unencrypted PEM (PKCS#8 or traditional) or DER private keys.
+  std::shared_ptr<const ParsedKey> privateKey(const uint8_t* data, size_t len);
+
+  // Uses both on ctx and ties their lifetime to it. Fails if the key does
+  // not match the certificate.
+  static bool install(SSL_CTX* ctx, std::shared_ptr<const ParsedCertificate> cert,
+                      std::shared_ptr<const ParsedKey> key);
+
+  const Stats& stats() const { return stats_; }
+  size_t size() const;  // live entries, certificates and keys together
+
+private:
+  template <typename T, typename Parse>
+  std::shared_ptr<const T> lookup(WeakCache<const T>& table, const uint8_t* data, size_t len, Parse parse);
+
+  static int exIndex();
+  static void freeExData(void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  WeakCache<const ParsedCertificate> certs_;
+  WeakCache<const ParsedKey> keys_;
+  Stats stats_;
+};
+
+// Whole-file read used for path-based loading; false if it cannot be read.
+bool read_file_bytes(const char* path, std::vector<uint8_t>& out);
+
+#endif // IDENTITY_CACHE_H
@@ -0,0 +1,98 @@
+// src/bindings/kem_pool.cpp
+#include "kem_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+KemKeyPairPool::KemKeyPairPool(const OQS_KEM* kem)
+  : kem_(kem), slotSize_(kem->length_public_key + kem->length_secret_key) {}
+
+KemKeyPairPool::~KemKeyPairPool() {
+  stop();
+}
+
+void KemKeyPairPool::configure(size_t depth, size_t lowWatermark, size_t highWatermark) {
+  stop();
+
+  std::lock_guard<std::mutex> lock(mu_);
+  storage_.reset();  // wipes any pooled keys
+  if (depth > 0) {
+    storage_ = make_secret(depth * slotSize_);
+    if (!storage_) depth = 0;
+  }
+  depth_ = depth;
+  high_ = std::min(highWatermark, depth);
+  low_ = std::min(lowWatermark, high_);
+  head_ = 0;
+  count_ = 0;
+
+  if (depth_ > 0) start();
+}
+
+void KemKeyPairPool::start() {
+  stopping_ = false;
+  refill_ = std::thread(&KemKeyPairPool::refillLoop, this);
+}
+
+void KemKeyPairPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (refill_.joinable()) refill_.join();
+}
+
+bool KemKeyPairPool::take(uint8_t* pk, uint8_t* sk) {
+  std::unique_lock<std::mutex> lock(mu_);
+  if (count_ == 0) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    lock.unlock();
+    wake_.notify_one();
+    return false;
+  }
+
+  uint8_t* s = slot(head_);
+  std::memcpy(pk, s, kem_->length_public_key);
+  std::memcpy(sk, s + kem_->length_public_key, kem_->length_secret_key);
+  OQS_MEM_cleanse(s, slotSize_);
+  head_ = (head_ + 1) % depth_;
+  bool refill = --count_ < low_;
+  lock.unlock();
+
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  if (refill) wake_.notify_one();
+  return true;
+}
+
+KemKeyPairPool::Stats KemKeyPairPool::stats() {
+  std::lock_guard<std::mutex> lock(mu_);
+  return Stats{ hits_.load(), misses_.load(), generated_.load(), count_, depth_, low_, high_ };
+}
+
+// Single producer: the slot just past the pooled range is never read by
+// take(), so keys are generated into it without holding the lock and only
+// published by bumping count_.
+void KemKeyPairPool::refillLoop() {
+  std::unique_lock<std::mutex> lock(mu_);
+  for (;;) {
+    wake_.wait(lock, [this] {
+      return stopping_ || (count_ < high_ && (count_ < low_ || count_ == 0));
+    });
+    if (stopping_) return;
+
+    while (!stopping_ && count_ < high_) {
+      uint8_t* s = slot((head_ + count_) % depth_);
+      lock.unlock();
+      bool ok = OQS_KEM_keypair(kem_, s, s + kem_->length_public_key) == OQS_SUCCESS;
+      lock.lock();
+      if (!ok) {
+        // Back off instead of spinning on a persistent keygen failure.
+        wake_.wait_for(lock, std::chrono::seconds(1), [this] { return stopping_; });
+        break;
+      }
+      count_++;
+      generated_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
@@ -0,0 +1,66 @@
+// src/bindings/kem_pool.h
+#ifndef KEM_POOL_H
+#define KEM_POOL_H
+
+#include "secret_arena.h"
+#include <oqs/oqs.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Pre-generated ephemeral keypairs for one KEM. A background thread tops the
+// pool up to the high watermark whenever it drains below the low watermark,
+// so take() is a ring-buffer pop instead of a keygen on the handshake path.
+class KemKeyPairPool {
+public:
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t generated;
+    size_t available;
+    size_t depth;
+    size_t lowWatermark;
+    size_t highWatermark;
+  };
+
+  explicit KemKeyPairPool(const OQS_KEM* kem);
+  ~KemKeyPairPool();
+
+  // Resizes the pool (dropping pooled keys) and restarts the refill thread.
+  // A depth of 0 disables pooling. Watermarks are clamped to the depth.
+  void configure(size_t depth, size_t lowWatermark, size_t highWatermark);
+
+  // Copies the oldest pooled keypair into pk/sk and wipes its slot. Returns
+  // false on a miss (pool empty), in which case the caller generates inline.
+  bool take(uint8_t* pk, uint8_t* sk);
+
+  Stats stats();
+
+private:
+  void start();
+  void stop();
+  void refillLoop();
+  uint8_t* slot(size_t index) { return storage_.get() + index * slotSize_; }
+
+  const OQS_KEM* kem_;
+  size_t slotSize_;
+
+  std::mutex mu_;
+  std::condition_variable wake_;
+  SecretPtr storage_;             // depth_ slots of public key || secret key, arena-backed
+  size_t depth_ = 0;
+  size_t low_ = 0;
+  size_t high_ = 0;
+  size_t head_ = 0;               // oldest pooled slot
+  size_t count_ = 0;              // pooled slots starting at head_
+  bool stopping_ = false;
+  std::thread refill_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> generated_{0};
+};
+
+#endif // KEM_POOL_H
@@ -0,0 +1,57 @@
+// src/bindings/kem_registry.cpp
+#include "kem_registry.h"
+#include <cstring>
+#include <mutex>
+
+// --- string ↔ enum conversion ---
+const KemSpec* find_kem_spec(const char* name, size_t len) {
+  for (const KemSpec& s : KEM_TABLE)
+    if (std::strlen(s.name) == len && std::memcmp(s.name, name, len) == 0) return &s;
+  return nullptr;
+}
+
+PQAlgorithmType string_to_pq_algorithm(const std::string& algo) {
+  if (const KemSpec* s = find_kem_spec(algo.data(), algo.size())) return s->type;
+  if (algo=="dilithium2")   return PQAlgorithmType::DILITHIUM2;
+  if (algo=="dilithium3")   return PQAlgorithmType::DILITHIUM3;
+  if (algo=="dilithium5")   return PQAlgorithmType::DILITHIUM5;
+  return PQAlgorithmType::KYBER768;
+}
+
+// --- KEM registry ---
+struct KemRegistry {
+  OQS_KEM* kems[KEM_COUNT] = {};
+};
+
+static KemRegistry& kem_registry() {
+  // Never destroyed: KemKeyPairPool refill threads (pq_crypto.cpp) may still
+  // be generating keys while other translation units' statics are torn down.
+  static KemRegistry* registry = new KemRegistry();
+  return *registry;
+}
+
+static std::once_flag g_kem_registry_once;
+
+static bool matches_spec(const OQS_KEM* k, const KemSpec& s) {
+  return k->length_public_key == s.publicKey && k->length_secret_key == s.secretKey &&
+         k->length_ciphertext == s.ciphertext && k->length_shared_secret == s.sharedSecret;
+}
+
+void init_kem_registry() {
+  std::call_once(g_kem_registry_once, [] {
+    OQS_init();
+    for (int h = 0; h < KEM_COUNT; h++) {
+      OQS_KEM* k = OQS_KEM_new(KEM_TABLE[h].oqsName);
+      if (k && !matches_spec(k, KEM_TABLE[h])) {
+        OQS_KEM_free(k);
+        k = nullptr;
+      }
+      kem_registry().kems[h] = k;
+    }
+  });
+}
+
+const OQS_KEM* get_kem(int handle) {
+  if (handle < 0 || handle >= KEM_COUNT) return nullptr;
+  return kem_registry().kems[handle];
+}
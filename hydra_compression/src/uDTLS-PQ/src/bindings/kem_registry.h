@@ -0,0 +1,110 @@
+// src/bindings/kem_registry.h
+#ifndef KEM_REGISTRY_H
+#define KEM_REGISTRY_H
+
+#include <oqs/oqs.h>
+#include <array>
+#include <cstddef>
+#include <string>
+
+// PQ algorithm identifiers
+enum class PQAlgorithmType {
+  KYBER512,
+  KYBER768,
+  KYBER1024,
+  DILITHIUM2,
+  DILITHIUM3,
+  DILITHIUM5
+};
+
+// Compile-time description of one KEM level. Sizes come from the liboqs
+// headers, so buffers can be std::arrays and length checks are constants.
+template <PQAlgorithmType A> struct KemTraits;
+
+template <> struct KemTraits<PQAlgorithmType::KYBER512> {
+  static constexpr const char* name = "kyber512";
+  static constexpr const char* oqsName = OQS_KEM_alg_kyber_512;
+  static constexpr size_t publicKey = OQS_KEM_kyber_512_length_public_key;
+  static constexpr size_t secretKey = OQS_KEM_kyber_512_length_secret_key;
+  static constexpr size_t ciphertext = OQS_KEM_kyber_512_length_ciphertext;
+  static constexpr size_t sharedSecret = OQS_KEM_kyber_512_length_shared_secret;
+};
+
+template <> struct KemTraits<PQAlgorithmType::KYBER768> {
+  static constexpr const char* name = "kyber768";
+  static constexpr const char* oqsName = OQS_KEM_alg_kyber_768;
+  static constexpr size_t publicKey = OQS_KEM_kyber_768_length_public_key;
+  static constexpr size_t secretKey = OQS_KEM_kyber_768_length_secret_key;
+  static constexpr size_t ciphertext = OQS_KEM_kyber_768_length_ciphertext;
+  static constexpr size_t sharedSecret = OQS_KEM_kyber_768_length_shared_secret;
+};
+
+template <> struct KemTraits<PQAlgorithmType::KYBER1024> {
+  static constexpr const char* name = "kyber1024";
+  static constexpr const char* oqsName = OQS_KEM_alg_kyber_1024;
+  static constexpr size_t publicKey = OQS_KEM_kyber_1024_length_public_key;
+  static constexpr size_t secretKey = OQS_KEM_kyber_1024_length_secret_key;
+  static constexpr size_t ciphertext = OQS_KEM_kyber_1024_length_ciphertext;
+  static constexpr size_t sharedSecret = OQS_KEM_kyber_1024_length_shared_secret;
+};
+
+struct KemSpec {
+  PQAlgorithmType type;
+  const char* name;      // JS-facing name
+  const char* oqsName;   // OQS_KEM_new identifier
+  size_t publicKey, secretKey, ciphertext, sharedSecret;
+};
+
+template <PQAlgorithmType A>
+constexpr KemSpec kem_spec_of() {
+  using T = KemTraits<A>;
+  return { A, T::name, T::oqsName, T::publicKey, T::secretKey, T::ciphertext, T::sharedSecret };
+}
+
+// The one dispatch table, indexed by handle (the PQAlgorithmType value).
+// A new level is a KemTraits specialization plus an entry here.
+inline constexpr std::array<KemSpec, 3> KEM_TABLE = {
+  kem_spec_of<PQAlgorithmType::KYBER512>(),
+  kem_spec_of<PQAlgorithmType::KYBER768>(),
+  kem_spec_of<PQAlgorithmType::KYBER1024>(),
+};
+
+static constexpr int KEM_COUNT = static_cast<int>(KEM_TABLE.size());
+
+constexpr bool kem_table_is_indexed_by_type() {
+  for (size_t i = 0; i < KEM_TABLE.size(); i++)
+    if (static_cast<size_t>(KEM_TABLE[i].type) != i) return false;
+  return true;
+}
+static_assert(kem_table_is_indexed_by_type(), "KEM_TABLE order must follow PQAlgorithmType");
+
+constexpr size_t kem_table_max(size_t KemSpec::*field) {
+  size_t m = 0;
+  for (const KemSpec& s : KEM_TABLE) if (s.*field > m) m = s.*field;
+  return m;
+}
+
+// Upper bounds for fixed-size storage that must fit any level.
+static constexpr size_t KEM_MAX_PUBLIC_KEY    = kem_table_max(&KemSpec::publicKey);
+static constexpr size_t KEM_MAX_SECRET_KEY    = kem_table_max(&KemSpec::secretKey);
+static constexpr size_t KEM_MAX_CIPHERTEXT    = kem_table_max(&KemSpec::ciphertext);
+static constexpr size_t KEM_MAX_SHARED_SECRET = kem_table_max(&KemSpec::sharedSecret);
+
+// Name lookup without building a std::string; nullptr if unknown.
+const KemSpec* find_kem_spec(const char* name, size_t len);
+
+// Unknown names fall back to KYBER768, as the JS API always has.
+PQAlgorithmType string_to_pq_algorithm(const std::string& algo);
+
+// One prepared OQS_KEM per level, created once and shared by every call
+// for the lifetime of the process. OQS_KEM descriptors are immutable after
+// OQS_KEM_new, so worker threads may use them freely. JS may resolve an
+// algorithm once with kemHandle() and pass the integer handle instead of
+// the name to skip the string lookup on each call.
+void init_kem_registry();
+
+// nullptr for an unknown handle, if liboqs lacks the algorithm, or if its
+// sizes disagree with KEM_TABLE (so fixed-size buffers are always safe).
+const OQS_KEM* get_kem(int handle);
+
+#endif // KEM_REGISTRY_H
@@ -0,0 +1,258 @@
+// src/bindings/metrics.cpp
+#include "metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int MAX_EXPORTS = 128;
+
+// Log-linear histogram over nanoseconds: bucket 0 is everything below
+// 2^MIN_POW, then SUB buckets per power of two up to 2^MAX_POW (~2 min).
+// Four sub-buckets keep percentile error under 25% at 120 counters.
+constexpr int MIN_POW = 7;
+constexpr int MAX_POW = 37;
+constexpr int SUB_BITS = 2;
+constexpr int SUB = 1 << SUB_BITS;
+constexpr int BUCKETS = 1 + (MAX_POW - MIN_POW) * SUB;
+
+int bucket_of(uint64_t ns) {
+  if (ns < (uint64_t(1) << MIN_POW)) return 0;
+  int pow = 63 - __builtin_clzll(ns);
+  if (pow >= MAX_POW) return BUCKETS - 1;
+  int sub = static_cast<int>((ns >> (pow - SUB_BITS)) & (SUB - 1));
+  return 1 + (pow - MIN_POW) * SUB + sub;
+}
+
+// Upper edge of a bucket, used for reported percentiles.
+uint64_t bucket_upper_ns(int b) {
+  if (b == 0) return uint64_t(1) << MIN_POW;
+  int pow = MIN_POW + (b - 1) / SUB;
+  int sub = (b - 1) % SUB;
+  return uint64_t(SUB + sub + 1) << (pow - SUB_BITS);
+}
+
+// Written only by the owning thread (load + store, no RMW); any thread may
+// read. Allocated on the first call of that export on that thread.
+struct Counters {
+  std::atomic<uint64_t> calls{0}, errors{0}, totalNs{0};
+  std::atomic<uint64_t> buckets[BUCKETS] = {};
+};
+
+struct ThreadBlock {
+  std::atomic<Counters*> exports[MAX_EXPORTS] = {};
+  ~ThreadBlock() { for (auto& c : exports) delete c.load(); }
+};
+
+struct Totals {
+  uint64_t calls = 0, errors = 0, totalNs = 0;
+  uint64_t buckets[BUCKETS] = {};
+};
+
+struct ExportSlot {
+  std::string name;
+  napi_callback fn;
+  int id;
+};
+
+std::mutex g_mu;                                   // guards everything below
+std::deque<ExportSlot> g_slots;                    // stable addresses for descriptor data
+std::vector<std::unique_ptr<ThreadBlock>> g_blocks;
+std::vector<ThreadBlock*> g_idle_blocks;           // left behind by exited threads
+std::vector<Totals> g_baseline(MAX_EXPORTS);
+Clock::time_point g_since = Clock::now();
+
+// A block outlives its thread and is handed to the next new thread, so
+// exited worker threads keep their counts without growing the list.
+struct ThreadBlockLease {
+  ThreadBlock* block = nullptr;
+  ~ThreadBlockLease() {
+    if (!block) return;
+    std::lock_guard<std::mutex> lock(g_mu);
+    g_idle_blocks.push_back(block);
+  }
+};
+
+thread_local ThreadBlockLease t_lease;
+
+ThreadBlock* this_thread_block() {
+  if (t_lease.block) return t_lease.block;
+  std::lock_guard<std::mutex> lock(g_mu);
+  if (!g_idle_blocks.empty()) {
+    t_lease.block = g_idle_blocks.back();
+    g_idle_blocks.pop_back();
+  } else {
+    g_blocks.emplace_back(new ThreadBlock());
+    t_lease.block = g_blocks.back().get();
+  }
+  return t_lease.block;
+}
+
+inline void bump(std::atomic<uint64_t>& c, uint64_t by) {
+  c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+void record(int id, uint64_t ns, bool failed) {
+  ThreadBlock* block = this_thread_block();
+  Counters* c = block->exports[id].load(std::memory_order_acquire);
+  if (!c) {
+    c = new Counters();
+    block->exports[id].store(c, std::memory_order_release);
+  }
+  bump(c->calls, 1);
+  if (failed) bump(c->errors, 1);
+  bump(c->totalNs, ns);
+  bump(c->buckets[bucket_of(ns)], 1);
+}
+
+napi_value Instrumented(napi_env env, napi_callback_info info) {
+  void* data = nullptr;
+  napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data);
+  const ExportSlot* slot = static_cast<const ExportSlot*>(data);
+
+  auto start = Clock::now();
+  napi_value result = slot->fn(env, info);
+  uint64_t ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+  bool pending = false;
+  napi_is_exception_pending(env, &pending);
+  record(slot->id, ns, pending);
+  return result;
+}
+
+// Caller holds g_mu.
+void merge_locked(std::vector<Totals>& out) {
+  out.assign(g_slots.size(), Totals());
+  for (auto& block : g_blocks) {
+    for (size_t id = 0; id < g_slots.size(); id++) {
+      Counters* c = block->exports[id].load(std::memory_order_acquire);
+      if (!c) continue;
+      Totals& t = out[id];
+      t.calls += c->calls.load(std::memory_order_relaxed);
+      t.errors += c->errors.load(std::memory_order_relaxed);
+      t.totalNs += c->totalNs.load(std::memory_order_relaxed);
+      for (int b = 0; b < BUCKETS; b++) t.buckets[b] += c->buckets[b].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+double percentile_us(const uint64_t* buckets, uint64_t calls, double p) {
+  uint64_t rank = static_cast<uint64_t>(p * calls);
+  if (rank >= calls) rank = calls - 1;
+  uint64_t seen = 0;
+  for (int b = 0; b < BUCKETS; b++) {
+    seen += buckets[b];
+    if (seen > rank) return bucket_upper_ns(b) / 1000.0;
+  }
+  return bucket_upper_ns(BUCKETS - 1) / 1000.0;
+}
+
+void set_number(napi_env env, napi_value obj, const char* key, double v) {
+  napi_value n;
+  napi_create_double(env, v, &n);
+  napi_set_named_property(env, obj, key, n);
+}
+
+} // namespace
+
+void metrics_instrument(napi_property_descriptor* descs, size_t count) {
+  std::lock_guard<std::mutex> lock(g_mu);
+  for (size_t i = 0; i < count; i++) {
+    napi_property_descriptor& d = descs[i];
+    if (!d.method || d.data || !d.utf8name) continue;
+
+    ExportSlot* slot = nullptr;
+    for (auto& s : g_slots) {
+      if (s.name == d.utf8name) { slot = &s; break; }
+    }
+    if (!slot) {
+      if (g_slots.size() >= MAX_EXPORTS) continue;  // left uninstrumented
+      g_slots.push_back({ d.utf8name, d.method, static_cast<int>(g_slots.size()) });
+      slot = &g_slots.back();
+    }
+    d.method = Instrumented;
+    d.data = slot;
+  }
+}
+
+// getMetrics() -> { sinceMs, exports: { name: { calls, errors, totalMs,
+//                   meanUs, p50Us, p90Us, p99Us, maxUs } } }
+// Only exports called since the last reset are listed. Percentiles are
+// bucket upper edges.
+napi_value GetMetrics(napi_env env, napi_callback_info info) {
+  std::vector<Totals> totals;
+  std::vector<std::string> names;
+  double since_ms;
+  {
+    std::lock_guard<std::mutex> lock(g_mu);
+    merge_locked(totals);
+    for (size_t id = 0; id < totals.size(); id++) {
+      const Totals& base = g_baseline[id];
+      Totals& t = totals[id];
+      t.calls -= base.calls;
+      t.errors -= base.errors;
+      t.totalNs -= base.totalNs;
+      for (int b = 0; b < BUCKETS; b++) t.buckets[b] -= base.buckets[b];
+      names.push_back(g_slots[id].name);
+    }
+    since_ms = std::chrono::duration<double, std::milli>(Clock::now() - g_since).count();
+  }
+
+  napi_value result, exports;
+  napi_create_object(env, &result);
+  napi_create_object(env, &exports);
+  set_number(env, result, "sinceMs", since_ms);
+
+  for (size_t id = 0; id < totals.size(); id++) {
+    const Totals& t = totals[id];
+    if (t.calls == 0) continue;
+
+    int max_bucket = 0;
+    for (int b = 0; b < BUCKETS; b++) if (t.buckets[b]) max_bucket = b;
+
+    napi_value entry;
+    napi_create_object(env, &entry);
+    set_number(env, entry, "calls", static_cast<double>(t.calls));
+    set_number(env, entry, "errors", static_cast<double>(t.errors));
+    set_number(env, entry, "totalMs", t.totalNs / 1e6);
+    set_number(env, entry, "meanUs", t.totalNs / 1e3 / t.calls);
+    set_number(env, entry, "p50Us", percentile_us(t.buckets, t.calls, 0.50));
+    set_number(env, entry, "p90Us", percentile_us(t.buckets, t.calls, 0.90));
+    set_number(env, entry, "p99Us", percentile_us(t.buckets, t.calls, 0.99));
+    set_number(env, entry, "maxUs", bucket_upper_ns(max_bucket) / 1000.0);
+    napi_set_named_property(env, exports, names[id].c_str(), entry);
+  }
+  napi_set_named_property(env, result, "exports", exports);
+  return result;
+}
+
+// resetMetrics(): later getMetrics() calls only count calls made after this.
+napi_value ResetMetrics(napi_env env, napi_callback_info info) {
+  std::lock_guard<std::mutex> lock(g_mu);
+  std::vector<Totals> totals;
+  merge_locked(totals);
+  for (size_t id = 0; id < totals.size(); id++) g_baseline[id] = totals[id];
+  g_since = Clock::now();
+
+  napi_value undefined;
+  napi_get_undefined(env, &undefined);
+  return undefined;
+}
+
+napi_value InitMetrics(napi_env env, napi_value exports) {
+  napi_property_descriptor desc[] = {
+    { "getMetrics",   nullptr, GetMetrics,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "resetMetrics", nullptr, ResetMetrics, nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc);
+  return exports;
+}
@@ -0,0 +1,28 @@
+// src/bindings/metrics.h
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <node_api.h>
+#include <cstddef>
+
+// Always-on call metrics for N-API exports. metrics_instrument() swaps each
+// descriptor's callback for a trampoline that times the call and records it
+// in a block owned by the calling thread, so the hot path is a handful of
+// uncontended relaxed stores. getMetrics() merges every thread's block on
+// demand; resetMetrics() moves the baseline rather than touching live
+// counters.
+//
+// Latency is the time spent inside the export on the JS thread. For the
+// Promise-returning variants that is the submission cost, not the work.
+
+// Instruments every descriptor with a method and no data pointer. Safe to
+// call once per env: an export name maps to the same slot every time.
+void metrics_instrument(napi_property_descriptor* descs, size_t count);
+
+napi_value GetMetrics  (napi_env env, napi_callback_info info);
+napi_value ResetMetrics(napi_env env, napi_callback_info info);
+
+// Registers getMetrics/resetMetrics (called from openssl.cpp)
+napi_value InitMetrics(napi_env env, napi_value exports);
+
+#endif // METRICS_H
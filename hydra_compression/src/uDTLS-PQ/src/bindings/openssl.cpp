@@ -1,14 +1,29 @@
 // src/bindings/openssl.cpp
 #include "openssl.h"
 #include "pq_crypto.h"  // Include pq_crypto.h to access InitPQCrypto
+#include "dgram_bio.h"
+#include "handle_table.h"
+#include "udp_socket.h"
+#include "dtls_server.h"
+#include "metrics.h"
+#include "identity_cache.h"
+#include "context_pool.h"
+#include "aead.h"
+#include "ost_codec.h"
+#include "ost_pack.h"
+#include "ost_stream.h"
+#include "universal_codec.h"
+#include "blake3.h"
 #include <node_api.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <openssl/crypto.h>
 #include <iostream>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
-#include <map>
+#include <netinet/in.h>
 
 // ----- tiny helper so we can write DECLARE_NAPI_METHOD("foo", Foo) -----
 #ifndef DECLARE_NAPI_METHOD
@@ -18,182 +33,197 @@
 
 
 // Mapping between our handles and the actual OpenSSL objects
-static std::map<int, std::shared_ptr<SSLContextWrapper>> g_contexts;
-static std::map<int, std::shared_ptr<SSLSessionWrapper>> g_sessions;
-static int next_id = 1;
+static HandleTable<SSLContextWrapper> g_contexts;
+static HandleTable<SSLSessionWrapper> g_sessions;
 
-// Initialize OpenSSL
-void init_openssl() {
-  SSL_library_init();
-  OpenSSL_add_all_algorithms();
-  SSL_load_error_strings();
-  ERR_load_crypto_strings();
+std::shared_ptr<SSLContextWrapper> find_context(int id) {
+  return g_contexts.get(id);
 }
 
-// Clean up OpenSSL
-void cleanup_openssl() {
-  ERR_free_strings();
-  EVP_cleanup();
-  CRYPTO_cleanup_all_ex_data();
-}
-
-// SSL Context wrapper implementation
-SSLContextWrapper::SSLContextWrapper() : ctx_(nullptr), ocspStaplingEnabled_(false), certTransparencyEnabled_(false) {}
-
-SSLContextWrapper::SSLContextWrapper(SSL_CTX* ctx) : ctx_(ctx), ocspStaplingEnabled_(false), certTransparencyEnabled_(false) {}
-
-SSLContextWrapper::~SSLContextWrapper() {
-  if (ctx_) {
-    SSL_CTX_free(ctx_);
-    ctx_ = nullptr;
+// cert/key option: a Buffer holds PEM or DER, a string holding PEM text is
+// used as is, and any other string is a file path.
+struct IdentityArg {
+  bool present = false;
+  const uint8_t* data = nullptr;
+  size_t len = 0;
+  std::string text;            // string value
+  std::vector<uint8_t> file;   // contents when text is a path
+
+  ~IdentityArg() {
+    OPENSSL_cleanse(&text[0], text.size());
+    OPENSSL_cleanse(file.data(), file.size());
   }
-}
-
-// Implementation of enableOCSPStapling
-void SSLContextWrapper::enableOCSPStapling(bool enable) {
-  ocspStaplingEnabled_ = enable;
-  
-  // In newer OpenSSL versions, we would use SSL_CTX_set_tlsext_status_cb
-  // But for compatibility, we'll use a different approach
-  if (enable) {
-    // Set up OCSP stapling (implementation depends on OpenSSL version)
-    // For newer versions of OpenSSL, you might use:
-    // SSL_CTX_set_tlsext_status_cb(ctx_, ocsp_status_callback);
-    // SSL_CTX_set_tlsext_status_arg(ctx_, ctx_);
-    
-    // For compatibility, we'll use the SSL_CONF approach
-    SSL_CONF_CTX *cctx = SSL_CONF_CTX_new();
-    SSL_CONF_CTX_set_flags(cctx, SSL_CONF_FLAG_CLIENT);
-    SSL_CONF_CTX_set_ssl_ctx(cctx, ctx_);
-    SSL_CONF_cmd(cctx, "Options", "StatusRequest");
-    SSL_CONF_CTX_free(cctx);
+};
+
+static bool get_identity_option(napi_env env, napi_value options, const char* name, IdentityArg& out) {
+  bool has = false;
+  napi_has_named_property(env, options, name, &has);
+  if (!has) return true;
+  napi_value v;
+  napi_valuetype type;
+  if (napi_get_named_property(env, options, name, &v) != napi_ok) return false;
+  napi_typeof(env, v, &type);
+  if (type == napi_undefined || type == napi_null) return true;
+
+  bool is_buffer = false;
+  napi_is_buffer(env, v, &is_buffer);
+  if (is_buffer) {
+    void* data;
+    napi_get_buffer_info(env, v, &data, &out.len);
+    out.data = static_cast<const uint8_t*>(data);
+  } else if (type == napi_string) {
+    size_t len = 0;
+    napi_get_value_string_utf8(env, v, nullptr, 0, &len);
+    out.text.resize(len + 1);
+    napi_get_value_string_utf8(env, v, &out.text[0], len + 1, &len);
+    out.text.resize(len);
+    if (out.text.find("-----BEGIN") != std::string::npos) {
+      out.data = reinterpret_cast<const uint8_t*>(out.text.data());
+      out.len = out.text.size();
+    } else {
+      if (!read_file_bytes(out.text.c_str(), out.file)) return false;
+      out.data = out.file.data();
+      out.len = out.file.size();
+    }
+  } else {
+    return false;
   }
+  out.present = true;
+  return true;
 }
 
-// Implementation of enableCertTransparency
-void SSLContextWrapper::enableCertTransparency(bool enable) {
-  certTransparencyEnabled_ = enable;
-  // Certificate Transparency implementation would go here
-  // This is typically done via custom verification callbacks
-}
-
-// Implementation of addCRLDistributionPoint
-void SSLContextWrapper::addCRLDistributionPoint(const std::string& uri) {
-  crlPoints_.push_back(uri);
-  // In a full implementation, we would set up CRL checking with these URIs
-}
-
-// Implementation of addCertificatePolicy
-void SSLContextWrapper::addCertificatePolicy(const std::string& policyOID) {
-  policies_.push_back(policyOID);
-  // In a full implementation, we would configure policy checking
-}
-
-// SSL Session wrapper implementation
-SSLSessionWrapper::SSLSessionWrapper(SSL_CTX* ctx) : ssl_(nullptr) {
-  if (ctx) {
-    ssl_ = SSL_new(ctx);
+// Options understood by createContext and getSharedContext. Throws and
+// returns false on a malformed cert/key; unknown or mistyped settings are
+// left at their defaults.
+static bool get_context_options(napi_env env, napi_value options, ContextConfig& config,
+                                IdentityArg& cert, IdentityArg& key) {
+  napi_value prop_value;
+  napi_valuetype type;
+
+  // Check if it's a server
+  if (napi_get_named_property(env, options, "isServer", &prop_value) == napi_ok) {
+    napi_get_value_bool(env, prop_value, &config.isServer);
   }
-}
 
-SSLSessionWrapper::~SSLSessionWrapper() {
-  if (ssl_) {
-    SSL_free(ssl_);
-    ssl_ = nullptr;
+  // cert / key: Buffer (PEM or DER), PEM string, or file path
+  if (!get_identity_option(env, options, "cert", cert) ||
+      !get_identity_option(env, options, "key", key)) {
+    napi_throw_error(env, nullptr, "cert and key must be Buffers, PEM strings or readable paths");
+    return false;
   }
-}
-
-// Create a DTLS context
-SSL_CTX* create_dtls_context(bool is_server) {
-  // For OpenSSL 3.0+
-  const SSL_METHOD* method = is_server ? DTLS_server_method() : DTLS_client_method();
-  SSL_CTX* ctx = SSL_CTX_new(method);
-
-  if (!ctx) {
-    std::cerr << "Error creating SSL context" << std::endl;
-    ERR_print_errors_fp(stderr);
-    return nullptr;
+  if (cert.present && key.present) {
+    config.cert = cert.data;
+    config.certLen = cert.len;
+    config.key = key.data;
+    config.keyLen = key.len;
   }
 
-  // Set default options
-  SSL_CTX_set_options(ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1);
-
-  return ctx;
-}
-
-// Set certificates for the context
-bool set_certificates(SSL_CTX* ctx, const char* cert_path, const char* key_path) {
-  if (!ctx) return false;
-
-  if (cert_path && SSL_CTX_use_certificate_file(ctx, cert_path, SSL_FILETYPE_PEM) <= 0) {
-    ERR_print_errors_fp(stderr);
-    return false;
+  // ciphers: OpenSSL cipher names
+  bool is_array = false;
+  if (napi_get_named_property(env, options, "ciphers", &prop_value) == napi_ok &&
+      napi_is_array(env, prop_value, &is_array) == napi_ok && is_array) {
+    uint32_t n = 0;
+    napi_get_array_length(env, prop_value, &n);
+    for (uint32_t i = 0; i < n; i++) {
+      napi_value item;
+      char buffer[256];
+      size_t len = 0;
+      napi_get_element(env, prop_value, i, &item);
+      if (napi_get_value_string_utf8(env, item, buffer, sizeof(buffer), &len) == napi_ok)
+        config.ciphers.emplace_back(buffer, len);
+    }
   }
 
-  if (key_path && SSL_CTX_use_PrivateKey_file(ctx, key_path, SSL_FILETYPE_PEM) <= 0) {
-    ERR_print_errors_fp(stderr);
-    return false;
+  // pqSuite: same names as setPQCipherSuites
+  if (napi_get_named_property(env, options, "pqSuite", &prop_value) == napi_ok) {
+    char buffer[32];
+    size_t len = 0;
+    if (napi_get_value_string_utf8(env, prop_value, buffer, sizeof(buffer), &len) == napi_ok)
+      config.pqSuite.assign(buffer, len);
   }
 
-  if (cert_path && key_path && !SSL_CTX_check_private_key(ctx)) {
-    std::cerr << "Private key does not match the certificate" << std::endl;
-    return false;
+  // minVersion / maxVersion / verifyMode: OpenSSL constants, as for the setters
+  const std::pair<const char*, int*> ints[] = {
+    { "minVersion", &config.minVersion },
+    { "maxVersion", &config.maxVersion },
+    { "verifyMode", &config.verifyMode },
+  };
+  for (auto& f : ints) {
+    if (napi_get_named_property(env, options, f.first, &prop_value) == napi_ok &&
+        napi_typeof(env, prop_value, &type) == napi_ok && type == napi_number)
+      napi_get_value_int32(env, prop_value, f.second);
   }
 
-  return true;
-}
-
-// Set cipher list for the context
-void set_cipher_list(SSL_CTX* ctx, const std::vector<std::string>& ciphers) {
-  if (!ctx || ciphers.empty()) return;
-
-  std::string cipher_list;
-  for (const auto& cipher : ciphers) {
-    if (!cipher_list.empty()) cipher_list += ":";
-    cipher_list += cipher;
+  // sessionCache: true | { size?, ttlSeconds?, shards?, tickets?, ticketRotateSeconds? }
+  bool has_cache = false;
+  napi_has_named_property(env, options, "sessionCache", &has_cache);
+  if (has_cache && napi_get_named_property(env, options, "sessionCache", &prop_value) == napi_ok) {
+    napi_typeof(env, prop_value, &type);
+    SessionCacheOptions& cache_opts = config.sessionCacheOptions;
+    bool flag = false;
+    if (type == napi_boolean) {
+      napi_get_value_bool(env, prop_value, &flag);
+      config.sessionCache = flag;
+    } else if (type == napi_object) {
+      config.sessionCache = true;
+      const std::pair<const char*, long*> numbers[] = {
+        { "ttlSeconds", &cache_opts.ttlSeconds },
+        { "ticketRotateSeconds", &cache_opts.ticketRotateSeconds },
+      };
+      napi_value v;
+      int64_t n;
+      for (auto& f : numbers) {
+        if (napi_get_named_property(env, prop_value, f.first, &v) == napi_ok &&
+            napi_get_value_int64(env, v, &n) == napi_ok && n > 0)
+          *f.second = static_cast<long>(n);
+      }
+      if (napi_get_named_property(env, prop_value, "size", &v) == napi_ok &&
+          napi_get_value_int64(env, v, &n) == napi_ok && n > 0)
+        cache_opts.capacity = static_cast<size_t>(n);
+      if (napi_get_named_property(env, prop_value, "shards", &v) == napi_ok &&
+          napi_get_value_int64(env, v, &n) == napi_ok && n > 0)
+        cache_opts.shards = static_cast<size_t>(std::min<int64_t>(n, 256));
+      if (napi_get_named_property(env, prop_value, "tickets", &v) == napi_ok &&
+          napi_get_value_bool(env, v, &flag) == napi_ok)
+        cache_opts.tickets = flag;
+    }
   }
 
-  SSL_CTX_set_cipher_list(ctx, cipher_list.c_str());
+  // cookieExchange: true | { rotateSeconds? }
+  bool has_cookies = false;
+  napi_has_named_property(env, options, "cookieExchange", &has_cookies);
+  if (has_cookies && napi_get_named_property(env, options, "cookieExchange", &prop_value) == napi_ok) {
+    napi_typeof(env, prop_value, &type);
+    if (type == napi_boolean) {
+      napi_get_value_bool(env, prop_value, &config.cookieExchange);
+    } else if (type == napi_object) {
+      config.cookieExchange = true;
+      napi_value v;
+      int64_t n;
+      if (napi_get_named_property(env, prop_value, "rotateSeconds", &v) == napi_ok &&
+          napi_get_value_int64(env, v, &n) == napi_ok && n > 0)
+        config.cookieOptions.rotateSeconds = static_cast<long>(n);
+    }
+  }
+  return true;
 }
 
 // NAPI implementation for CreateContext
+// A private, mutable context: only isServer, cert/key, sessionCache and
+// cookieExchange are applied here; the rest go through the setters.
 napi_value CreateContext(napi_env env, napi_callback_info info) {
   size_t argc = 1;
   napi_value args[1];
   napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
-  bool is_server = false;
-  std::string cert_path, key_path;
+  ContextConfig config;
+  IdentityArg cert, key;
 
   // Parse options object
-  if (argc > 0) {
-    napi_value options = args[0];
-    napi_value prop_value;
-
-    // Check if it's a server
-    if (napi_get_named_property(env, options, "isServer", &prop_value) == napi_ok) {
-      napi_get_value_bool(env, prop_value, &is_server);
-    }
-
-    // Get cert path
-    if (napi_get_named_property(env, options, "cert", &prop_value) == napi_ok) {
-      char buffer[1024];
-      size_t result;
-      napi_get_value_string_utf8(env, prop_value, buffer, sizeof(buffer), &result);
-      cert_path = std::string(buffer, result);
-    }
-
-    // Get key path
-    if (napi_get_named_property(env, options, "key", &prop_value) == napi_ok) {
-      char buffer[1024];
-      size_t result;
-      napi_get_value_string_utf8(env, prop_value, buffer, sizeof(buffer), &result);
-      key_path = std::string(buffer, result);
-    }
-  }
+  if (argc > 0 && !get_context_options(env, args[0], config, cert, key)) return nullptr;
 
   // Create OpenSSL context
-  SSL_CTX* ctx = create_dtls_context(is_server);
+  SSL_CTX* ctx = create_dtls_context(config.isServer);
   if (!ctx) {
     napi_throw_error(env, nullptr, "Failed to create DTLS context");
     napi_value result;
@@ -202,8 +232,8 @@ napi_value CreateContext(napi_env env, napi_callback_info info) {
   }
 
   // Set certificates if provided
-  if (!cert_path.empty() && !key_path.empty()) {
-    if (!set_certificates(ctx, cert_path.c_str(), key_path.c_str())) {
+  if (config.cert && config.key) {
+    if (!set_certificates_from_memory(ctx, config.cert, config.certLen, config.key, config.keyLen)) {
       SSL_CTX_free(ctx);
       napi_throw_error(env, nullptr, "Failed to set certificates");
       napi_value result;
@@ -212,9 +242,22 @@ napi_value CreateContext(napi_env env, napi_callback_info info) {
     }
   }
 
-  // Store context in our map
-  int id = next_id++;
-  g_contexts[id] = std::make_shared<SSLContextWrapper>(ctx);
+  auto wrapper = std::make_shared<SSLContextWrapper>(ctx);
+  if (config.sessionCache && config.isServer && !wrapper->enableSessionCache(config.sessionCacheOptions)) {
+    napi_throw_error(env, nullptr, "Failed to set up session cache");
+    return nullptr;
+  }
+  if (config.cookieExchange && config.isServer && !wrapper->enableCookieExchange(config.cookieOptions)) {
+    napi_throw_error(env, nullptr, "Failed to set up cookie exchange");
+    return nullptr;
+  }
+
+  // Store context in the handle table
+  int id = g_contexts.insert(wrapper);
+  if (!id) {
+    napi_throw_error(env, nullptr, "Too many contexts");
+    return nullptr;
+  }
 
   // Create and return the context handle
   napi_value result;
@@ -227,6 +270,42 @@ napi_value CreateContext(napi_env env, napi_callback_info info) {
   return result;
 }
 
+// NAPI implementation for GetSharedContext
+// Applies the whole option set at once and returns a frozen context shared
+// with every other caller that asked for the same settings: { id, shared }.
+// Each call gets its own handle; freeContext releases just that handle.
+napi_value GetSharedContext(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  ContextConfig config;
+  IdentityArg cert, key;
+  if (argc > 0 && !get_context_options(env, args[0], config, cert, key)) return nullptr;
+
+  std::string error;
+  bool reused = false;
+  std::shared_ptr<SSLContextWrapper> wrapper = ContextPool::shared().acquire(config, error, &reused);
+  if (!wrapper) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+
+  int id = g_contexts.insert(wrapper);
+  if (!id) {
+    napi_throw_error(env, nullptr, "Too many contexts");
+    return nullptr;
+  }
+
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  napi_get_boolean(env, reused, &v);
+  napi_set_named_property(env, result, "shared", v);
+  return result;
+}
+
 // NAPI implementation for FreeContext
 napi_value FreeContext(napi_env env, napi_callback_info info) {
   size_t argc = 1;
@@ -248,17 +327,14 @@ napi_value FreeContext(napi_env env, napi_callback_info info) {
   int id;
   napi_get_value_int32(env, id_value, &id);
 
-  // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  // Remove context; sessions already created keep their SSL_CTX reference
+  if (!g_contexts.remove(id)) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
 
-  // Remove context from map
-  g_contexts.erase(id);
-
   napi_value result;
   napi_get_boolean(env, true, &result);
   return result;
@@ -286,12 +362,19 @@ napi_value SetCipherSuites(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get cipher suites array
   napi_value cipher_suites_array = args[1];
@@ -322,7 +405,7 @@ napi_value SetCipherSuites(napi_env env, napi_callback_info info) {
   }
 
   // Set cipher list
-  SSL_CTX* ctx = g_contexts[id]->get();
+  SSL_CTX* ctx = context->get();
   set_cipher_list(ctx, ciphers);
 
   napi_value result;
@@ -352,19 +435,26 @@ napi_value SSLContextSetCertTransparency(napi_env env, napi_callback_info info)
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get enable flag
   bool enable;
   napi_get_value_bool(env, args[1], &enable);
 
   // Enable cert transparency
-  g_contexts[id]->enableCertTransparency(enable);
+  context->enableCertTransparency(enable);
 
   napi_value result;
   napi_get_boolean(env, true, &result);
@@ -393,12 +483,19 @@ napi_value SSLContextAddCRLDistributionPoint(napi_env env, napi_callback_info in
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get URI
   char uri[1024];
@@ -407,7 +504,7 @@ napi_value SSLContextAddCRLDistributionPoint(napi_env env, napi_callback_info in
   std::string uri_str(uri, uri_len);
 
   // Add CRL distribution point
-  g_contexts[id]->addCRLDistributionPoint(uri_str);
+  context->addCRLDistributionPoint(uri_str);
 
   napi_value result;
   napi_get_boolean(env, true, &result);
@@ -436,19 +533,26 @@ napi_value SSLContextEnableOCSPStapling(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get enable flag
   bool enable;
   napi_get_value_bool(env, args[1], &enable);
 
   // Enable OCSP stapling
-  g_contexts[id]->enableOCSPStapling(enable);
+  context->enableOCSPStapling(enable);
 
   napi_value result;
   napi_get_boolean(env, true, &result);
@@ -477,12 +581,19 @@ napi_value SSLContextAddCertificatePolicy(napi_env env, napi_callback_info info)
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get policy OID
   char policy[256];
@@ -491,7 +602,7 @@ napi_value SSLContextAddCertificatePolicy(napi_env env, napi_callback_info info)
   std::string policy_str(policy, policy_len);
 
   // Add certificate policy
-  g_contexts[id]->addCertificatePolicy(policy_str);
+  context->addCertificatePolicy(policy_str);
 
   napi_value result;
   napi_get_boolean(env, true, &result);
@@ -520,12 +631,19 @@ napi_value SetPQCipherSuites(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get PQ algorithm type
   napi_value pq_algo_value = args[1];
@@ -534,61 +652,14 @@ napi_value SetPQCipherSuites(napi_env env, napi_callback_info info) {
   napi_get_value_string_utf8(env, pq_algo_value, pq_algo_str, sizeof(pq_algo_str), &pq_algo_len);
   std::string pq_algo(pq_algo_str, pq_algo_len);
 
-  // Get the SSL context
-  SSL_CTX* ctx = g_contexts[id]->get();
-
-  // Set appropriate post-quantum TLS groups and signature algorithms based on the requested algorithm
-  if (pq_algo == "kyber512") {
-    // For Kyber512, use appropriate groups
-    if (SSL_CTX_set1_groups_list(ctx, "kyber512") != 1) {
-      napi_throw_error(env, nullptr, "Failed to set Kyber512 groups");
-      napi_value result;
-      napi_get_boolean(env, false, &result);
-      return result;
-    }
-  } else if (pq_algo == "kyber768") {
-    // For Kyber768, use appropriate groups
-    if (SSL_CTX_set1_groups_list(ctx, "kyber768") != 1) {
-      napi_throw_error(env, nullptr, "Failed to set Kyber768 groups");
-      napi_value result;
-      napi_get_boolean(env, false, &result);
-      return result;
-    }
-  } else if (pq_algo == "hybrid") {
-    // For hybrid mode, use both classical and PQ groups with preference for PQ
-    if (SSL_CTX_set1_groups_list(ctx, "kyber768:x25519:kyber512:secp384r1") != 1) {
-      napi_throw_error(env, nullptr, "Failed to set hybrid groups");
-      napi_value result;
-      napi_get_boolean(env, false, &result);
-      return result;
-    }
-  }
-
-  // Set signature algorithms if Dilithium is requested
-  if (pq_algo == "dilithium2" || pq_algo == "dilithium3" || pq_algo == "hybrid") {
-    // Set signature algorithms with preference for Dilithium
-    if (SSL_CTX_set1_sigalgs_list(ctx, "dilithium3:dilithium2:RSA+SHA256:ECDSA+SHA256") != 1) {
-      napi_throw_error(env, nullptr, "Failed to set PQ signature algorithms");
-      napi_value result;
-      napi_get_boolean(env, false, &result);
-      return result;
-    }
+  // Groups, signature algorithms and PQ-friendly ciphers
+  if (const char* err = set_pq_suite(context->get(), pq_algo)) {
+    napi_throw_error(env, nullptr, err);
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
   }
 
-  // Set DTLS cipher suites that work well with PQ algorithms
-  // Use modern AEAD ciphers with PQ key exchange
-  std::vector<std::string> pq_compatible_ciphers = {
-    "TLS_AES_256_GCM_SHA384",
-    "TLS_AES_128_GCM_SHA256",
-    "TLS_CHACHA20_POLY1305_SHA256",
-    "ECDHE-RSA-AES256-GCM-SHA384",
-    "ECDHE-RSA-AES128-GCM-SHA256",
-    "ECDHE-RSA-CHACHA20-POLY1305"
-  };
-
-  // Set the cipher list
-  set_cipher_list(ctx, pq_compatible_ciphers);
-
   napi_value result;
   napi_get_boolean(env, true, &result);
   return result;
@@ -616,19 +687,26 @@ napi_value SetVerifyMode(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get verify mode
   int mode;
   napi_get_value_int32(env, args[1], &mode);
 
   // Set verify mode
-  SSL_CTX* ctx = g_contexts[id]->get();
+  SSL_CTX* ctx = context->get();
   SSL_CTX_set_verify(ctx, mode, nullptr);
 
   napi_value result;
@@ -658,12 +736,19 @@ napi_value SetMinMaxVersion(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, id_value, &id);
 
   // Check if context exists
-  if (g_contexts.find(id) == g_contexts.end()) {
+  auto context = g_contexts.get(id);
+  if (!context) {
     napi_throw_error(env, nullptr, "Invalid context");
     napi_value result;
     napi_get_boolean(env, false, &result);
     return result;
   }
+  if (context->frozen()) {
+    napi_throw_error(env, nullptr, "Context is shared and immutable");
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    return result;
+  }
 
   // Get min and max versions
   int min_version, max_version;
@@ -671,7 +756,7 @@ napi_value SetMinMaxVersion(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, args[2], &max_version);
 
   // Set min and max versions
-  SSL_CTX* ctx = g_contexts[id]->get();
+  SSL_CTX* ctx = context->get();
   SSL_CTX_set_min_proto_version(ctx, min_version);
   SSL_CTX_set_max_proto_version(ctx, max_version);
 
@@ -702,7 +787,8 @@ napi_value GetError(napi_env env, napi_callback_info info) {
   napi_get_value_int32(env, id_value, &id);
 
   // Check if session exists
-  if (g_sessions.find(id) == g_sessions.end()) {
+  auto session = g_sessions.get(id);
+  if (!session) {
     napi_throw_error(env, nullptr, "Invalid session");
     napi_value result;
     napi_create_string_utf8(env, "Invalid session", NAPI_AUTO_LENGTH, &result);
@@ -727,6 +813,520 @@ napi_value GetVersion(napi_env env, napi_callback_info info) {
   return result;
 }
 
+// ----- DTLS record path -----
+// Sessions own a datagram memory BIO. JS hands over each received datagram
+// and gets back, in the same call, any plaintext plus the datagrams it must
+// send; nothing in the native layer touches a socket.
+
+static std::shared_ptr<SSLSessionWrapper> get_session_arg(napi_env env, napi_value session_obj) {
+  napi_value id_value;
+  int id = 0;
+  if (napi_get_named_property(env, session_obj, "id", &id_value) != napi_ok ||
+      napi_get_value_int32(env, id_value, &id) != napi_ok) {
+    napi_throw_error(env, nullptr, "Invalid session");
+    return nullptr;
+  }
+
+  auto session = g_sessions.get(id);
+  if (!session) napi_throw_error(env, nullptr, "Invalid session");
+  return session;
+}
+
+// { handshakeComplete, closed, timeoutMs, datagrams: Buffer[], data?: Buffer, error?: string }
+static napi_value dtls_result_to_js(napi_env env, DtlsStepResult& r) {
+  napi_value out, v, list;
+  napi_create_object(env, &out);
+
+  napi_get_boolean(env, r.handshakeComplete, &v);
+  napi_set_named_property(env, out, "handshakeComplete", v);
+  napi_get_boolean(env, r.closed, &v);
+  napi_set_named_property(env, out, "closed", v);
+  napi_create_int64(env, r.timeoutMs, &v);
+  napi_set_named_property(env, out, "timeoutMs", v);
+
+  napi_create_array_with_length(env, r.datagrams.size(), &list);
+  for (size_t i = 0; i < r.datagrams.size(); i++) {
+    napi_create_buffer_copy(env, r.datagrams[i].size(), r.datagrams[i].data(), nullptr, &v);
+    napi_set_element(env, list, static_cast<uint32_t>(i), v);
+  }
+  napi_set_named_property(env, out, "datagrams", list);
+
+  if (!r.plaintext.empty()) {
+    napi_create_buffer_copy(env, r.plaintext.size(), r.plaintext.data(), nullptr, &v);
+    napi_set_named_property(env, out, "data", v);
+  }
+  if (!r.error.empty()) {
+    napi_create_string_utf8(env, r.error.c_str(), NAPI_AUTO_LENGTH, &v);
+    napi_set_named_property(env, out, "error", v);
+  }
+  return out;
+}
+
+// NAPI implementation for CreateSession
+napi_value CreateSession(napi_env env, napi_callback_info info) {
+  // Parse arguments: [context, { mtu? }?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  // Get context ID
+  napi_value id_value;
+  napi_get_named_property(env, args[0], "id", &id_value);
+
+  int ctx_id;
+  napi_get_value_int32(env, id_value, &ctx_id);
+
+  // Check if context exists
+  auto context = g_contexts.get(ctx_id);
+  if (!context) {
+    napi_throw_error(env, nullptr, "Invalid context");
+    return nullptr;
+  }
+
+  auto session = std::make_shared<SSLSessionWrapper>(context->get());
+  if (!session->get()) {
+    napi_throw_error(env, nullptr, "Failed to create DTLS session");
+    return nullptr;
+  }
+
+  long mtu = 1400;
+  if (argc >= 2) {
+    napi_value mtu_value;
+    bool has_mtu = false;
+    napi_has_named_property(env, args[1], "mtu", &has_mtu);
+    if (has_mtu && napi_get_named_property(env, args[1], "mtu", &mtu_value) == napi_ok) {
+      int32_t m;
+      if (napi_get_value_int32(env, mtu_value, &m) == napi_ok && m > 0) mtu = m;
+    }
+  }
+  SSL_set_mtu(session->get(), mtu);
+  DTLS_set_link_mtu(session->get(), mtu);
+
+  int id = g_sessions.insert(session);
+  if (!id) {
+    napi_throw_error(env, nullptr, "Too many sessions");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &id_value);
+  napi_set_named_property(env, result, "id", id_value);
+  return result;
+}
+
+// NAPI implementation for FreeSession
+napi_value FreeSession(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  napi_value id_value;
+  napi_get_named_property(env, args[0], "id", &id_value);
+
+  int id;
+  napi_get_value_int32(env, id_value, &id);
+
+  napi_value result;
+  napi_get_boolean(env, g_sessions.remove(id) != nullptr, &result);
+  return result;
+}
+
+// Shared by DtlsConnect/DtlsAccept: [session, host?, port?]
+static napi_value dtls_start(napi_env env, napi_callback_info info, bool is_client) {
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  // The peer address only feeds BIO_dgram_get_peer (cookie binding).
+  if (argc >= 3) {
+    char host[INET6_ADDRSTRLEN + 1];
+    size_t host_len = 0;
+    int32_t port = 0;
+    if (napi_get_value_string_utf8(env, args[1], host, sizeof(host), &host_len) == napi_ok &&
+        napi_get_value_int32(env, args[2], &port) == napi_ok) {
+      sockaddr_storage addr;
+      socklen_t addr_len;
+      if (parse_peer_address(std::string(host, host_len), port, addr, addr_len))
+        dgram_bio_set_peer(session->bio(), reinterpret_cast<sockaddr*>(&addr), addr_len);
+    }
+  }
+
+  if (is_client) SSL_set_connect_state(session->get());
+  else           SSL_set_accept_state(session->get());
+
+  DtlsStepResult result;
+  dtls_step(*session, nullptr, 0, result);
+  return dtls_result_to_js(env, result);
+}
+
+// NAPI implementation for DtlsConnect
+napi_value DtlsConnect(napi_env env, napi_callback_info info) {
+  return dtls_start(env, info, true);
+}
+
+// NAPI implementation for DtlsAccept
+napi_value DtlsAccept(napi_env env, napi_callback_info info) {
+  return dtls_start(env, info, false);
+}
+
+// NAPI implementation for DtlsReceive
+napi_value DtlsReceive(napi_env env, napi_callback_info info) {
+  // Parse arguments: [session, datagram]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  bool is_buffer;
+  napi_is_buffer(env, args[1], &is_buffer);
+  if (!is_buffer) {
+    napi_throw_error(env, nullptr, "Datagram must be a buffer");
+    return nullptr;
+  }
+  void* data;
+  size_t len;
+  napi_get_buffer_info(env, args[1], &data, &len);
+
+  DtlsStepResult result;
+  dtls_step(*session, static_cast<uint8_t*>(data), len, result);
+  return dtls_result_to_js(env, result);
+}
+
+// NAPI implementation for DtlsSend
+napi_value DtlsSend(napi_env env, napi_callback_info info) {
+  // Parse arguments: [session, data]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  if (!SSL_is_init_finished(session->get())) {
+    napi_throw_error(env, nullptr, "DTLS handshake not complete");
+    return nullptr;
+  }
+
+  bool is_buffer;
+  napi_is_buffer(env, args[1], &is_buffer);
+  if (!is_buffer) {
+    napi_throw_error(env, nullptr, "Data must be a buffer");
+    return nullptr;
+  }
+  void* data;
+  size_t len;
+  napi_get_buffer_info(env, args[1], &data, &len);
+
+  DtlsStepResult result;
+  dtls_write(*session, static_cast<uint8_t*>(data), len, result);
+  return dtls_result_to_js(env, result);
+}
+
+// NAPI implementation for DtlsShutdown
+napi_value DtlsShutdown(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  // Queues close_notify; the peer's reply is not awaited.
+  DtlsStepResult result;
+  if (SSL_is_init_finished(session->get())) SSL_shutdown(session->get());
+  result.closed = true;
+  dgram_bio_take_outbound(session->bio(), result.datagrams);
+  return dtls_result_to_js(env, result);
+}
+
+// NAPI implementation for DtlsHandleTimeout
+napi_value DtlsHandleTimeout(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  // Retransmits the last flight if the handshake timer has expired.
+  DtlsStepResult result;
+  if (DTLSv1_handle_timeout(session->get()) < 0)
+    result.error = "DTLS retransmission limit reached";
+  dtls_step(*session, nullptr, 0, result);
+  return dtls_result_to_js(env, result);
+}
+
+// Client-side resumption: after a handshake JS can keep the serialized
+// session and hand it to a later session before dtlsConnect.
+
+// NAPI implementation for GetSessionData
+napi_value GetSessionData(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  napi_value result;
+  SSL_SESSION* sess = SSL_get1_session(session->get());
+  if (!sess || !SSL_SESSION_is_resumable(sess)) {
+    SSL_SESSION_free(sess);
+    napi_get_null(env, &result);
+    return result;
+  }
+
+  int len = i2d_SSL_SESSION(sess, nullptr);
+  void* data = nullptr;
+  if (len <= 0 || napi_create_buffer(env, len, &data, &result) != napi_ok) {
+    SSL_SESSION_free(sess);
+    napi_get_null(env, &result);
+    return result;
+  }
+  unsigned char* p = static_cast<unsigned char*>(data);
+  i2d_SSL_SESSION(sess, &p);
+  SSL_SESSION_free(sess);
+  return result;
+}
+
+// NAPI implementation for SetSessionData
+napi_value SetSessionData(napi_env env, napi_callback_info info) {
+  // Parse arguments: [session, data]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  bool is_buffer = false;
+  napi_is_buffer(env, args[1], &is_buffer);
+  if (!is_buffer) {
+    napi_throw_error(env, nullptr, "Session data must be a Buffer");
+    return nullptr;
+  }
+  void* data;
+  size_t len;
+  napi_get_buffer_info(env, args[1], &data, &len);
+
+  // A stale or foreign blob just means a full handshake, not an error.
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  SSL_SESSION* sess = d2i_SSL_SESSION(nullptr, &p, static_cast<long>(len));
+  bool ok = sess && SSL_set_session(session->get(), sess) == 1;
+  SSL_SESSION_free(sess);
+  ERR_clear_error();
+
+  napi_value result;
+  napi_get_boolean(env, ok, &result);
+  return result;
+}
+
+// NAPI implementation for SessionReused
+napi_value SessionReused(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto session = get_session_arg(env, args[0]);
+  if (!session) return nullptr;
+
+  napi_value result;
+  napi_get_boolean(env, SSL_session_reused(session->get()) == 1, &result);
+  return result;
+}
+
+// NAPI implementation for GetSessionCacheStats
+// { hits, misses, timeouts, entries, cacheHits, cacheMisses, stored, evicted,
+//   expired, ticketsIssued, ticketsAccepted, ticketsRejected, keyRotations }
+napi_value GetSessionCacheStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  napi_value id_value;
+  int id = 0;
+  napi_get_named_property(env, args[0], "id", &id_value);
+  napi_get_value_int32(env, id_value, &id);
+
+  auto context = g_contexts.get(id);
+  if (!context) {
+    napi_throw_error(env, nullptr, "Invalid context");
+    return nullptr;
+  }
+
+  // hits/misses count every resumption attempt, cache or ticket.
+  SSL_CTX* ctx = context->get();
+  std::vector<std::pair<const char*, double>> fields = {
+    { "hits",     static_cast<double>(SSL_CTX_sess_hits(ctx)) },
+    { "misses",   static_cast<double>(SSL_CTX_sess_misses(ctx)) },
+    { "timeouts", static_cast<double>(SSL_CTX_sess_timeouts(ctx)) },
+  };
+  if (SessionCache* cache = context->sessionCache()) {
+    const SessionCache::Stats& s = cache->stats();
+    fields.insert(fields.end(), {
+      { "entries",         static_cast<double>(cache->size()) },
+      { "cacheHits",       static_cast<double>(s.cacheHits.load()) },
+      { "cacheMisses",     static_cast<double>(s.cacheMisses.load()) },
+      { "stored",          static_cast<double>(s.stored.load()) },
+      { "evicted",         static_cast<double>(s.evicted.load()) },
+      { "expired",         static_cast<double>(s.expired.load()) },
+      { "ticketsIssued",   static_cast<double>(s.ticketsIssued.load()) },
+      { "ticketsAccepted", static_cast<double>(s.ticketsAccepted.load()) },
+      { "ticketsRejected", static_cast<double>(s.ticketsRejected.load()) },
+      { "keyRotations",    static_cast<double>(s.keyRotations.load()) },
+    });
+  }
+
+  napi_value result, v;
+  napi_create_object(env, &result);
+  for (auto& f : fields) {
+    napi_create_double(env, f.second, &v);
+    napi_set_named_property(env, result, f.first, v);
+  }
+  return result;
+}
+
+// NAPI implementation for GetCookieStats
+// { enabled, issued, verified, rejected, rotations }
+napi_value GetCookieStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  napi_value id_value;
+  int id = 0;
+  napi_get_named_property(env, args[0], "id", &id_value);
+  napi_get_value_int32(env, id_value, &id);
+
+  auto context = g_contexts.get(id);
+  if (!context) {
+    napi_throw_error(env, nullptr, "Invalid context");
+    return nullptr;
+  }
+
+  CookieExchange* cookies = context->cookieExchange();
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_get_boolean(env, cookies != nullptr, &v);
+  napi_set_named_property(env, result, "enabled", v);
+
+  const std::pair<const char*, uint64_t> fields[] = {
+    { "issued",    cookies ? cookies->stats().issued.load() : 0 },
+    { "verified",  cookies ? cookies->stats().verified.load() : 0 },
+    { "rejected",  cookies ? cookies->stats().rejected.load() : 0 },
+    { "rotations", cookies ? cookies->stats().rotations.load() : 0 },
+  };
+  for (auto& f : fields) {
+    napi_create_double(env, static_cast<double>(f.second), &v);
+    napi_set_named_property(env, result, f.first, v);
+  }
+  return result;
+}
+
+// getIdentityCacheStats() -> { hits, misses, parseErrors, entries }
+napi_value GetIdentityCacheStats(napi_env env, napi_callback_info info) {
+  IdentityCache& cache = IdentityCache::shared();
+  const IdentityCache::Stats& st = cache.stats();
+  const std::pair<const char*, uint64_t> fields[] = {
+    { "hits",        st.hits.load() },
+    { "misses",      st.misses.load() },
+    { "parseErrors", st.parseErrors.load() },
+    { "entries",     cache.size() },
+  };
+  napi_value result, v;
+  napi_create_object(env, &result);
+  for (auto& f : fields) {
+    napi_create_double(env, static_cast<double>(f.second), &v);
+    napi_set_named_property(env, result, f.first, v);
+  }
+  return result;
+}
+
+// getContextPoolStats() -> { hits, misses, buildErrors, entries }
+napi_value GetContextPoolStats(napi_env env, napi_callback_info info) {
+  ContextPool& pool = ContextPool::shared();
+  const ContextPool::Stats& st = pool.stats();
+  const std::pair<const char*, uint64_t> fields[] = {
+    { "hits",        st.hits.load() },
+    { "misses",      st.misses.load() },
+    { "buildErrors", st.buildErrors.load() },
+    { "entries",     pool.size() },
+  };
+  napi_value result, v;
+  napi_create_object(env, &result);
+  for (auto& f : fields) {
+    napi_create_double(env, static_cast<double>(f.second), &v);
+    napi_set_named_property(env, result, f.first, v);
+  }
+  return result;
+}
+
 static napi_value Init(napi_env env, napi_value exports)
 {
 std::cout << "[native] Init called!" << std::endl;
@@ -734,9 +1334,25 @@ std::cout << "[native] Init called!" << std::endl;
   init_openssl();
   napi_add_env_cleanup_hook(env, [](void*) { cleanup_openssl(); }, nullptr);
 
-  const napi_property_descriptor spec[] = {
+  napi_property_descriptor spec[] = {
     DECLARE_NAPI_METHOD("createContext",            CreateContext),
     DECLARE_NAPI_METHOD("freeContext",              FreeContext),
+    DECLARE_NAPI_METHOD("getSharedContext",         GetSharedContext),
+    DECLARE_NAPI_METHOD("createSession",            CreateSession),
+    DECLARE_NAPI_METHOD("freeSession",              FreeSession),
+    DECLARE_NAPI_METHOD("dtlsConnect",              DtlsConnect),
+    DECLARE_NAPI_METHOD("dtlsAccept",               DtlsAccept),
+    DECLARE_NAPI_METHOD("dtlsReceive",              DtlsReceive),
+    DECLARE_NAPI_METHOD("dtlsSend",                 DtlsSend),
+    DECLARE_NAPI_METHOD("dtlsShutdown",             DtlsShutdown),
+    DECLARE_NAPI_METHOD("dtlsHandleTimeout",        DtlsHandleTimeout),
+    DECLARE_NAPI_METHOD("getSessionData",           GetSessionData),
+    DECLARE_NAPI_METHOD("setSessionData",           SetSessionData),
+    DECLARE_NAPI_METHOD("sessionReused",            SessionReused),
+    DECLARE_NAPI_METHOD("getSessionCacheStats",     GetSessionCacheStats),
+    DECLARE_NAPI_METHOD("getCookieStats",           GetCookieStats),
+    DECLARE_NAPI_METHOD("getIdentityCacheStats",    GetIdentityCacheStats),
+    DECLARE_NAPI_METHOD("getContextPoolStats",      GetContextPoolStats),
     DECLARE_NAPI_METHOD("setCipherSuites",          SetCipherSuites),
     DECLARE_NAPI_METHOD("setPQCipherSuites",        SetPQCipherSuites),
     DECLARE_NAPI_METHOD("setVerifyMode",            SetVerifyMode),
@@ -749,8 +1365,18 @@ std::cout << "[native] Init called!" << std::endl;
     DECLARE_NAPI_METHOD("addCertificatePolicy",     SSLContextAddCertificatePolicy)
   };
 
+  metrics_instrument(spec, sizeof(spec) / sizeof(spec[0]));
   napi_define_properties(env, exports, sizeof(spec) / sizeof(spec[0]), spec);
   InitPQCrypto(env, exports);
+  InitUdpSocket(env, exports);
+  InitDtlsServer(env, exports);
+  InitAead(env, exports);
+  InitOstCodec(env, exports);
+  InitOstPack(env, exports);
+  InitOstStream(env, exports);
+  InitUniversalCodec(env, exports);
+  InitBlake3(env, exports);
+  InitMetrics(env, exports);
 
   napi_value test_value;
   napi_create_string_utf8(env, "hello", NAPI_AUTO_LENGTH, &test_value);
@@ -8,6 +8,8 @@
 #include <openssl/crypto.h>
 #include <openssl/x509v3.h>
 #include <openssl/ocsp.h>
+#include "session_cache.h"
+#include "cookie_exchange.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -27,36 +29,81 @@ public:
   void enableOCSPStapling(bool enable);
   void addCertificatePolicy(const std::string& policyOID);
 
+  // Server-side resumption; the cache is owned by the SSL_CTX.
+  bool enableSessionCache(const SessionCacheOptions& opts);
+  SessionCache* sessionCache() const { return sessionCache_; }
+
+  // Stateless HMAC cookies (HelloVerifyRequest) before any handshake work.
+  bool enableCookieExchange(const CookieExchangeOptions& opts);
+  CookieExchange* cookieExchange() const { return cookieExchange_; }
+
+  // Pooled contexts are shared between callers and reject further setters.
+  void freeze() { frozen_ = true; }
+  bool frozen() const { return frozen_; }
+
 private:
   SSL_CTX* ctx_;
+  SessionCache* sessionCache_ = nullptr;
+  CookieExchange* cookieExchange_ = nullptr;
   std::vector<std::string> crlPoints_;
   std::vector<std::string> policies_;
   bool ocspStaplingEnabled_;
   bool certTransparencyEnabled_;
+  bool frozen_ = false;
 };
 
-// RAII wrapper around SSL*
+// RAII wrapper around SSL* bound to a datagram memory BIO (see dgram_bio.h)
 class SSLSessionWrapper {
 public:
   SSLSessionWrapper(SSL_CTX* ctx);
   ~SSLSessionWrapper();
   SSL* get() const { return ssl_; }
+  BIO* bio() const { return bio_; }
 private:
   SSL* ssl_;
+  BIO* bio_;  // owned by ssl_, used as both rbio and wbio
 };
 
+// Outcome of one pass through the DTLS record layer: plaintext that became
+// readable, datagrams that must go out to the peer, and handshake state.
+struct DtlsStepResult {
+  std::vector<std::vector<uint8_t>> datagrams;
+  std::vector<uint8_t> plaintext;
+  bool handshakeComplete = false;
+  bool closed = false;
+  long timeoutMs = -1;   // retransmission timer, -1 when none is armed
+  std::string error;
+};
+
+// Feeds an optional inbound datagram, advances the handshake, reads any
+// application data and collects outbound datagrams, all in one call.
+void dtls_step(SSLSessionWrapper& session, const uint8_t* datagram, size_t len,
+               DtlsStepResult& result);
+
+// Encrypts plaintext into records sized for the session MTU.
+void dtls_write(SSLSessionWrapper& session, const uint8_t* data, size_t len,
+                DtlsStepResult& result);
+
 // OpenSSL init/cleanup
 void init_openssl();
 void cleanup_openssl();
 
 // Helpers
 SSL_CTX* create_dtls_context(bool is_server);
+std::shared_ptr<SSLContextWrapper> find_context(int id);  // JS thread only
 bool set_certificates(SSL_CTX* ctx, const char* cert_path, const char* key_path);
+// PEM or DER; parsed objects are shared through IdentityCache.
+bool set_certificates_from_memory(SSL_CTX* ctx, const uint8_t* cert, size_t cert_len,
+                                  const uint8_t* key, size_t key_len);
 void set_cipher_list(SSL_CTX* ctx, const std::vector<std::string>& ciphers);
+// "kyber512" | "kyber768" | "hybrid" | "dilithium2" | "dilithium3"; returns
+// an error message, or nullptr on success.
+const char* set_pq_suite(SSL_CTX* ctx, const std::string& suite);
 
 // N-API exports for DTLS/OpenSSL
 napi_value CreateContext           (napi_env, napi_callback_info);
 napi_value FreeContext             (napi_env, napi_callback_info);
+napi_value GetSharedContext        (napi_env, napi_callback_info);
 napi_value CreateSession           (napi_env, napi_callback_info);
 napi_value FreeSession             (napi_env, napi_callback_info);
 napi_value DtlsConnect             (napi_env, napi_callback_info);
@@ -64,6 +111,14 @@ napi_value DtlsAccept              (napi_env, napi_callback_info);
 napi_value DtlsReceive             (napi_env, napi_callback_info);
 napi_value DtlsSend                (napi_env, napi_callback_info);
 napi_value DtlsShutdown            (napi_env, napi_callback_info);
+napi_value DtlsHandleTimeout       (napi_env, napi_callback_info);
+napi_value GetSessionData          (napi_env, napi_callback_info);
+napi_value SetSessionData          (napi_env, napi_callback_info);
+napi_value SessionReused           (napi_env, napi_callback_info);
+napi_value GetSessionCacheStats    (napi_env, napi_callback_info);
+napi_value GetCookieStats          (napi_env, napi_callback_info);
+napi_value GetIdentityCacheStats   (napi_env, napi_callback_info);
+napi_value GetContextPoolStats     (napi_env, napi_callback_info);
 napi_value SetCipherSuites         (napi_env, napi_callback_info);
 napi_value SetPQCipherSuites       (napi_env, napi_callback_info);
 napi_value SetVerifyMode           (napi_env, napi_callback_info);
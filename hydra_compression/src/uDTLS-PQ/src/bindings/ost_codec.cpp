@@ -0,0 +1,2213 @@
+// src/bindings/ost_codec.cpp
+#include "ost_codec.h"
+#include "bin_compress.h"
+#include "metrics.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+// --- Text ---
+bool is_ascii(const uint8_t* p, size_t n) {
+  uint64_t acc = 0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t w;
+    std::memcpy(&w, p + i, 8);
+    acc |= w;
+  }
+  for (; i < n; i++) acc |= p[i];
+  return (acc & 0x8080808080808080ULL) == 0;
+}
+
+void append_code_point(std::u16string& s, uint32_t cp) {
+  if (cp < 0x10000) {
+    s.push_back(static_cast<char16_t>(cp));
+  } else {
+    cp -= 0x10000;
+    s.push_back(static_cast<char16_t>(0xD800 | (cp >> 10)));
+    s.push_back(static_cast<char16_t>(0xDC00 | (cp & 0x3FF)));
+  }
+}
+
+void append_utf8(std::string& s, uint32_t cp) {
+  if (cp < 0x80) {
+    s.push_back(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    s.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+    s.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else if (cp < 0x10000) {
+    s.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+    s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    s.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    s.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+    s.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+    s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    s.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+// TextDecoder semantics: each maximal invalid subpart becomes one U+FFFD.
+void append_utf8_as_utf16(const uint8_t* s, size_t n, std::u16string& out) {
+  size_t i = 0;
+  while (i < n) {
+    uint8_t b = s[i];
+    if (b < 0x80) {
+      out.push_back(b);
+      i++;
+      continue;
+    }
+    uint32_t cp;
+    size_t need;
+    uint8_t lo = 0x80, hi = 0xBF;
+    if (b >= 0xC2 && b <= 0xDF) {
+      need = 1;
+      cp = b & 0x1F;
+    } else if (b >= 0xE0 && b <= 0xEF) {
+      need = 2;
+      cp = b & 0x0F;
+      if (b == 0xE0) lo = 0xA0;
+      if (b == 0xED) hi = 0x9F;
+    } else if (b >= 0xF0 && b <= 0xF4) {
+      need = 3;
+      cp = b & 0x07;
+      if (b == 0xF0) lo = 0x90;
+      if (b == 0xF4) hi = 0x8F;
+    } else {
+      out.push_back(0xFFFD);
+      i++;
+      continue;
+    }
+    size_t j = i + 1, k = 0;
+    for (; k < need && j < n && s[j] >= lo && s[j] <= hi; k++, j++) {
+      cp = (cp << 6) | (s[j] & 0x3F);
+      lo = 0x80;
+      hi = 0xBF;
+    }
+    // A bad continuation byte is not consumed; it starts the next sequence.
+    if (k < need) out.push_back(0xFFFD);
+    else append_code_point(out, cp);
+    i = j;
+  }
+}
+
+// One JS "character" as `for (const char of str)` sees it: a code point, or
+// a lone surrogate.
+inline size_t next_code_point(const uint8_t* p, size_t i, size_t, uint32_t& cp) {
+  cp = p[i];
+  return i + 1;
+}
+
+inline size_t next_code_point(const char16_t* p, size_t i, size_t n, uint32_t& cp) {
+  uint32_t u = p[i];
+  if (u >= 0xD800 && u <= 0xDBFF && i + 1 < n) {
+    uint32_t v = p[i + 1];
+    if (v >= 0xDC00 && v <= 0xDFFF) {
+      cp = 0x10000 + ((u - 0xD800) << 10) + (v - 0xDC00);
+      return i + 2;
+    }
+  }
+  cp = u;
+  return i + 1;
+}
+
+// JSON.stringify escaping, including "\udxxx" for lone surrogates.
+void append_json_code_point(std::string& s, uint32_t cp) {
+  switch (cp) {
+    case '"':  s += "\\\""; return;
+    case '\\': s += "\\\\"; return;
+    case '\b': s += "\\b"; return;
+    case '\f': s += "\\f"; return;
+    case '\n': s += "\\n"; return;
+    case '\r': s += "\\r"; return;
+    case '\t': s += "\\t"; return;
+  }
+  if (cp < 0x20 || (cp >= 0xD800 && cp <= 0xDFFF)) {
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "\\u%04x", cp);
+    s += buf;
+    return;
+  }
+  append_utf8(s, cp);
+}
+
+void append_json_string(std::string& s, const std::u16string& str) {
+  s.push_back('"');
+  for (size_t i = 0; i < str.size();) {
+    uint32_t cp;
+    i = next_code_point(str.data(), i, str.size(), cp);
+    append_json_code_point(s, cp);
+  }
+  s.push_back('"');
+}
+
+void put_u16(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(static_cast<uint8_t>(v >> 8));
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(static_cast<uint8_t>(v >> 24));
+  out.push_back(static_cast<uint8_t>(v >> 16));
+  out.push_back(static_cast<uint8_t>(v >> 8));
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+void put_u64(std::vector<uint8_t>& out, uint64_t v) {
+  put_u32(out, static_cast<uint32_t>(v >> 32));
+  put_u32(out, static_cast<uint32_t>(v));
+}
+
+uint32_t get_u32(const uint8_t* p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+uint64_t get_u64(const uint8_t* p) {
+  return (uint64_t(get_u32(p)) << 32) | get_u32(p + 4);
+}
+
+// --- Symbol counting ---
+struct Leaf {
+  uint32_t symbol;
+  uint64_t count;
+};
+
+// Byte histogram over four interleaved tables, so runs of one byte do not
+// serialise on a single counter's store-to-load forwarding. Tables are
+// uint32, so long inputs are counted in blocks and folded.
+void count_bytes(const uint8_t* p, size_t n, uint64_t counts[256]) {
+  std::fill(counts, counts + 256, 0);
+  if (n < 1024) {
+    for (size_t i = 0; i < n; i++) counts[p[i]]++;
+    return;
+  }
+  static constexpr size_t BLOCK = size_t(1) << 30;
+  uint32_t t[4][256];
+  for (size_t base = 0; base < n; base += BLOCK) {
+    std::memset(t, 0, sizeof(t));
+    const size_t end = std::min(n, base + BLOCK);
+    size_t i = base;
+    for (; i + 16 <= end; i += 16) {
+      uint64_t a, b;
+      std::memcpy(&a, p + i, 8);
+      std::memcpy(&b, p + i + 8, 8);
+      for (int k = 0; k < 64; k += 16) {
+        t[0][(a >> k) & 0xff]++;
+        t[1][(a >> (k + 8)) & 0xff]++;
+        t[2][(b >> k) & 0xff]++;
+        t[3][(b >> (k + 8)) & 0xff]++;
+      }
+    }
+    for (; i < end; i++) t[0][p[i]]++;
+    for (int c = 0; c < 256; c++) counts[c] += uint64_t(t[0][c]) + t[1][c] + t[2][c] + t[3][c];
+  }
+}
+
+// Symbol counts in order of first appearance, matching the insertion order
+// of the frequency Map in OSTCompression.
+class SymbolCounter {
+public:
+  void count(const uint8_t* p, size_t n, std::vector<Leaf>& leaves) {
+    leaves.clear();
+    uint64_t counts[256];
+    count_bytes(p, n, counts);
+    size_t distinct = 0;
+    for (uint64_t c : counts) distinct += c != 0;
+    // Only the prefix up to the last new symbol has to be scanned.
+    bool seen[256] = {};
+    for (size_t i = 0; leaves.size() < distinct; i++) {
+      if (!seen[p[i]]) {
+        seen[p[i]] = true;
+        leaves.push_back({ p[i], counts[p[i]] });
+      }
+    }
+  }
+
+  void count(const char16_t* p, size_t n, std::vector<Leaf>& leaves) {
+    leaves.clear();
+    std::fill(low_, low_ + 256, 0);
+    high_.clear();
+    for (size_t i = 0; i < n;) {
+      uint32_t cp;
+      i = next_code_point(p, i, n, cp);
+      uint32_t& slot = cp < 256 ? low_[cp] : high_[cp];
+      if (!slot) {
+        leaves.push_back({ cp, 0 });
+        slot = static_cast<uint32_t>(leaves.size());
+      }
+      leaves[slot - 1].count++;
+    }
+  }
+
+private:
+  uint32_t low_[256];                          // leaf index + 1
+  std::unordered_map<uint32_t, uint32_t> high_;
+};
+
+// --- Huffman ---
+struct HuffNode {
+  uint64_t count;
+  int32_t left, right;  // -1 for leaves
+  uint32_t symbol;
+};
+
+struct Code {
+  uint32_t symbol;
+  uint32_t len;
+  uint64_t bits;
+};
+
+// The tree OSTCompression.buildHuffmanTree builds. That loop stable-sorts the
+// node list by count, merges the first two and appends the parent. Parents
+// are created in non-decreasing count order and always land after leaves of
+// equal count, so the same tree falls out of a two-queue merge that prefers
+// the leaf on ties.
+class Huffman {
+public:
+  std::vector<HuffNode> nodes;
+  int32_t root = -1;
+  std::vector<Code> codes;  // generateHuffmanCodes order: depth-first, left ("0") first
+
+  // False if a code would exceed 64 bits, which needs more than Fib(66)
+  // symbols and so cannot happen for in-memory input.
+  bool build(const std::vector<Leaf>& leaves) {
+    nodes.clear();
+    codes.clear();
+    const size_t k = leaves.size();
+    for (const Leaf& l : leaves) nodes.push_back({ l.count, -1, -1, l.symbol });
+    root = k ? 0 : -1;
+    if (k < 2) {
+      if (k) codes.push_back({ leaves[0].symbol, 0, 0 });
+      return true;
+    }
+
+    order_.resize(k);
+    std::iota(order_.begin(), order_.end(), 0);
+    std::stable_sort(order_.begin(), order_.end(),
+                     [&](int32_t a, int32_t b) { return nodes[a].count < nodes[b].count; });
+
+    size_t next_leaf = 0, next_parent = k;
+    auto pick = [&]() -> int32_t {
+      if (next_leaf < k && (next_parent >= nodes.size() ||
+                            nodes[order_[next_leaf]].count <= nodes[next_parent].count))
+        return order_[next_leaf++];
+      return static_cast<int32_t>(next_parent++);
+    };
+    for (size_t merges = 1; merges < k; merges++) {
+      int32_t left = pick();
+      int32_t right = pick();
+      nodes.push_back({ nodes[left].count + nodes[right].count, left, right, 0 });
+    }
+    root = static_cast<int32_t>(nodes.size() - 1);
+
+    stack_.clear();
+    stack_.push_back({ root, 0, 0 });
+    while (!stack_.empty()) {
+      StackFrame f = stack_.back();
+      stack_.pop_back();
+      const HuffNode& n = nodes[f.node];
+      if (n.left < 0) {
+        codes.push_back({ n.symbol, f.len, f.bits });
+        continue;
+      }
+      if (f.len == 64) return false;
+      stack_.push_back({ n.right, f.len + 1, (f.bits << 1) | 1 });
+      stack_.push_back({ n.left, f.len + 1, f.bits << 1 });
+    }
+    return true;
+  }
+
+private:
+  struct StackFrame { int32_t node; uint32_t len; uint64_t bits; };
+  std::vector<int32_t> order_;
+  std::vector<StackFrame> stack_;
+};
+
+// MSB-first bit packing, zero-padded to a whole byte like the TS padEnd.
+class BitWriter {
+public:
+  explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+  void put(uint64_t bits, uint32_t len) {
+    if (len > 32) {
+      put(bits >> 32, len - 32);
+      bits &= 0xffffffffULL;
+      len = 32;
+    }
+    total_ += len;
+    acc_ = (acc_ << len) | bits;
+    n_ += len;
+    if (n_ >= 32) {
+      n_ -= 32;
+      uint32_t w = static_cast<uint32_t>(acc_ >> n_);
+      uint8_t b[4] = { uint8_t(w >> 24), uint8_t(w >> 16), uint8_t(w >> 8), uint8_t(w) };
+      out_.insert(out_.end(), b, b + 4);
+    }
+  }
+
+  void finish() {
+    while (n_ >= 8) {
+      n_ -= 8;
+      out_.push_back(static_cast<uint8_t>(acc_ >> n_));
+    }
+    if (n_) out_.push_back(static_cast<uint8_t>(acc_ << (8 - n_)));
+    n_ = 0;
+  }
+
+  // Bits put so far.
+  uint64_t position() const { return total_; }
+
+private:
+  std::vector<uint8_t>& out_;
+  uint64_t acc_ = 0;
+  uint32_t n_ = 0;
+  uint64_t total_ = 0;
+};
+
+class BitReader {
+public:
+  BitReader(const uint8_t* p, size_t n, uint64_t first_bit = 0) : p_(p), n_(n) {
+    pos_ = static_cast<size_t>(std::min<uint64_t>(first_bit >> 3, n));
+    consumed_ = first_bit & ~uint64_t(7);
+    if (first_bit & 7) {
+      refill();
+      skip(first_bit & 7);
+    }
+  }
+
+  // Past the end the stream reads as zeros; overrun() reports it.
+  uint32_t peek(uint32_t k) {
+    refill();
+    return static_cast<uint32_t>(acc_ >> (64 - k));
+  }
+  void skip(uint32_t k) {
+    acc_ <<= k;
+    bits_ -= k;
+    consumed_ += k;
+  }
+  uint32_t bit() {
+    refill();
+    uint32_t b = static_cast<uint32_t>(acc_ >> 63);
+    skip(1);
+    return b;
+  }
+  bool overrun() const { return consumed_ > 8 * uint64_t(n_); }
+
+private:
+  // Tops the window up to at least 56 bits. Re-reading bytes that are
+  // already partly in acc_ ORs in the same bits, so whole-word loads need no
+  // masking.
+  void refill() {
+    if (pos_ + 8 <= n_) {
+      uint64_t w;
+      std::memcpy(&w, p_ + pos_, 8);
+      acc_ |= __builtin_bswap64(w) >> bits_;
+      pos_ += (63 - bits_) >> 3;
+      bits_ |= 56;
+      return;
+    }
+    while (bits_ <= 56) {
+      uint64_t byte = pos_ < n_ ? p_[pos_] : 0;
+      pos_++;
+      acc_ |= byte << (56 - bits_);
+      bits_ += 8;
+    }
+  }
+
+  const uint8_t* p_;
+  size_t n_;
+  size_t pos_ = 0;
+  uint64_t acc_ = 0;  // left-aligned
+  uint32_t bits_ = 0;
+  uint64_t consumed_ = 0;
+};
+
+// Per-call scratch, reused across windows and bins.
+struct Scratch {
+  SymbolCounter counter;
+  std::vector<Leaf> leaves;
+  Huffman huffman;
+  std::vector<const Code*> byLength;
+  std::unordered_map<uint32_t, const Code*> highCodes;
+};
+
+// generateLabel: the labelLength shortest-coded symbols (ties in tree
+// order), a space, then their code lengths as decimal digits.
+void make_label(Scratch& s, uint32_t label_length, std::u16string& label) {
+  s.byLength.clear();
+  for (const Code& c : s.huffman.codes) s.byLength.push_back(&c);
+  std::stable_sort(s.byLength.begin(), s.byLength.end(),
+                   [](const Code* a, const Code* b) { return a->len < b->len; });
+  const size_t n = std::min<size_t>(label_length, s.byLength.size());
+  label.clear();
+  for (size_t i = 0; i < n; i++) append_code_point(label, s.byLength[i]->symbol);
+  label.push_back(u' ');
+  for (size_t i = 0; i < n; i++) {
+    char digits[12];
+    int len = std::snprintf(digits, sizeof(digits), "%u", s.byLength[i]->len);
+    label.append(digits, digits + len);
+  }
+}
+
+// --- Bin compression ---
+// Where a window starts in its bin's code stream, for OstConfig::index.
+// `cuts` are the unit offsets of the bin's windows; each gets one mark.
+struct WindowMark {
+  uint64_t bit;
+  bool straddle;  // the cut falls inside a surrogate pair symbol
+};
+
+void append_utf8_units(const uint8_t* p, size_t n, std::vector<uint8_t>& out,
+                       const std::vector<size_t>* cuts, std::vector<WindowMark>* marks) {
+  out.insert(out.end(), p, p + n);
+  for (size_t c = 0; cuts && c < cuts->size(); c++) marks->push_back({ 8 * uint64_t((*cuts)[c]), false });
+}
+
+void append_utf8_units(const char16_t* p, size_t n, std::vector<uint8_t>& out,
+                       const std::vector<size_t>* cuts, std::vector<WindowMark>* marks) {
+  std::string utf8;
+  if (!cuts) {
+    utf16_to_utf8(p, n, utf8);
+  } else {
+    size_t next = 0;
+    for (size_t i = 0; i < n;) {
+      uint32_t cp;
+      const size_t j = next_code_point(p, i, n, cp);
+      for (; next < cuts->size() && (*cuts)[next] < j; next++)
+        marks->push_back({ 8 * uint64_t(utf8.size()), (*cuts)[next] != i });
+      append_utf8(utf8, cp >= 0xD800 && cp <= 0xDFFF ? 0xFFFD : cp);
+      i = j;
+    }
+  }
+  out.insert(out.end(), utf8.begin(), utf8.end());
+}
+
+template <typename Unit>
+bool huffman_compress(const Unit* p, size_t n, Scratch& s, std::vector<uint8_t>& out,
+                      const std::vector<size_t>* cuts, std::vector<WindowMark>* marks, std::string& error) {
+  s.counter.count(p, n, s.leaves);
+  if (!s.huffman.build(s.leaves)) {
+    error = "Huffman code longer than 64 bits";
+    return false;
+  }
+
+  // JSON.stringify(Array.from(frequencyMap.entries()))
+  std::string table = "[";
+  for (size_t i = 0; i < s.leaves.size(); i++) {
+    if (i) table.push_back(',');
+    table += "[\"";
+    append_json_code_point(table, s.leaves[i].symbol);
+    table += "\",";
+    table += std::to_string(s.leaves[i].count);
+    table.push_back(']');
+  }
+  table.push_back(']');
+
+  const Code* low[256] = {};
+  s.highCodes.clear();
+  uint64_t total_bits = 0;
+  for (const Code& c : s.huffman.codes) {
+    if (c.symbol < 256) low[c.symbol] = &c;
+    else s.highCodes[c.symbol] = &c;
+  }
+  for (const Leaf& l : s.leaves) {
+    const Code* c = l.symbol < 256 ? low[l.symbol] : s.highCodes[l.symbol];
+    total_bits += l.count * c->len;
+  }
+
+  out.reserve(out.size() + 4 + table.size() + (total_bits + 7) / 8);
+  put_u32(out, static_cast<uint32_t>(table.size()));
+  out.insert(out.end(), table.begin(), table.end());
+
+  BitWriter w(out);
+  if (sizeof(Unit) == 1) {
+    // Flat table: one load per byte.
+    uint64_t bits[256] = {};
+    uint32_t lens[256] = {};
+    for (int c = 0; c < 256; c++) {
+      if (low[c]) {
+        bits[c] = low[c]->bits;
+        lens[c] = low[c]->len;
+      }
+    }
+    auto put_range = [&](size_t i, size_t end) {
+      for (; i < end; i++) w.put(bits[uint32_t(p[i])], lens[uint32_t(p[i])]);
+    };
+    if (!cuts) put_range(0, n);
+    for (size_t c = 0; cuts && c < cuts->size(); c++) {
+      marks->push_back({ w.position(), false });
+      put_range((*cuts)[c], c + 1 < cuts->size() ? (*cuts)[c + 1] : n);
+    }
+  } else {
+    size_t next = 0;
+    for (size_t i = 0; i < n;) {
+      uint32_t cp;
+      const size_t j = next_code_point(p, i, n, cp);
+      for (; cuts && next < cuts->size() && (*cuts)[next] < j; next++)
+        marks->push_back({ w.position(), (*cuts)[next] != i });
+      const Code* c = cp < 256 ? low[cp] : s.highCodes[cp];
+      w.put(c->bits, c->len);
+      i = j;
+    }
+  }
+  w.finish();
+  return true;
+}
+
+template <typename Unit>
+bool compress_bin(const Unit* p, size_t n, const OstConfig& config, Scratch& s,
+                  std::vector<uint8_t>& out, const std::vector<size_t>* cuts,
+                  std::vector<WindowMark>* marks, std::string& error) {
+  out.clear();
+  if (config.compressionMethod == "huffman") return huffman_compress(p, n, s, out, cuts, marks, error);
+  BinCodec codec;
+  if (bin_codec_from_name(config.compressionMethod, codec)) {
+    std::vector<uint8_t> utf8;
+    append_utf8_units(p, n, utf8, nullptr, nullptr);
+    return bin_compress(codec, static_cast<int>(config.compressionLevel), utf8.data(), utf8.size(), out, error);
+  }
+  // 'raw', and like compressBin's default branch anything unrecognised
+  append_utf8_units(p, n, out, cuts, marks);
+  return true;
+}
+
+// Below this much input the bins are compressed on the calling thread.
+constexpr size_t OST_PARALLEL_MIN_UNITS = 256 * 1024;
+
+// Runs fn(i) for every bin, across the WorkerPool when there is enough work.
+// fn must only touch state belonging to bin i.
+void for_each_bin(size_t bins, size_t units, const std::function<void(size_t)>& fn) {
+  auto run = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) fn(i);
+  };
+  if (bins > 1 && units >= OST_PARALLEL_MIN_UNITS) WorkerPool::shared().parallelFor(bins, 1, run);
+  else run(0, bins);
+}
+
+// UTF-8 offset of every window start. A surrogate pair cut by a boundary
+// counts towards the earlier window, and the later one is flagged as
+// opening on the pair's tail.
+uint64_t window_offsets(const uint8_t*, size_t len, size_t window,
+                        std::vector<uint64_t>& bytes, std::vector<uint32_t>&) {
+  for (size_t start = 0; start < len; start += window) bytes.push_back(start);  // ASCII
+  return len;
+}
+
+uint64_t window_offsets(const char16_t* p, size_t len, size_t window,
+                        std::vector<uint64_t>& bytes, std::vector<uint32_t>& flags) {
+  uint64_t total = 0;
+  size_t start = 0;
+  auto reach = [&](size_t i) {
+    for (; start < len && start <= i; start += window) {
+      if (start < i) flags[start / window] |= OST_WINDOW_PAIR_TAIL;
+      bytes.push_back(total);
+    }
+  };
+  for (size_t i = 0; i < len;) {
+    reach(i);
+    uint32_t cp;
+    const size_t j = next_code_point(p, i, len, cp);
+    total += cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;  // lone surrogates: U+FFFD
+    i = j;
+  }
+  reach(len);
+  return total;
+}
+
+std::string config_json(const OstConfig& c) {
+  std::u16string method;
+  append_utf8_as_utf16(reinterpret_cast<const uint8_t*>(c.compressionMethod.data()),
+                       c.compressionMethod.size(), method);
+  std::string s = "{";
+  if (!c.leadingKeys.empty()) s.append(c.leadingKeys, 1, std::string::npos).push_back(',');
+  s += "\"windowLength\":" + std::to_string(c.windowLength) +
+                  ",\"labelLength\":" + std::to_string(c.labelLength) +
+                  ",\"variableWindow\":" + (c.variableWindow ? "true" : "false") +
+                  ",\"compressionMethod\":";
+  append_json_string(s, method);
+  s += std::string(",\"subBinning\":") + (c.subBinning ? "true" : "false") +
+       ",\"subBinningDepth\":" + std::to_string(c.subBinningDepth) + c.trailingKeys + "}";
+  return s;
+}
+
+template <typename Unit>
+bool encode_text(const Unit* text, size_t len, const OstConfig& config,
+                 std::vector<uint8_t>& out, std::string& error) {
+  if (config.windowLength == 0) {
+    error = "windowLength must be positive";
+    return false;
+  }
+  const size_t window = config.windowLength;
+
+  struct Bin {
+    std::u16string label;
+    std::vector<size_t> windows;  // start offsets, in input order
+    size_t units = 0;
+  };
+  std::vector<Bin> bins;
+  std::unordered_map<std::u16string, uint32_t> index;
+  std::vector<uint32_t> window_bins;
+  const bool record_bins = config.recordOrder || config.index;
+  if (config.index && (len + window - 1) / window > OST_WINDOW_BIN_MASK) {
+    error = "Too many windows for the OST index";
+    return false;
+  }
+  BinCodec codec;
+  if (config.index && bin_codec_from_name(config.compressionMethod, codec)) {
+    error = "The OST index needs huffman or raw bins";
+    return false;
+  }
+  Scratch s;
+  std::u16string label;
+
+  // Steps 1-3 of OSTCompression.encode: windows, labels, bins.
+  for (size_t start = 0; start < len; start += window) {
+    const size_t n = std::min(window, len - start);
+    s.counter.count(text + start, n, s.leaves);
+    if (!s.huffman.build(s.leaves)) {
+      error = "Huffman code longer than 64 bits";
+      return false;
+    }
+    make_label(s, config.labelLength, label);
+
+    auto it = index.find(label);
+    uint32_t b;
+    if (it == index.end()) {
+      b = static_cast<uint32_t>(bins.size());
+      index.emplace(label, b);
+      bins.push_back({ label, {}, 0 });
+    } else {
+      b = it->second;
+    }
+    bins[b].windows.push_back(start);
+    bins[b].units += n;
+    if (record_bins) window_bins.push_back(b);
+  }
+
+  // Header, as OSTPackWriter serialises it
+  std::string labels;
+  for (size_t i = 0; i < bins.size(); i++) {
+    if (i) labels.push_back(',');
+    append_json_string(labels, bins[i].label);
+  }
+  std::string header = "{\"config\":" + config_json(config) + ",\"binSequence\":[" + labels +
+                       "],\"bins\":[" + labels + "]";
+  if (config.recordOrder) {
+    header += ",\"windowBins\":[";
+    for (size_t i = 0; i < window_bins.size(); i++) {
+      if (i) header.push_back(',');
+      header += std::to_string(window_bins[i]);
+    }
+    header.push_back(']');
+  }
+  if (config.index) header += ",\"index\":true";
+  header.push_back('}');
+
+  out.clear();
+  out.reserve(8 + header.size() + len / 2);
+  static const uint8_t magic[4] = { 'O', 'S', 'T', '1' };
+  out.insert(out.end(), magic, magic + 4);
+  put_u32(out, static_cast<uint32_t>(header.size()));
+  out.insert(out.end(), header.begin(), header.end());
+
+  // Step 4: compress each bin. Bins are independent, so large inputs spread
+  // them over the WorkerPool; the pack still lists them in first-appearance
+  // order.
+  const bool raw = config.compressionMethod != "huffman";
+  struct Packed {
+    std::vector<uint8_t> payload;
+    std::vector<WindowMark> marks;  // one per window, for the index
+    std::vector<size_t> unpaired;   // text offsets raw bins store as U+FFFD
+    std::string error;
+  };
+  std::vector<Packed> packed(bins.size());
+  for_each_bin(bins.size(), len, [&](size_t b) {
+    const Bin& bin = bins[b];
+    Packed& p = packed[b];
+    Scratch scratch;
+    std::vector<Unit> data;
+    std::vector<size_t> cuts;
+    data.reserve(bin.units);
+    for (size_t start : bin.windows) {
+      cuts.push_back(data.size());
+      data.insert(data.end(), text + start, text + start + std::min(window, len - start));
+    }
+    if (!compress_bin(data.data(), data.size(), config, scratch, p.payload,
+                      config.index ? &cuts : nullptr, &p.marks, p.error)) {
+      if (p.error.empty()) p.error = "Bin compression failed";
+      return;
+    }
+    for (size_t i = 0, c = 0; config.index && raw && sizeof(Unit) == 2 && i < data.size();) {
+      uint32_t cp;
+      const size_t j = next_code_point(data.data(), i, data.size(), cp);
+      if (cp >= 0xD800 && cp <= 0xDFFF) {
+        while (c + 1 < cuts.size() && cuts[c + 1] <= i) c++;
+        p.unpaired.push_back(bin.windows[c] + (i - cuts[c]));
+      }
+      i = j;
+    }
+  });
+
+  // Window index entries: bin | flags, bit offset, byte offset
+  std::vector<uint32_t> entry_flags;
+  std::vector<uint64_t> entry_bits;
+  std::vector<uint64_t> records;
+  std::vector<size_t> unpaired;
+  if (config.index) {
+    entry_flags.assign(window_bins.begin(), window_bins.end());
+    entry_bits.resize(window_bins.size());
+  }
+
+  std::string label8;
+  for (size_t b = 0; b < bins.size(); b++) {
+    const Bin& bin = bins[b];
+    Packed& p = packed[b];
+    if (!p.error.empty()) {
+      error = p.error;
+      return false;
+    }
+    for (size_t k = 0; k < p.marks.size(); k++) {
+      const size_t w = bin.windows[k] / window;
+      entry_bits[w] = p.marks[k].bit;
+      if (p.marks[k].straddle) entry_flags[w] |= OST_WINDOW_STRADDLE;
+    }
+    unpaired.insert(unpaired.end(), p.unpaired.begin(), p.unpaired.end());
+    records.push_back(out.size());
+
+    utf16_to_utf8(bin.label.data(), bin.label.size(), label8);
+    if (label8.size() > 0xffff || p.payload.size() > 0xffffffffULL) {
+      error = "Bin too large for the OST1 format";
+      return false;
+    }
+    put_u16(out, static_cast<uint32_t>(label8.size()));
+    out.insert(out.end(), label8.begin(), label8.end());
+    put_u32(out, static_cast<uint32_t>(p.payload.size()));
+    out.insert(out.end(), p.payload.begin(), p.payload.end());
+    std::vector<uint8_t>().swap(p.payload);
+  }
+
+  if (config.index) {
+    // Offsets describe the text as it decodes.
+    std::vector<uint64_t> entry_bytes;
+    entry_bytes.reserve(entry_flags.size());
+    uint64_t text_bytes;
+    if (unpaired.empty()) {
+      text_bytes = window_offsets(text, len, window, entry_bytes, entry_flags);
+    } else {
+      std::vector<Unit> decoded(text, text + len);
+      for (size_t i : unpaired) decoded[i] = static_cast<Unit>(0xFFFD);
+      text_bytes = window_offsets(decoded.data(), len, window, entry_bytes, entry_flags);
+    }
+
+    const uint64_t index_offset = out.size();
+    static const uint8_t index_magic[4] = { 'O', 'S', 'T', 'I' };
+    out.reserve(out.size() + 48 + 8 * records.size() + 20 * entry_flags.size());
+    out.insert(out.end(), index_magic, index_magic + 4);
+    put_u32(out, config.compressionMethod == "huffman" ? OST_METHOD_HUFFMAN : OST_METHOD_RAW);
+    put_u32(out, static_cast<uint32_t>(bins.size()));
+    put_u32(out, static_cast<uint32_t>(entry_flags.size()));
+    put_u32(out, config.windowLength);
+    put_u64(out, len);
+    put_u64(out, text_bytes);
+    for (uint64_t r : records) put_u64(out, r);
+    for (size_t w = 0; w < entry_flags.size(); w++) {
+      put_u32(out, entry_flags[w]);
+      put_u64(out, entry_bits[w]);
+      put_u64(out, entry_bytes[w]);
+    }
+    put_u64(out, index_offset);
+    out.insert(out.end(), index_magic, index_magic + 4);
+  }
+  return true;
+}
+
+// --- Decoding ---
+// Just enough JSON for OST headers and Huffman tables.
+struct JsonValue {
+  enum Kind { Null, Bool, Number, String, Array, Object } kind = Null;
+  bool boolean = false;
+  double number = 0;
+  std::u16string string;
+  std::vector<JsonValue> items;
+  std::vector<std::pair<std::u16string, JsonValue>> fields;
+
+  const JsonValue* field(const char* name) const {
+    for (const auto& f : fields) {
+      size_t i = 0;
+      while (name[i] && i < f.first.size() && f.first[i] == char16_t(name[i])) i++;
+      if (!name[i] && i == f.first.size()) return &f.second;
+    }
+    return nullptr;
+  }
+};
+
+class JsonParser {
+public:
+  JsonParser(const uint8_t* p, size_t n) : p_(p), end_(p + n) {}
+
+  bool parse(JsonValue& v) {
+    if (!value(v, 0)) return false;
+    ws();
+    return p_ == end_;
+  }
+
+private:
+  void ws() {
+    while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) p_++;
+  }
+
+  bool literal(const char* word) {
+    size_t n = std::strlen(word);
+    if (size_t(end_ - p_) < n || std::memcmp(p_, word, n) != 0) return false;
+    p_ += n;
+    return true;
+  }
+
+  bool value(JsonValue& v, int depth) {
+    if (depth > 32) return false;
+    ws();
+    if (p_ == end_) return false;
+    switch (*p_) {
+      case '{': {
+        v.kind = JsonValue::Object;
+        p_++;
+        ws();
+        if (p_ < end_ && *p_ == '}') { p_++; return true; }
+        for (;;) {
+          ws();
+          std::u16string key;
+          if (p_ == end_ || *p_ != '"' || !string(key)) return false;
+          ws();
+          if (p_ == end_ || *p_++ != ':') return false;
+          v.fields.emplace_back(std::move(key), JsonValue());
+          if (!value(v.fields.back().second, depth + 1)) return false;
+          ws();
+          if (p_ == end_) return false;
+          if (*p_ == ',') { p_++; continue; }
+          if (*p_++ == '}') return true;
+          return false;
+        }
+      }
+      case '[': {
+        v.kind = JsonValue::Array;
+        p_++;
+        ws();
+        if (p_ < end_ && *p_ == ']') { p_++; return true; }
+        for (;;) {
+          v.items.emplace_back();
+          if (!value(v.items.back(), depth + 1)) return false;
+          ws();
+          if (p_ == end_) return false;
+          if (*p_ == ',') { p_++; continue; }
+          if (*p_++ == ']') return true;
+          return false;
+        }
+      }
+      case '"':
+        v.kind = JsonValue::String;
+        return string(v.string);
+      case 't':
+        v.kind = JsonValue::Bool;
+        v.boolean = true;
+        return literal("true");
+      case 'f':
+        v.kind = JsonValue::Bool;
+        return literal("false");
+      case 'n':
+        return literal("null");
+      default: {
+        const uint8_t* start = p_;
+        while (p_ < end_ && (std::strchr("+-.eE", *p_) || (*p_ >= '0' && *p_ <= '9')) && *p_) p_++;
+        if (p_ == start || p_ - start > 32) return false;
+        char buf[40];
+        std::memcpy(buf, start, p_ - start);
+        buf[p_ - start] = 0;
+        char* stop;
+        v.kind = JsonValue::Number;
+        v.number = std::strtod(buf, &stop);
+        return *stop == 0;
+      }
+    }
+  }
+
+  bool hex4(uint32_t& out) {
+    if (end_ - p_ < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; i++) {
+      uint8_t c = *p_++;
+      out <<= 4;
+      if (c >= '0' && c <= '9') out |= c - '0';
+      else if (c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+      else return false;
+    }
+    return true;
+  }
+
+  bool string(std::u16string& out) {
+    p_++;  // opening quote
+    for (;;) {
+      const uint8_t* run = p_;
+      while (p_ < end_ && *p_ != '"' && *p_ != '\\' && *p_ >= 0x20) p_++;
+      append_utf8_as_utf16(run, p_ - run, out);
+      if (p_ == end_ || *p_ < 0x20) return false;
+      if (*p_++ == '"') return true;
+      if (p_ == end_) return false;
+      uint32_t unit;
+      switch (*p_++) {
+        case '"': out.push_back(u'"'); break;
+        case '\\': out.push_back(u'\\'); break;
+        case '/': out.push_back(u'/'); break;
+        case 'b': out.push_back(u'\b'); break;
+        case 'f': out.push_back(u'\f'); break;
+        case 'n': out.push_back(u'\n'); break;
+        case 'r': out.push_back(u'\r'); break;
+        case 't': out.push_back(u'\t'); break;
+        case 'u':
+          if (!hex4(unit)) return false;
+          out.push_back(static_cast<char16_t>(unit));  // surrogate halves pair up on their own
+          break;
+        default: return false;
+      }
+    }
+  }
+
+  const uint8_t* p_;
+  const uint8_t* end_;
+};
+
+// Lookup of the next `bits` bits: codes that short resolve in one step,
+// longer ones resume a tree walk from the node reached. Bins are often only
+// a few KiB, so the table is sized to the longest code, up to MAX_LOOKUP_BITS.
+constexpr uint32_t MAX_LOOKUP_BITS = 11;
+
+struct LookupEntry {
+  int32_t node;
+  uint16_t len;   // 0: internal node at depth `bits`
+  char16_t unit;  // the leaf's symbol when it is a single UTF-16 unit
+};
+
+uint32_t build_lookup(const Huffman& h, const std::vector<std::u16string>& symbols,
+                      std::vector<LookupEntry>& table) {
+  uint32_t bits = 1;
+  for (const Code& c : h.codes) bits = std::max(bits, c.len);
+  bits = std::min(bits, MAX_LOOKUP_BITS);
+
+  table.assign(size_t(1) << bits, { h.root, 0, 0 });
+  struct Frame { int32_t node; uint32_t len; uint32_t bits; };
+  std::vector<Frame> stack{ { h.root, 0, 0 } };
+  while (!stack.empty()) {
+    Frame f = stack.back();
+    stack.pop_back();
+    const HuffNode& n = h.nodes[f.node];
+    if (n.left < 0) {
+      const uint32_t shift = bits - f.len;
+      const std::u16string& sym = symbols[n.symbol];
+      const LookupEntry e{ f.node, static_cast<uint16_t>(f.len), sym.size() == 1 ? sym[0] : u'\0' };
+      std::fill_n(table.begin() + (size_t(f.bits) << shift), size_t(1) << shift, e);
+    } else if (f.len == bits) {
+      table[f.bits] = { f.node, 0, 0 };
+    } else {
+      stack.push_back({ n.left, f.len + 1, f.bits << 1 });
+      stack.push_back({ n.right, f.len + 1, (f.bits << 1) | 1 });
+    }
+  }
+  return bits;
+}
+
+// A Huffman bin with its table parsed, ready to decode from any bit offset.
+struct HuffmanBin {
+  std::vector<std::u16string> symbols;  // leaf symbol = index into this
+  Huffman h;
+  std::vector<LookupEntry> lookup;
+  uint32_t lookup_bits = 0;
+  bool single_units = false;
+  uint64_t total = 0;                   // symbols in the bin
+  const uint8_t* bits = nullptr;
+  size_t bits_len = 0;
+
+  bool parse(const uint8_t* p, size_t n, std::string& error) {
+    if (n < 4 || get_u32(p) > n - 4) {
+      error = "Truncated Huffman table";
+      return false;
+    }
+    const uint32_t table_len = get_u32(p);
+    JsonValue table;
+    if (!JsonParser(p + 4, table_len).parse(table) || table.kind != JsonValue::Array) {
+      error = "Invalid Huffman table";
+      return false;
+    }
+
+    // A Map key is any string, not necessarily one code point.
+    std::vector<Leaf> leaves;
+    for (uint32_t i = 0; i < table.items.size(); i++) {
+      const JsonValue& e = table.items[i];
+      if (e.kind != JsonValue::Array || e.items.size() != 2 || e.items[0].kind != JsonValue::String ||
+          e.items[1].kind != JsonValue::Number || e.items[1].number < 1 || e.items[1].number > 9007199254740991.0) {
+        error = "Invalid Huffman table";
+        return false;
+      }
+      symbols.push_back(e.items[0].string);
+      leaves.push_back({ i, static_cast<uint64_t>(e.items[1].number) });
+      total += leaves.back().count;
+    }
+
+    bits = p + 4 + table_len;
+    bits_len = n - 4 - table_len;
+    if (!h.build(leaves)) {
+      error = "Huffman code longer than 64 bits";
+      return false;
+    }
+    // Every table the TS encoder writes has one-unit symbols outside the
+    // astral planes, so output lengths are known up front.
+    single_units =
+        std::all_of(symbols.begin(), symbols.end(), [](const std::u16string& s) { return s.size() == 1; });
+    if (leaves.size() >= 2) lookup_bits = build_lookup(h, symbols, lookup);
+    return true;
+  }
+
+  // Appends symbols starting at bit `offset` of the code stream until
+  // max_symbols symbols or at least max_units units are out.
+  bool decode(uint64_t offset, uint64_t max_symbols, size_t max_units,
+              std::u16string& out, std::string& error) const {
+    const size_t base = out.size();
+    if (symbols.size() < 2) {
+      // Zero-length code: the count alone says how many.
+      for (uint64_t i = 0; symbols.size() == 1 && !symbols[0].empty() && i < max_symbols &&
+                           out.size() - base < max_units; i++)
+        out += symbols[0];
+      return true;
+    }
+
+    BitReader r(bits, bits_len, offset);
+    auto walk = [&](int32_t node) {
+      r.skip(lookup_bits);
+      while (h.nodes[node].left >= 0) node = r.bit() ? h.nodes[node].right : h.nodes[node].left;
+      return node;
+    };
+    if (single_units) {
+      const size_t n = static_cast<size_t>(std::min<uint64_t>(max_symbols, max_units));
+      out.resize(base + n);
+      char16_t* dst = &out[base];
+      for (size_t i = 0; i < n; i++) {
+        const LookupEntry& e = lookup[r.peek(lookup_bits)];
+        if (e.len) {
+          r.skip(e.len);
+          dst[i] = e.unit;
+        } else {
+          dst[i] = symbols[h.nodes[walk(e.node)].symbol][0];
+        }
+      }
+    } else {
+      for (uint64_t i = 0; i < max_symbols && out.size() - base < max_units; i++) {
+        const LookupEntry& e = lookup[r.peek(lookup_bits)];
+        int32_t node = e.node;
+        if (e.len) r.skip(e.len);
+        else node = walk(node);
+        out += symbols[h.nodes[node].symbol];
+      }
+    }
+    if (r.overrun()) {
+      error = "Truncated Huffman data";
+      return false;
+    }
+    return true;
+  }
+};
+
+bool huffman_decompress(const uint8_t* p, size_t n, std::u16string& out, std::string& error) {
+  HuffmanBin bin;
+  if (!bin.parse(p, n, error)) return false;
+  if (bin.symbols.size() == 1 && bin.total * bin.symbols[0].size() > 0xffffffffULL) {
+    error = "Invalid Huffman table";
+    return false;
+  }
+  if (bin.symbols.size() >= 2 && bin.total > 8 * uint64_t(bin.bits_len)) {
+    error = "Truncated Huffman data";
+    return false;
+  }
+  return bin.decode(0, bin.total, SIZE_MAX, out, error);
+}
+
+bool decompress_bin(const uint8_t* p, size_t n, const std::string& method,
+                    std::u16string& out, std::string& error) {
+  out.clear();
+  if (method == "huffman") return huffman_decompress(p, n, out, error);
+  BinCodec codec;
+  if (bin_codec_from_name(method, codec)) {
+    std::vector<uint8_t> utf8;
+    if (!bin_decompress(codec, p, n, utf8, error)) return false;
+    append_utf8_as_utf16(utf8.data(), utf8.size(), out);
+    return true;
+  }
+  append_utf8_as_utf16(p, n, out);
+  return true;
+}
+}  // namespace
+
+void utf16_to_utf8(const char16_t* s, size_t n, std::string& out) {
+  out.clear();
+  out.reserve(n);
+  size_t ascii = 0;
+  while (ascii < n && s[ascii] < 0x80) ascii++;
+  out.resize(ascii);
+  for (size_t i = 0; i < ascii; i++) out[i] = static_cast<char>(s[i]);
+  for (size_t i = ascii; i < n;) {
+    uint32_t cp;
+    i = next_code_point(s, i, n, cp);
+    append_utf8(out, cp >= 0xD800 && cp <= 0xDFFF ? 0xFFFD : cp);
+  }
+}
+
+bool ost_encode(const uint8_t* text, size_t len, const OstConfig& config,
+                std::vector<uint8_t>& out, std::string& error) {
+  if (is_ascii(text, len)) return encode_text(text, len, config, out, error);
+  std::u16string wide;
+  wide.reserve(len);
+  append_utf8_as_utf16(text, len, wide);
+  return encode_text(wide.data(), wide.size(), config, out, error);
+}
+
+bool ost_encode_utf16(const char16_t* text, size_t len, const OstConfig& config,
+                      std::vector<uint8_t>& out, std::string& error) {
+  return encode_text(text, len, config, out, error);
+}
+
+bool ost_read_index(const uint8_t* pack, size_t len, OstPackIndex& index, std::string& error) {
+  static constexpr size_t FIXED = 36, TRAILER = 12, RECORD = 8, ENTRY = 20;
+  if (len < 8 + FIXED + TRAILER || std::memcmp(pack, "OST1", 4) != 0 ||
+      std::memcmp(pack + len - 4, "OSTI", 4) != 0) {
+    error = "OST pack has no index";
+    return false;
+  }
+  const uint64_t offset = get_u64(pack + len - TRAILER);
+  if (offset < 8 || offset > len - TRAILER - FIXED || std::memcmp(pack + offset, "OSTI", 4) != 0) {
+    error = "Invalid OST index";
+    return false;
+  }
+  const uint8_t* p = pack + offset;
+  index.offset = offset;
+  index.method = get_u32(p + 4);
+  index.binCount = get_u32(p + 8);
+  index.windowCount = get_u32(p + 12);
+  index.windowLength = get_u32(p + 16);
+  index.units = get_u64(p + 20);
+  index.bytes = get_u64(p + 28);
+  index.records = p + FIXED;
+  index.windows = index.records + RECORD * size_t(index.binCount);
+  const uint64_t windows = index.windowLength ? (index.units + index.windowLength - 1) / index.windowLength : 0;
+  if (index.method > OST_METHOD_HUFFMAN || !index.windowLength || windows != index.windowCount ||
+      offset + FIXED + RECORD * uint64_t(index.binCount) + ENTRY * uint64_t(index.windowCount) + TRAILER != len) {
+    error = "Invalid OST index";
+    return false;
+  }
+  return true;
+}
+
+bool ost_decode(const uint8_t* pack, size_t len, OstDecoded& out, std::string& error) {
+  if (len < 8 || std::memcmp(pack, "OST1", 4) != 0) {
+    error = "Invalid OST pack format";
+    return false;
+  }
+  const uint32_t header_len = get_u32(pack + 4);
+  if (header_len > len - 8) {
+    error = "Truncated OST header";
+    return false;
+  }
+  out.header.assign(reinterpret_cast<const char*>(pack + 8), header_len);
+
+  JsonValue header;
+  if (!JsonParser(pack + 8, header_len).parse(header) || header.kind != JsonValue::Object) {
+    error = "Invalid OST header";
+    return false;
+  }
+
+  // Missing config fields fall back to the OSTCompression defaults.
+  OstConfig defaults;
+  out.compressionMethod = defaults.compressionMethod;
+  out.windowLength = defaults.windowLength;
+  if (const JsonValue* config = header.field("config")) {
+    const JsonValue* method = config->field("compressionMethod");
+    if (method && method->kind == JsonValue::String)
+      utf16_to_utf8(method->string.data(), method->string.size(), out.compressionMethod);
+    const JsonValue* window = config->field("windowLength");
+    if (window && window->kind == JsonValue::Number && window->number >= 1 && window->number <= 0xffffffff)
+      out.windowLength = static_cast<uint32_t>(window->number);
+  }
+
+  // Indexed packs end their bins where the index starts.
+  OstPackIndex index;
+  const JsonValue* indexed = header.field("index");
+  const bool has_index = indexed && indexed->kind == JsonValue::Bool && indexed->boolean;
+  if (has_index) {
+    if (!ost_read_index(pack, len, index, error)) return false;
+    len = index.offset;
+  }
+
+  // Streamed packs repeat labels across blocks and interleave order records.
+  const JsonValue* stream = header.field("stream");
+  const bool streamed = stream && stream->kind == JsonValue::Bool && stream->boolean;
+  std::unordered_map<std::string, uint32_t> stream_bins;
+  std::vector<uint32_t> block_bins;  // the bin each payload belongs to
+  std::vector<uint32_t> order;
+
+  size_t offset = 8 + size_t(header_len);
+  out.labels.clear();
+  out.bins.clear();
+  std::vector<std::pair<const uint8_t*, uint32_t>> payloads;
+  while (offset < len) {
+    if (len - offset < 2) {
+      error = "Truncated OST bin";
+      return false;
+    }
+    const size_t label_len = (size_t(pack[offset]) << 8) | pack[offset + 1];
+    if (len - offset - 2 < label_len + 4) {
+      error = "Truncated OST bin";
+      return false;
+    }
+    const uint8_t* label = pack + offset + 2;
+    const uint32_t data_len = get_u32(label + label_len);
+    const uint8_t* data = label + label_len + 4;
+    if (size_t(pack + len - data) < data_len) {
+      error = "Truncated OST bin";
+      return false;
+    }
+    offset = (data - pack) + data_len;
+
+    if (streamed && label_len == 0) {
+      if (data_len % 4) {
+        error = "Invalid window order";
+        return false;
+      }
+      for (uint32_t i = 0; i < data_len; i += 4) {
+        const uint32_t b = get_u32(data + i);
+        if (b >= out.labels.size()) {
+          error = "Invalid window order";
+          return false;
+        }
+        order.push_back(b);
+      }
+      continue;
+    }
+    if (streamed) {
+      auto it = stream_bins.emplace(std::string(reinterpret_cast<const char*>(label), label_len),
+                                    static_cast<uint32_t>(out.labels.size()));
+      if (it.second) {
+        out.labels.emplace_back();
+        append_utf8_as_utf16(label, label_len, out.labels.back());
+      }
+      block_bins.push_back(it.first->second);
+    } else {
+      out.labels.emplace_back();
+      append_utf8_as_utf16(label, label_len, out.labels.back());
+    }
+    payloads.emplace_back(data, data_len);
+  }
+
+  // Bins decompress independently, like they were compressed. A streamed
+  // bin's blocks are joined in pack order.
+  std::vector<std::u16string> blocks(payloads.size());
+  std::vector<std::string> errors(payloads.size());
+  for_each_bin(payloads.size(), len - 8 - header_len, [&](size_t b) {
+    decompress_bin(payloads[b].first, payloads[b].second, out.compressionMethod, blocks[b], errors[b]);
+  });
+  for (const std::string& e : errors) {
+    if (!e.empty()) {
+      error = e;
+      return false;
+    }
+  }
+  if (streamed) {
+    out.bins.resize(out.labels.size());
+    for (size_t i = 0; i < blocks.size(); i++) {
+      std::u16string& bin = out.bins[block_bins[i]];
+      if (bin.empty()) bin.swap(blocks[i]);
+      else bin += blocks[i];
+      std::u16string().swap(blocks[i]);
+    }
+  } else {
+    out.bins.swap(blocks);
+  }
+
+  // Every window but the last is exactly windowLength units, and the last
+  // one is also the last in its bin, so bins split back apart greedily.
+  out.data.clear();
+  const JsonValue* window_bins = header.field("windowBins");
+  if (streamed) {
+    out.ordered = true;
+  } else if (window_bins && window_bins->kind == JsonValue::Array) {
+    for (const JsonValue& b : window_bins->items) {
+      if (b.kind != JsonValue::Number || b.number < 0 || b.number >= out.bins.size()) {
+        error = "Invalid window order";
+        return false;
+      }
+      order.push_back(static_cast<uint32_t>(b.number));
+    }
+    out.ordered = true;
+  } else if (has_index) {
+    for (uint32_t w = 0; w < index.windowCount; w++) {
+      const uint32_t b = get_u32(index.windows + 20 * size_t(w)) & OST_WINDOW_BIN_MASK;
+      if (b >= out.bins.size()) {
+        error = "Invalid window order";
+        return false;
+      }
+      order.push_back(b);
+    }
+    out.ordered = true;
+  } else {
+    out.ordered = false;
+  }
+  if (out.ordered) {
+    std::vector<size_t> cursor(out.bins.size(), 0);
+    for (const uint32_t bin : order) {
+      const std::u16string& src = out.bins[bin];
+      const size_t take = std::min<size_t>(out.windowLength, src.size() - cursor[bin]);
+      out.data.append(src, cursor[bin], take);
+      cursor[bin] += take;
+    }
+  }
+  return true;
+}
+
+// --- Ranged reads ---
+struct OstPackView::Bin {
+  HuffmanBin huffman;
+  const uint8_t* data = nullptr;  // raw bins: the UTF-8 bytes
+  size_t len = 0;
+};
+
+// Sequential readers ask for a few KiB at a time; decoding at least this
+// much per miss keeps them from re-decoding the same window.
+static constexpr uint64_t OST_READ_AHEAD = 16 * 1024;
+
+OstPackView::OstPackView() = default;
+OstPackView::~OstPackView() = default;
+
+bool OstPackView::open(const uint8_t* pack, size_t len, std::string& error) {
+  if (!ost_read_index(pack, len, index_, error)) return false;
+  pack_ = pack;
+  len_ = len;
+  bins_.clear();
+  bins_.resize(index_.binCount);
+  span_begin_ = 0;
+  span_.clear();
+  return true;
+}
+
+uint64_t OstPackView::window_byte(uint32_t w) const {
+  return w < index_.windowCount ? get_u64(index_.windows + 20 * size_t(w) + 12) : index_.bytes;
+}
+
+bool OstPackView::decode_window(uint32_t w, size_t units, std::u16string& out, std::string& error) {
+  const uint8_t* entry = index_.windows + 20 * size_t(w);
+  const uint32_t flags = get_u32(entry);
+  const uint32_t b = flags & OST_WINDOW_BIN_MASK;
+  if (b >= index_.binCount) {
+    error = "Invalid OST index";
+    return false;
+  }
+
+  if (!bins_[b]) {
+    // Record: u16 labelLen | label | u32 dataLen | data, all before the index.
+    const uint64_t record = get_u64(index_.records + 8 * size_t(b));
+    if (record < 8 || record > index_.offset - 2) {
+      error = "Invalid OST index";
+      return false;
+    }
+    const uint64_t label_len = (uint64_t(pack_[record]) << 8) | pack_[record + 1];
+    if (index_.offset - record - 2 < label_len + 4) {
+      error = "Truncated OST bin";
+      return false;
+    }
+    const uint8_t* data = pack_ + record + 2 + label_len + 4;
+    const uint32_t data_len = get_u32(data - 4);
+    if (uint64_t(pack_ + index_.offset - data) < data_len) {
+      error = "Truncated OST bin";
+      return false;
+    }
+    auto bin = std::make_unique<Bin>();
+    if (index_.method == OST_METHOD_HUFFMAN && !bin->huffman.parse(data, data_len, error)) return false;
+    bin->data = data;
+    bin->len = data_len;
+    bins_[b] = std::move(bin);
+  }
+  const Bin& bin = *bins_[b];
+
+  const uint64_t bit = get_u64(entry + 4);
+  const size_t skip = (flags & OST_WINDOW_STRADDLE) ? 1 : 0;
+  const size_t need = skip + units;
+  const size_t base = out.size();
+  if (index_.method == OST_METHOD_HUFFMAN) {
+    if (!bin.huffman.decode(bit, need, need, out, error)) return false;
+  } else {
+    // A unit takes at most three bytes of UTF-8.
+    const uint64_t at = bit / 8;
+    if (at > bin.len) {
+      error = "Invalid OST index";
+      return false;
+    }
+    append_utf8_as_utf16(bin.data + at, static_cast<size_t>(std::min<uint64_t>(bin.len - at, 3 * uint64_t(need) + 4)), out);
+  }
+  if (out.size() - base < need) {
+    error = "Truncated OST bin";
+    return false;
+  }
+  out.erase(base, skip);
+  out.resize(base + units);
+  return true;
+}
+
+bool OstPackView::fill(uint64_t pos, uint64_t end, std::string& error) {
+  span_.clear();
+  const uint32_t windows = index_.windowCount;
+  const uint64_t window = index_.windowLength;
+
+  // First window: the last one starting at or before pos.
+  uint32_t lo = 0, hi = windows;
+  while (hi - lo > 1) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (window_byte(mid) <= pos) lo = mid;
+    else hi = mid;
+  }
+  const uint32_t first = lo;
+  const uint64_t want = std::max(end, pos + OST_READ_AHEAD);
+  uint32_t last = first;
+  while (last + 1 < windows && window_byte(last + 1) < want) last++;
+
+  units_.clear();
+  for (uint32_t w = first; w <= last; w++) {
+    const size_t units = static_cast<size_t>(std::min<uint64_t>(window, index_.units - w * window));
+    if (!decode_window(w, units, units_, error)) return false;
+  }
+  // Bytes are attributed to the window a pair starts in: finish a pair cut
+  // at the end, and drop the tail of one cut at the start.
+  if (last + 1 < windows && (get_u32(index_.windows + 20 * size_t(last + 1)) & OST_WINDOW_PAIR_TAIL) &&
+      !decode_window(last + 1, 1, units_, error))
+    return false;
+  const size_t drop = (get_u32(index_.windows + 20 * size_t(first)) & OST_WINDOW_PAIR_TAIL) ? 1 : 0;
+  utf16_to_utf8(units_.data() + drop, units_.size() - drop, span_);
+
+  span_begin_ = window_byte(first);
+  if (span_.size() != window_byte(last + 1) - span_begin_ || pos < span_begin_ ||
+      pos >= span_begin_ + span_.size()) {
+    span_.clear();
+    error = "Invalid OST index";
+    return false;
+  }
+  return true;
+}
+
+bool OstPackView::read(uint64_t pos, uint8_t* dst, size_t len, size_t& n, std::string& error) {
+  std::lock_guard<std::mutex> lock(mu_);
+  n = 0;
+  if (pos >= index_.bytes) return true;
+  const uint64_t end = pos + std::min<uint64_t>(len, index_.bytes - pos);
+  while (pos < end) {
+    if ((pos < span_begin_ || pos >= span_begin_ + span_.size()) && !fill(pos, end, error)) return false;
+    const size_t take = static_cast<size_t>(std::min<uint64_t>(end - pos, span_begin_ + span_.size() - pos));
+    std::memcpy(dst + n, span_.data() + (pos - span_begin_), take);
+    n += take;
+    pos += take;
+  }
+  return true;
+}
+
+// --- Streaming ---
+// Order records are written once this many windows are waiting.
+static constexpr size_t OST_STREAM_ORDER_WINDOWS = 16 * 1024;
+static constexpr uint32_t OST_STREAM_NO_ORDINAL = UINT32_MAX;
+
+// UTF-8 sequence length for a lead byte, 0 if it cannot start one.
+static size_t utf8_sequence_length(uint8_t lead) {
+  if (lead >= 0xC2 && lead <= 0xDF) return 2;
+  if (lead >= 0xE0 && lead <= 0xEF) return 3;
+  if (lead >= 0xF0 && lead <= 0xF4) return 4;
+  return 0;
+}
+
+// Whether b can be byte i (>= 1) of a sequence starting with lead, with the
+// same overlong/surrogate limits as append_utf8_as_utf16.
+static bool utf8_continues(uint8_t lead, size_t i, uint8_t b) {
+  uint8_t lo = 0x80, hi = 0xBF;
+  if (i == 1) {
+    if (lead == 0xE0) lo = 0xA0;
+    if (lead == 0xED) hi = 0x9F;
+    if (lead == 0xF0) lo = 0x90;
+    if (lead == 0xF4) hi = 0x8F;
+  }
+  return b >= lo && b <= hi;
+}
+
+// Length of a UTF-8 sequence cut off at the end of s[0, n), 0 if there is
+// none. Bytes that could never complete are left for the decoder to replace.
+static size_t utf8_partial_tail(const uint8_t* s, size_t n) {
+  for (size_t k = 1; k <= 3 && k <= n; k++) {
+    const uint8_t lead = s[n - k];
+    if (lead >= 0x80 && lead <= 0xBF) continue;
+    if (k >= utf8_sequence_length(lead)) return 0;
+    for (size_t i = 1; i < k; i++)
+      if (!utf8_continues(lead, i, s[n - k + i])) return 0;
+    return k;
+  }
+  return 0;
+}
+
+struct OstStreamEncoder::State {
+  struct Bin {
+    std::string label;          // UTF-8, as written
+    std::u16string text;        // windows not yet compressed, back to back
+    uint32_t ordinal = OST_STREAM_NO_ORDINAL;
+    bool queued = false;
+  };
+
+  OstConfig config;
+  size_t block_units = 0;
+  size_t limit_units = 0;
+  std::vector<Bin> bins;
+  // Keyed by the UTF-8 label: labels differing only in lone surrogates
+  // are written the same, so they share a bin.
+  std::unordered_map<std::string, uint32_t> ids;
+  std::vector<uint32_t> order;  // bin of each window since the last order record
+  std::vector<uint32_t> due;    // bins to compress at the end of this call
+  uint32_t ordinals = 0;
+  size_t buffered = 0;          // units held across all bins
+  std::u16string window;        // the window still being filled
+  std::string partial;          // UTF-8 sequence split across write() calls
+  std::u16string units;         // write()'s decoded chunk
+  Scratch scratch;
+  std::u16string label;
+  std::string label8;
+  bool header = false;
+  bool finishing = false;
+  bool finished = false;
+
+  size_t block_end(const Bin& bin) const;
+  bool add_window(const char16_t* p, size_t n, std::string& error);
+  bool flush(std::vector<uint8_t>& out, std::string& error);
+  bool flush_order(std::vector<uint8_t>& out, std::string& error);
+  bool consume(const char16_t* p, size_t n, std::vector<uint8_t>& out, std::string& error);
+};
+
+bool OstStreamEncoder::State::add_window(const char16_t* p, size_t n, std::string& error) {
+  scratch.counter.count(p, n, scratch.leaves);
+  if (!scratch.huffman.build(scratch.leaves)) {
+    error = "Huffman code longer than 64 bits";
+    return false;
+  }
+  make_label(scratch, config.labelLength, label);
+  utf16_to_utf8(label.data(), label.size(), label8);
+
+  auto it = ids.find(label8);
+  uint32_t b;
+  if (it == ids.end()) {
+    if (label8.size() > 0xffff) {
+      error = "Bin too large for the OST1 format";
+      return false;
+    }
+    b = static_cast<uint32_t>(bins.size());
+    ids.emplace(label8, b);
+    bins.emplace_back();
+    bins.back().label = label8;
+  } else {
+    b = it->second;
+  }
+  Bin& bin = bins[b];
+  bin.text.append(p, n);
+  buffered += n;
+  order.push_back(b);
+  if (bin.text.size() >= block_units && !bin.queued) {
+    bin.queued = true;
+    due.push_back(b);
+  }
+  return true;
+}
+
+// A block stops short of a trailing high surrogate, which stays behind
+// for the next one: a pair split between blocks would otherwise reach
+// UTF-8 bins as two U+FFFD where ostEncode keeps the character.
+size_t OstStreamEncoder::State::block_end(const Bin& bin) const {
+  const size_t n = bin.text.size();
+  return !finishing && n && bin.text[n - 1] >= 0xD800 && bin.text[n - 1] <= 0xDBFF ? n - 1 : n;
+}
+
+// Compresses every queued bin, spread over the WorkerPool, and writes the
+// blocks in queue order.
+bool OstStreamEncoder::State::flush(std::vector<uint8_t>& out, std::string& error) {
+  if (due.empty()) return true;
+  size_t units = 0;
+  for (uint32_t b : due) units += bins[b].text.size();
+  std::vector<std::vector<uint8_t>> payloads(due.size());
+  std::vector<std::string> errors(due.size());
+  for_each_bin(due.size(), units, [&](size_t i) {
+    const Bin& bin = bins[due[i]];
+    Scratch s;
+    if (!compress_bin(bin.text.data(), block_end(bin), config, s, payloads[i], nullptr, nullptr, errors[i]) &&
+        errors[i].empty())
+      errors[i] = "Bin compression failed";
+  });
+
+  for (size_t i = 0; i < due.size(); i++) {
+    if (!errors[i].empty()) {
+      error = errors[i];
+      return false;
+    }
+    Bin& bin = bins[due[i]];
+    if (payloads[i].size() > 0xffffffffULL) {
+      error = "Bin too large for the OST1 format";
+      return false;
+    }
+    if (bin.ordinal == OST_STREAM_NO_ORDINAL) bin.ordinal = ordinals++;
+    put_u16(out, static_cast<uint32_t>(bin.label.size()));
+    out.insert(out.end(), bin.label.begin(), bin.label.end());
+    put_u32(out, static_cast<uint32_t>(payloads[i].size()));
+    out.insert(out.end(), payloads[i].begin(), payloads[i].end());
+
+    const size_t end = block_end(bin);
+    buffered -= end;
+    std::u16string(bin.text, end).swap(bin.text);
+    bin.queued = false;
+  }
+  due.clear();
+  return true;
+}
+
+// Writes the pending window order. Bins that have no block yet get one
+// first, so every bin it names already has its number.
+bool OstStreamEncoder::State::flush_order(std::vector<uint8_t>& out, std::string& error) {
+  if (!flush(out, error)) return false;
+  for (uint32_t b : order) {
+    if (bins[b].ordinal == OST_STREAM_NO_ORDINAL && !bins[b].queued) {
+      bins[b].queued = true;
+      due.push_back(b);
+    }
+  }
+  if (!flush(out, error)) return false;
+  if (order.empty()) return true;
+
+  put_u16(out, 0);
+  put_u32(out, static_cast<uint32_t>(4 * order.size()));
+  for (uint32_t b : order) put_u32(out, bins[b].ordinal);
+  order.clear();
+  return true;
+}
+
+bool OstStreamEncoder::State::consume(const char16_t* p, size_t n, std::vector<uint8_t>& out,
+                                      std::string& error) {
+  const size_t w = config.windowLength;
+  if (!window.empty()) {
+    const size_t take = std::min(n, w - window.size());
+    window.append(p, take);
+    p += take;
+    n -= take;
+    if (window.size() == w) {
+      if (!add_window(window.data(), w, error)) return false;
+      window.clear();
+    }
+  }
+  for (; n >= w; p += w, n -= w)
+    if (!add_window(p, w, error)) return false;
+  window.append(p, n);
+
+  if (!flush(out, error)) return false;
+  // Over the limit: compress the largest bins until half of it is left.
+  if (buffered > limit_units) {
+    std::vector<uint32_t> largest;
+    for (uint32_t b = 0; b < bins.size(); b++)
+      if (!bins[b].text.empty()) largest.push_back(b);
+    std::sort(largest.begin(), largest.end(),
+              [&](uint32_t a, uint32_t b) { return bins[a].text.size() > bins[b].text.size(); });
+    size_t left = buffered;
+    for (uint32_t b : largest) {
+      if (left <= limit_units / 2) break;
+      left -= bins[b].text.size();
+      bins[b].queued = true;
+      due.push_back(b);
+    }
+    if (!flush(out, error)) return false;
+  }
+  return order.size() < OST_STREAM_ORDER_WINDOWS || flush_order(out, error);
+}
+
+OstStreamEncoder::OstStreamEncoder() = default;
+OstStreamEncoder::~OstStreamEncoder() = default;
+
+bool OstStreamEncoder::start(const OstConfig& config, size_t blockBytes, size_t memoryLimit,
+                             std::string& error) {
+  if (config.windowLength == 0) {
+    error = "windowLength must be positive";
+    return false;
+  }
+  if (config.index) {
+    error = "Streamed OST packs cannot be indexed";
+    return false;
+  }
+  if (blockBytes == 0 || blockBytes > memoryLimit) {
+    error = "blockSize must be positive and no larger than memoryLimit";
+    return false;
+  }
+  s_.reset(new State());
+  s_->config = config;
+  s_->block_units = std::max<size_t>(blockBytes / 2, 1);
+  s_->limit_units = std::max<size_t>(memoryLimit / 2, 1);
+  return true;
+}
+
+bool OstStreamEncoder::write(const uint8_t* text, size_t len, std::vector<uint8_t>& out,
+                             std::string& error) {
+  if (!s_ || s_->finished) {
+    error = "OST stream is finished";
+    return false;
+  }
+  State& s = *s_;
+  s.units.clear();
+  if (!s.partial.empty()) {
+    // Finish the sequence the last chunk split, or let it decode to U+FFFD
+    // at the first byte that cannot continue it.
+    const uint8_t lead = static_cast<uint8_t>(s.partial[0]);
+    const size_t need = utf8_sequence_length(lead);
+    size_t used = 0;
+    while (s.partial.size() < need && used < len && utf8_continues(lead, s.partial.size(), text[used]))
+      s.partial.push_back(static_cast<char>(text[used++]));
+    if (s.partial.size() < need && used == len) return true;
+    append_utf8_as_utf16(reinterpret_cast<const uint8_t*>(s.partial.data()), s.partial.size(), s.units);
+    s.partial.clear();
+    text += used;
+    len -= used;
+  }
+  const size_t held = utf8_partial_tail(text, len);
+  append_utf8_as_utf16(text, len - held, s.units);
+  s.partial.assign(reinterpret_cast<const char*>(text + len - held), held);
+  return write_utf16(s.units.data(), s.units.size(), out, error);
+}
+
+bool OstStreamEncoder::write_utf16(const char16_t* text, size_t len, std::vector<uint8_t>& out,
+                                   std::string& error) {
+  if (!s_ || s_->finished) {
+    error = "OST stream is finished";
+    return false;
+  }
+  State& s = *s_;
+  if (!s.header) {
+    const std::string header = "{\"config\":" + config_json(s.config) + ",\"stream\":true}";
+    static const uint8_t magic[4] = { 'O', 'S', 'T', '1' };
+    out.insert(out.end(), magic, magic + 4);
+    put_u32(out, static_cast<uint32_t>(header.size()));
+    out.insert(out.end(), header.begin(), header.end());
+    s.header = true;
+  }
+  return s.consume(text, len, out, error);
+}
+
+bool OstStreamEncoder::finish(std::vector<uint8_t>& out, std::string& error) {
+  if (!s_ || s_->finished) {
+    error = "OST stream is finished";
+    return false;
+  }
+  State& s = *s_;
+  // A split sequence the input never completed decodes to U+FFFD.
+  std::u16string tail;
+  append_utf8_as_utf16(reinterpret_cast<const uint8_t*>(s.partial.data()), s.partial.size(), tail);
+  s.partial.clear();
+  if (!write_utf16(tail.data(), tail.size(), out, error)) return false;
+  if (!s.window.empty() && !s.add_window(s.window.data(), s.window.size(), error)) return false;
+  s.window.clear();
+  s.finishing = true;
+
+  for (uint32_t b = 0; b < s.bins.size(); b++) {
+    if (!s.bins[b].text.empty() && !s.bins[b].queued) {
+      s.bins[b].queued = true;
+      s.due.push_back(b);
+    }
+  }
+  if (!s.flush_order(out, error)) return false;
+  s.finished = true;
+  return true;
+}
+
+// --- N-API ---
+static bool get_uint_option(napi_env env, napi_value options, const char* name, uint32_t* out) {
+  napi_value v;
+  napi_valuetype type;
+  int64_t n;
+  if (napi_get_named_property(env, options, name, &v) != napi_ok ||
+      napi_typeof(env, v, &type) != napi_ok || type != napi_number)
+    return true;
+  napi_get_value_int64(env, v, &n);
+  if (n < 0 || n > 0xffffffffLL) return false;
+  *out = static_cast<uint32_t>(n);
+  return true;
+}
+
+static void get_bool_option(napi_env env, napi_value options, const char* name, bool* out) {
+  napi_value v;
+  napi_valuetype type;
+  if (napi_get_named_property(env, options, name, &v) == napi_ok &&
+      napi_typeof(env, v, &type) == napi_ok && type == napi_boolean)
+    napi_get_value_bool(env, v, out);
+}
+
+static bool is_array_index(const std::u16string& key) {
+  if (key.empty() || key.size() > 10 || (key[0] == u'0' && key.size() > 1)) return false;
+  uint64_t n = 0;
+  for (char16_t c : key) {
+    if (c < u'0' || c > u'9') return false;
+    n = n * 10 + (c - u'0');
+  }
+  return n < 0xffffffffULL;
+}
+
+// Keys the header config does not carry through as extra members: the
+// OSTConfig fields config_json writes itself, and encoder-only options.
+static bool is_config_option(const std::u16string& key) {
+  static const char16_t* const names[] = {
+      u"windowLength", u"labelLength", u"variableWindow", u"compressionMethod", u"subBinning",
+      u"subBinningDepth", u"recordOrder", u"index", u"compressionLevel", u"blockSize", u"memoryLimit"};
+  for (const char16_t* name : names)
+    if (key == name) return true;
+  return false;
+}
+
+// Serializes the remaining own enumerable keys of options with JSON.stringify,
+// dropping the ones it would (undefined, functions, symbols).
+static void get_extra_keys(napi_env env, napi_value options, OstConfig& config) {
+  napi_value keys, global, json, stringify;
+  uint32_t count = 0;
+  if (napi_get_all_property_names(env, options, napi_key_own_only,
+                                  static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols),
+                                  napi_key_numbers_to_strings, &keys) != napi_ok ||
+      napi_get_array_length(env, keys, &count) != napi_ok || count == 0 ||
+      napi_get_global(env, &global) != napi_ok ||
+      napi_get_named_property(env, global, "JSON", &json) != napi_ok ||
+      napi_get_named_property(env, json, "stringify", &stringify) != napi_ok)
+    return;
+
+  for (uint32_t i = 0; i < count; i++) {
+    napi_value key, value, str;
+    napi_valuetype type;
+    size_t len = 0;
+    if (napi_get_element(env, keys, i, &key) != napi_ok ||
+        napi_get_value_string_utf16(env, key, nullptr, 0, &len) != napi_ok)
+      continue;
+    std::u16string name(len, u'\0');
+    napi_get_value_string_utf16(env, key, &name[0], len + 1, &len);
+    if (is_config_option(name) || napi_get_property(env, options, key, &value) != napi_ok ||
+        napi_call_function(env, json, stringify, 1, &value, &str) != napi_ok ||
+        napi_typeof(env, str, &type) != napi_ok || type != napi_string)
+      continue;
+
+    std::string& members = is_array_index(name) ? config.leadingKeys : config.trailingKeys;
+    members += ',';
+    append_json_string(members, name);
+    members += ':';
+    size_t start = members.size();
+    napi_get_value_string_utf8(env, str, nullptr, 0, &len);
+    members.resize(start + len);
+    napi_get_value_string_utf8(env, str, &members[start], len + 1, &len);
+  }
+}
+
+// { windowLength?, labelLength?, variableWindow?, compressionMethod?, subBinning?,
+//   subBinningDepth?, recordOrder?, index?, compressionLevel? } -- other keys are copied
+// into the header's config as JSON.stringify writes them.
+bool ost_get_config(napi_env env, napi_value options, OstConfig& config) {
+  napi_valuetype type;
+  if (!options || napi_typeof(env, options, &type) != napi_ok || type != napi_object) return true;
+  if (!get_uint_option(env, options, "windowLength", &config.windowLength) ||
+      !get_uint_option(env, options, "labelLength", &config.labelLength) ||
+      !get_uint_option(env, options, "subBinningDepth", &config.subBinningDepth) ||
+      !get_uint_option(env, options, "compressionLevel", &config.compressionLevel))
+    return false;
+  get_bool_option(env, options, "variableWindow", &config.variableWindow);
+  get_bool_option(env, options, "subBinning", &config.subBinning);
+  get_bool_option(env, options, "recordOrder", &config.recordOrder);
+  get_bool_option(env, options, "index", &config.index);
+
+  napi_value v;
+  if (napi_get_named_property(env, options, "compressionMethod", &v) == napi_ok &&
+      napi_typeof(env, v, &type) == napi_ok && type == napi_string) {
+    size_t len = 0;
+    napi_get_value_string_utf8(env, v, nullptr, 0, &len);
+    config.compressionMethod.resize(len);
+    napi_get_value_string_utf8(env, v, &config.compressionMethod[0], len + 1, &len);
+  }
+  get_extra_keys(env, options, config);
+  return config.windowLength > 0;
+}
+
+static napi_value new_buffer_copy(napi_env env, const void* data, size_t len) {
+  napi_value result;
+  if (napi_create_buffer_copy(env, len, data, nullptr, &result) != napi_ok) return nullptr;
+  return result;
+}
+
+static napi_value utf16_buffer(napi_env env, const std::u16string& s) {
+  std::string utf8;
+  utf16_to_utf8(s.data(), s.size(), utf8);
+  return new_buffer_copy(env, utf8.data(), utf8.size());
+}
+
+napi_value OstEncode(napi_env env, napi_callback_info info) {
+  // Parse arguments: [data: Buffer | string, options?] -> OST1 pack
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  OstConfig config;
+  if (!ost_get_config(env, argc > 1 ? args[1] : nullptr, config)) {
+    napi_throw_error(env, nullptr, "windowLength must be a positive integer and labelLength non-negative");
+    return nullptr;
+  }
+
+  std::vector<uint8_t> out;
+  std::string error;
+  bool ok;
+  bool is_buffer = false;
+  napi_valuetype type;
+  napi_is_buffer(env, args[0], &is_buffer);
+  napi_typeof(env, args[0], &type);
+  if (is_buffer) {
+    void* data;
+    size_t len;
+    napi_get_buffer_info(env, args[0], &data, &len);
+    ok = ost_encode(static_cast<const uint8_t*>(data), len, config, out, error);
+  } else if (type == napi_string) {
+    size_t len = 0;
+    napi_get_value_string_utf16(env, args[0], nullptr, 0, &len);
+    std::u16string text(len, u'\0');
+    napi_get_value_string_utf16(env, args[0], &text[0], len + 1, &len);
+    ok = ost_encode_utf16(text.data(), text.size(), config, out, error);
+  } else {
+    napi_throw_error(env, nullptr, "Data must be a buffer or a string");
+    return nullptr;
+  }
+
+  if (!ok) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  return new_buffer_copy(env, out.data(), out.size());
+}
+
+napi_value OstDecode(napi_env env, napi_callback_info info) {
+  // Parse arguments: [pack] -> { header, labels, bins, data }
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  bool is_buffer = false;
+  if (argc > 0) napi_is_buffer(env, args[0], &is_buffer);
+  if (!is_buffer) {
+    napi_throw_error(env, nullptr, "Pack must be a buffer");
+    return nullptr;
+  }
+  void* data;
+  size_t len;
+  napi_get_buffer_info(env, args[0], &data, &len);
+
+  OstDecoded decoded;
+  std::string error;
+  if (!ost_decode(static_cast<const uint8_t*>(data), len, decoded, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+
+  napi_value result, header, labels, bins, text;
+  napi_create_object(env, &result);
+  napi_create_string_utf8(env, decoded.header.data(), decoded.header.size(), &header);
+  napi_create_array_with_length(env, decoded.labels.size(), &labels);
+  napi_create_array_with_length(env, decoded.bins.size(), &bins);
+  for (uint32_t i = 0; i < decoded.bins.size(); i++) {
+    napi_value label;
+    napi_create_string_utf16(env, decoded.labels[i].data(), decoded.labels[i].size(), &label);
+    napi_set_element(env, labels, i, label);
+    napi_set_element(env, bins, i, utf16_buffer(env, decoded.bins[i]));
+  }
+  if (decoded.ordered) text = utf16_buffer(env, decoded.data);
+  else napi_get_null(env, &text);
+
+  napi_set_named_property(env, result, "header", header);
+  napi_set_named_property(env, result, "labels", labels);
+  napi_set_named_property(env, result, "bins", bins);
+  napi_set_named_property(env, result, "data", text);
+  return result;
+}
+
+static bool get_method_arg(napi_env env, size_t argc, napi_value* args, OstConfig& config) {
+  napi_valuetype type;
+  if (argc < 2 || napi_typeof(env, args[1], &type) != napi_ok || type != napi_string) return false;
+  size_t len = 0;
+  napi_get_value_string_utf8(env, args[1], nullptr, 0, &len);
+  config.compressionMethod.resize(len);
+  napi_get_value_string_utf8(env, args[1], &config.compressionMethod[0], len + 1, &len);
+  return true;
+}
+
+static napi_value buffer_array(napi_env env, std::vector<std::vector<uint8_t>>& items) {
+  napi_value result;
+  napi_create_array_with_length(env, items.size(), &result);
+  for (uint32_t i = 0; i < items.size(); i++) {
+    napi_value buf = new_buffer_copy(env, items[i].data(), items[i].size());
+    if (!buf) {
+      napi_throw_error(env, nullptr, "Failed to allocate buffer");
+      return nullptr;
+    }
+    napi_set_element(env, result, i, buf);
+    std::vector<uint8_t>().swap(items[i]);
+  }
+  return result;
+}
+
+napi_value OstCompressBins(napi_env env, napi_callback_info info) {
+  // Parse arguments: [bins: (Buffer | string)[], method, level?] -> Buffer[]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  OstConfig config;
+  bool is_array = false;
+  if (argc > 0) napi_is_array(env, args[0], &is_array);
+  if (!is_array || !get_method_arg(env, argc, args, config)) {
+    napi_throw_error(env, nullptr, "Expected an array of bins and a compression method");
+    return nullptr;
+  }
+  if (argc > 2) {
+    int64_t level = 0;
+    napi_valuetype type;
+    napi_typeof(env, args[2], &type);
+    if (type == napi_number) napi_get_value_int64(env, args[2], &level);
+    config.compressionLevel = static_cast<uint32_t>(std::max<int64_t>(0, std::min<int64_t>(level, 22)));
+  }
+
+  // Strings keep their JS semantics (huffman symbols are code points);
+  // Buffers are UTF-8 text and only read, from the worker threads too.
+  struct Input {
+    const uint8_t* bytes = nullptr;
+    size_t len = 0;
+    std::u16string text;
+    bool isText = false;
+  };
+  uint32_t count = 0;
+  napi_get_array_length(env, args[0], &count);
+  std::vector<Input> inputs(count);
+  size_t total = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    napi_value item;
+    napi_valuetype type;
+    bool is_buffer = false;
+    napi_get_element(env, args[0], i, &item);
+    napi_is_buffer(env, item, &is_buffer);
+    napi_typeof(env, item, &type);
+    if (is_buffer) {
+      void* data;
+      napi_get_buffer_info(env, item, &data, &inputs[i].len);
+      inputs[i].bytes = static_cast<const uint8_t*>(data);
+      total += inputs[i].len;
+    } else if (type == napi_string) {
+      size_t len = 0;
+      napi_get_value_string_utf16(env, item, nullptr, 0, &len);
+      inputs[i].text.assign(len, u'\0');
+      napi_get_value_string_utf16(env, item, &inputs[i].text[0], len + 1, &len);
+      inputs[i].isText = true;
+      total += len;
+    } else {
+      napi_throw_error(env, nullptr, "Bins must be buffers or strings");
+      return nullptr;
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> outputs(count);
+  std::vector<std::string> errors(count);
+  for_each_bin(count, total, [&](size_t i) {
+    Scratch scratch;
+    Input& in = inputs[i];
+    bool ok;
+    if (!in.isText && config.compressionMethod == "huffman" && !is_ascii(in.bytes, in.len)) {
+      append_utf8_as_utf16(in.bytes, in.len, in.text);
+      in.isText = true;
+    }
+    if (in.isText)
+      ok = compress_bin(in.text.data(), in.text.size(), config, scratch, outputs[i], nullptr, nullptr, errors[i]);
+    else
+      ok = compress_bin(in.bytes, in.len, config, scratch, outputs[i], nullptr, nullptr, errors[i]);
+    if (!ok && errors[i].empty()) errors[i] = "Bin compression failed";
+  });
+  for (const std::string& e : errors) {
+    if (!e.empty()) {
+      napi_throw_error(env, nullptr, e.c_str());
+      return nullptr;
+    }
+  }
+  return buffer_array(env, outputs);
+}
+
+napi_value OstDecompressBins(napi_env env, napi_callback_info info) {
+  // Parse arguments: [bins: Buffer[], method] -> Buffer[] (UTF-8)
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  OstConfig config;
+  bool is_array = false;
+  if (argc > 0) napi_is_array(env, args[0], &is_array);
+  if (!is_array || !get_method_arg(env, argc, args, config)) {
+    napi_throw_error(env, nullptr, "Expected an array of bins and a compression method");
+    return nullptr;
+  }
+
+  uint32_t count = 0;
+  napi_get_array_length(env, args[0], &count);
+  std::vector<std::pair<const uint8_t*, size_t>> inputs(count);
+  size_t total = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    napi_value item;
+    bool is_buffer = false;
+    napi_get_element(env, args[0], i, &item);
+    napi_is_buffer(env, item, &is_buffer);
+    if (!is_buffer) {
+      napi_throw_error(env, nullptr, "Bins must be buffers");
+      return nullptr;
+    }
+    void* data;
+    napi_get_buffer_info(env, item, &data, &inputs[i].second);
+    inputs[i].first = static_cast<const uint8_t*>(data);
+    total += inputs[i].second;
+  }
+
+  std::vector<std::vector<uint8_t>> outputs(count);
+  std::vector<std::string> errors(count);
+  for_each_bin(count, total, [&](size_t i) {
+    std::u16string text;
+    if (!decompress_bin(inputs[i].first, inputs[i].second, config.compressionMethod, text, errors[i])) return;
+    std::string utf8;
+    utf16_to_utf8(text.data(), text.size(), utf8);
+    outputs[i].assign(utf8.begin(), utf8.end());
+  });
+  for (const std::string& e : errors) {
+    if (!e.empty()) {
+      napi_throw_error(env, nullptr, e.c_str());
+      return nullptr;
+    }
+  }
+  return buffer_array(env, outputs);
+}
+
+napi_value InitOstCodec(napi_env env, napi_value exports) {
+  napi_property_descriptor descs[] = {
+    { "ostEncode",         nullptr, OstEncode,         nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostDecode",         nullptr, OstDecode,         nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostCompressBins",   nullptr, OstCompressBins,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostDecompressBins", nullptr, OstDecompressBins, nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(descs, sizeof(descs) / sizeof(*descs));
+  napi_define_properties(env, exports, sizeof(descs) / sizeof(*descs), descs);
+  return exports;
+}
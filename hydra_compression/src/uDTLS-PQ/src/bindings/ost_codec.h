@@ -0,0 +1,186 @@
+// src/bindings/ost_codec.h
+#ifndef OST_CODEC_H
+#define OST_CODEC_H
+
+#include <node_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Native OST (Okaily-Srivastava-Tbakhi) codec producing the same "OST1"
+// packs as OSTPackWriter.createPack:
+//
+//   "OST1" | u32 headerLen | header JSON {config, binSequence, bins}
+//   per bin: u16 labelLen | label (UTF-8) | u32 dataLen | data
+//
+// with huffman bins stored as u32 tableLen | JSON [[char, count], ...] |
+// MSB-first code bits. All integers are big-endian.
+//
+// The TypeScript codec works on JS strings, so to stay byte-for-byte
+// compatible this one does too: windows are cut every windowLength UTF-16
+// units and Huffman symbols are code points, with ties broken in order of
+// first appearance exactly like the stable sorts in OSTCompression.ts.
+// Pure-ASCII input (the common case: logs, DNA, JSON) skips the UTF-16
+// view and runs on the bytes directly.
+
+struct OstConfig {
+  uint32_t windowLength = 1000;
+  uint32_t labelLength = 4;
+  bool variableWindow = false;          // recorded only; the TS codec ignores it too
+  std::string compressionMethod = "huffman";  // huffman, raw, or a bin_compress.h codec
+  bool subBinning = false;
+  uint32_t subBinningDepth = 0;
+  // Adds "windowBins" (bin index per window) to the header so the pack can be
+  // decoded back to the original text. Off by default: OST1 as written by
+  // OSTPackWriter has no window order and this field changes the bytes.
+  bool recordOrder = false;
+  // Appends a binary window index after the last bin (see OstPackIndex) and
+  // sets "index": true in the header, so OstPackView can decode any byte
+  // range without touching the rest of the pack.
+  bool index = false;
+  // brotli/zstd level; 0 keeps the library default. Not written to the header.
+  uint32_t compressionLevel = 0;
+  // Any other option keys, as ",\"key\":value" JSON members, so the header's
+  // config matches JSON.stringify({ ...DEFAULT_CONFIG, ...options }).
+  // Integer-like keys sort ahead of the defaults there, hence two lists.
+  std::string leadingKeys;
+  std::string trailingKeys;
+};
+
+// text is UTF-8 (decoded like TextDecoder, so invalid sequences become U+FFFD).
+bool ost_encode(const uint8_t* text, size_t len, const OstConfig& config,
+                std::vector<uint8_t>& out, std::string& error);
+bool ost_encode_utf16(const char16_t* text, size_t len, const OstConfig& config,
+                      std::vector<uint8_t>& out, std::string& error);
+
+struct OstDecoded {
+  std::string header;                   // header JSON as stored
+  std::string compressionMethod;
+  uint32_t windowLength = 0;
+  std::vector<std::u16string> labels;
+  std::vector<std::u16string> bins;     // decompressed bin contents, in pack order
+  bool ordered = false;                 // header carried windowBins
+  std::u16string data;                  // reconstructed input when ordered
+};
+
+bool ost_decode(const uint8_t* pack, size_t len, OstDecoded& out, std::string& error);
+
+// Index written after the bins when OstConfig::index is set:
+//
+//   "OSTI" | u32 method | u32 binCount | u32 windowCount | u32 windowLength
+//          | u64 units | u64 bytes
+//   binCount    x u64 record offset (the bin's u16 labelLen)
+//   windowCount x { u32 bin | flags, u64 bit offset, u64 byte offset }
+//   u64 index offset | "OSTI"
+//
+// Bit offsets count from the start of the bin's code stream (after the
+// Huffman table; raw bins use byte offset * 8) and point at the symbol that
+// holds the window's first unit. Byte offsets are into the UTF-8 text; a
+// surrogate pair cut by a window boundary counts towards the earlier window.
+enum OstMethod : uint32_t { OST_METHOD_RAW = 0, OST_METHOD_HUFFMAN = 1 };
+
+static constexpr uint32_t OST_WINDOW_STRADDLE = 1u << 31;  // that symbol began in the previous window
+static constexpr uint32_t OST_WINDOW_PAIR_TAIL = 1u << 30; // first unit ends a pair begun before it
+static constexpr uint32_t OST_WINDOW_BIN_MASK = OST_WINDOW_PAIR_TAIL - 1;
+
+struct OstPackIndex {
+  uint64_t offset = 0;                  // start of the index, i.e. end of the bins
+  uint32_t method = OST_METHOD_RAW;
+  uint32_t binCount = 0;
+  uint32_t windowCount = 0;
+  uint32_t windowLength = 0;
+  uint64_t units = 0;                   // UTF-16 length of the text
+  uint64_t bytes = 0;                   // UTF-8 length of the text
+  const uint8_t* records = nullptr;     // points into the pack
+  const uint8_t* windows = nullptr;
+};
+
+// Validates the footer of an indexed pack; the entries are read in place.
+bool ost_read_index(const uint8_t* pack, size_t len, OstPackIndex& index, std::string& error);
+
+// Ranged reads from an indexed pack. Only the windows overlapping a request
+// are decoded, from the bit offsets in the index, so opening costs nothing
+// beyond validating the footer. A bin's Huffman table is parsed the first
+// time one of its windows is read. The pack memory must outlive the view.
+class OstPackView {
+public:
+  OstPackView();
+  ~OstPackView();
+
+  bool open(const uint8_t* pack, size_t len, std::string& error);
+  const OstPackIndex& index() const { return index_; }
+
+  // Copies up to len bytes of the UTF-8 text starting at pos into dst; n
+  // is short only at the end of the text.
+  bool read(uint64_t pos, uint8_t* dst, size_t len, size_t& n, std::string& error);
+
+private:
+  struct Bin;
+  uint64_t window_byte(uint32_t w) const;
+  bool decode_window(uint32_t w, size_t units, std::u16string& out, std::string& error);
+  bool fill(uint64_t pos, uint64_t end, std::string& error);
+
+  const uint8_t* pack_ = nullptr;
+  size_t len_ = 0;
+  OstPackIndex index_;
+  std::vector<std::unique_ptr<Bin>> bins_;
+  std::mutex mu_;
+  // Last decoded run of windows, so sequential small reads decode once.
+  uint64_t span_begin_ = 0;
+  std::string span_;
+  std::u16string units_;
+};
+
+// Incremental encoder for inputs too large to hold at once. Windows are
+// labelled and binned as they arrive, and a bin is compressed into a block
+// once it holds blockBytes of text, or earlier when everything buffered
+// passes memoryLimit, so memory stays bounded however long the input. It
+// writes an OST1 variant with "stream": true in the header:
+//
+//   block: u16 labelLen | label (UTF-8) | u32 dataLen | data
+//   order: u16 0 | u32 4n | n x u32 bin
+//
+// A bin may take several blocks, which decode back to back. Bins are
+// numbered by their first block, and an order record (the bin of each
+// window, in input order) only names bins whose first block precedes it.
+// ost_decode rebuilds the input; the index and recordOrder do not apply.
+class OstStreamEncoder {
+public:
+  OstStreamEncoder();
+  ~OstStreamEncoder();
+
+  bool start(const OstConfig& config, size_t blockBytes, size_t memoryLimit, std::string& error);
+
+  // Each call appends whatever pack bytes are ready to out, the header
+  // first. UTF-8 chunks may end partway through a sequence.
+  bool write(const uint8_t* text, size_t len, std::vector<uint8_t>& out, std::string& error);
+  bool write_utf16(const char16_t* text, size_t len, std::vector<uint8_t>& out, std::string& error);
+  bool finish(std::vector<uint8_t>& out, std::string& error);
+
+private:
+  struct State;
+  std::unique_ptr<State> s_;
+};
+
+// UTF-16 -> UTF-8 the way TextEncoder does it (lone surrogates become U+FFFD).
+void utf16_to_utf8(const char16_t* s, size_t n, std::string& out);
+
+// Reads an ostEncode options object into config; false if a length is invalid.
+bool ost_get_config(napi_env env, napi_value options, OstConfig& config);
+
+// ** Exports: ostEncode(data, options?) -> Buffer, ostDecode(pack) -> { ... } **
+napi_value OstEncode(napi_env env, napi_callback_info info);
+napi_value OstDecode(napi_env env, napi_callback_info info);
+
+// ** Bin stage alone: ostCompressBins(bins, method, level?) -> Buffer[],
+//    ostDecompressBins(bins, method) -> Buffer[] (UTF-8) **
+napi_value OstCompressBins  (napi_env env, napi_callback_info info);
+napi_value OstDecompressBins(napi_env env, napi_callback_info info);
+
+// Module initialization function (called from openssl.cpp)
+napi_value InitOstCodec(napi_env env, napi_value exports);
+
+#endif // OST_CODEC_H
@@ -0,0 +1,235 @@
+// src/bindings/ost_pack.cpp
+#include "ost_pack.h"
+#include "handle_table.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::shared_ptr<OstPack> OstPack::map(const char* path, std::string& error) {
+  const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error = std::string("Cannot open OST pack: ") + std::strerror(errno);
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    ::close(fd);
+    error = "Invalid OST pack format";
+    return nullptr;
+  }
+
+  // The mapping holds the file open on its own.
+  void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    error = std::string("Cannot map OST pack: ") + std::strerror(errno);
+    return nullptr;
+  }
+
+  std::shared_ptr<OstPack> pack(new OstPack());
+  pack->map_ = addr;
+  pack->mapLen_ = static_cast<size_t>(st.st_size);
+  if (!pack->view_.open(static_cast<const uint8_t*>(addr), pack->mapLen_, error)) return nullptr;
+  return pack;
+}
+
+std::shared_ptr<OstPack> OstPack::copy(const uint8_t* data, size_t len, std::string& error) {
+  std::shared_ptr<OstPack> pack(new OstPack());
+  pack->copy_.assign(data, data + len);
+  if (!pack->view_.open(pack->copy_.data(), len, error)) return nullptr;
+  return pack;
+}
+
+OstPack::~OstPack() {
+  if (map_) munmap(map_, mapLen_);
+}
+
+// --- Argument helpers ---
+static HandleTable<OstPack> g_ost_packs;
+
+static int get_handle_id(napi_env env, napi_value v) {
+  napi_value id_value;
+  int id = 0;
+  if (napi_get_named_property(env, v, "id", &id_value) == napi_ok)
+    napi_get_value_int32(env, id_value, &id);
+  return id;
+}
+
+static std::shared_ptr<OstPack> get_pack_or_throw(napi_env env, size_t argc, napi_value* args) {
+  std::shared_ptr<OstPack> pack = argc > 0 ? g_ost_packs.get(get_handle_id(env, args[0])) : nullptr;
+  if (!pack) napi_throw_error(env, nullptr, "Invalid OST pack handle");
+  return pack;
+}
+
+static bool get_position(napi_env env, napi_value v, uint64_t* out) {
+  napi_valuetype type;
+  int64_t n;
+  if (napi_typeof(env, v, &type) != napi_ok || type != napi_number ||
+      napi_get_value_int64(env, v, &n) != napi_ok || n < 0)
+    return false;
+  *out = static_cast<uint64_t>(n);
+  return true;
+}
+
+// --- Exports ---
+napi_value OstOpenPack(napi_env env, napi_callback_info info) {
+  // Parse arguments: [path | pack]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  std::shared_ptr<OstPack> pack;
+  std::string error;
+  bool is_buffer = false;
+  napi_valuetype type;
+  napi_is_buffer(env, args[0], &is_buffer);
+  napi_typeof(env, args[0], &type);
+  if (is_buffer) {
+    void* data;
+    size_t len;
+    napi_get_buffer_info(env, args[0], &data, &len);
+    pack = OstPack::copy(static_cast<const uint8_t*>(data), len, error);
+  } else if (type == napi_string) {
+    size_t len = 0;
+    napi_get_value_string_utf8(env, args[0], nullptr, 0, &len);
+    std::string path(len, '\0');
+    napi_get_value_string_utf8(env, args[0], &path[0], len + 1, &len);
+    pack = OstPack::map(path.c_str(), error);
+  } else {
+    napi_throw_error(env, nullptr, "Pack must be a path or a buffer");
+    return nullptr;
+  }
+  if (!pack) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+
+  int id = g_ost_packs.insert(pack);
+  if (!id) {
+    napi_throw_error(env, nullptr, "Too many open OST packs");
+    return nullptr;
+  }
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  return result;
+}
+
+napi_value OstClosePack(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  napi_value result;
+  napi_get_boolean(env, argc > 0 && g_ost_packs.remove(get_handle_id(env, args[0])) != nullptr, &result);
+  return result;
+}
+
+napi_value OstPackInfo(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<OstPack> pack = get_pack_or_throw(env, argc, args);
+  if (!pack) return nullptr;
+
+  const OstPackIndex& index = pack->view().index();
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_create_double(env, static_cast<double>(index.bytes), &v);
+  napi_set_named_property(env, result, "size", v);
+  napi_create_double(env, static_cast<double>(index.units), &v);
+  napi_set_named_property(env, result, "units", v);
+  napi_create_uint32(env, index.windowLength, &v);
+  napi_set_named_property(env, result, "windowLength", v);
+  napi_create_uint32(env, index.windowCount, &v);
+  napi_set_named_property(env, result, "windows", v);
+  napi_create_uint32(env, index.binCount, &v);
+  napi_set_named_property(env, result, "bins", v);
+  napi_create_string_utf8(env, index.method == OST_METHOD_HUFFMAN ? "huffman" : "raw", NAPI_AUTO_LENGTH, &v);
+  napi_set_named_property(env, result, "compressionMethod", v);
+  return result;
+}
+
+napi_value OstPackRead(napi_env env, napi_callback_info info) {
+  // Parse arguments: [pack, position, length] -> Buffer (short at the end)
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<OstPack> pack = get_pack_or_throw(env, argc, args);
+  if (!pack) return nullptr;
+
+  uint64_t position, length;
+  if (argc < 3 || !get_position(env, args[1], &position) || !get_position(env, args[2], &length)) {
+    napi_throw_error(env, nullptr, "Position and length must be non-negative integers");
+    return nullptr;
+  }
+  const uint64_t size = pack->view().index().bytes;
+  length = position < size ? std::min(length, size - position) : 0;
+
+  std::vector<uint8_t> out(static_cast<size_t>(length));
+  size_t n = 0;
+  std::string error;
+  if (!pack->view().read(position, out.data(), out.size(), n, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  napi_value result;
+  if (napi_create_buffer_copy(env, n, out.data(), nullptr, &result) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate buffer");
+    return nullptr;
+  }
+  return result;
+}
+
+napi_value OstPackReadInto(napi_env env, napi_callback_info info) {
+  // Parse arguments: [pack, target, position] -> bytes read
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<OstPack> pack = get_pack_or_throw(env, argc, args);
+  if (!pack) return nullptr;
+
+  bool is_buffer = false;
+  if (argc > 1) napi_is_buffer(env, args[1], &is_buffer);
+  uint64_t position;
+  if (!is_buffer || argc < 3 || !get_position(env, args[2], &position)) {
+    napi_throw_error(env, nullptr, "Expected a target buffer and a non-negative position");
+    return nullptr;
+  }
+  void* target;
+  size_t target_len;
+  napi_get_buffer_info(env, args[1], &target, &target_len);
+
+  size_t n = 0;
+  std::string error;
+  if (!pack->view().read(position, static_cast<uint8_t*>(target), target_len, n, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_double(env, static_cast<double>(n), &result);
+  return result;
+}
+
+napi_value InitOstPack(napi_env env, napi_value exports) {
+  napi_property_descriptor descs[] = {
+    { "ostOpenPack",     nullptr, OstOpenPack,     nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostClosePack",    nullptr, OstClosePack,    nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostPackInfo",     nullptr, OstPackInfo,     nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostPackRead",     nullptr, OstPackRead,     nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostPackReadInto", nullptr, OstPackReadInto, nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(descs, sizeof(descs) / sizeof(*descs));
+  napi_define_properties(env, exports, sizeof(descs) / sizeof(*descs), descs);
+  return exports;
+}
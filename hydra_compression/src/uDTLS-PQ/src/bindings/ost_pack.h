@@ -0,0 +1,48 @@
+// src/bindings/ost_pack.h
+#ifndef OST_PACK_H
+#define OST_PACK_H
+
+#include "ost_codec.h"
+#include <node_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// An indexed OST pack opened for ranged reads. Files are mapped read-only,
+// so opening one touches only the footer and reads fault in just the bins
+// they decode. Buffers are copied in, since JS may reuse their memory.
+class OstPack {
+public:
+  static std::shared_ptr<OstPack> map(const char* path, std::string& error);
+  static std::shared_ptr<OstPack> copy(const uint8_t* data, size_t len, std::string& error);
+  ~OstPack();
+
+  OstPackView& view() { return view_; }
+
+private:
+  OstPack() = default;
+
+  void* map_ = nullptr;
+  size_t mapLen_ = 0;
+  std::vector<uint8_t> copy_;
+  OstPackView view_;
+};
+
+// ** ostOpenPack(path | Buffer) -> { id }, ostClosePack({ id }) **
+napi_value OstOpenPack (napi_env env, napi_callback_info info);
+napi_value OstClosePack(napi_env env, napi_callback_info info);
+
+// ** ostPackInfo({ id }) -> { size, units, windowLength, windows, bins, compressionMethod } **
+napi_value OstPackInfo(napi_env env, napi_callback_info info);
+
+// ** ostPackRead({ id }, position, length) -> Buffer,
+//    ostPackReadInto({ id }, target, position) -> bytes read **
+napi_value OstPackRead    (napi_env env, napi_callback_info info);
+napi_value OstPackReadInto(napi_env env, napi_callback_info info);
+
+// Module initialization function (called from openssl.cpp)
+napi_value InitOstPack(napi_env env, napi_value exports);
+
+#endif // OST_PACK_H
@@ -0,0 +1,166 @@
+// src/bindings/ost_stream.cpp
+#include "ost_stream.h"
+#include "ost_codec.h"
+#include "handle_table.h"
+#include "metrics.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static constexpr size_t OST_STREAM_BLOCK_BYTES = 4 * 1024 * 1024;
+static constexpr size_t OST_STREAM_MEMORY_LIMIT = 64 * 1024 * 1024;
+
+struct OstStream {
+  std::mutex mu;
+  OstStreamEncoder encoder;
+};
+
+static HandleTable<OstStream> g_ost_streams;
+
+// --- Argument helpers ---
+static int get_handle_id(napi_env env, napi_value v) {
+  napi_value id_value;
+  int id = 0;
+  if (napi_get_named_property(env, v, "id", &id_value) == napi_ok)
+    napi_get_value_int32(env, id_value, &id);
+  return id;
+}
+
+// Leaves *out alone when the option is absent; false if it is not a
+// non-negative number.
+static bool get_size_option(napi_env env, napi_value options, const char* name, size_t* out) {
+  napi_valuetype type;
+  napi_value v;
+  if (!options || napi_typeof(env, options, &type) != napi_ok || type != napi_object ||
+      napi_get_named_property(env, options, name, &v) != napi_ok ||
+      napi_typeof(env, v, &type) != napi_ok || type == napi_undefined)
+    return true;
+  int64_t n;
+  if (type != napi_number || napi_get_value_int64(env, v, &n) != napi_ok || n < 0) return false;
+  *out = static_cast<size_t>(n);
+  return true;
+}
+
+static napi_value new_buffer_copy(napi_env env, const std::vector<uint8_t>& out) {
+  napi_value result;
+  if (napi_create_buffer_copy(env, out.size(), out.data(), nullptr, &result) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate buffer");
+    return nullptr;
+  }
+  return result;
+}
+
+// --- Exports ---
+napi_value OstStreamCreate(napi_env env, napi_callback_info info) {
+  // Parse arguments: [options?]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  napi_value options = argc > 0 ? args[0] : nullptr;
+
+  OstConfig config;
+  size_t block = OST_STREAM_BLOCK_BYTES, limit = OST_STREAM_MEMORY_LIMIT;
+  if (!ost_get_config(env, options, config)) {
+    napi_throw_error(env, nullptr, "windowLength must be a positive integer and labelLength non-negative");
+    return nullptr;
+  }
+  if (!get_size_option(env, options, "blockSize", &block) ||
+      !get_size_option(env, options, "memoryLimit", &limit)) {
+    napi_throw_error(env, nullptr, "blockSize and memoryLimit must be non-negative integers");
+    return nullptr;
+  }
+
+  auto stream = std::make_shared<OstStream>();
+  std::string error;
+  if (!stream->encoder.start(config, block, limit, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  int id = g_ost_streams.insert(stream);
+  if (!id) {
+    napi_throw_error(env, nullptr, "Too many open OST streams");
+    return nullptr;
+  }
+  napi_value result, v;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  return result;
+}
+
+napi_value OstStreamWrite(napi_env env, napi_callback_info info) {
+  // Parse arguments: [stream, chunk: Buffer | string]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<OstStream> stream = argc > 0 ? g_ost_streams.get(get_handle_id(env, args[0])) : nullptr;
+  if (!stream) {
+    napi_throw_error(env, nullptr, "Invalid OST stream handle");
+    return nullptr;
+  }
+
+  std::vector<uint8_t> out;
+  std::string error;
+  bool ok;
+  bool is_buffer = false;
+  napi_valuetype type = napi_undefined;
+  if (argc > 1) {
+    napi_is_buffer(env, args[1], &is_buffer);
+    napi_typeof(env, args[1], &type);
+  }
+  if (is_buffer) {
+    void* data;
+    size_t len;
+    napi_get_buffer_info(env, args[1], &data, &len);
+    std::lock_guard<std::mutex> lock(stream->mu);
+    ok = stream->encoder.write(static_cast<const uint8_t*>(data), len, out, error);
+  } else if (type == napi_string) {
+    size_t len = 0;
+    napi_get_value_string_utf16(env, args[1], nullptr, 0, &len);
+    std::u16string text(len, u'\0');
+    napi_get_value_string_utf16(env, args[1], &text[0], len + 1, &len);
+    std::lock_guard<std::mutex> lock(stream->mu);
+    ok = stream->encoder.write_utf16(text.data(), text.size(), out, error);
+  } else {
+    napi_throw_error(env, nullptr, "Chunk must be a buffer or a string");
+    return nullptr;
+  }
+
+  if (!ok) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  return new_buffer_copy(env, out);
+}
+
+napi_value OstStreamEnd(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  std::shared_ptr<OstStream> stream = argc > 0 ? g_ost_streams.remove(get_handle_id(env, args[0])) : nullptr;
+  if (!stream) {
+    napi_throw_error(env, nullptr, "Invalid OST stream handle");
+    return nullptr;
+  }
+
+  std::vector<uint8_t> out;
+  std::string error;
+  std::lock_guard<std::mutex> lock(stream->mu);
+  if (!stream->encoder.finish(out, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  return new_buffer_copy(env, out);
+}
+
+napi_value InitOstStream(napi_env env, napi_value exports) {
+  napi_property_descriptor descs[] = {
+    { "ostStreamCreate", nullptr, OstStreamCreate, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostStreamWrite",  nullptr, OstStreamWrite,  nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ostStreamEnd",    nullptr, OstStreamEnd,    nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(descs, sizeof(descs) / sizeof(*descs));
+  napi_define_properties(env, exports, sizeof(descs) / sizeof(*descs), descs);
+  return exports;
+}
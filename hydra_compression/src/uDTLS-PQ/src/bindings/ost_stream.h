@@ -0,0 +1,23 @@
+// src/bindings/ost_stream.h
+#ifndef OST_STREAM_H
+#define OST_STREAM_H
+
+#include <node_api.h>
+
+// ** ostStreamCreate(options?) -> { id } **
+// options are ostEncode's plus blockSize (bytes of text per bin block,
+// default 4 MiB) and memoryLimit (text buffered across bins, default 64 MiB).
+napi_value OstStreamCreate(napi_env env, napi_callback_info info);
+
+// ** ostStreamWrite({ id }, chunk: Buffer | string) -> Buffer **
+// Returns the pack bytes the chunk completed, often none.
+napi_value OstStreamWrite(napi_env env, napi_callback_info info);
+
+// ** ostStreamEnd({ id }) -> Buffer **
+// Flushes every bin and the remaining window order, and frees the handle.
+napi_value OstStreamEnd(napi_env env, napi_callback_info info);
+
+// Module initialization function (called from openssl.cpp)
+napi_value InitOstStream(napi_env env, napi_value exports);
+
+#endif // OST_STREAM_H
@@ -1,13 +1,25 @@
 // src/bindings/pq_crypto.cpp
 #include "pq_crypto.h"
+#include "worker_pool.h"
+#include "kem_pool.h"
+#include "sig_registry.h"
+#include "metrics.h"
+#include "secret_arena.h"
 #include <oqs/oqs.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 #include <stdexcept>
+#include <array>
+#include <cstring>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <node_api.h>
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
 #include <openssl/rsa.h>
 #include <openssl/pem.h>
@@ -16,24 +28,118 @@
 #include <sstream>
 #include <iomanip>
 
-// --- string ↔ enum conversion ---
-PQAlgorithmType string_to_pq_algorithm(const std::string& algo) {
-  if (algo=="kyber512")     return PQAlgorithmType::KYBER512;
-  if (algo=="kyber768")     return PQAlgorithmType::KYBER768;
-  if (algo=="kyber1024")    return PQAlgorithmType::KYBER1024;
-  if (algo=="dilithium2")   return PQAlgorithmType::DILITHIUM2;
-  if (algo=="dilithium3")   return PQAlgorithmType::DILITHIUM3;
-  if (algo=="dilithium5")   return PQAlgorithmType::DILITHIUM5;
-  return PQAlgorithmType::KYBER768;
+// Reads the optional algorithm argument as a name or a cached handle.
+// Returns -1 for an unknown handle; names keep the kyber768 fallback.
+static int get_kem_arg(napi_env env, size_t argc, napi_value* args, size_t index) {
+  int fallback = static_cast<int>(PQAlgorithmType::KYBER768);
+  if (argc <= index) return fallback;
+
+  napi_valuetype t;
+  napi_typeof(env, args[index], &t);
+  if (t == napi_number) {
+    int32_t handle;
+    napi_get_value_int32(env, args[index], &handle);
+    return (handle >= 0 && handle < KEM_COUNT) ? handle : -1;
+  }
+  if (t != napi_string) return fallback;
+
+  char buf[32]; size_t len;
+  napi_get_value_string_utf8(env, args[index], buf, sizeof(buf), &len);
+  const KemSpec* spec = find_kem_spec(buf, len);
+  return spec ? static_cast<int>(spec->type) : fallback;
+}
+
+static const OQS_KEM* get_kem_or_throw(napi_env env, int handle) {
+  const OQS_KEM* k = get_kem(handle);
+  if (!k) napi_throw_error(env, nullptr, handle < 0 ? "Unknown KEM handle" : "Failed to initialize OQS KEM");
+  return k;
+}
+
+napi_value KemHandle(napi_env env, napi_callback_info info) {
+  // Parse arguments: [algo]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  int handle = get_kem_arg(env, argc, args, 0);
+  if (!get_kem_or_throw(env, handle)) return nullptr;
+
+  napi_value result;
+  napi_create_int32(env, handle, &result);
+  return result;
+}
+
+// --- Result buffers ---
+// Outputs are written straight into Node-owned memory: the Buffer is created
+// first and liboqs fills it in place, so there is no staging vector and no
+// copy on the way out.
+static uint8_t* new_buffer(napi_env env, size_t len, napi_value* out) {
+  void* data = nullptr;
+  if (napi_create_buffer(env, len, &data, out) != napi_ok) return nullptr;
+  return static_cast<uint8_t*>(data);
+}
+
+// Hands a vector's storage to JS without copying; the finalizer frees it.
+static napi_value adopt_vector(napi_env env, std::vector<uint8_t>&& v) {
+  napi_value out;
+  if (v.empty()) {
+    napi_create_buffer(env, 0, nullptr, &out);
+    return out;
+  }
+  auto* owned = new std::vector<uint8_t>(std::move(v));
+  napi_status st = napi_create_external_buffer(env, owned->size(), owned->data(),
+    [](napi_env, void*, void* hint) { delete static_cast<std::vector<uint8_t>*>(hint); },
+    owned, &out);
+  if (st != napi_ok) {
+    // Runtimes that forbid external buffers get a copy instead.
+    napi_create_buffer_copy(env, owned->size(), owned->data(), nullptr, &out);
+    delete owned;
+  }
+  return out;
+}
+
+// Private keys and shared secrets go into SecretArena memory instead: locked,
+// kept out of core dumps, and wiped when the Buffer is collected. The size
+// is reported to V8 so unreferenced secrets are collected promptly rather
+// than pinning locked pages. Runtimes that forbid external buffers get an
+// ordinary Buffer.
+static uint8_t* new_secret_buffer(napi_env env, size_t len, napi_value* out) {
+  uint8_t* data = SecretArena::shared().allocate(len);
+  if (!data) return nullptr;
+  napi_status st = napi_create_external_buffer(env, len, data,
+    [](napi_env env, void* p, void* hint) {
+      SecretArena::shared().release(p);
+      int64_t ignored;
+      napi_adjust_external_memory(env, -static_cast<int64_t>(reinterpret_cast<uintptr_t>(hint)), &ignored);
+    }, reinterpret_cast<void*>(static_cast<uintptr_t>(len)), out);
+  if (st != napi_ok) {
+    SecretArena::shared().release(data);
+    return new_buffer(env, len, out);
+  }
+  int64_t ignored;
+  napi_adjust_external_memory(env, static_cast<int64_t>(len), &ignored);
+  return data;
 }
 
-static const char* get_kem_name(PQAlgorithmType a) {
-  switch(a) {
-    case PQAlgorithmType::KYBER512:  return OQS_KEM_alg_kyber_512;
-    case PQAlgorithmType::KYBER768:  return OQS_KEM_alg_kyber_768;
-    case PQAlgorithmType::KYBER1024: return OQS_KEM_alg_kyber_1024;
-    default:                         return OQS_KEM_alg_kyber_768;
+static bool get_buffer_arg(napi_env env, napi_value v, uint8_t** data, size_t* len) {
+  bool is_buffer;
+  napi_is_buffer(env, v, &is_buffer);
+  if (!is_buffer) return false;
+  void* ptr;
+  napi_get_buffer_info(env, v, &ptr, len);
+  *data = static_cast<uint8_t*>(ptr);
+  return true;
+}
+
+// Checks a caller-supplied output Buffer for the *Into variants.
+static uint8_t* get_output_arg(napi_env env, napi_value v, size_t need, const char* what) {
+  uint8_t* data; size_t len;
+  if (!get_buffer_arg(env, v, &data, &len) || len < need) {
+    std::string msg = std::string(what) + " must be a buffer of at least " + std::to_string(need) + " bytes";
+    napi_throw_error(env, nullptr, msg.c_str());
+    return nullptr;
   }
+  return data;
 }
 
 // --- Keypair / encapsulation ---
@@ -42,33 +148,20 @@ napi_value GenerateKyberKeyPair(napi_env env, napi_callback_info info) {
   size_t argc=1; napi_value args[1];
   napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
-  std::string algo = "kyber768";
-  if (argc>=1) {
-    char buf[32]; size_t len;
-    napi_get_value_string_utf8(env, args[0], buf, sizeof(buf), &len);
-    algo = std::string(buf, len);
-  }
-  PQAlgorithmType at = string_to_pq_algorithm(algo);
-  const char* kem = get_kem_name(at);
-
-  // init OQS
-  OQS_init();
-  OQS_KEM *k = OQS_KEM_new(kem);
-  if (!k) throw std::runtime_error("OQS init failed");
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 0));
+  if (!k) return nullptr;
 
-  std::vector<uint8_t> pk(k->length_public_key), sk(k->length_secret_key);
-  if (OQS_KEM_keypair(k, pk.data(), sk.data()) != OQS_SUCCESS) {
-    OQS_KEM_free(k);
-    throw std::runtime_error("keypair failed");
+  napi_value out, buf1, buf2;
+  uint8_t* pk = new_buffer(env, k->length_public_key, &buf1);
+  uint8_t* sk = new_secret_buffer(env, k->length_secret_key, &buf2);
+  if (!pk || !sk || OQS_KEM_keypair(k, pk, sk) != OQS_SUCCESS) {
+    napi_throw_error(env, nullptr, "keypair failed");
+    return nullptr;
   }
-  OQS_KEM_free(k);
 
   // return {publicKey, privateKey}
-  napi_value out, buf1, buf2;
   napi_create_object(env, &out);
-  napi_create_buffer_copy(env, pk.size(),  pk.data(),  nullptr, &buf1);
   napi_set_named_property(env, out, "publicKey", buf1);
-  napi_create_buffer_copy(env, sk.size(),  sk.data(),  nullptr, &buf2);
   napi_set_named_property(env, out, "privateKey", buf2);
   return out;
 }
@@ -85,57 +178,36 @@ napi_value KyberEncapsulate(napi_env env, napi_callback_info info) {
   }
   
   // Get public key buffer
-  bool is_buffer;
-  napi_is_buffer(env, args[0], &is_buffer);
-  if (!is_buffer) {
+  uint8_t* pub_data;
+  size_t pub_len;
+  if (!get_buffer_arg(env, args[0], &pub_data, &pub_len)) {
     napi_throw_error(env, nullptr, "Public key must be a buffer");
     return nullptr;
   }
   
-  void* pub_data;
-  size_t pub_len;
-  napi_get_buffer_info(env, args[0], &pub_data, &pub_len);
-  
-  // Get algorithm (optional)
-  std::string algo = "kyber768";
-  if (argc >= 2) {
-    char buf[32];
-    size_t len;
-    napi_get_value_string_utf8(env, args[1], buf, sizeof(buf), &len);
-    algo = std::string(buf, len);
-  }
-  
-  // Get algorithm type and KEM name
-  PQAlgorithmType at = string_to_pq_algorithm(algo);
-  const char* kem = get_kem_name(at);
-  
-  // Initialize OQS
-  OQS_init();
-  OQS_KEM* k = OQS_KEM_new(kem);
-  if (!k) {
-    napi_throw_error(env, nullptr, "Failed to initialize OQS KEM");
+  // Look up the prepared KEM
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 1));
+  if (!k) return nullptr;
+
+  if (pub_len != k->length_public_key) {
+    napi_throw_error(env, nullptr, "Invalid public key length");
     return nullptr;
   }
   
   // Encapsulate
-  std::vector<uint8_t> ciphertext(k->length_ciphertext);
-  std::vector<uint8_t> shared_secret(k->length_shared_secret);
+  napi_value result, ct_buf, ss_buf;
+  uint8_t* ciphertext = new_buffer(env, k->length_ciphertext, &ct_buf);
+  uint8_t* shared_secret = new_secret_buffer(env, k->length_shared_secret, &ss_buf);
   
-  if (OQS_KEM_encaps(k, ciphertext.data(), shared_secret.data(), 
-                     static_cast<uint8_t*>(pub_data)) != OQS_SUCCESS) {
-    OQS_KEM_free(k);
+  if (!ciphertext || !shared_secret ||
+      OQS_KEM_encaps(k, ciphertext, shared_secret, pub_data) != OQS_SUCCESS) {
     napi_throw_error(env, nullptr, "Encapsulation failed");
     return nullptr;
   }
   
-  OQS_KEM_free(k);
-  
   // Return { ciphertext, sharedSecret }
-  napi_value result, ct_buf, ss_buf;
   napi_create_object(env, &result);
-  napi_create_buffer_copy(env, ciphertext.size(), ciphertext.data(), nullptr, &ct_buf);
   napi_set_named_property(env, result, "ciphertext", ct_buf);
-  napi_create_buffer_copy(env, shared_secret.size(), shared_secret.data(), nullptr, &ss_buf);
   napi_set_named_property(env, result, "sharedSecret", ss_buf);
   
   return result;
@@ -152,68 +224,934 @@ napi_value KyberDecapsulate(napi_env env, napi_callback_info info) {
     return nullptr;
   }
   
-  // Get private key buffer
-  bool is_buffer;
-  napi_is_buffer(env, args[0], &is_buffer);
-  if (!is_buffer) {
+  // Get private key and ciphertext buffers
+  uint8_t *priv_data, *ct_data;
+  size_t priv_len, ct_len;
+  if (!get_buffer_arg(env, args[0], &priv_data, &priv_len)) {
     napi_throw_error(env, nullptr, "Private key must be a buffer");
     return nullptr;
   }
-  
-  void* priv_data;
-  size_t priv_len;
-  napi_get_buffer_info(env, args[0], &priv_data, &priv_len);
-  
-  // Get ciphertext buffer
-  napi_is_buffer(env, args[1], &is_buffer);
-  if (!is_buffer) {
+  if (!get_buffer_arg(env, args[1], &ct_data, &ct_len)) {
     napi_throw_error(env, nullptr, "Ciphertext must be a buffer");
     return nullptr;
   }
   
-  void* ct_data;
-  size_t ct_len;
-  napi_get_buffer_info(env, args[1], &ct_data, &ct_len);
-  
-  // Get algorithm (optional)
-  std::string algo = "kyber768";
-  if (argc >= 3) {
-    char buf[32];
-    size_t len;
-    napi_get_value_string_utf8(env, args[2], buf, sizeof(buf), &len);
-    algo = std::string(buf, len);
-  }
-  
-  // Get algorithm type and KEM name
-  PQAlgorithmType at = string_to_pq_algorithm(algo);
-  const char* kem = get_kem_name(at);
-  
-  // Initialize OQS
-  OQS_init();
-  OQS_KEM* k = OQS_KEM_new(kem);
-  if (!k) {
-    napi_throw_error(env, nullptr, "Failed to initialize OQS KEM");
+  // Look up the prepared KEM
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 2));
+  if (!k) return nullptr;
+
+  if (priv_len != k->length_secret_key || ct_len != k->length_ciphertext) {
+    napi_throw_error(env, nullptr, "Invalid private key or ciphertext length");
     return nullptr;
   }
   
   // Decapsulate
-  std::vector<uint8_t> shared_secret(k->length_shared_secret);
-  if (OQS_KEM_decaps(k, shared_secret.data(), 
-                     static_cast<uint8_t*>(ct_data), 
-                     static_cast<uint8_t*>(priv_data)) != OQS_SUCCESS) {
-    OQS_KEM_free(k);
+  napi_value result;
+  uint8_t* shared_secret = new_secret_buffer(env, k->length_shared_secret, &result);
+  if (!shared_secret || OQS_KEM_decaps(k, shared_secret, ct_data, priv_data) != OQS_SUCCESS) {
     napi_throw_error(env, nullptr, "Decapsulation failed");
     return nullptr;
   }
   
-  OQS_KEM_free(k);
-  
   // Return shared secret buffer
+  return result;
+}
+
+// --- "Into" variants ---
+// Same operations, but results land in caller-supplied Buffers (for example
+// views into a preallocated slab) and nothing is allocated per call.
+napi_value GenerateKyberKeyPairInto(napi_env env, napi_callback_info info) {
+  // Parse arguments: [publicKeyOut, privateKeyOut, algo?]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 2));
+  if (!k) return nullptr;
+
+  uint8_t* pk = get_output_arg(env, args[0], k->length_public_key, "Public key output");
+  if (!pk) return nullptr;
+  uint8_t* sk = get_output_arg(env, args[1], k->length_secret_key, "Private key output");
+  if (!sk) return nullptr;
+
+  if (OQS_KEM_keypair(k, pk, sk) != OQS_SUCCESS)
+    napi_throw_error(env, nullptr, "keypair failed");
+  return nullptr;
+}
+
+napi_value KyberEncapsulateInto(napi_env env, napi_callback_info info) {
+  // Parse arguments: [publicKey, ciphertextOut, sharedSecretOut, algo?]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 3));
+  if (!k) return nullptr;
+
+  uint8_t* pub_data; size_t pub_len;
+  if (!get_buffer_arg(env, args[0], &pub_data, &pub_len) || pub_len != k->length_public_key) {
+    napi_throw_error(env, nullptr, "Invalid public key");
+    return nullptr;
+  }
+  uint8_t* ct = get_output_arg(env, args[1], k->length_ciphertext, "Ciphertext output");
+  if (!ct) return nullptr;
+  uint8_t* ss = get_output_arg(env, args[2], k->length_shared_secret, "Shared secret output");
+  if (!ss) return nullptr;
+
+  if (OQS_KEM_encaps(k, ct, ss, pub_data) != OQS_SUCCESS)
+    napi_throw_error(env, nullptr, "Encapsulation failed");
+  return nullptr;
+}
+
+napi_value KyberDecapsulateInto(napi_env env, napi_callback_info info) {
+  // Parse arguments: [privateKey, ciphertext, sharedSecretOut, algo?]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 3));
+  if (!k) return nullptr;
+
+  uint8_t *priv_data, *ct_data;
+  size_t priv_len, ct_len;
+  if (!get_buffer_arg(env, args[0], &priv_data, &priv_len) || priv_len != k->length_secret_key) {
+    napi_throw_error(env, nullptr, "Invalid private key");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[1], &ct_data, &ct_len) || ct_len != k->length_ciphertext) {
+    napi_throw_error(env, nullptr, "Invalid ciphertext");
+    return nullptr;
+  }
+  uint8_t* ss = get_output_arg(env, args[2], k->length_shared_secret, "Shared secret output");
+  if (!ss) return nullptr;
+
+  if (OQS_KEM_decaps(k, ss, ct_data, priv_data) != OQS_SUCCESS)
+    napi_throw_error(env, nullptr, "Decapsulation failed");
+  return nullptr;
+}
+
+// --- Ephemeral keypair pool ---
+// One KemKeyPairPool per Kyber level, created on first configure/take. The
+// pool's refill thread keeps keygen off the handshake path; takeKyberKeyPair
+// falls back to inline keygen (and counts a miss) when the pool is empty.
+static constexpr size_t KEM_POOL_DEFAULT_DEPTH = 64;
+static constexpr size_t KEM_POOL_DEFAULT_LOW = 16;
+
+static std::unique_ptr<KemKeyPairPool> g_kem_pools[KEM_COUNT];
+static std::mutex g_kem_pools_mu;
+
+static KemKeyPairPool* get_kem_pool(int handle) {
+  std::lock_guard<std::mutex> lock(g_kem_pools_mu);
+  std::unique_ptr<KemKeyPairPool>& pool = g_kem_pools[handle];
+  if (!pool) {
+    pool.reset(new KemKeyPairPool(get_kem(handle)));
+    pool->configure(KEM_POOL_DEFAULT_DEPTH, KEM_POOL_DEFAULT_LOW, KEM_POOL_DEFAULT_DEPTH);
+  }
+  return pool.get();
+}
+
+static size_t get_size_property(napi_env env, napi_value obj, const char* name, size_t fallback) {
+  bool has = false;
+  napi_has_named_property(env, obj, name, &has);
+  if (!has) return fallback;
+  napi_value v;
+  int64_t n;
+  napi_get_named_property(env, obj, name, &v);
+  if (napi_get_value_int64(env, v, &n) != napi_ok || n < 0) return fallback;
+  return static_cast<size_t>(n);
+}
+
+napi_value ConfigureKyberKeyPairPool(napi_env env, napi_callback_info info) {
+  // Parse arguments: [algo, { depth?, lowWatermark?, highWatermark? }?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  int handle = get_kem_arg(env, argc, args, 0);
+  if (!get_kem_or_throw(env, handle)) return nullptr;
+
+  size_t depth = KEM_POOL_DEFAULT_DEPTH, low = KEM_POOL_DEFAULT_LOW;
+  size_t high = KEM_POOL_DEFAULT_DEPTH;
+  if (argc >= 2) {
+    napi_valuetype t;
+    napi_typeof(env, args[1], &t);
+    if (t == napi_object) {
+      depth = get_size_property(env, args[1], "depth", depth);
+      high = get_size_property(env, args[1], "highWatermark", depth);
+      low = get_size_property(env, args[1], "lowWatermark", std::min(low, high));
+    }
+  }
+
+  get_kem_pool(handle)->configure(depth, low, high);
+  return nullptr;
+}
+
+napi_value TakeKyberKeyPair(napi_env env, napi_callback_info info) {
+  // Parse arguments: [algo?]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  int handle = get_kem_arg(env, argc, args, 0);
+  const OQS_KEM* k = get_kem_or_throw(env, handle);
+  if (!k) return nullptr;
+
+  napi_value out, buf1, buf2;
+  uint8_t* pk = new_buffer(env, k->length_public_key, &buf1);
+  uint8_t* sk = new_secret_buffer(env, k->length_secret_key, &buf2);
+  if (!pk || !sk) {
+    napi_throw_error(env, nullptr, "keypair failed");
+    return nullptr;
+  }
+
+  if (!get_kem_pool(handle)->take(pk, sk) && OQS_KEM_keypair(k, pk, sk) != OQS_SUCCESS) {
+    napi_throw_error(env, nullptr, "keypair failed");
+    return nullptr;
+  }
+
+  napi_create_object(env, &out);
+  napi_set_named_property(env, out, "publicKey", buf1);
+  napi_set_named_property(env, out, "privateKey", buf2);
+  return out;
+}
+
+napi_value GetKyberKeyPairPoolStats(napi_env env, napi_callback_info info) {
+  // Parse arguments: [algo?]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  int handle = get_kem_arg(env, argc, args, 0);
+  if (!get_kem_or_throw(env, handle)) return nullptr;
+
+  KemKeyPairPool::Stats st = get_kem_pool(handle)->stats();
+
+  napi_value out, v;
+  napi_create_object(env, &out);
+  const std::pair<const char*, double> fields[] = {
+    { "hits",          static_cast<double>(st.hits) },
+    { "misses",        static_cast<double>(st.misses) },
+    { "generated",     static_cast<double>(st.generated) },
+    { "available",     static_cast<double>(st.available) },
+    { "depth",         static_cast<double>(st.depth) },
+    { "lowWatermark",  static_cast<double>(st.lowWatermark) },
+    { "highWatermark", static_cast<double>(st.highWatermark) },
+  };
+  for (const auto& f : fields) {
+    napi_create_double(env, f.second, &v);
+    napi_set_named_property(env, out, f.first, v);
+  }
+  return out;
+}
+
+// { inUse, allocations, releases, largeAllocations, slabs, lockedBytes, lockFailures, sizeClasses }
+napi_value GetSecretArenaStats(napi_env env, napi_callback_info info) {
+  const SecretArena::Stats& st = SecretArena::shared().stats();
+
+  napi_value out, v;
+  napi_create_object(env, &out);
+  const std::pair<const char*, double> fields[] = {
+    { "inUse",            static_cast<double>(st.inUse.load()) },
+    { "allocations",      static_cast<double>(st.allocations.load()) },
+    { "releases",         static_cast<double>(st.releases.load()) },
+    { "largeAllocations", static_cast<double>(st.largeAllocations.load()) },
+    { "slabs",            static_cast<double>(st.slabs.load()) },
+    { "lockedBytes",      static_cast<double>(st.lockedBytes.load()) },
+    { "lockFailures",     static_cast<double>(st.lockFailures.load()) },
+  };
+  for (const auto& f : fields) {
+    napi_create_double(env, f.second, &v);
+    napi_set_named_property(env, out, f.first, v);
+  }
+
+  napi_value classes;
+  napi_create_array_with_length(env, SECRET_CLASSES.size(), &classes);
+  for (size_t i = 0; i < SECRET_CLASSES.size(); i++) {
+    napi_create_double(env, static_cast<double>(SECRET_CLASSES[i]), &v);
+    napi_set_element(env, classes, static_cast<uint32_t>(i), v);
+  }
+  napi_set_named_property(env, out, "sizeClasses", classes);
+  return out;
+}
+
+// --- Async (Promise) variants ---
+// The liboqs work runs on the libuv thread pool through napi_async_work, so a
+// burst of handshakes no longer stalls the event loop. Inputs are copied up
+// front into fixed-size storage inside the work item (sized for the largest
+// level in KEM_TABLE) or, for private keys, an arena slot, so the caller may
+// reuse its buffers as soon as the call returns. Result Buffers are created
+// before queueing and filled in place.
+enum class KemOp { KEYPAIR, ENCAPS, DECAPS };
+
+struct KemWork {
+  napi_async_work work = nullptr;
+  napi_deferred deferred = nullptr;
+  KemOp op;
+  const OQS_KEM* kem = nullptr;
+  std::array<uint8_t, KEM_MAX_PUBLIC_KEY> publicKey;   // encaps input
+  SecretPtr privateKey;                                 // decaps input, wiped on release
+  std::array<uint8_t, KEM_MAX_CIPHERTEXT> ciphertext;  // decaps input
+  napi_ref out_refs[2] = { nullptr, nullptr };
+  uint8_t* out[2] = { nullptr, nullptr };  // publicKey+privateKey, ciphertext+sharedSecret, or sharedSecret
+  bool failed = false;
+};
+
+// Creates a result Buffer for async work and keeps it alive until completion.
+static bool add_async_output(napi_env env, size_t len, napi_ref* ref, uint8_t** data,
+                             bool secret = false) {
+  napi_value buf;
+  *data = secret ? new_secret_buffer(env, len, &buf) : new_buffer(env, len, &buf);
+  if (!*data && len) return false;
+  return napi_create_reference(env, buf, 1, ref) == napi_ok;
+}
+
+static napi_value ref_value(napi_env env, napi_ref ref) {
+  napi_value v;
+  napi_get_reference_value(env, ref, &v);
+  return v;
+}
+
+static void reject_with_message(napi_env env, napi_deferred deferred, const char* text) {
+  napi_value msg, err;
+  napi_create_string_utf8(env, text, NAPI_AUTO_LENGTH, &msg);
+  napi_create_error(env, nullptr, msg, &err);
+  napi_reject_deferred(env, deferred, err);
+}
+
+// Invalid key material is reported through the promise, like a failed
+// operation, rather than thrown synchronously.
+static napi_value rejected_promise(napi_env env, const char* text) {
+  napi_value promise;
+  napi_deferred deferred;
+  napi_create_promise(env, &deferred, &promise);
+  reject_with_message(env, deferred, text);
+  return promise;
+}
+
+static void KemWorkExecute(napi_env, void* data) {
+  KemWork* w = static_cast<KemWork*>(data);
+  const OQS_KEM* k = w->kem;
+
+  switch (w->op) {
+    case KemOp::KEYPAIR:
+      w->failed = OQS_KEM_keypair(k, w->out[0], w->out[1]) != OQS_SUCCESS;
+      break;
+    case KemOp::ENCAPS:
+      w->failed = OQS_KEM_encaps(k, w->out[0], w->out[1], w->publicKey.data()) != OQS_SUCCESS;
+      break;
+    case KemOp::DECAPS:
+      w->failed = OQS_KEM_decaps(k, w->out[0], w->ciphertext.data(), w->privateKey.get()) != OQS_SUCCESS;
+      break;
+  }
+}
+
+static void KemWorkComplete(napi_env env, napi_status status, void* data) {
+  KemWork* w = static_cast<KemWork*>(data);
+
+  if (status != napi_ok) {
+    reject_with_message(env, w->deferred, "KEM operation cancelled");
+  } else if (w->failed) {
+    reject_with_message(env, w->deferred,
+      w->op == KemOp::KEYPAIR ? "keypair failed"
+      : w->op == KemOp::ENCAPS ? "Encapsulation failed" : "Decapsulation failed");
+  } else {
+    napi_value result;
+    switch (w->op) {
+      case KemOp::KEYPAIR:
+        napi_create_object(env, &result);
+        napi_set_named_property(env, result, "publicKey", ref_value(env, w->out_refs[0]));
+        napi_set_named_property(env, result, "privateKey", ref_value(env, w->out_refs[1]));
+        break;
+      case KemOp::ENCAPS:
+        napi_create_object(env, &result);
+        napi_set_named_property(env, result, "ciphertext", ref_value(env, w->out_refs[0]));
+        napi_set_named_property(env, result, "sharedSecret", ref_value(env, w->out_refs[1]));
+        break;
+      case KemOp::DECAPS:
+        result = ref_value(env, w->out_refs[0]);
+        break;
+    }
+    napi_resolve_deferred(env, w->deferred, result);
+  }
+
+  for (napi_ref ref : w->out_refs) if (ref) napi_delete_reference(env, ref);
+  napi_delete_async_work(env, w->work);
+  delete w;
+}
+
+static napi_value QueueKemWork(napi_env env, KemWork* w) {
+  const OQS_KEM* k = w->kem;
+  size_t len0 = 0, len1 = 0;
+  switch (w->op) {
+    case KemOp::KEYPAIR: len0 = k->length_public_key; len1 = k->length_secret_key; break;
+    case KemOp::ENCAPS:  len0 = k->length_ciphertext; len1 = k->length_shared_secret; break;
+    case KemOp::DECAPS:  len0 = k->length_shared_secret; break;
+  }
+  // The second output is always secret; the first only for decaps.
+  if (!add_async_output(env, len0, &w->out_refs[0], &w->out[0], w->op == KemOp::DECAPS) ||
+      (len1 && !add_async_output(env, len1, &w->out_refs[1], &w->out[1], true))) {
+    for (napi_ref ref : w->out_refs) if (ref) napi_delete_reference(env, ref);
+    delete w;
+    napi_throw_error(env, nullptr, "Failed to allocate result buffers");
+    return nullptr;
+  }
+
+  napi_value promise, name;
+  napi_create_promise(env, &w->deferred, &promise);
+  napi_create_string_utf8(env, "pq_crypto:kem", NAPI_AUTO_LENGTH, &name);
+  napi_create_async_work(env, nullptr, name, KemWorkExecute, KemWorkComplete, w, &w->work);
+  napi_queue_async_work(env, w->work);
+  return promise;
+}
+
+napi_value GenerateKyberKeyPairAsync(napi_env env, napi_callback_info info) {
+  // Parse arguments: [algo?]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 0));
+  if (!k) return nullptr;
+
+  KemWork* w = new KemWork();
+  w->op = KemOp::KEYPAIR;
+  w->kem = k;
+  return QueueKemWork(env, w);
+}
+
+napi_value KyberEncapsulateAsync(napi_env env, napi_callback_info info) {
+  // Parse arguments: [publicKey, algo?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  int handle = get_kem_arg(env, argc, args, 1);
+  const OQS_KEM* k = get_kem_or_throw(env, handle);
+  if (!k) return nullptr;
+  const KemSpec& spec = KEM_TABLE[handle];
+
+  uint8_t* pub_data; size_t pub_len;
+  if (!get_buffer_arg(env, args[0], &pub_data, &pub_len)) {
+    napi_throw_error(env, nullptr, "Public key must be a buffer");
+    return nullptr;
+  }
+  if (pub_len != spec.publicKey) return rejected_promise(env, "Invalid public key length");
+
+  KemWork* w = new KemWork();
+  std::memcpy(w->publicKey.data(), pub_data, pub_len);
+  w->op = KemOp::ENCAPS;
+  w->kem = k;
+  return QueueKemWork(env, w);
+}
+
+napi_value KyberDecapsulateAsync(napi_env env, napi_callback_info info) {
+  // Parse arguments: [privateKey, ciphertext, algo?]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  int handle = get_kem_arg(env, argc, args, 2);
+  const OQS_KEM* k = get_kem_or_throw(env, handle);
+  if (!k) return nullptr;
+  const KemSpec& spec = KEM_TABLE[handle];
+
+  uint8_t *priv_data, *ct_data;
+  size_t priv_len, ct_len;
+  if (!get_buffer_arg(env, args[0], &priv_data, &priv_len)) {
+    napi_throw_error(env, nullptr, "Private key must be a buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[1], &ct_data, &ct_len)) {
+    napi_throw_error(env, nullptr, "Ciphertext must be a buffer");
+    return nullptr;
+  }
+  if (priv_len != spec.secretKey || ct_len != spec.ciphertext)
+    return rejected_promise(env, "Invalid private key or ciphertext length");
+
+  KemWork* w = new KemWork();
+  w->privateKey = make_secret(priv_len);
+  if (!w->privateKey) {
+    delete w;
+    napi_throw_error(env, nullptr, "Failed to allocate secret memory");
+    return nullptr;
+  }
+  std::memcpy(w->privateKey.get(), priv_data, priv_len);
+  std::memcpy(w->ciphertext.data(), ct_data, ct_len);
+  w->op = KemOp::DECAPS;
+  w->kem = k;
+  return QueueKemWork(env, w);
+}
+
+// --- Batched KEM ---
+// N operations packed back to back in contiguous buffers, so a whole batch
+// costs one N-API crossing. The batch runs as async work and is split across
+// the shared WorkerPool. Input buffers are referenced rather than copied and
+// must not be modified until the promise settles.
+static constexpr size_t KEM_BATCH_GRAIN = 16;
+
+struct KemBatchWork {
+  napi_async_work work = nullptr;
+  napi_deferred deferred = nullptr;
+  napi_ref refs[4] = { nullptr, nullptr, nullptr, nullptr };  // inputs, then outputs
+  KemOp op;
+  const OQS_KEM* kem = nullptr;
+  size_t count = 0;
+  const uint8_t* keys = nullptr;     // packed public keys, or private keys
+  size_t key_stride = 0;             // 0: one private key shared by every item
+  const uint8_t* ciphertexts_in = nullptr;
+  uint8_t* ciphertexts = nullptr;    // encaps output
+  uint8_t* secrets = nullptr;        // packed shared secrets
+  std::atomic<bool> failed{false};
+};
+
+static void KemBatchExecute(napi_env, void* data) {
+  KemBatchWork* w = static_cast<KemBatchWork*>(data);
+  const OQS_KEM* k = w->kem;
+  size_t ct_len = k->length_ciphertext, ss_len = k->length_shared_secret;
+
+  WorkerPool::shared().parallelFor(w->count, KEM_BATCH_GRAIN, [w, k, ct_len, ss_len](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const uint8_t* key = w->keys + i * w->key_stride;
+      uint8_t* ss = w->secrets + i * ss_len;
+      OQS_STATUS rc = (w->op == KemOp::ENCAPS)
+        ? OQS_KEM_encaps(k, w->ciphertexts + i * ct_len, ss, key)
+        : OQS_KEM_decaps(k, ss, w->ciphertexts_in + i * ct_len, key);
+      if (rc != OQS_SUCCESS) w->failed.store(true, std::memory_order_relaxed);
+    }
+  });
+}
+
+static void KemBatchComplete(napi_env env, napi_status status, void* data) {
+  KemBatchWork* w = static_cast<KemBatchWork*>(data);
+
+  if (status != napi_ok) {
+    reject_with_message(env, w->deferred, "KEM batch cancelled");
+  } else if (w->failed.load()) {
+    reject_with_message(env, w->deferred,
+      w->op == KemOp::ENCAPS ? "Encapsulation failed" : "Decapsulation failed");
+  } else if (w->op == KemOp::ENCAPS) {
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "ciphertexts", ref_value(env, w->refs[2]));
+    napi_set_named_property(env, result, "sharedSecrets", ref_value(env, w->refs[3]));
+    napi_resolve_deferred(env, w->deferred, result);
+  } else {
+    napi_resolve_deferred(env, w->deferred, ref_value(env, w->refs[3]));
+  }
+
+  for (napi_ref ref : w->refs) if (ref) napi_delete_reference(env, ref);
+  napi_delete_async_work(env, w->work);
+  delete w;
+}
+
+static napi_value QueueKemBatch(napi_env env, KemBatchWork* w) {
+  const OQS_KEM* k = w->kem;
+  if ((w->op == KemOp::ENCAPS &&
+       !add_async_output(env, w->count * k->length_ciphertext, &w->refs[2], &w->ciphertexts)) ||
+      !add_async_output(env, w->count * k->length_shared_secret, &w->refs[3], &w->secrets, true)) {
+    for (napi_ref ref : w->refs) if (ref) napi_delete_reference(env, ref);
+    delete w;
+    napi_throw_error(env, nullptr, "Failed to allocate result buffers");
+    return nullptr;
+  }
+
+  napi_value promise, name;
+  napi_create_promise(env, &w->deferred, &promise);
+  napi_create_string_utf8(env, "pq_crypto:kem_batch", NAPI_AUTO_LENGTH, &name);
+  napi_create_async_work(env, nullptr, name, KemBatchExecute, KemBatchComplete, w, &w->work);
+  napi_queue_async_work(env, w->work);
+  return promise;
+}
+
+// Exposes the buffer's bytes and pins it for the lifetime of the batch.
+static bool pin_buffer_arg(napi_env env, napi_value v, napi_ref* ref,
+                           const uint8_t** data, size_t* len) {
+  uint8_t* ptr;
+  if (!get_buffer_arg(env, v, &ptr, len)) return false;
+  napi_create_reference(env, v, 1, ref);
+  *data = ptr;
+  return true;
+}
+
+napi_value KyberEncapsulateBatch(napi_env env, napi_callback_info info) {
+  // Parse arguments: [publicKeys (N * publicKeyLength), algo?]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 1));
+  if (!k) return nullptr;
+
+  KemBatchWork* w = new KemBatchWork();
+  size_t keys_len;
+  if (!pin_buffer_arg(env, args[0], &w->refs[0], &w->keys, &keys_len)) {
+    delete w;
+    napi_throw_error(env, nullptr, "Public keys must be a buffer");
+    return nullptr;
+  }
+  if (keys_len % k->length_public_key != 0) {
+    napi_delete_reference(env, w->refs[0]);
+    delete w;
+    napi_throw_error(env, nullptr, "Public keys length is not a multiple of the key size");
+    return nullptr;
+  }
+
+  w->op = KemOp::ENCAPS;
+  w->kem = k;
+  w->count = keys_len / k->length_public_key;
+  w->key_stride = k->length_public_key;
+  return QueueKemBatch(env, w);
+}
+
+napi_value KyberDecapsulateBatch(napi_env env, napi_callback_info info) {
+  // Parse arguments: [privateKeys (N * secretKeyLength, or one key), ciphertexts (N * ciphertextLength), algo?]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  const OQS_KEM* k = get_kem_or_throw(env, get_kem_arg(env, argc, args, 2));
+  if (!k) return nullptr;
+
+  KemBatchWork* w = new KemBatchWork();
+  size_t keys_len = 0, ct_len = 0;
+  const char* error = nullptr;
+  if (!pin_buffer_arg(env, args[0], &w->refs[0], &w->keys, &keys_len)) error = "Private keys must be a buffer";
+  else if (!pin_buffer_arg(env, args[1], &w->refs[1], &w->ciphertexts_in, &ct_len)) error = "Ciphertexts must be a buffer";
+  else if (ct_len % k->length_ciphertext != 0) error = "Ciphertexts length is not a multiple of the ciphertext size";
+  else {
+    w->count = ct_len / k->length_ciphertext;
+    if (keys_len == k->length_secret_key) w->key_stride = 0;
+    else if (keys_len == w->count * k->length_secret_key) w->key_stride = k->length_secret_key;
+    else error = "Private keys must be one key or one key per ciphertext";
+  }
+
+  if (error) {
+    for (napi_ref ref : w->refs) if (ref) napi_delete_reference(env, ref);
+    delete w;
+    napi_throw_error(env, nullptr, error);
+    return nullptr;
+  }
+
+  w->op = KemOp::DECAPS;
+  w->kem = k;
+  return QueueKemBatch(env, w);
+}
+
+// --- Dilithium signatures ---
+// The algorithm argument is a name from SIG_TABLE; dilithium3 by default.
+static const OQS_SIG* get_sig_arg_or_throw(napi_env env, size_t argc, napi_value* args, size_t index,
+                                           const SigSpec** spec) {
+  int sig_index = sig_index_of(PQAlgorithmType::DILITHIUM3);
+  if (argc > index) {
+    napi_valuetype t;
+    napi_typeof(env, args[index], &t);
+    if (t == napi_string) {
+      char buf[32]; size_t len;
+      napi_get_value_string_utf8(env, args[index], buf, sizeof(buf), &len);
+      sig_index = find_sig_index(buf, len);
+    } else if (t != napi_undefined) {
+      sig_index = -1;
+    }
+  }
+  const OQS_SIG* s = get_sig(sig_index);
+  if (!s) {
+    napi_throw_error(env, nullptr, sig_index < 0 ? "Unknown signature algorithm" : "Failed to initialize OQS SIG");
+    return nullptr;
+  }
+  *spec = &SIG_TABLE[sig_index];
+  return s;
+}
+
+napi_value GenerateDilithiumKeyPair(napi_env env, napi_callback_info info) {
+  // Parse arguments: [algo?]
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  const SigSpec* spec;
+  const OQS_SIG* s = get_sig_arg_or_throw(env, argc, args, 0, &spec);
+  if (!s) return nullptr;
+
+  napi_value out, buf1, buf2;
+  uint8_t* pk = new_buffer(env, spec->publicKey, &buf1);
+  uint8_t* sk = new_secret_buffer(env, spec->secretKey, &buf2);
+  if (!pk || !sk || OQS_SIG_keypair(s, pk, sk) != OQS_SUCCESS) {
+    napi_throw_error(env, nullptr, "keypair failed");
+    return nullptr;
+  }
+
+  napi_create_object(env, &out);
+  napi_set_named_property(env, out, "publicKey", buf1);
+  napi_set_named_property(env, out, "privateKey", buf2);
+  return out;
+}
+
+napi_value DilithiumSign(napi_env env, napi_callback_info info) {
+  // Parse arguments: [privateKey, message, algo?]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  uint8_t *sk, *msg;
+  size_t sk_len, msg_len;
+  if (!get_buffer_arg(env, args[0], &sk, &sk_len)) {
+    napi_throw_error(env, nullptr, "Private key must be a buffer");
+    return nullptr;
+  }
+  if (!get_buffer_arg(env, args[1], &msg, &msg_len)) {
+    napi_throw_error(env, nullptr, "Message must be a buffer");
+    return nullptr;
+  }
+
+  const SigSpec* spec;
+  const OQS_SIG* s = get_sig_arg_or_throw(env, argc, args, 2, &spec);
+  if (!s) return nullptr;
+  if (sk_len != spec->secretKey) {
+    napi_throw_error(env, nullptr, "Invalid private key length");
+    return nullptr;
+  }
+
+  // Signatures may come out shorter than the maximum, so sign on the stack
+  // and copy out exactly what was produced.
+  std::array<uint8_t, SIG_MAX_SIGNATURE> sig;
+  size_t sig_len = 0;
   napi_value result;
-  napi_create_buffer_copy(env, shared_secret.size(), shared_secret.data(), nullptr, &result);
+  if (OQS_SIG_sign(s, sig.data(), &sig_len, msg, msg_len, sk) != OQS_SUCCESS ||
+      napi_create_buffer_copy(env, sig_len, sig.data(), nullptr, &result) != napi_ok) {
+    napi_throw_error(env, nullptr, "Signing failed");
+    return nullptr;
+  }
   return result;
 }
 
+napi_value DilithiumVerify(napi_env env, napi_callback_info info) {
+  // Parse arguments: [publicKey, message, signature, algo?]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  uint8_t *pk, *msg, *sig;
+  size_t pk_len, msg_len, sig_len;
+  if (!get_buffer_arg(env, args[0], &pk, &pk_len) ||
+      !get_buffer_arg(env, args[1], &msg, &msg_len) ||
+      !get_buffer_arg(env, args[2], &sig, &sig_len)) {
+    napi_throw_error(env, nullptr, "Public key, message and signature must be buffers");
+    return nullptr;
+  }
+
+  const SigSpec* spec;
+  const OQS_SIG* s = get_sig_arg_or_throw(env, argc, args, 3, &spec);
+  if (!s) return nullptr;
+  if (pk_len != spec->publicKey) {
+    napi_throw_error(env, nullptr, "Invalid public key length");
+    return nullptr;
+  }
+
+  // A malformed signature is just an invalid one.
+  bool ok = sig_len <= spec->signature &&
+            OQS_SIG_verify(s, msg, msg_len, sig, sig_len, pk) == OQS_SUCCESS;
+  napi_value result;
+  napi_get_boolean(env, ok, &result);
+  return result;
+}
+
+// --- Batched verification ---
+// Checks N (public key, message, signature) tuples on the WorkerPool and
+// resolves with a bitmap: bit i (LSB first within each byte) is set when
+// signature i is valid. Chunks start at multiples of the grain, so keeping
+// the grain a multiple of 8 gives every bitmap byte a single writer.
+// Inputs are referenced rather than copied and must not be modified until
+// the promise settles.
+static constexpr size_t SIG_BATCH_GRAIN = 32;
+static_assert(SIG_BATCH_GRAIN % 8 == 0, "bitmap bytes must not straddle chunks");
+
+struct SigVerifyItem {
+  const uint8_t* pk;
+  const uint8_t* msg;
+  size_t msg_len;
+  const uint8_t* sig;
+  size_t sig_len;
+};
+
+struct SigBatchWork {
+  napi_async_work work = nullptr;
+  napi_deferred deferred = nullptr;
+  napi_ref refs[4] = { nullptr, nullptr, nullptr, nullptr };  // publicKeys, messages, signatures, bitmap
+  const OQS_SIG* sig = nullptr;
+  size_t max_sig_len = 0;
+  std::vector<SigVerifyItem> items;
+  uint8_t* bitmap = nullptr;
+};
+
+static void SigBatchExecute(napi_env, void* data) {
+  SigBatchWork* w = static_cast<SigBatchWork*>(data);
+
+  WorkerPool::shared().parallelFor(w->items.size(), SIG_BATCH_GRAIN, [w](size_t begin, size_t end) {
+    for (size_t byte_start = begin; byte_start < end; byte_start += 8) {
+      uint8_t bits = 0;
+      for (size_t i = byte_start; i < end && i < byte_start + 8; i++) {
+        const SigVerifyItem& it = w->items[i];
+        if (it.sig_len <= w->max_sig_len &&
+            OQS_SIG_verify(w->sig, it.msg, it.msg_len, it.sig, it.sig_len, it.pk) == OQS_SUCCESS)
+          bits |= static_cast<uint8_t>(1u << (i - byte_start));
+      }
+      w->bitmap[byte_start / 8] = bits;
+    }
+  });
+}
+
+static void SigBatchComplete(napi_env env, napi_status status, void* data) {
+  SigBatchWork* w = static_cast<SigBatchWork*>(data);
+
+  if (status != napi_ok) reject_with_message(env, w->deferred, "Signature batch cancelled");
+  else                   napi_resolve_deferred(env, w->deferred, ref_value(env, w->refs[3]));
+
+  for (napi_ref ref : w->refs) if (ref) napi_delete_reference(env, ref);
+  napi_delete_async_work(env, w->work);
+  delete w;
+}
+
+// Reads element i of a JS array as a Buffer.
+static bool get_array_buffer(napi_env env, napi_value array, uint32_t i, uint8_t** data, size_t* len) {
+  napi_value element;
+  return napi_get_element(env, array, i, &element) == napi_ok && get_buffer_arg(env, element, data, len);
+}
+
+napi_value DilithiumVerifyBatch(napi_env env, napi_callback_info info) {
+  // Parse arguments: [publicKeys (Buffer[], N packed keys, or one key), messages: Buffer[], signatures: Buffer[], algo?]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  const SigSpec* spec;
+  const OQS_SIG* s = get_sig_arg_or_throw(env, argc, args, 3, &spec);
+  if (!s) return nullptr;
+
+  bool msgs_array = false, sigs_array = false, keys_array = false;
+  napi_is_array(env, args[1], &msgs_array);
+  napi_is_array(env, args[2], &sigs_array);
+  napi_is_array(env, args[0], &keys_array);
+  uint32_t count = 0, sig_count = 0;
+  if (msgs_array) napi_get_array_length(env, args[1], &count);
+  if (sigs_array) napi_get_array_length(env, args[2], &sig_count);
+  if (!msgs_array || !sigs_array || count != sig_count) {
+    napi_throw_error(env, nullptr, "Messages and signatures must be arrays of equal length");
+    return nullptr;
+  }
+
+  // Keys: one per item from an array, packed back to back, or one shared key.
+  uint8_t* packed_keys = nullptr;
+  size_t key_stride = 0;
+  if (!keys_array) {
+    size_t keys_len;
+    if (!get_buffer_arg(env, args[0], &packed_keys, &keys_len)) {
+      napi_throw_error(env, nullptr, "Public keys must be a buffer or an array of buffers");
+      return nullptr;
+    }
+    if (keys_len == spec->publicKey) key_stride = 0;
+    else if (keys_len == size_t(count) * spec->publicKey) key_stride = spec->publicKey;
+    else {
+      napi_throw_error(env, nullptr, "Public keys must be one key or one key per signature");
+      return nullptr;
+    }
+  } else {
+    uint32_t key_count = 0;
+    napi_get_array_length(env, args[0], &key_count);
+    if (key_count != count) {
+      napi_throw_error(env, nullptr, "Public keys array must have one key per signature");
+      return nullptr;
+    }
+  }
+
+  SigBatchWork* w = new SigBatchWork();
+  w->sig = s;
+  w->max_sig_len = spec->signature;
+  w->items.resize(count);
+  const char* error = nullptr;
+  for (uint32_t i = 0; i < count && !error; i++) {
+    SigVerifyItem& it = w->items[i];
+    uint8_t *msg, *sig, *pk;
+    size_t pk_len;
+    if (!get_array_buffer(env, args[1], i, &msg, &it.msg_len)) error = "Every message must be a buffer";
+    else if (!get_array_buffer(env, args[2], i, &sig, &it.sig_len)) error = "Every signature must be a buffer";
+    else if (keys_array) {
+      if (!get_array_buffer(env, args[0], i, &pk, &pk_len) || pk_len != spec->publicKey)
+        error = "Every public key must be a buffer of the algorithm's key length";
+    } else {
+      pk = packed_keys + i * key_stride;
+    }
+    if (!error) { it.msg = msg; it.sig = sig; it.pk = pk; }
+  }
+
+  for (int i = 0; i < 3 && !error; i++) napi_create_reference(env, args[i], 1, &w->refs[i]);
+  if (!error && !add_async_output(env, (size_t(count) + 7) / 8, &w->refs[3], &w->bitmap))
+    error = "Failed to allocate result buffers";
+
+  if (error) {
+    for (napi_ref ref : w->refs) if (ref) napi_delete_reference(env, ref);
+    delete w;
+    napi_throw_error(env, nullptr, error);
+    return nullptr;
+  }
+
+  napi_value promise, name;
+  napi_create_promise(env, &w->deferred, &promise);
+  napi_create_string_utf8(env, "pq_crypto:sig_batch", NAPI_AUTO_LENGTH, &name);
+  napi_create_async_work(env, nullptr, name, SigBatchExecute, SigBatchComplete, w, &w->work);
+  napi_queue_async_work(env, w->work);
+  return promise;
+}
+
 // Forward declaration for hybrid certificate generation
 extern std::pair<std::vector<uint8_t>,std::vector<uint8_t>>
   generate_hybrid_certificate(
@@ -248,9 +1186,9 @@ napi_value GenerateHybridCertificate(napi_env env, napi_callback_info info) {
 
   napi_value out, certBuf, keyBuf;
   napi_create_object(env, &out);
-  napi_create_buffer_copy(env, cert.size(), cert.data(), nullptr, &certBuf);
+  certBuf = adopt_vector(env, std::move(cert));
   napi_set_named_property(env, out, "cert", certBuf);
-  napi_create_buffer_copy(env, key.size(), key.data(), nullptr, &keyBuf);
+  keyBuf = adopt_vector(env, std::move(key));
   napi_set_named_property(env, out, "key", keyBuf);
   return out;
 }
@@ -273,9 +1211,9 @@ napi_value GenerateDidKeyPair(napi_env env, napi_callback_info info) {
   napi_create_object(env,&out);
   napi_create_string_utf8(env,did.c_str(),NAPI_AUTO_LENGTH,&didVal);
   napi_set_named_property(env,out,"did",didVal);
-  napi_create_buffer_copy(env, pub.size(), pub.data(), nullptr, &pubBuf);
+  pubBuf = adopt_vector(env, std::move(pub));
   napi_set_named_property(env,out,"publicKey",pubBuf);
-  napi_create_buffer_copy(env, priv.size(), priv.data(), nullptr, &privBuf);
+  privBuf = adopt_vector(env, std::move(priv));
   napi_set_named_property(env,out,"privateKey",privBuf);
   return out;
 }
@@ -326,41 +1264,43 @@ napi_value DeactivateDID(napi_env env, napi_callback_info info) {
 // --- Module init ---
 // The Init function has been moved to InitPQCrypto and is called from openssl.cpp
 
-
-
-// === Helpers for PQ algorithm names ===
-// enum class PQAlgorithmType { KYBER512, KYBER768, KYBER1024 };
-static PQAlgorithmType str2pq(const std::string& a){
-  if(a=="kyber512") return PQAlgorithmType::KYBER512;
-  if(a=="kyber1024")return PQAlgorithmType::KYBER1024;
-  return PQAlgorithmType::KYBER768;
-}
-static const char* pqName(PQAlgorithmType a){
-  switch(a){
-    case PQAlgorithmType::KYBER512:  return OQS_KEM_alg_kyber_512;
-    case PQAlgorithmType::KYBER1024: return OQS_KEM_alg_kyber_1024;
-    default:                         return OQS_KEM_alg_kyber_768;
-  }
-}
-
 // === Module registration function (called from openssl.cpp) ===
 napi_value InitPQCrypto(napi_env env, napi_value exports) {
 
-  OQS_init();
+  init_kem_registry();
+  init_sig_registry();
   
   // Register cleanup hook for OQS
   napi_add_env_cleanup_hook(env, [](void*){ /* OQS cleanup if needed */ }, nullptr);
   
   napi_property_descriptor descs[] = {
+    { "kemHandle",                   nullptr, KemHandle,                   nullptr, nullptr, nullptr, napi_default, nullptr },
     { "generateKyberKeyPair",        nullptr, GenerateKyberKeyPair,        nullptr, nullptr, nullptr, napi_default, nullptr },
     { "kyberEncapsulate",            nullptr, KyberEncapsulate,            nullptr, nullptr, nullptr, napi_default, nullptr },
     { "kyberDecapsulate",            nullptr, KyberDecapsulate,            nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "generateKyberKeyPairInto",    nullptr, GenerateKyberKeyPairInto,    nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "kyberEncapsulateInto",        nullptr, KyberEncapsulateInto,        nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "kyberDecapsulateInto",        nullptr, KyberDecapsulateInto,        nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "configureKyberKeyPairPool",   nullptr, ConfigureKyberKeyPairPool,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "takeKyberKeyPair",            nullptr, TakeKyberKeyPair,            nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getKyberKeyPairPoolStats",    nullptr, GetKyberKeyPairPoolStats,    nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getSecretArenaStats",         nullptr, GetSecretArenaStats,         nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "generateKyberKeyPairAsync",   nullptr, GenerateKyberKeyPairAsync,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "kyberEncapsulateAsync",       nullptr, KyberEncapsulateAsync,       nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "kyberDecapsulateAsync",       nullptr, KyberDecapsulateAsync,       nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "kyberEncapsulateBatch",       nullptr, KyberEncapsulateBatch,       nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "kyberDecapsulateBatch",       nullptr, KyberDecapsulateBatch,       nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "generateDilithiumKeyPair",    nullptr, GenerateDilithiumKeyPair,    nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "dilithiumSign",               nullptr, DilithiumSign,               nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "dilithiumVerify",             nullptr, DilithiumVerify,             nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "dilithiumVerifyBatch",        nullptr, DilithiumVerifyBatch,        nullptr, nullptr, nullptr, napi_default, nullptr },
     { "generateHybridCertificate",   nullptr, GenerateHybridCertificate,   nullptr, nullptr, nullptr, napi_default, nullptr },
     { "generateDidKeyPair",          nullptr, GenerateDidKeyPair,          nullptr, nullptr, nullptr, napi_default, nullptr },
     { "resolveDID",                  nullptr, ResolveDID,                  nullptr, nullptr, nullptr, napi_default, nullptr },
     { "registerDID",                 nullptr, RegisterDID,                 nullptr, nullptr, nullptr, napi_default, nullptr },
     { "deactivateDID",               nullptr, DeactivateDID,               nullptr, nullptr, nullptr, napi_default, nullptr }
   };
+  metrics_instrument(descs, sizeof(descs)/sizeof(*descs));
   napi_define_properties(env, exports, sizeof(descs)/sizeof(*descs), descs);
   return exports;
 }
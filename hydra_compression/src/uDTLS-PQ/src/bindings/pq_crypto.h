@@ -2,27 +2,46 @@
 #ifndef PQ_CRYPTO_H
 #define PQ_CRYPTO_H
 
+#include "kem_registry.h"
 #include <node_api.h>
 #include <vector>
 #include <string>
 
-// PQ algorithm identifiers
-enum class PQAlgorithmType {
-  KYBER512,
-  KYBER768,
-  KYBER1024,
-  DILITHIUM2,
-  DILITHIUM3,
-  DILITHIUM5
-};
-
-PQAlgorithmType string_to_pq_algorithm(const std::string& algo);
-
 // ** Core liboqs wrappers **
+// The optional algorithm argument accepts a name or a handle from kemHandle().
+napi_value KemHandle           (napi_env env, napi_callback_info info);
 napi_value GenerateKyberKeyPair(napi_env env, napi_callback_info info);
 napi_value KyberEncapsulate    (napi_env env, napi_callback_info info);
 napi_value KyberDecapsulate    (napi_env env, napi_callback_info info);
 
+// ** Variants writing into caller-supplied output Buffers **
+napi_value GenerateKyberKeyPairInto(napi_env env, napi_callback_info info);
+napi_value KyberEncapsulateInto    (napi_env env, napi_callback_info info);
+napi_value KyberDecapsulateInto    (napi_env env, napi_callback_info info);
+
+// ** Background pre-generated keypair pool **
+napi_value ConfigureKyberKeyPairPool(napi_env env, napi_callback_info info);
+napi_value TakeKyberKeyPair         (napi_env env, napi_callback_info info);
+napi_value GetKyberKeyPairPoolStats (napi_env env, napi_callback_info info);
+
+// ** Locked, wiped-on-release storage behind every private key / shared secret **
+napi_value GetSecretArenaStats(napi_env env, napi_callback_info info);
+
+// ** Promise-returning variants (run on the libuv thread pool) **
+napi_value GenerateKyberKeyPairAsync(napi_env env, napi_callback_info info);
+napi_value KyberEncapsulateAsync    (napi_env env, napi_callback_info info);
+napi_value KyberDecapsulateAsync    (napi_env env, napi_callback_info info);
+
+// ** Batched KEM over packed buffers (Promise, split across WorkerPool) **
+napi_value KyberEncapsulateBatch(napi_env env, napi_callback_info info);
+napi_value KyberDecapsulateBatch(napi_env env, napi_callback_info info);
+
+// ** Dilithium signatures; the batch verifies on the WorkerPool and resolves a bitmap **
+napi_value GenerateDilithiumKeyPair(napi_env env, napi_callback_info info);
+napi_value DilithiumSign           (napi_env env, napi_callback_info info);
+napi_value DilithiumVerify         (napi_env env, napi_callback_info info);
+napi_value DilithiumVerifyBatch    (napi_env env, napi_callback_info info);
+
 // ** Hybrid certificate **
 napi_value GenerateHybridCertificate(napi_env env, napi_callback_info info);
 
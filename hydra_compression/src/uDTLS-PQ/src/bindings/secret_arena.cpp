@@ -0,0 +1,133 @@
+// src/bindings/secret_arena.cpp
+#include "secret_arena.h"
+#include <openssl/crypto.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <exception>
+
+namespace {
+// Sits in front of every slot. Keeping it a full 16 bytes leaves the
+// payload as aligned as malloc would.
+struct Header {
+  uint32_t magic;
+  uint16_t sizeClass;   // index into SECRET_CLASSES, or LARGE
+  uint16_t locked;      // LARGE only: the mapping was mlock'd and counted
+  union {
+    Header* next;       // free list link while the slot is free
+    size_t mapped;      // mapping length for LARGE
+  };
+};
+static_assert(sizeof(Header) == 16, "slot header must keep 16-byte alignment");
+
+constexpr uint32_t MAGIC = 0x53454352;          // "SECR"
+constexpr uint16_t LARGE = 0xffff;
+constexpr size_t SLAB_TARGET = 64 * 1024;     // stays under common RLIMIT_MEMLOCK defaults
+constexpr size_t MIN_SLOTS_PER_SLAB = 8;
+
+constexpr size_t stride_of(size_t payload) {
+  return (sizeof(Header) + payload + 63) & ~size_t(63);
+}
+
+size_t page_size() {
+  static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page;
+}
+}
+
+SecretArena& SecretArena::shared() {
+  // Never destroyed: JS Buffers backed by the arena can be finalized late.
+  static SecretArena* arena = new SecretArena();
+  return *arena;
+}
+
+void* SecretArena::map(size_t bytes, bool* locked) {
+  void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return nullptr;
+#ifdef MADV_DONTDUMP
+  madvise(p, bytes, MADV_DONTDUMP);
+#endif
+  const bool ok = mlock(p, bytes) == 0;
+  if (ok) stats_.lockedBytes += bytes;
+  else stats_.lockFailures++;
+  if (locked) *locked = ok;
+  return p;
+}
+
+// Called with the class lock held. Slabs are never returned to the OS; a
+// burst of handshakes leaves its slots on the free list for the next one.
+bool SecretArena::grow(uint32_t index) {
+  const size_t stride = stride_of(SECRET_CLASSES[index]);
+  const size_t slots = std::max(MIN_SLOTS_PER_SLAB, SLAB_TARGET / stride);
+  const size_t bytes = (slots * stride + page_size() - 1) & ~(page_size() - 1);
+
+  uint8_t* base = static_cast<uint8_t*>(map(bytes));
+  if (!base) return false;
+  stats_.slabs++;
+
+  SizeClass& c = classes_[index];
+  for (size_t i = bytes / stride; i-- > 0;) {
+    Header* h = reinterpret_cast<Header*>(base + i * stride);
+    h->magic = MAGIC;
+    h->sizeClass = static_cast<uint16_t>(index);
+    h->locked = 0;
+    h->next = static_cast<Header*>(c.free);
+    c.free = h;
+  }
+  return true;
+}
+
+uint8_t* SecretArena::allocate(size_t len) {
+  if (len == 0) len = 1;
+  auto it = std::lower_bound(SECRET_CLASSES.begin(), SECRET_CLASSES.end(), len);
+
+  Header* h = nullptr;
+  if (it == SECRET_CLASSES.end()) {
+    const size_t bytes = (sizeof(Header) + len + page_size() - 1) & ~(page_size() - 1);
+    bool locked = false;
+    h = static_cast<Header*>(map(bytes, &locked));
+    if (!h) return nullptr;
+    h->magic = MAGIC;
+    h->sizeClass = LARGE;
+    h->locked = locked;
+    h->mapped = bytes;
+    stats_.largeAllocations++;
+  } else {
+    const uint32_t index = static_cast<uint32_t>(it - SECRET_CLASSES.begin());
+    SizeClass& c = classes_[index];
+    std::lock_guard<std::mutex> lock(c.mu);
+    if (!c.free && !grow(index)) return nullptr;
+    h = static_cast<Header*>(c.free);
+    c.free = h->next;
+    h->next = nullptr;
+  }
+
+  stats_.allocations++;
+  stats_.inUse++;
+  return reinterpret_cast<uint8_t*>(h + 1);
+}
+
+void SecretArena::release(void* p) {
+  if (!p) return;
+  Header* h = static_cast<Header*>(p) - 1;
+  if (h->magic != MAGIC) std::terminate();  // not ours; freeing it would corrupt a free list
+
+  stats_.releases++;
+  stats_.inUse--;
+  if (h->sizeClass == LARGE) {
+    const size_t bytes = h->mapped;
+    OPENSSL_cleanse(p, bytes - sizeof(Header));
+    // munlock succeeds on pages that were never locked, so only undo
+    // what map() actually counted.
+    if (h->locked && munlock(h, bytes) == 0) stats_.lockedBytes -= bytes;
+    munmap(h, bytes);
+    return;
+  }
+
+  // Wipe outside the lock; the slot is still ours until it is pushed.
+  OPENSSL_cleanse(p, SECRET_CLASSES[h->sizeClass]);
+  SizeClass& c = classes_[h->sizeClass];
+  std::lock_guard<std::mutex> lock(c.mu);
+  h->next = static_cast<Header*>(c.free);
+  c.free = h;
+}
@@ -0,0 +1,97 @@
+// src/bindings/secret_arena.h
+#ifndef SECRET_ARENA_H
+#define SECRET_ARENA_H
+
+#include "kem_registry.h"
+#include "sig_registry.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Size classes: every secret length in KEM_TABLE and SIG_TABLE, sorted and
+// de-duplicated at compile time so a new level gets its own class for free.
+constexpr size_t SECRET_CLASS_CANDIDATES = 2 * KEM_COUNT + SIG_COUNT;
+
+constexpr std::array<size_t, SECRET_CLASS_CANDIDATES> secret_class_candidates() {
+  std::array<size_t, SECRET_CLASS_CANDIDATES> v{};
+  size_t n = 0;
+  for (const KemSpec& k : KEM_TABLE) { v[n++] = k.secretKey; v[n++] = k.sharedSecret; }
+  for (const SigSpec& s : SIG_TABLE) v[n++] = s.secretKey;
+  for (size_t i = 1; i < n; i++)
+    for (size_t j = i; j > 0 && v[j - 1] > v[j]; j--) { size_t t = v[j]; v[j] = v[j - 1]; v[j - 1] = t; }
+  return v;
+}
+
+constexpr size_t secret_class_count() {
+  auto v = secret_class_candidates();
+  size_t n = 0;
+  for (size_t i = 0; i < v.size(); i++) if (i == 0 || v[i] != v[i - 1]) n++;
+  return n;
+}
+
+constexpr std::array<size_t, secret_class_count()> secret_classes() {
+  auto v = secret_class_candidates();
+  std::array<size_t, secret_class_count()> out{};
+  size_t n = 0;
+  for (size_t i = 0; i < v.size(); i++) if (i == 0 || v[i] != v[i - 1]) out[n++] = v[i];
+  return out;
+}
+
+inline constexpr auto SECRET_CLASSES = secret_classes();
+
+// Allocator for private keys and shared secrets. Slots come from slabs of
+// mmap'd pages that are mlock'd (never swapped) and excluded from core
+// dumps; each size class keeps an intrusive free list, so allocate() and
+// release() are a pointer pop/push under a per-class lock once the slab
+// exists. Memory is zero on allocation and wiped on release. Requests
+// larger than the biggest class (batch outputs, the keypair pool ring) get
+// their own locked mapping, unmapped on release.
+//
+// If RLIMIT_MEMLOCK is exhausted the pages stay usable and wiped, just not
+// locked; lockFailures counts how often that happened.
+class SecretArena {
+public:
+  struct Stats {
+    std::atomic<uint64_t> allocations{0}, releases{0}, largeAllocations{0};
+    std::atomic<uint64_t> slabs{0}, lockedBytes{0}, lockFailures{0};
+    std::atomic<int64_t> inUse{0};
+  };
+
+  static SecretArena& shared();
+
+  // nullptr only if the system is out of address space.
+  uint8_t* allocate(size_t len);
+  // Wipes and recycles a pointer from allocate(); nullptr is ignored.
+  void release(void* p);
+
+  const Stats& stats() const { return stats_; }
+
+private:
+  struct SizeClass {
+    std::mutex mu;
+    void* free = nullptr;  // first free slot header
+  };
+
+  SecretArena() = default;
+  bool grow(uint32_t index);
+  void* map(size_t bytes, bool* locked = nullptr);
+
+  std::array<SizeClass, SECRET_CLASSES.size()> classes_;
+  Stats stats_;
+};
+
+struct SecretDeleter {
+  void operator()(uint8_t* p) const { SecretArena::shared().release(p); }
+};
+
+// Owning handle for arena memory.
+using SecretPtr = std::unique_ptr<uint8_t[], SecretDeleter>;
+
+inline SecretPtr make_secret(size_t len) {
+  return SecretPtr(SecretArena::shared().allocate(len));
+}
+
+#endif // SECRET_ARENA_H
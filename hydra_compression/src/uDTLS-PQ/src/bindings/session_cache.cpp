@@ -0,0 +1,250 @@
+// src/bindings/session_cache.cpp
+#include "session_cache.h"
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <cstring>
+#include <functional>
+
+// Sessions are looked up by the id the server assigned; the id context is
+// fixed so resumption works with peer verification enabled.
+static const unsigned char SESSION_ID_CONTEXT[] = "udtls-pq";
+
+SessionCache::SessionCache(const SessionCacheOptions& opts) : opts_(opts) {
+  if (opts_.shards == 0) opts_.shards = 1;
+  if (opts_.capacity < opts_.shards) opts_.capacity = opts_.shards;
+  perShard_ = opts_.capacity / opts_.shards;
+  for (size_t i = 0; i < opts_.shards; i++) shards_.emplace_back(new Shard());
+}
+
+SessionCache::~SessionCache() {
+  for (auto& shard : shards_)
+    for (auto& kv : shard->entries)
+      OPENSSL_cleanse(kv.second.der.data(), kv.second.der.size());
+  OPENSSL_cleanse(&current_, sizeof(current_));
+  OPENSSL_cleanse(&previous_, sizeof(previous_));
+}
+
+// The SSL_CTX may outlive its wrapper (sessions hold a reference), so the
+// cache lives in the context's ex_data and is deleted with it.
+int SessionCache::exIndex() {
+  static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, &SessionCache::freeExData);
+  return index;
+}
+
+SessionCache* SessionCache::attach(SSL_CTX* ctx, const SessionCacheOptions& opts) {
+  if (SessionCache* existing = of(ctx)) return existing;
+
+  SessionCache* cache = new SessionCache(opts);
+  if (cache->opts_.tickets && !cache->newTicketKey(cache->current_)) {
+    delete cache;
+    return nullptr;
+  }
+  SSL_CTX_set_ex_data(ctx, exIndex(), cache);
+
+  SSL_CTX_set_session_id_context(ctx, SESSION_ID_CONTEXT, sizeof(SESSION_ID_CONTEXT) - 1);
+  SSL_CTX_set_timeout(ctx, opts.ttlSeconds);
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+  SSL_CTX_sess_set_new_cb(ctx, &SessionCache::onNewSession);
+  SSL_CTX_sess_set_get_cb(ctx, &SessionCache::onGetSession);
+  SSL_CTX_sess_set_remove_cb(ctx, &SessionCache::onRemoveSession);
+
+  if (cache->opts_.tickets) {
+    SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
+    SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &SessionCache::onTicketKey);
+  } else {
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+  }
+  return cache;
+}
+
+SessionCache* SessionCache::of(SSL_CTX* ctx) {
+  return static_cast<SessionCache*>(SSL_CTX_get_ex_data(ctx, exIndex()));
+}
+
+void SessionCache::freeExData(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<SessionCache*>(ptr);
+}
+
+size_t SessionCache::size() const {
+  size_t n = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mu);
+    n += shard->entries.size();
+  }
+  return n;
+}
+
+SessionCache::Shard& SessionCache::shardFor(const std::string& id) {
+  return *shards_[std::hash<std::string>()(id) % shards_.size()];
+}
+
+void SessionCache::erase(Shard& shard, std::unordered_map<std::string, Entry>::iterator it) {
+  OPENSSL_cleanse(it->second.der.data(), it->second.der.size());
+  shard.lru.erase(it->second.lru);
+  shard.entries.erase(it);
+}
+
+void SessionCache::put(const std::string& id, std::vector<uint8_t> der) {
+  Shard& shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mu);
+
+  auto it = shard.entries.find(id);
+  if (it != shard.entries.end()) erase(shard, it);
+
+  while (shard.entries.size() >= perShard_ && !shard.lru.empty()) {
+    erase(shard, shard.entries.find(shard.lru.back()));
+    stats_.evicted++;
+  }
+
+  shard.lru.push_front(id);
+  Entry& entry = shard.entries[id];
+  entry.der = std::move(der);
+  entry.expires = Clock::now() + std::chrono::seconds(opts_.ttlSeconds);
+  entry.lru = shard.lru.begin();
+  stats_.stored++;
+}
+
+SSL_SESSION* SessionCache::get(const std::string& id) {
+  Shard& shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mu);
+
+  auto it = shard.entries.find(id);
+  if (it == shard.entries.end()) {
+    stats_.cacheMisses++;
+    return nullptr;
+  }
+  if (it->second.expires <= Clock::now()) {
+    erase(shard, it);
+    stats_.expired++;
+    stats_.cacheMisses++;
+    return nullptr;
+  }
+
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru);
+  const unsigned char* p = it->second.der.data();
+  SSL_SESSION* sess = d2i_SSL_SESSION(nullptr, &p, static_cast<long>(it->second.der.size()));
+  if (sess) stats_.cacheHits++;
+  else      stats_.cacheMisses++;
+  return sess;
+}
+
+void SessionCache::remove(const std::string& id) {
+  Shard& shard = shardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto it = shard.entries.find(id);
+  if (it != shard.entries.end()) erase(shard, it);
+}
+
+int SessionCache::onNewSession(SSL* ssl, SSL_SESSION* sess) {
+  SessionCache* cache = of(SSL_get_SSL_CTX(ssl));
+  unsigned int id_len = 0;
+  const unsigned char* id = SSL_SESSION_get_id(sess, &id_len);
+  if (!cache || id_len == 0) return 0;
+
+  int der_len = i2d_SSL_SESSION(sess, nullptr);
+  if (der_len <= 0) return 0;
+  std::vector<uint8_t> der(der_len);
+  unsigned char* p = der.data();
+  i2d_SSL_SESSION(sess, &p);
+
+  cache->put(std::string(reinterpret_cast<const char*>(id), id_len), std::move(der));
+  return 0;  // we keep a serialized copy, not the reference
+}
+
+SSL_SESSION* SessionCache::onGetSession(SSL* ssl, const unsigned char* id, int len, int* copy) {
+  *copy = 0;  // the returned session is a fresh object owned by OpenSSL
+  SessionCache* cache = of(SSL_get_SSL_CTX(ssl));
+  if (!cache || len <= 0) return nullptr;
+  return cache->get(std::string(reinterpret_cast<const char*>(id), len));
+}
+
+void SessionCache::onRemoveSession(SSL_CTX* ctx, SSL_SESSION* sess) {
+  SessionCache* cache = of(ctx);
+  unsigned int id_len = 0;
+  const unsigned char* id = SSL_SESSION_get_id(sess, &id_len);
+  if (cache && id_len) cache->remove(std::string(reinterpret_cast<const char*>(id), id_len));
+}
+
+bool SessionCache::newTicketKey(TicketKey& key) {
+  if (RAND_bytes(key.name, sizeof(key.name)) != 1 ||
+      RAND_priv_bytes(key.aesKey, sizeof(key.aesKey)) != 1 ||
+      RAND_priv_bytes(key.hmacKey, sizeof(key.hmacKey)) != 1)
+    return false;
+  key.created = Clock::now();
+  return true;
+}
+
+// Rotates lazily: the first ticket issued after the period ends promotes a
+// fresh key and demotes the old one to decrypt-only.
+bool SessionCache::ticketKeyForEncrypt(TicketKey& out) {
+  std::lock_guard<std::mutex> lock(keysMu_);
+  if (Clock::now() - current_.created >= std::chrono::seconds(opts_.ticketRotateSeconds)) {
+    TicketKey next;
+    if (newTicketKey(next)) {
+      previous_ = current_;
+      hasPrevious_ = true;
+      current_ = next;
+      OPENSSL_cleanse(&next, sizeof(next));
+      stats_.keyRotations++;
+    }
+  }
+  out = current_;
+  return true;
+}
+
+// 1 = current key, 2 = previous key (OpenSSL re-issues the ticket), 0 = unknown.
+int SessionCache::ticketKeyForDecrypt(const unsigned char* name, TicketKey& out) {
+  std::lock_guard<std::mutex> lock(keysMu_);
+  if (std::memcmp(name, current_.name, sizeof(current_.name)) == 0) {
+    out = current_;
+    return 1;
+  }
+  if (hasPrevious_ &&
+      Clock::now() - previous_.created < std::chrono::seconds(2 * opts_.ticketRotateSeconds) &&
+      std::memcmp(name, previous_.name, sizeof(previous_.name)) == 0) {
+    out = previous_;
+    return 2;
+  }
+  return 0;
+}
+
+int SessionCache::onTicketKey(SSL* ssl, unsigned char* name, unsigned char* iv,
+                              EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int enc) {
+  SessionCache* cache = of(SSL_get_SSL_CTX(ssl));
+  if (!cache) return -1;
+
+  TicketKey key;
+  int rc = 1;
+  if (enc) {
+    cache->ticketKeyForEncrypt(key);
+    if (RAND_bytes(iv, EVP_CIPHER_get_iv_length(EVP_aes_256_cbc())) != 1) return -1;
+    std::memcpy(name, key.name, sizeof(key.name));
+    if (EVP_EncryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key.aesKey, iv) != 1) rc = -1;
+  } else {
+    rc = cache->ticketKeyForDecrypt(name, key);
+    if (rc == 0) {
+      cache->stats_.ticketsRejected++;
+      return 0;
+    }
+    if (EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key.aesKey, iv) != 1) rc = -1;
+  }
+
+  if (rc > 0) {
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmacKey, sizeof(key.hmacKey)),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+      OSSL_PARAM_construct_end(),
+    };
+    if (EVP_MAC_CTX_set_params(mac, params) != 1) rc = -1;
+  }
+  OPENSSL_cleanse(&key, sizeof(key));
+
+  if (rc > 0) {
+    if (enc) cache->stats_.ticketsIssued++;
+    else     cache->stats_.ticketsAccepted++;
+  }
+  return rc;
+}
@@ -0,0 +1,100 @@
+// src/bindings/session_cache.h
+#ifndef SESSION_CACHE_H
+#define SESSION_CACHE_H
+
+#include <openssl/ssl.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SessionCacheOptions {
+  size_t capacity = 20000;          // sessions across all shards
+  long ttlSeconds = 7200;           // also the SSL_CTX session timeout
+  size_t shards = 16;
+  bool tickets = true;              // stateless tickets alongside the cache
+  long ticketRotateSeconds = 3600;  // previous key is still accepted for one period
+};
+
+// Server-side resumption state for one SSL_CTX: an external session cache
+// split into independently locked LRU shards, and a two-key ring for session
+// tickets. Installed with attach(); the SSL_CTX then owns the object through
+// its ex_data, so it outlives every SSL still using that context.
+class SessionCache {
+public:
+  struct Stats {
+    std::atomic<uint64_t> cacheHits{0}, cacheMisses{0};
+    std::atomic<uint64_t> stored{0}, evicted{0}, expired{0};
+    std::atomic<uint64_t> ticketsIssued{0}, ticketsAccepted{0}, ticketsRejected{0};
+    std::atomic<uint64_t> keyRotations{0};
+  };
+
+  // Returns the cache owned by ctx (creating it on first use), or nullptr
+  // if ticket keys could not be generated.
+  static SessionCache* attach(SSL_CTX* ctx, const SessionCacheOptions& opts);
+  static SessionCache* of(SSL_CTX* ctx);
+
+  const Stats& stats() const { return stats_; }
+  size_t size() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::vector<uint8_t> der;  // i2d_SSL_SESSION; holds the master secret
+    Clock::time_point expires;
+    std::list<std::string>::iterator lru;
+  };
+
+  struct Shard {
+    mutable std::mutex mu;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> lru;  // most recent at the front
+  };
+
+  struct TicketKey {
+    unsigned char name[16];
+    unsigned char aesKey[32];
+    unsigned char hmacKey[32];
+    Clock::time_point created;
+  };
+
+  explicit SessionCache(const SessionCacheOptions& opts);
+  ~SessionCache();
+
+  Shard& shardFor(const std::string& id);
+  void erase(Shard& shard, std::unordered_map<std::string, Entry>::iterator it);
+  void put(const std::string& id, std::vector<uint8_t> der);
+  SSL_SESSION* get(const std::string& id);
+  void remove(const std::string& id);
+
+  bool newTicketKey(TicketKey& key);
+  bool ticketKeyForEncrypt(TicketKey& out);
+  int ticketKeyForDecrypt(const unsigned char* name, TicketKey& out);
+
+  static int onNewSession(SSL* ssl, SSL_SESSION* sess);
+  static SSL_SESSION* onGetSession(SSL* ssl, const unsigned char* id, int len, int* copy);
+  static void onRemoveSession(SSL_CTX* ctx, SSL_SESSION* sess);
+  static int onTicketKey(SSL* ssl, unsigned char* name, unsigned char* iv,
+                         EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int enc);
+  static int exIndex();
+  static void freeExData(void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  SessionCacheOptions opts_;
+  size_t perShard_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  std::mutex keysMu_;
+  TicketKey current_;
+  TicketKey previous_;
+  bool hasPrevious_ = false;
+
+  Stats stats_;
+};
+
+#endif // SESSION_CACHE_H
@@ -0,0 +1,43 @@
+// src/bindings/sig_registry.cpp
+#include "sig_registry.h"
+#include <cstring>
+#include <mutex>
+
+int find_sig_index(const char* name, size_t len) {
+  for (int i = 0; i < SIG_COUNT; i++) {
+    const char* n = SIG_TABLE[i].name;
+    if (std::strlen(n) == len && std::memcmp(n, name, len) == 0) return i;
+  }
+  return -1;
+}
+
+struct SigRegistry {
+  OQS_SIG* sigs[SIG_COUNT] = {};
+  ~SigRegistry() {
+    for (OQS_SIG* s : sigs) if (s) OQS_SIG_free(s);
+  }
+};
+
+static SigRegistry g_sig_registry;
+static std::once_flag g_sig_registry_once;
+
+void init_sig_registry() {
+  std::call_once(g_sig_registry_once, [] {
+    OQS_init();
+    for (int i = 0; i < SIG_COUNT; i++) {
+      const SigSpec& spec = SIG_TABLE[i];
+      OQS_SIG* s = OQS_SIG_new(spec.oqsName);
+      if (s && (s->length_public_key != spec.publicKey || s->length_secret_key != spec.secretKey ||
+                s->length_signature != spec.signature)) {
+        OQS_SIG_free(s);
+        s = nullptr;
+      }
+      g_sig_registry.sigs[i] = s;
+    }
+  });
+}
+
+const OQS_SIG* get_sig(int index) {
+  if (index < 0 || index >= SIG_COUNT) return nullptr;
+  return g_sig_registry.sigs[index];
+}
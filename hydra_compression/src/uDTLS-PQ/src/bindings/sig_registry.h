@@ -0,0 +1,88 @@
+// src/bindings/sig_registry.h
+#ifndef SIG_REGISTRY_H
+#define SIG_REGISTRY_H
+
+#include "kem_registry.h"
+#include <oqs/oqs.h>
+#include <array>
+#include <cstddef>
+
+// Signature counterpart of KemTraits/KEM_TABLE (see kem_registry.h).
+template <PQAlgorithmType A> struct SigTraits;
+
+template <> struct SigTraits<PQAlgorithmType::DILITHIUM2> {
+  static constexpr const char* name = "dilithium2";
+  static constexpr const char* oqsName = OQS_SIG_alg_dilithium_2;
+  static constexpr size_t publicKey = OQS_SIG_dilithium_2_length_public_key;
+  static constexpr size_t secretKey = OQS_SIG_dilithium_2_length_secret_key;
+  static constexpr size_t signature = OQS_SIG_dilithium_2_length_signature;
+};
+
+template <> struct SigTraits<PQAlgorithmType::DILITHIUM3> {
+  static constexpr const char* name = "dilithium3";
+  static constexpr const char* oqsName = OQS_SIG_alg_dilithium_3;
+  static constexpr size_t publicKey = OQS_SIG_dilithium_3_length_public_key;
+  static constexpr size_t secretKey = OQS_SIG_dilithium_3_length_secret_key;
+  static constexpr size_t signature = OQS_SIG_dilithium_3_length_signature;
+};
+
+template <> struct SigTraits<PQAlgorithmType::DILITHIUM5> {
+  static constexpr const char* name = "dilithium5";
+  static constexpr const char* oqsName = OQS_SIG_alg_dilithium_5;
+  static constexpr size_t publicKey = OQS_SIG_dilithium_5_length_public_key;
+  static constexpr size_t secretKey = OQS_SIG_dilithium_5_length_secret_key;
+  static constexpr size_t signature = OQS_SIG_dilithium_5_length_signature;
+};
+
+struct SigSpec {
+  PQAlgorithmType type;
+  const char* name;
+  const char* oqsName;
+  size_t publicKey, secretKey, signature;  // signature is the maximum length
+};
+
+template <PQAlgorithmType A>
+constexpr SigSpec sig_spec_of() {
+  using T = SigTraits<A>;
+  return { A, T::name, T::oqsName, T::publicKey, T::secretKey, T::signature };
+}
+
+// Indexed by PQAlgorithmType minus DILITHIUM2.
+inline constexpr std::array<SigSpec, 3> SIG_TABLE = {
+  sig_spec_of<PQAlgorithmType::DILITHIUM2>(),
+  sig_spec_of<PQAlgorithmType::DILITHIUM3>(),
+  sig_spec_of<PQAlgorithmType::DILITHIUM5>(),
+};
+
+static constexpr int SIG_COUNT = static_cast<int>(SIG_TABLE.size());
+
+constexpr int sig_index_of(PQAlgorithmType type) {
+  return static_cast<int>(type) - static_cast<int>(PQAlgorithmType::DILITHIUM2);
+}
+
+constexpr bool sig_table_is_indexed_by_type() {
+  for (size_t i = 0; i < SIG_TABLE.size(); i++)
+    if (sig_index_of(SIG_TABLE[i].type) != static_cast<int>(i)) return false;
+  return true;
+}
+static_assert(sig_table_is_indexed_by_type(), "SIG_TABLE order must follow PQAlgorithmType");
+
+constexpr size_t sig_table_max(size_t SigSpec::*field) {
+  size_t m = 0;
+  for (const SigSpec& s : SIG_TABLE) if (s.*field > m) m = s.*field;
+  return m;
+}
+
+static constexpr size_t SIG_MAX_SIGNATURE = sig_table_max(&SigSpec::signature);
+
+// Returns the SIG_TABLE index for a name, or -1.
+int find_sig_index(const char* name, size_t len);
+
+// One prepared OQS_SIG per level, shared by all threads like the KEMs.
+void init_sig_registry();
+
+// nullptr for an unknown index, if liboqs lacks the algorithm, or if its
+// sizes disagree with SIG_TABLE.
+const OQS_SIG* get_sig(int index);
+
+#endif // SIG_REGISTRY_H
@@ -0,0 +1,904 @@
+// src/bindings/udp_socket.cpp
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // recvmmsg/sendmmsg
+#endif
+#include "udp_socket.h"
+#include "dgram_bio.h"
+#include "handle_table.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+#include <sys/uio.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+// DTLS content type of a handshake record; only these may open a new peer.
+static const uint8_t DTLS_CT_HANDSHAKE = 22;
+
+// Peers are keyed by family, address and port only, so the key does not
+// depend on how the kernel filled padding bytes in the sockaddr.
+std::string udp_peer_key(const sockaddr_storage& addr) {
+  std::string key(1, static_cast<char>(addr.ss_family));
+  if (addr.ss_family == AF_INET6) {
+    auto* v6 = reinterpret_cast<const sockaddr_in6*>(&addr);
+    key.append(reinterpret_cast<const char*>(&v6->sin6_addr), sizeof(v6->sin6_addr));
+    key.append(reinterpret_cast<const char*>(&v6->sin6_port), sizeof(v6->sin6_port));
+    key.append(reinterpret_cast<const char*>(&v6->sin6_scope_id), sizeof(v6->sin6_scope_id));
+  } else {
+    auto* v4 = reinterpret_cast<const sockaddr_in*>(&addr);
+    key.append(reinterpret_cast<const char*>(&v4->sin_addr), sizeof(v4->sin_addr));
+    key.append(reinterpret_cast<const char*>(&v4->sin_port), sizeof(v4->sin_port));
+  }
+  return key;
+}
+
+// One slot per datagram; buffers are allocated once per endpoint.
+struct UdpEndpoint::Batch {
+  std::vector<uint8_t> buffer;
+  std::vector<sockaddr_storage> addrs;
+  std::vector<iovec> iov;
+#ifdef __linux__
+  std::vector<mmsghdr> msgs;
+#endif
+
+  Batch(size_t slots, size_t slotSize)
+      : buffer(slots * slotSize), addrs(slots), iov(slots)
+#ifdef __linux__
+      , msgs(slots)
+#endif
+  {
+    for (size_t i = 0; i < slots; i++) {
+      iov[i].iov_base = buffer.data() + i * slotSize;
+      iov[i].iov_len = slotSize;
+    }
+  }
+};
+
+UdpEndpoint::UdpEndpoint(const UdpEndpointOptions& opts,
+                         std::shared_ptr<SSLContextWrapper> acceptContext,
+                         napi_threadsafe_function onEvents)
+    : opts_(opts), acceptContext_(std::move(acceptContext)), onEvents_(onEvents) {
+  if (opts_.batchSize == 0) opts_.batchSize = 1;
+  if (opts_.maxDatagram < 512) opts_.maxDatagram = 512;
+}
+
+UdpEndpoint::~UdpEndpoint() {
+  stop();
+}
+
+bool UdpEndpoint::start(std::string& error) {
+  sockaddr_storage local;
+  socklen_t local_len;
+  if (!parse_peer_address(opts_.address, opts_.port, local, local_len)) {
+    error = "Invalid bind address";
+    return false;
+  }
+
+  fd_ = socket(local.ss_family, SOCK_DGRAM, 0);
+  if (fd_ < 0) {
+    error = std::string("socket: ") + strerror(errno);
+    return false;
+  }
+  fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL, 0) | O_NONBLOCK);
+
+  int one = 1;
+  setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+#ifdef SO_REUSEPORT
+  if (opts_.reusePort) setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+#endif
+
+  if (bind(fd_, reinterpret_cast<sockaddr*>(&local), local_len) < 0 || pipe(wakePipe_) < 0) {
+    error = std::string("bind: ") + strerror(errno);
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  fcntl(wakePipe_[0], F_SETFL, fcntl(wakePipe_[0], F_GETFL, 0) | O_NONBLOCK);
+  fcntl(wakePipe_[1], F_SETFL, fcntl(wakePipe_[1], F_GETFL, 0) | O_NONBLOCK);
+
+#ifdef __linux__
+  epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = wakePipe_[0];
+  epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakePipe_[0], &ev);
+  ev.data.fd = fd_;
+  epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd_, &ev);
+#endif
+
+  sockaddr_storage bound;
+  socklen_t bound_len = sizeof(bound);
+  getsockname(fd_, reinterpret_cast<sockaddr*>(&bound), &bound_len);
+  format_peer_address(bound, &localPort_);
+
+  rx_.reset(new Batch(opts_.batchSize, opts_.maxDatagram));
+  tx_.reset(new Batch(opts_.batchSize, 0));
+
+  running_ = true;
+  thread_ = std::thread(&UdpEndpoint::run, this);
+  return true;
+}
+
+void UdpEndpoint::stop() {
+  if (running_.exchange(false)) {
+    wake();
+    if (thread_.joinable()) thread_.join();
+  }
+  if (fd_ >= 0) { close(fd_); fd_ = -1; }
+  if (epollFd_ >= 0) { close(epollFd_); epollFd_ = -1; }
+  for (int& p : wakePipe_) {
+    if (p >= 0) { close(p); p = -1; }
+  }
+  peers_.clear();
+  listener_.reset();
+  stats_.peers = 0;
+}
+
+void UdpEndpoint::wake() {
+  char b = 1;
+  ssize_t rc = write(wakePipe_[1], &b, 1);
+  (void)rc;  // a full pipe already means a wake-up is pending
+}
+
+void UdpEndpoint::connect(std::shared_ptr<SSLContextWrapper> ctx, const sockaddr_storage& peer, socklen_t len) {
+  {
+    std::lock_guard<std::mutex> lock(commandsMu_);
+    commands_.push_back(Command{ Command::CONNECT, peer, len, std::move(ctx), {} });
+  }
+  wake();
+}
+
+void UdpEndpoint::send(const sockaddr_storage& peer, socklen_t len, std::vector<uint8_t> data) {
+  {
+    std::lock_guard<std::mutex> lock(commandsMu_);
+    commands_.push_back(Command{ Command::SEND, peer, len, nullptr, std::move(data) });
+  }
+  wake();
+}
+
+void UdpEndpoint::disconnect(const sockaddr_storage& peer, socklen_t len) {
+  {
+    std::lock_guard<std::mutex> lock(commandsMu_);
+    commands_.push_back(Command{ Command::DISCONNECT, peer, len, nullptr, {} });
+  }
+  wake();
+}
+
+// Blocks until the wake pipe or the socket is ready, or the nearest
+// retransmission deadline passes. The socket is watched for writability
+// only while datagrams are queued.
+void UdpEndpoint::wait(bool& woke, bool& readable) {
+  woke = readable = false;
+  bool want_write = !outbound_.empty();
+#ifdef __linux__
+  if (want_write != wantWrite_) {
+    epoll_event ev{};
+    ev.events = EPOLLIN | (want_write ? uint32_t(EPOLLOUT) : 0u);
+    ev.data.fd = fd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd_, &ev);
+    wantWrite_ = want_write;
+  }
+  epoll_event events[2];
+  int n = epoll_wait(epollFd_, events, 2, pollTimeoutMs());
+  for (int i = 0; i < n; i++) {
+    if (events[i].data.fd == wakePipe_[0]) woke = true;
+    else if (events[i].events & (EPOLLIN | EPOLLERR)) readable = true;
+  }
+#else
+  pollfd fds[2];
+  fds[0] = { wakePipe_[0], POLLIN, 0 };
+  fds[1] = { fd_, static_cast<short>(POLLIN | (want_write ? POLLOUT : 0)), 0 };
+  if (poll(fds, 2, pollTimeoutMs()) > 0) {
+    woke = fds[0].revents & POLLIN;
+    readable = fds[1].revents & (POLLIN | POLLERR);
+  }
+#endif
+}
+
+// I/O thread: wait for datagrams, commands or a retransmission deadline,
+// then work through everything that is ready before handing the collected
+// events to JS in one call.
+void UdpEndpoint::run() {
+  while (running_) {
+    bool woke, readable;
+    wait(woke, readable);
+    if (!running_) break;
+
+    pending_ = new std::vector<UdpEvent>();
+
+    if (woke) {
+      char drain[64];
+      while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {}
+    }
+    drainCommands();
+    if (readable) receiveBatch();
+    handleTimers();
+    flushOutbound();
+    emit();
+  }
+}
+
+void UdpEndpoint::drainCommands() {
+  std::vector<Command> cmds;
+  {
+    std::lock_guard<std::mutex> lock(commandsMu_);
+    cmds.swap(commands_);
+  }
+
+  for (auto& cmd : cmds) {
+    std::string key = udp_peer_key(cmd.peer);
+    auto it = peers_.find(key);
+
+    switch (cmd.type) {
+      case Command::CONNECT: {
+        if (it != peers_.end()) break;
+        Peer* peer = newPeer(cmd.ctx->get(), cmd.peer, cmd.peerLen, true);
+        if (!peer) break;
+        DtlsStepResult result;
+        dtls_step(*peer->session, nullptr, 0, result);
+        afterStep(key, *peer, result);
+        break;
+      }
+      case Command::SEND: {
+        if (it == peers_.end()) {
+          UdpEvent ev{ UdpEvent::ERROR, cmd.peer, cmd.peerLen, {}, "Unknown peer" };
+          pending_->push_back(std::move(ev));
+          break;
+        }
+        Peer& peer = it->second;
+        if (!peer.connected) {
+          peer.queued.push_back(std::move(cmd.data));
+          break;
+        }
+        DtlsStepResult result;
+        dtls_write(*peer.session, cmd.data.data(), cmd.data.size(), result);
+        afterStep(key, peer, result);
+        break;
+      }
+      case Command::DISCONNECT: {
+        if (it != peers_.end()) closePeer(key, it->second);
+        break;
+      }
+    }
+  }
+}
+
+// Reads until the socket would block, one recvmmsg per batch.
+void UdpEndpoint::receiveBatch() {
+  Batch& b = *rx_;
+  const size_t slots = opts_.batchSize;
+
+  for (;;) {
+    size_t received = 0;
+#ifdef __linux__
+    for (size_t i = 0; i < slots; i++) {
+      std::memset(&b.msgs[i], 0, sizeof(mmsghdr));
+      b.msgs[i].msg_hdr.msg_name = &b.addrs[i];
+      b.msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+      b.msgs[i].msg_hdr.msg_iov = &b.iov[i];
+      b.msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int n = recvmmsg(fd_, b.msgs.data(), static_cast<unsigned>(slots), MSG_DONTWAIT, nullptr);
+    if (n <= 0) return;
+    received = static_cast<size_t>(n);
+#else
+    std::vector<size_t> lengths(slots);
+    for (; received < slots; received++) {
+      socklen_t alen = sizeof(sockaddr_storage);
+      ssize_t n = recvfrom(fd_, b.iov[received].iov_base, opts_.maxDatagram, MSG_DONTWAIT,
+                           reinterpret_cast<sockaddr*>(&b.addrs[received]), &alen);
+      if (n < 0) break;
+      lengths[received] = static_cast<size_t>(n);
+    }
+    if (received == 0) return;
+#endif
+    stats_.rxBatches++;
+    stats_.rxPackets += received;
+
+    for (size_t i = 0; i < received; i++) {
+#ifdef __linux__
+      size_t len = b.msgs[i].msg_len;
+      socklen_t alen = b.msgs[i].msg_hdr.msg_namelen;
+      if (b.msgs[i].msg_hdr.msg_flags & MSG_TRUNC) { stats_.dropped++; continue; }
+#else
+      size_t len = lengths[i];
+      socklen_t alen = b.addrs[i].ss_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+      if (len > opts_.maxDatagram) { stats_.dropped++; continue; }
+#endif
+      const uint8_t* data = static_cast<const uint8_t*>(b.iov[i].iov_base);
+      if (len == 0) continue;
+
+      std::string key = udp_peer_key(b.addrs[i]);
+      auto it = peers_.find(key);
+      Peer* peer = it == peers_.end() ? nullptr : &it->second;
+      if (!peer) {
+        // Only a handshake record may open a session, only on a server, and
+        // only while there is room for one more.
+        if (!acceptContext_ || data[0] != DTLS_CT_HANDSHAKE ||
+            (opts_.maxPeers && peers_.size() >= opts_.maxPeers)) {
+          stats_.dropped++;
+          continue;
+        }
+        if (acceptContext_->cookieExchange()) {
+          std::unique_ptr<SSLSessionWrapper> verified = listen(b.addrs[i], alen, data, len);
+          if (!verified) continue;
+          peer = addPeer(std::move(verified), b.addrs[i], alen);
+          len = 0;  // the listener already holds this ClientHello
+        } else {
+          peer = newPeer(acceptContext_->get(), b.addrs[i], alen, false);
+        }
+        if (!peer) { stats_.dropped++; continue; }
+      }
+      peer->lastHeard = Clock::now();
+
+      DtlsStepResult result;
+      dtls_step(*peer->session, data, len, result);
+      afterStep(key, *peer, result);
+    }
+
+    if (received < slots) return;
+  }
+}
+
+// Sends queued datagrams one sendmmsg per batch; whatever the kernel does
+// not accept stays queued until the socket polls writable.
+void UdpEndpoint::flushOutbound() {
+  Batch& b = *tx_;
+  size_t sent = 0;
+
+  while (sent < outbound_.size()) {
+    size_t count = std::min(opts_.batchSize, outbound_.size() - sent);
+    size_t accepted = 0;
+#ifdef __linux__
+    for (size_t i = 0; i < count; i++) {
+      Outbound& o = outbound_[sent + i];
+      b.iov[i].iov_base = o.data.data();
+      b.iov[i].iov_len = o.data.size();
+      std::memset(&b.msgs[i], 0, sizeof(mmsghdr));
+      b.msgs[i].msg_hdr.msg_name = &o.peer;
+      b.msgs[i].msg_hdr.msg_namelen = o.peerLen;
+      b.msgs[i].msg_hdr.msg_iov = &b.iov[i];
+      b.msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int n = sendmmsg(fd_, b.msgs.data(), static_cast<unsigned>(count), MSG_DONTWAIT);
+    if (n > 0) accepted = static_cast<size_t>(n);
+#else
+    for (; accepted < count; accepted++) {
+      Outbound& o = outbound_[sent + accepted];
+      if (sendto(fd_, o.data.data(), o.data.size(), MSG_DONTWAIT,
+                 reinterpret_cast<sockaddr*>(&o.peer), o.peerLen) < 0) break;
+    }
+#endif
+    if (accepted == 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) break;
+      // The first datagram is undeliverable (e.g. no route); skip it.
+      stats_.dropped++;
+      sent++;
+      continue;
+    }
+    stats_.txBatches++;
+    stats_.txPackets += accepted;
+    sent += accepted;
+  }
+
+  outbound_.erase(outbound_.begin(), outbound_.begin() + sent);
+}
+
+// Retransmits for peers whose handshake timer fired, and closes peers that
+// have been silent longer than idleTimeoutMs.
+void UdpEndpoint::handleTimers() {
+  auto now = Clock::now();
+  std::vector<std::string> due, idle;
+  for (auto& kv : peers_) {
+    if (idleDeadline(kv.second) <= now) idle.push_back(kv.first);
+    else if (kv.second.deadline <= now) due.push_back(kv.first);
+  }
+
+  for (auto& key : idle) closePeer(key, peers_.at(key));
+
+  for (auto& key : due) {
+    auto it = peers_.find(key);
+    if (it == peers_.end()) continue;
+    Peer& peer = it->second;
+    DtlsStepResult result;
+    if (DTLSv1_handle_timeout(peer.session->get()) < 0)
+      result.error = "DTLS retransmission limit reached";
+    dtls_step(*peer.session, nullptr, 0, result);
+    afterStep(key, peer, result);
+  }
+}
+
+Clock::time_point UdpEndpoint::idleDeadline(const Peer& peer) const {
+  if (opts_.idleTimeoutMs <= 0) return Clock::time_point::max();
+  return peer.lastHeard + std::chrono::milliseconds(opts_.idleTimeoutMs);
+}
+
+int UdpEndpoint::pollTimeoutMs() const {
+  auto next = Clock::time_point::max();
+  for (auto& kv : peers_) next = std::min({ next, kv.second.deadline, idleDeadline(kv.second) });
+  if (next == Clock::time_point::max()) return -1;
+
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(next - Clock::now()).count();
+  return ms < 0 ? 0 : static_cast<int>(std::min<long long>(ms, 60000));
+}
+
+void UdpEndpoint::emit() {
+  if (pending_->empty() ||
+      napi_call_threadsafe_function(onEvents_, pending_, napi_tsfn_nonblocking) != napi_ok)
+    delete pending_;
+  pending_ = nullptr;
+}
+
+void UdpEndpoint::configureSession(SSLSessionWrapper& session, const sockaddr_storage& addr, socklen_t len) {
+  SSL_set_mtu(session.get(), opts_.mtu);
+  DTLS_set_link_mtu(session.get(), opts_.mtu);
+  dgram_bio_set_peer(session.bio(), reinterpret_cast<const sockaddr*>(&addr), len);
+}
+
+UdpEndpoint::Peer* UdpEndpoint::newPeer(SSL_CTX* ctx, const sockaddr_storage& addr, socklen_t len, bool client) {
+  std::unique_ptr<SSLSessionWrapper> session(new SSLSessionWrapper(ctx));
+  if (!session->get()) return nullptr;
+  configureSession(*session, addr, len);
+  if (client) SSL_set_connect_state(session->get());
+  else        SSL_set_accept_state(session->get());
+  return addPeer(std::move(session), addr, len);
+}
+
+// Stateless cookie gate: unknown peers share one listener SSL until they
+// echo a valid cookie, so a spoofed ClientHello costs one HMAC and one
+// HelloVerifyRequest, never an SSL object or key exchange of its own.
+// On success the listener, now mid-handshake, becomes the peer's session.
+std::unique_ptr<SSLSessionWrapper> UdpEndpoint::listen(const sockaddr_storage& addr, socklen_t len,
+                                                       const uint8_t* data, size_t size) {
+  if (!listener_) {
+    listener_.reset(new SSLSessionWrapper(acceptContext_->get()));
+    if (!listener_->get()) {
+      listener_.reset();
+      return nullptr;
+    }
+  }
+
+  configureSession(*listener_, addr, len);
+  dgram_bio_push_inbound(listener_->bio(), data, size);
+  BIO_ADDR* client = BIO_ADDR_new();
+  int rc = DTLSv1_listen(listener_->get(), client);
+  BIO_ADDR_free(client);
+
+  std::vector<std::vector<uint8_t>> datagrams;
+  dgram_bio_take_outbound(listener_->bio(), datagrams);
+  for (auto& d : datagrams)
+    outbound_.push_back(Outbound{ addr, len, std::move(d) });
+
+  if (rc <= 0) {
+    ERR_clear_error();
+    return nullptr;
+  }
+  // The retained ClientHello was just verified; don't check it twice.
+  SSL_clear_options(listener_->get(), SSL_OP_COOKIE_EXCHANGE);
+  return std::move(listener_);
+}
+
+UdpEndpoint::Peer* UdpEndpoint::addPeer(std::unique_ptr<SSLSessionWrapper> session,
+                                        const sockaddr_storage& addr, socklen_t len) {
+  Peer peer;
+  peer.session = std::move(session);
+  peer.addr = addr;
+  peer.addrLen = len;
+
+  std::string key = udp_peer_key(addr);
+  auto inserted = peers_.emplace(key, std::move(peer));
+  stats_.peers = peers_.size();
+  if (peerObserver_) peerObserver_(key, true);
+  return &inserted.first->second;
+}
+
+// Sends close_notify if the handshake finished, then forgets the peer.
+void UdpEndpoint::closePeer(const std::string& key, Peer& peer) {
+  std::vector<std::vector<uint8_t>> datagrams;
+  if (SSL_is_init_finished(peer.session->get())) SSL_shutdown(peer.session->get());
+  dgram_bio_take_outbound(peer.session->bio(), datagrams);
+  for (auto& d : datagrams)
+    outbound_.push_back(Outbound{ peer.addr, peer.addrLen, std::move(d) });
+  pushEvent(UdpEvent::CLOSE, peer);
+  dropPeer(key);
+}
+
+void UdpEndpoint::dropPeer(const std::string& key) {
+  if (peers_.erase(key) && peerObserver_) peerObserver_(key, false);
+  stats_.peers = peers_.size();
+}
+
+void UdpEndpoint::pushEvent(UdpEvent::Type type, const Peer& peer) {
+  UdpEvent ev;
+  ev.type = type;
+  ev.peer = peer.addr;
+  ev.peerLen = peer.addrLen;
+  pending_->push_back(std::move(ev));
+}
+
+// Routes one step's output: datagrams to the send queue, state changes and
+// plaintext to the pending event batch.
+void UdpEndpoint::afterStep(const std::string& key, Peer& peer, DtlsStepResult& result) {
+  for (auto& d : result.datagrams)
+    outbound_.push_back(Outbound{ peer.addr, peer.addrLen, std::move(d) });
+
+  if (result.handshakeComplete && !peer.connected) {
+    peer.connected = true;
+    pushEvent(UdpEvent::CONNECT, peer);
+
+    std::vector<std::vector<uint8_t>> queued;
+    queued.swap(peer.queued);
+    for (auto& q : queued) {
+      DtlsStepResult sent;
+      dtls_write(*peer.session, q.data(), q.size(), sent);
+      for (auto& d : sent.datagrams)
+        outbound_.push_back(Outbound{ peer.addr, peer.addrLen, std::move(d) });
+    }
+  }
+
+  if (!result.plaintext.empty()) {
+    pushEvent(UdpEvent::MESSAGE, peer);
+    pending_->back().data = std::move(result.plaintext);
+  }
+
+  peer.deadline = result.timeoutMs >= 0
+      ? Clock::now() + std::chrono::milliseconds(result.timeoutMs)
+      : Clock::time_point::max();
+
+  if (!result.error.empty()) {
+    pushEvent(UdpEvent::ERROR, peer);
+    pending_->back().error = result.error;
+    dropPeer(key);
+  } else if (result.closed) {
+    pushEvent(UdpEvent::CLOSE, peer);
+    dropPeer(key);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// N-API surface. Sockets are addressed by { id } like contexts and sessions;
+// events arrive as one array per I/O batch:
+//   [{ type: 'connect'|'message'|'close'|'error', address, port, data?, error? }]
+// ---------------------------------------------------------------------------
+
+static HandleTable<UdpEndpoint> g_udp_sockets;
+
+static const char* event_type_name(UdpEvent::Type type) {
+  switch (type) {
+    case UdpEvent::CONNECT: return "connect";
+    case UdpEvent::MESSAGE: return "message";
+    case UdpEvent::CLOSE:   return "close";
+    default:                return "error";
+  }
+}
+
+void udp_call_js_events(napi_env env, napi_value js_cb, void*, void* data) {
+  std::unique_ptr<std::vector<UdpEvent>> events(static_cast<std::vector<UdpEvent>*>(data));
+  if (!env || !js_cb) return;
+
+  napi_value list, v;
+  napi_create_array_with_length(env, events->size(), &list);
+  for (size_t i = 0; i < events->size(); i++) {
+    UdpEvent& ev = (*events)[i];
+    napi_value obj;
+    napi_create_object(env, &obj);
+
+    napi_create_string_utf8(env, event_type_name(ev.type), NAPI_AUTO_LENGTH, &v);
+    napi_set_named_property(env, obj, "type", v);
+
+    int port = 0;
+    std::string host = format_peer_address(ev.peer, &port);
+    napi_create_string_utf8(env, host.c_str(), host.size(), &v);
+    napi_set_named_property(env, obj, "address", v);
+    napi_create_int32(env, port, &v);
+    napi_set_named_property(env, obj, "port", v);
+
+    if (!ev.data.empty()) {
+      napi_create_buffer_copy(env, ev.data.size(), ev.data.data(), nullptr, &v);
+      napi_set_named_property(env, obj, "data", v);
+    }
+    if (!ev.error.empty()) {
+      napi_create_string_utf8(env, ev.error.c_str(), ev.error.size(), &v);
+      napi_set_named_property(env, obj, "error", v);
+    }
+    napi_set_element(env, list, static_cast<uint32_t>(i), obj);
+  }
+
+  napi_value undefined;
+  napi_get_undefined(env, &undefined);
+  napi_call_function(env, undefined, js_cb, 1, &list, nullptr);
+}
+
+int udp_get_id_property(napi_env env, napi_value obj) {
+  napi_value id_value;
+  int id = 0;
+  if (napi_get_named_property(env, obj, "id", &id_value) != napi_ok ||
+      napi_get_value_int32(env, id_value, &id) != napi_ok)
+    return 0;
+  return id;
+}
+
+static bool get_int_option(napi_env env, napi_value obj, const char* name, int32_t* out) {
+  bool has = false;
+  napi_value v;
+  if (napi_has_named_property(env, obj, name, &has) != napi_ok || !has) return false;
+  napi_get_named_property(env, obj, name, &v);
+  return napi_get_value_int32(env, v, out) == napi_ok;
+}
+
+static std::shared_ptr<UdpEndpoint> get_socket_arg(napi_env env, napi_value obj) {
+  auto endpoint = g_udp_sockets.get(udp_get_id_property(env, obj));
+  if (!endpoint) napi_throw_error(env, nullptr, "Invalid UDP socket");
+  return endpoint;
+}
+
+// [host, port] at args[index], args[index + 1]
+bool udp_get_peer_args(napi_env env, napi_value* args, size_t index,
+                          sockaddr_storage& addr, socklen_t& len) {
+  char host[INET6_ADDRSTRLEN + 1];
+  size_t host_len = 0;
+  int32_t port = 0;
+  if (napi_get_value_string_utf8(env, args[index], host, sizeof(host), &host_len) != napi_ok ||
+      napi_get_value_int32(env, args[index + 1], &port) != napi_ok ||
+      port <= 0 || port > 65535 ||
+      !parse_peer_address(std::string(host, host_len), port, addr, len)) {
+    napi_throw_error(env, nullptr, "Invalid peer address");
+    return false;
+  }
+  return true;
+}
+
+// NAPI implementation for CreateUdpSocket
+napi_value CreateUdpSocket(napi_env env, napi_callback_info info) {
+  // Parse arguments: [{ address?, port?, context?, batchSize?, maxDatagram?, mtu?, reusePort?,
+  //                    idleTimeoutMs?, maxPeers? }, onEvents]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  napi_valuetype cb_type = napi_undefined;
+  if (argc >= 2) napi_typeof(env, args[1], &cb_type);
+  if (argc < 2 || cb_type != napi_function) {
+    napi_throw_error(env, nullptr, "Expected (options, onEvents)");
+    return nullptr;
+  }
+
+  UdpEndpointOptions opts;
+  std::shared_ptr<SSLContextWrapper> accept_ctx;
+  int32_t n;
+
+  napi_value v;
+  bool has = false;
+  napi_has_named_property(env, args[0], "address", &has);
+  if (has) {
+    char host[INET6_ADDRSTRLEN + 1];
+    size_t host_len = 0;
+    napi_get_named_property(env, args[0], "address", &v);
+    if (napi_get_value_string_utf8(env, v, host, sizeof(host), &host_len) == napi_ok)
+      opts.address.assign(host, host_len);
+  }
+  if (get_int_option(env, args[0], "port", &n)) opts.port = n;
+  if (get_int_option(env, args[0], "batchSize", &n) && n > 0) opts.batchSize = std::min(n, 1024);
+  if (get_int_option(env, args[0], "maxDatagram", &n) && n > 0) opts.maxDatagram = std::min(n, 65535);
+  if (get_int_option(env, args[0], "mtu", &n) && n > 0) opts.mtu = n;
+  if (get_int_option(env, args[0], "idleTimeoutMs", &n) && n > 0) opts.idleTimeoutMs = n;
+  if (get_int_option(env, args[0], "maxPeers", &n) && n > 0) opts.maxPeers = n;
+
+  napi_has_named_property(env, args[0], "reusePort", &has);
+  if (has) {
+    napi_get_named_property(env, args[0], "reusePort", &v);
+    napi_get_value_bool(env, v, &opts.reusePort);
+  }
+
+  // With a context the socket accepts DTLS handshakes from any peer.
+  napi_has_named_property(env, args[0], "context", &has);
+  if (has) {
+    napi_get_named_property(env, args[0], "context", &v);
+    accept_ctx = find_context(udp_get_id_property(env, v));
+    if (!accept_ctx) {
+      napi_throw_error(env, nullptr, "Invalid context");
+      return nullptr;
+    }
+  }
+
+  napi_value name;
+  napi_create_string_utf8(env, "udpSocketEvents", NAPI_AUTO_LENGTH, &name);
+  napi_threadsafe_function tsfn;
+  if (napi_create_threadsafe_function(env, args[1], nullptr, name, 0, 1, nullptr, nullptr,
+                                      nullptr, udp_call_js_events, &tsfn) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to create event callback");
+    return nullptr;
+  }
+
+  auto endpoint = std::make_shared<UdpEndpoint>(opts, accept_ctx, tsfn);
+  std::string error;
+  if (!endpoint->start(error)) {
+    napi_release_threadsafe_function(tsfn, napi_tsfn_abort);
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+
+  int id = g_udp_sockets.insert(endpoint);
+  if (!id) {
+    endpoint->stop();
+    napi_release_threadsafe_function(tsfn, napi_tsfn_abort);
+    napi_throw_error(env, nullptr, "Too many UDP sockets");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_create_object(env, &result);
+  napi_create_int32(env, id, &v);
+  napi_set_named_property(env, result, "id", v);
+  napi_create_int32(env, endpoint->localPort(), &v);
+  napi_set_named_property(env, result, "port", v);
+  return result;
+}
+
+// NAPI implementation for UdpConnect
+napi_value UdpConnect(napi_env env, napi_callback_info info) {
+  // Parse arguments: [socket, context, host, port]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 4) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto endpoint = get_socket_arg(env, args[0]);
+  if (!endpoint) return nullptr;
+
+  auto ctx = find_context(udp_get_id_property(env, args[1]));
+  if (!ctx) {
+    napi_throw_error(env, nullptr, "Invalid context");
+    return nullptr;
+  }
+
+  sockaddr_storage addr;
+  socklen_t len;
+  if (!udp_get_peer_args(env, args, 2, addr, len)) return nullptr;
+
+  endpoint->connect(ctx, addr, len);
+  return nullptr;
+}
+
+// NAPI implementation for UdpSend
+napi_value UdpSend(napi_env env, napi_callback_info info) {
+  // Parse arguments: [socket, host, port, data]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 4) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto endpoint = get_socket_arg(env, args[0]);
+  if (!endpoint) return nullptr;
+
+  sockaddr_storage addr;
+  socklen_t len;
+  if (!udp_get_peer_args(env, args, 1, addr, len)) return nullptr;
+
+  bool is_buffer = false;
+  napi_is_buffer(env, args[3], &is_buffer);
+  if (!is_buffer) {
+    napi_throw_error(env, nullptr, "Data must be a Buffer");
+    return nullptr;
+  }
+  void* data;
+  size_t data_len;
+  napi_get_buffer_info(env, args[3], &data, &data_len);
+
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  endpoint->send(addr, len, std::vector<uint8_t>(bytes, bytes + data_len));
+  return nullptr;
+}
+
+// NAPI implementation for UdpDisconnect
+napi_value UdpDisconnect(napi_env env, napi_callback_info info) {
+  // Parse arguments: [socket, host, port]
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto endpoint = get_socket_arg(env, args[0]);
+  if (!endpoint) return nullptr;
+
+  sockaddr_storage addr;
+  socklen_t len;
+  if (!udp_get_peer_args(env, args, 1, addr, len)) return nullptr;
+
+  endpoint->disconnect(addr, len);
+  return nullptr;
+}
+
+// NAPI implementation for UdpClose
+napi_value UdpClose(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto endpoint = g_udp_sockets.remove(udp_get_id_property(env, args[0]));
+  bool found = endpoint != nullptr;
+  if (found) {
+    // Join the I/O thread first so nothing calls into the released function.
+    endpoint->stop();
+    napi_release_threadsafe_function(endpoint->eventCallback(), napi_tsfn_release);
+  }
+
+  napi_value result;
+  napi_get_boolean(env, found, &result);
+  return result;
+}
+
+// NAPI implementation for GetUdpSocketStats
+napi_value GetUdpSocketStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  auto endpoint = get_socket_arg(env, args[0]);
+  if (!endpoint) return nullptr;
+
+  const UdpEndpoint::Stats& s = endpoint->stats();
+  const std::pair<const char*, uint64_t> fields[] = {
+    { "rxPackets", s.rxPackets.load() }, { "txPackets", s.txPackets.load() },
+    { "rxBatches", s.rxBatches.load() }, { "txBatches", s.txBatches.load() },
+    { "dropped",   s.dropped.load() },   { "peers",     s.peers.load() },
+  };
+
+  napi_value result, v;
+  napi_create_object(env, &result);
+  for (auto& f : fields) {
+    napi_create_double(env, static_cast<double>(f.second), &v);
+    napi_set_named_property(env, result, f.first, v);
+  }
+  return result;
+}
+
+napi_value InitUdpSocket(napi_env env, napi_value exports) {
+  // Sockets still open at teardown would otherwise keep their I/O threads
+  // running against a dead environment.
+  napi_add_env_cleanup_hook(env, [](void*) {
+    for (auto& endpoint : g_udp_sockets.drain()) endpoint->stop();
+  }, nullptr);
+
+  napi_property_descriptor desc[] = {
+    { "createUdpSocket",   nullptr, CreateUdpSocket,   nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "udpConnect",        nullptr, UdpConnect,        nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "udpSend",           nullptr, UdpSend,           nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "udpDisconnect",     nullptr, UdpDisconnect,     nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "udpClose",          nullptr, UdpClose,          nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getUdpSocketStats", nullptr, GetUdpSocketStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(desc, sizeof(desc) / sizeof(desc[0]));
+  napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc);
+  return exports;
+}
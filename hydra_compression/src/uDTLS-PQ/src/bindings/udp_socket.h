@@ -0,0 +1,168 @@
+// src/bindings/udp_socket.h
+#ifndef UDP_SOCKET_H
+#define UDP_SOCKET_H
+
+#include "openssl.h"
+#include <node_api.h>
+#include <sys/socket.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Something that happened on a peer, delivered to JS in batches.
+struct UdpEvent {
+  enum Type { CONNECT, MESSAGE, CLOSE, ERROR } type;
+  sockaddr_storage peer;
+  socklen_t peerLen;
+  std::vector<uint8_t> data;
+  std::string error;
+};
+
+struct UdpEndpointOptions {
+  std::string address = "0.0.0.0";
+  int port = 0;
+  size_t batchSize = 32;       // datagrams per recvmmsg/sendmmsg
+  size_t maxDatagram = 4096;   // receive slot size; longer datagrams are dropped
+  long mtu = 1400;
+  bool reusePort = false;      // SO_REUSEPORT, for sharded server engines
+  long idleTimeoutMs = 0;      // close peers that send nothing for this long; 0 never does
+  size_t maxPeers = 0;         // ClientHellos from new peers are dropped at this many; 0 = no cap
+};
+
+// A UDP socket owned by the addon. One I/O thread reads and writes datagrams
+// in batches (recvmmsg/sendmmsg on Linux), runs them through per-peer DTLS
+// sessions and hands decrypted payloads to JS through a thread-safe function,
+// one call per batch. Peers are keyed by address; sessions never leave the
+// I/O thread, so the record path needs no locks.
+class UdpEndpoint {
+public:
+  UdpEndpoint(const UdpEndpointOptions& opts,
+              std::shared_ptr<SSLContextWrapper> acceptContext,
+              napi_threadsafe_function onEvents);
+  ~UdpEndpoint();
+
+  // Binds the socket and starts the I/O thread; false with `error` set on failure.
+  bool start(std::string& error);
+  void stop();
+
+  // Queued for the I/O thread; safe to call from any thread.
+  void connect(std::shared_ptr<SSLContextWrapper> ctx, const sockaddr_storage& peer, socklen_t len);
+  void send(const sockaddr_storage& peer, socklen_t len, std::vector<uint8_t> data);
+  void disconnect(const sockaddr_storage& peer, socklen_t len);
+
+  // Told when a peer session is created (true) or dropped (false), on the
+  // I/O thread. Set before start().
+  void setPeerObserver(std::function<void(const std::string& key, bool added)> fn) {
+    peerObserver_ = std::move(fn);
+  }
+
+  int localPort() const { return localPort_; }
+  napi_threadsafe_function eventCallback() const { return onEvents_; }
+
+  struct Stats {
+    std::atomic<uint64_t> rxPackets{0}, txPackets{0};
+    std::atomic<uint64_t> rxBatches{0}, txBatches{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> peers{0};
+  };
+  const Stats& stats() const { return stats_; }
+
+private:
+  struct Peer {
+    std::unique_ptr<SSLSessionWrapper> session;
+    sockaddr_storage addr;
+    socklen_t addrLen;
+    bool connected = false;
+    std::vector<std::vector<uint8_t>> queued;  // plaintext sent before the handshake finished
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    std::chrono::steady_clock::time_point lastHeard = std::chrono::steady_clock::now();
+  };
+
+  struct Command {
+    enum Type { CONNECT, SEND, DISCONNECT } type;
+    sockaddr_storage peer;
+    socklen_t peerLen;
+    std::shared_ptr<SSLContextWrapper> ctx;
+    std::vector<uint8_t> data;
+  };
+
+  struct Outbound {
+    sockaddr_storage peer;
+    socklen_t peerLen;
+    std::vector<uint8_t> data;
+  };
+
+  struct Batch;  // recvmmsg/sendmmsg scratch, defined in udp_socket.cpp
+
+  void run();
+  void wait(bool& woke, bool& readable);
+  void wake();
+  void drainCommands();
+  void receiveBatch();
+  void flushOutbound();
+  void handleTimers();
+  std::chrono::steady_clock::time_point idleDeadline(const Peer& peer) const;
+  int pollTimeoutMs() const;
+  void emit();
+
+  void configureSession(SSLSessionWrapper& session, const sockaddr_storage& addr, socklen_t len);
+  Peer* newPeer(SSL_CTX* ctx, const sockaddr_storage& addr, socklen_t len, bool client);
+  Peer* addPeer(std::unique_ptr<SSLSessionWrapper> session, const sockaddr_storage& addr, socklen_t len);
+  std::unique_ptr<SSLSessionWrapper> listen(const sockaddr_storage& addr, socklen_t len,
+                                            const uint8_t* data, size_t size);
+  void closePeer(const std::string& key, Peer& peer);
+  void dropPeer(const std::string& key);
+  void pushEvent(UdpEvent::Type type, const Peer& peer);
+  void afterStep(const std::string& key, Peer& peer, DtlsStepResult& result);
+
+  UdpEndpointOptions opts_;
+  std::shared_ptr<SSLContextWrapper> acceptContext_;
+  napi_threadsafe_function onEvents_;
+
+  int fd_ = -1;
+  int wakePipe_[2] = { -1, -1 };
+  int epollFd_ = -1;
+  bool wantWrite_ = false;
+  int localPort_ = 0;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+
+  std::mutex commandsMu_;
+  std::vector<Command> commands_;
+
+  // I/O thread only.
+  std::unordered_map<std::string, Peer> peers_;
+  std::vector<Outbound> outbound_;
+  std::unique_ptr<SSLSessionWrapper> listener_;  // cookie exchange, see listen()
+  std::vector<UdpEvent>* pending_ = nullptr;
+  std::unique_ptr<Batch> rx_, tx_;
+
+  std::function<void(const std::string&, bool)> peerObserver_;
+  Stats stats_;
+};
+
+// Shared with the server engine (dtls_server.cpp).
+std::string udp_peer_key(const sockaddr_storage& addr);
+void udp_call_js_events(napi_env env, napi_value js_cb, void* context, void* data);
+bool udp_get_peer_args(napi_env env, napi_value* args, size_t index,
+                       sockaddr_storage& addr, socklen_t& len);
+int udp_get_id_property(napi_env env, napi_value obj);
+
+// N-API exports
+napi_value CreateUdpSocket   (napi_env, napi_callback_info);
+napi_value UdpConnect        (napi_env, napi_callback_info);
+napi_value UdpSend           (napi_env, napi_callback_info);
+napi_value UdpDisconnect     (napi_env, napi_callback_info);
+napi_value UdpClose          (napi_env, napi_callback_info);
+napi_value GetUdpSocketStats (napi_env, napi_callback_info);
+
+napi_value InitUdpSocket(napi_env env, napi_value exports);
+
+#endif // UDP_SOCKET_H
@@ -0,0 +1,501 @@
+// src/bindings/universal_codec.cpp
+#include "universal_codec.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+bool universal_code_from_name(const std::string& name, UniversalCode& code) {
+  if (name == "elias-gamma") code = UniversalCode::EliasGamma;
+  else if (name == "elias-delta") code = UniversalCode::EliasDelta;
+  else if (name == "fibonacci") code = UniversalCode::Fibonacci;
+  else if (name == "unary") code = UniversalCode::Unary;
+  else return false;
+  return true;
+}
+
+namespace {
+
+// --- Bit I/O ---
+// MSB-first writer; whole 64-bit words go out big-endian.
+class WordWriter {
+public:
+  explicit WordWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+  // The low n bits of v, n <= 64.
+  void put(uint64_t v, unsigned n) {
+    if (!n) return;
+    bits_ += n;
+    const unsigned room = 64 - used_;
+    if (n < room) {
+      acc_ |= v << (room - n);
+      used_ += n;
+      return;
+    }
+    acc_ |= v >> (n - room);
+    const uint64_t be = __builtin_bswap64(acc_);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&be);
+    out_.insert(out_.end(), bytes, bytes + 8);
+    used_ = n - room;
+    acc_ = used_ ? v << (64 - used_) : 0;
+  }
+
+  void zeros(uint64_t n) {
+    for (; n > 64; n -= 64) put(0, 64);
+    put(0, static_cast<unsigned>(n));
+  }
+
+  void ones(uint64_t n) {
+    for (; n > 64; n -= 64) put(~0ULL, 64);
+    if (n) put(~0ULL >> (64 - n), static_cast<unsigned>(n));
+  }
+
+  uint64_t bits() const { return bits_; }
+
+  void finish() {
+    for (unsigned i = 0; i < used_; i += 8) out_.push_back(static_cast<uint8_t>(acc_ >> (56 - i)));
+    acc_ = 0;
+    used_ = 0;
+  }
+
+private:
+  std::vector<uint8_t>& out_;
+  uint64_t acc_ = 0;
+  unsigned used_ = 0;
+  uint64_t bits_ = 0;
+};
+
+// Random-access 64-bit window over the first `bits` bits; anything past
+// them reads as 0.
+class WordReader {
+public:
+  WordReader(const uint8_t* p, uint64_t bits) : p_(p), bits_(bits), bytes_((bits + 7) / 8) {}
+
+  uint64_t bits() const { return bits_; }
+
+  uint64_t peek(uint64_t q) const {
+    if (q >= bits_) return 0;
+    const uint64_t byte = q >> 3;
+    const unsigned shift = q & 7;
+    uint64_t w;
+    if (byte + 9 <= bytes_) {
+      std::memcpy(&w, p_ + byte, 8);
+      w = __builtin_bswap64(w);
+      if (shift) w = (w << shift) | (p_[byte + 8] >> (8 - shift));
+    } else {
+      w = 0;
+      for (uint64_t i = byte; i < byte + 8; i++) w = (w << 8) | (i < bytes_ ? p_[i] : 0);
+      if (shift && byte + 8 < bytes_) w = (w << shift) | (p_[byte + 8] >> (8 - shift));
+      else w <<= shift;
+    }
+    const uint64_t left = bits_ - q;
+    return left < 64 ? w & (~0ULL << (64 - left)) : w;
+  }
+
+  // n <= 64 bits from q as an integer.
+  uint64_t read(uint64_t q, unsigned n) const { return n ? peek(q) >> (64 - n) : 0; }
+
+private:
+  const uint8_t* p_;
+  uint64_t bits_;
+  uint64_t bytes_;
+};
+
+// --- Fibonacci numbers ---
+// 1, 2, 3, 5, ... as doubles, like the TypeScript `fibs` arrays; past the
+// table they have overflowed to Infinity there too.
+const std::vector<double>& fibonacci_table() {
+  static const std::vector<double> table = [] {
+    std::vector<double> t = { 1, 2 };
+    while (std::isfinite(t.back())) t.push_back(t[t.size() - 1] + t[t.size() - 2]);
+    return t;
+  }();
+  return table;
+}
+
+inline double fibonacci(const std::vector<double>& t, uint64_t k) {
+  return k < t.size() ? t[k] : std::numeric_limits<double>::infinity();
+}
+
+inline unsigned bit_length(uint64_t v) { return 64 - __builtin_clzll(v); }
+
+// --- Encoders ---
+const char* positive_error(UniversalCode code) {
+  switch (code) {
+    case UniversalCode::EliasGamma: return "Elias Gamma can only encode positive integers";
+    case UniversalCode::EliasDelta: return "Elias Delta can only encode positive integers";
+    case UniversalCode::Fibonacci:  return "Fibonacci code can only encode positive integers";
+    case UniversalCode::Unary:      return "Unary code can only encode positive integers";
+  }
+  return "";
+}
+
+// n.toString(2) is the value in bit_length bits, so gamma is that many
+// zeros less one, then the value.
+inline void put_gamma(WordWriter& w, uint64_t v) {
+  const unsigned len = bit_length(v);
+  w.zeros(len - 1);
+  w.put(v, len);
+}
+
+inline void put_delta(WordWriter& w, uint64_t v) {
+  const unsigned len = bit_length(v);
+  put_gamma(w, len);
+  w.put(len > 1 ? v & (~0ULL >> (65 - len)) : 0, len - 1);
+}
+
+// The greedy representation over fibs = [1, 2, ...] grown until the last
+// one is >= n, written smallest first, then a final '1'. Done in doubles
+// like the TypeScript, including for n that are not Fibonacci numbers,
+// where the top bits are 0 and the code does not end in "11".
+void put_fibonacci(WordWriter& w, const std::vector<double>& fibs, double n) {
+  uint64_t top = 1;
+  while (fibonacci(fibs, top) < n) top++;
+  uint64_t word[2] = { 0, 0 };  // bit j counts fibs[j]; n < 2^64 needs < 128
+  double remaining = n;
+  for (uint64_t j = top + 1; j-- > 0;) {
+    if (fibonacci(fibs, j) <= remaining) {
+      word[j / 64] |= 1ULL << (63 - j % 64);
+      remaining -= fibonacci(fibs, j);
+    }
+  }
+  const uint64_t len = top + 1;
+  if (len <= 64) {
+    w.put(word[0] >> (64 - len), static_cast<unsigned>(len));
+  } else {
+    w.put(word[0], 64);
+    w.put(word[1] >> (128 - len), static_cast<unsigned>(len - 64));
+  }
+  w.put(1, 1);
+}
+
+// --- Decoders ---
+// The integer (leading_one ? "1" : "") + bits [q, q + n) as parseInt(.., 2)
+// gives it: exact up to 2^53, then rounded to nearest even. Bits past the
+// top 64 only matter as a sticky bit, since a double keeps 53 of them.
+double bits_to_double(const WordReader& r, uint64_t q, uint64_t n, bool leading_one) {
+  const uint64_t total = n + (leading_one ? 1 : 0);
+  if (total <= 64) {
+    const uint64_t v = r.read(q, static_cast<unsigned>(n));
+    return static_cast<double>(leading_one && n < 64 ? v | (1ULL << n) : v);
+  }
+  const unsigned head = leading_one ? 63 : 64;
+  uint64_t m = leading_one ? (1ULL << 63) | r.read(q, 63) : r.read(q, 64);
+  for (uint64_t t = q + head, end = q + n; t < end && !(m & 1); t += 64) {
+    uint64_t w = r.peek(t);
+    if (end - t < 64) w &= ~0ULL << (64 - (end - t));
+    if (w) m |= 1;
+  }
+  return std::ldexp(static_cast<double>(m), static_cast<int>(std::min<uint64_t>(total - 64, 2048)));
+}
+
+// Each returns the code's length in bits, or 0 with error set.
+uint64_t get_gamma(const WordReader& r, uint64_t pos, double& value, std::string& error) {
+  uint64_t q = pos;
+  for (;;) {
+    if (q >= r.bits()) {
+      error = "Invalid Elias Gamma code: no terminating '1' found";
+      return 0;
+    }
+    const uint64_t w = r.peek(q);
+    if (w) {
+      q += __builtin_clzll(w);
+      break;
+    }
+    q += 64;
+  }
+  const uint64_t zeros = q - pos;
+  if (r.bits() - pos < 2 * zeros + 1) {
+    error = "Invalid Elias Gamma code: not enough bits";
+    return 0;
+  }
+  value = bits_to_double(r, q, zeros + 1, false);
+  return 2 * zeros + 1;
+}
+
+uint64_t get_delta(const WordReader& r, uint64_t pos, double& value, std::string& error) {
+  double len;
+  const uint64_t n = get_gamma(r, pos, len, error);
+  if (!n) return 0;
+  // Compared in doubles, as `bits.length < bitsRead + length - 1` is.
+  if (static_cast<double>(r.bits() - pos) < static_cast<double>(n) + len - 1) {
+    error = "Invalid Elias Delta code: not enough bits";
+    return 0;
+  }
+  const uint64_t rest = static_cast<uint64_t>(len) - 1;
+  value = bits_to_double(r, pos + n, rest, true);
+  return n + rest;
+}
+
+// As in the TypeScript: the code runs to the first "11" and bit i of the
+// endPos - 1 before the final '1' counts fibs[endPos - i - 2], so the
+// first bit weighs the most -- the reverse of the encoder's order.
+uint64_t get_fibonacci(const WordReader& r, const std::vector<double>& fibs, uint64_t pos,
+                       double& value, std::string& error) {
+  uint64_t q = pos, pair;
+  for (;;) {
+    if (q + 1 >= r.bits()) {
+      error = "Invalid Fibonacci code: no terminating '11' found";
+      return 0;
+    }
+    const uint64_t w = r.peek(q);
+    const uint64_t t = w & (w << 1);  // bit k: bits k and k + 1 are both 1
+    if (t) {
+      pair = q + __builtin_clzll(t);
+      break;
+    }
+    q += 63;
+  }
+  const uint64_t end = pair + 2 - pos;
+  value = 0;
+  for (uint64_t base = pos; base <= pair; base += 64) {
+    uint64_t w = r.peek(base);
+    const uint64_t n = std::min<uint64_t>(64, pair - base + 1);
+    if (n < 64) w &= ~0ULL << (64 - n);
+    while (w) {
+      const unsigned k = __builtin_clzll(w);
+      value += fibonacci(fibs, end - 2 - (base + k - pos));
+      w &= ~(1ULL << (63 - k));
+    }
+  }
+  return end;
+}
+
+uint64_t get_unary(const WordReader& r, uint64_t pos, double& value, std::string& error) {
+  uint64_t q = pos;
+  for (;;) {
+    const uint64_t w = ~r.peek(q);
+    if (w) {
+      q += __builtin_clzll(w);
+      break;
+    }
+    q += 64;
+  }
+  if (q >= r.bits()) {
+    error = "Invalid unary code: no terminating '0' found";
+    return 0;
+  }
+  value = static_cast<double>(q - pos);
+  return q - pos + 1;
+}
+
+}  // namespace
+
+bool universal_encode(UniversalCode code, const double* values, size_t count,
+                      std::vector<uint8_t>& out, uint64_t& bits, std::string& error) {
+  const std::vector<double>& fibs = fibonacci_table();
+  WordWriter w(out);
+  for (size_t i = 0; i < count; i++) {
+    const double n = values[i];
+    if (!(n >= 1) || n != std::floor(n) || n >= 18446744073709551616.0) {
+      error = positive_error(code);
+      return false;
+    }
+    const uint64_t v = static_cast<uint64_t>(n);
+    switch (code) {
+      case UniversalCode::EliasGamma: put_gamma(w, v); break;
+      case UniversalCode::EliasDelta: put_delta(w, v); break;
+      case UniversalCode::Fibonacci:  put_fibonacci(w, fibs, n); break;
+      case UniversalCode::Unary:
+        if (v > 0xffffffffULL) {
+          error = "Unary value too large";
+          return false;
+        }
+        w.ones(v);
+        w.put(0, 1);
+        break;
+    }
+  }
+  bits = w.bits();
+  w.finish();
+  return true;
+}
+
+bool universal_decode(UniversalCode code, const uint8_t* data, uint64_t bits, size_t max_values,
+                      std::vector<double>& values, uint64_t& bits_read, std::string& error) {
+  const std::vector<double>& fibs = fibonacci_table();
+  const WordReader r(data, bits);
+  uint64_t pos = 0;
+  while (values.size() < max_values && pos < bits) {
+    uint64_t n = 0;
+    double v = 0;
+    switch (code) {
+      case UniversalCode::EliasGamma: n = get_gamma(r, pos, v, error); break;
+      case UniversalCode::EliasDelta: n = get_delta(r, pos, v, error); break;
+      case UniversalCode::Fibonacci:  n = get_fibonacci(r, fibs, pos, v, error); break;
+      case UniversalCode::Unary:      n = get_unary(r, pos, v, error); break;
+    }
+    if (!n) return false;
+    values.push_back(v);
+    pos += n;
+  }
+  bits_read = pos;
+  return true;
+}
+
+// --- N-API ---
+static bool get_code_arg(napi_env env, napi_value v, UniversalCode& code) {
+  char name[16];
+  size_t len = 0;
+  return napi_get_value_string_utf8(env, v, name, sizeof(name), &len) == napi_ok &&
+         universal_code_from_name(std::string(name, len), code);
+}
+
+// Any non-BigInt typed array, or an array of numbers.
+static bool get_values_arg(napi_env env, napi_value v, std::vector<double>& out) {
+  bool is_typed = false, is_array = false;
+  napi_is_typedarray(env, v, &is_typed);
+  if (is_typed) {
+    napi_typedarray_type type;
+    size_t length;
+    void* data;
+    if (napi_get_typedarray_info(env, v, &type, &length, &data, nullptr, nullptr) != napi_ok) return false;
+    out.resize(length);
+    switch (type) {
+      case napi_int8_array:    std::copy_n(static_cast<const int8_t*>(data), length, out.begin()); break;
+      case napi_uint8_array:
+      case napi_uint8_clamped_array:
+                               std::copy_n(static_cast<const uint8_t*>(data), length, out.begin()); break;
+      case napi_int16_array:   std::copy_n(static_cast<const int16_t*>(data), length, out.begin()); break;
+      case napi_uint16_array:  std::copy_n(static_cast<const uint16_t*>(data), length, out.begin()); break;
+      case napi_int32_array:   std::copy_n(static_cast<const int32_t*>(data), length, out.begin()); break;
+      case napi_uint32_array:  std::copy_n(static_cast<const uint32_t*>(data), length, out.begin()); break;
+      case napi_float32_array: std::copy_n(static_cast<const float*>(data), length, out.begin()); break;
+      case napi_float64_array: std::copy_n(static_cast<const double*>(data), length, out.begin()); break;
+      default: return false;
+    }
+    return true;
+  }
+  napi_is_array(env, v, &is_array);
+  if (!is_array) return false;
+  uint32_t length;
+  napi_get_array_length(env, v, &length);
+  out.resize(length);
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value item;
+    napi_get_element(env, v, i, &item);
+    if (napi_get_value_double(env, item, &out[i]) != napi_ok) out[i] = NAN;
+  }
+  return true;
+}
+
+static bool get_count_arg(napi_env env, napi_value v, uint64_t* out) {
+  napi_valuetype type;
+  if (napi_typeof(env, v, &type) != napi_ok) return false;
+  if (type == napi_undefined) return true;
+  double n;
+  if (type != napi_number || napi_get_value_double(env, v, &n) != napi_ok || !(n >= 0) || n != std::floor(n))
+    return false;
+  *out = n < 18446744073709551616.0 ? static_cast<uint64_t>(n) : UINT64_MAX;
+  return true;
+}
+
+napi_value UniversalEncode(napi_env env, napi_callback_info info) {
+  // Parse arguments: [type, values: number[] | TypedArray]
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+  UniversalCode code;
+  if (!get_code_arg(env, args[0], code)) {
+    napi_throw_error(env, nullptr, "Unsupported universal code type");
+    return nullptr;
+  }
+  std::vector<double> values;
+  if (!get_values_arg(env, args[1], values)) {
+    napi_throw_error(env, nullptr, "Values must be an array or a typed array of numbers");
+    return nullptr;
+  }
+
+  std::vector<uint8_t> out;
+  uint64_t bits = 0;
+  std::string error;
+  if (!universal_encode(code, values.data(), values.size(), out, bits, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+
+  napi_value result, data, v;
+  if (napi_create_buffer_copy(env, out.size(), out.data(), nullptr, &data) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate buffer");
+    return nullptr;
+  }
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "data", data);
+  napi_create_double(env, static_cast<double>(bits), &v);
+  napi_set_named_property(env, result, "bits", v);
+  return result;
+}
+
+napi_value UniversalDecode(napi_env env, napi_callback_info info) {
+  // Parse arguments: [type, data: Buffer, bits?, count?]
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+  UniversalCode code;
+  if (!get_code_arg(env, args[0], code)) {
+    napi_throw_error(env, nullptr, "Unsupported universal code type");
+    return nullptr;
+  }
+  bool is_buffer = false;
+  napi_is_buffer(env, args[1], &is_buffer);
+  if (!is_buffer) {
+    napi_throw_error(env, nullptr, "Data must be a buffer");
+    return nullptr;
+  }
+  void* data;
+  size_t len;
+  napi_get_buffer_info(env, args[1], &data, &len);
+
+  uint64_t bits = uint64_t(len) * 8, count = UINT64_MAX;
+  if ((argc > 2 && !get_count_arg(env, args[2], &bits)) || (argc > 3 && !get_count_arg(env, args[3], &count)) ||
+      bits > uint64_t(len) * 8) {
+    napi_throw_error(env, nullptr, "bits must be within the buffer and count a non-negative integer");
+    return nullptr;
+  }
+
+  std::vector<double> values;
+  uint64_t bits_read = 0;
+  std::string error;
+  const size_t max_values = static_cast<size_t>(std::min<uint64_t>(count, SIZE_MAX));
+  if (!universal_decode(code, static_cast<const uint8_t*>(data), bits, max_values, values, bits_read, error)) {
+    napi_throw_error(env, nullptr, error.c_str());
+    return nullptr;
+  }
+  if (count != UINT64_MAX && values.size() < count) {
+    napi_throw_error(env, nullptr, "Not enough bits for the requested count");
+    return nullptr;
+  }
+
+  napi_value result, buffer, array, v;
+  void* dst;
+  if (napi_create_arraybuffer(env, values.size() * sizeof(double), &dst, &buffer) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate buffer");
+    return nullptr;
+  }
+  if (!values.empty()) std::memcpy(dst, values.data(), values.size() * sizeof(double));
+  napi_create_typedarray(env, napi_float64_array, values.size(), buffer, 0, &array);
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "values", array);
+  napi_create_double(env, static_cast<double>(bits_read), &v);
+  napi_set_named_property(env, result, "bitsRead", v);
+  return result;
+}
+
+napi_value InitUniversalCodec(napi_env env, napi_value exports) {
+  napi_property_descriptor descs[] = {
+    { "universalEncode", nullptr, UniversalEncode, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "universalDecode", nullptr, UniversalDecode, nullptr, nullptr, nullptr, napi_default, nullptr },
+  };
+  metrics_instrument(descs, sizeof(descs) / sizeof(*descs));
+  napi_define_properties(env, exports, sizeof(descs) / sizeof(*descs), descs);
+  return exports;
+}
@@ -0,0 +1,43 @@
+// src/bindings/universal_codec.h
+#ifndef UNIVERSAL_CODEC_H
+#define UNIVERSAL_CODEC_H
+
+#include <node_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Universal integer codes as OSTHelper.createUniversalCodec writes them,
+// on packed MSB-first bits instead of '0'/'1' strings. Encoding goes
+// through a 64-bit accumulator and decoding peeks 64 bits at a time,
+// finding code boundaries with count-leading-zeros, so a code costs a few
+// instructions rather than a loop per bit. Concatenated codes decode the
+// way a loop over decode(bits.slice(pos)) would, including the quirks of
+// the TypeScript Fibonacci code (see universal_decode).
+enum class UniversalCode { EliasGamma, EliasDelta, Fibonacci, Unary };
+
+// False if name is not "elias-gamma", "elias-delta", "fibonacci" or "unary".
+bool universal_code_from_name(const std::string& name, UniversalCode& code);
+
+// Appends the codes for values; bits gets the total length. Values must be
+// positive integers below 2^64 (unary: below 2^32).
+bool universal_encode(UniversalCode code, const double* values, size_t count,
+                      std::vector<uint8_t>& out, uint64_t& bits, std::string& error);
+
+// Decodes from the first `bits` bits of data, stopping after max_values
+// codes or when the bits run out. Values are doubles, rounded like the
+// TypeScript parseInt / Fibonacci sums they mirror.
+bool universal_decode(UniversalCode code, const uint8_t* data, uint64_t bits, size_t max_values,
+                      std::vector<double>& values, uint64_t& bits_read, std::string& error);
+
+// ** universalEncode(type, values) -> { data: Buffer, bits } **
+napi_value UniversalEncode(napi_env env, napi_callback_info info);
+
+// ** universalDecode(type, data, bits?, count?) -> { values: Float64Array, bitsRead } **
+napi_value UniversalDecode(napi_env env, napi_callback_info info);
+
+// Module initialization function (called from openssl.cpp)
+napi_value InitUniversalCodec(napi_env env, napi_value exports);
+
+#endif // UNIVERSAL_CODEC_H
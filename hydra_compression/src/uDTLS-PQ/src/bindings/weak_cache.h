@@ -0,0 +1,67 @@
+// src/bindings/weak_cache.h
+#ifndef WEAK_CACHE_H
+#define WEAK_CACHE_H
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Shared objects by key, held weakly: an entry lasts as long as something
+// outside the cache holds the object, and the next lookup after that makes
+// a fresh one. Objects are made outside the lock; if two threads race on
+// the same key the first one to insert wins and the other's copy is
+// dropped. Expired entries are swept whenever the map doubles.
+template <typename T>
+class WeakCache {
+public:
+  // The live object for key, or make()'s result (nullptr if it failed).
+  // hit reports whether an existing object was returned.
+  template <typename Make>
+  std::shared_ptr<T> getOrCreate(const std::string& key, Make make, bool* hit = nullptr) {
+    if (hit) *hit = true;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        if (auto live = it->second.lock()) return live;
+      }
+    }
+
+    std::shared_ptr<T> made = make();
+    if (!made) {
+      if (hit) *hit = false;
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mu_);
+    std::weak_ptr<T>& slot = entries_[key];
+    if (auto live = slot.lock()) return live;
+    slot = made;
+    if (hit) *hit = false;
+
+    if (entries_.size() >= sweepAt_) {
+      for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.expired()) it = entries_.erase(it);
+        else ++it;
+      }
+      sweepAt_ = std::max<size_t>(64, entries_.size() * 2);
+    }
+    return made;
+  }
+
+  size_t size() const {  // live entries
+    std::lock_guard<std::mutex> lock(mu_);
+    size_t n = 0;
+    for (auto& kv : entries_) if (!kv.second.expired()) n++;
+    return n;
+  }
+
+private:
+  mutable std::mutex mu_;
+  std::unordered_map<std::string, std::weak_ptr<T>> entries_;
+  size_t sweepAt_ = 64;
+};
+
+#endif // WEAK_CACHE_H
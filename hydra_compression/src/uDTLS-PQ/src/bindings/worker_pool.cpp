@@ -0,0 +1,113 @@
+// src/bindings/worker_pool.cpp
+#include "worker_pool.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One parallelFor call. Chunks are claimed through an atomic cursor so any
+// number of threads can help without further locking.
+struct Job {
+  const std::function<void(size_t, size_t)>* fn;
+  size_t count;
+  size_t grain;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> done{0};
+  std::mutex mu;
+  std::condition_variable finished;
+
+  // Runs chunks until none are left; returns true if this call finished the job.
+  bool drain() {
+    bool last = false;
+    for (;;) {
+      size_t begin = next.fetch_add(grain);
+      if (begin >= count) break;
+      size_t end = begin + grain < count ? begin + grain : count;
+      (*fn)(begin, end);
+      if (done.fetch_add(end - begin) + (end - begin) == count) last = true;
+    }
+    return last;
+  }
+};
+
+struct WorkerPool::State {
+  std::mutex mu;
+  std::condition_variable wake;
+  std::deque<std::shared_ptr<Job>> queue;
+  std::vector<std::thread> threads;
+  bool stopping = false;
+};
+
+WorkerPool& WorkerPool::shared() {
+  static WorkerPool pool;
+  return pool;
+}
+
+WorkerPool::WorkerPool() : state_(new State()) {
+  unsigned n = std::thread::hardware_concurrency();
+  if (n == 0) n = 1;
+
+  // The caller always participates, so n - 1 helpers saturate the machine.
+  for (unsigned i = 1; i < n; i++) {
+    state_->threads.emplace_back([s = state_.get()] {
+      for (;;) {
+        std::shared_ptr<Job> job;
+        {
+          std::unique_lock<std::mutex> lock(s->mu);
+          s->wake.wait(lock, [s] { return s->stopping || !s->queue.empty(); });
+          if (s->stopping) return;
+          job = s->queue.front();
+          // Leave the job queued while chunks remain so other helpers join in.
+          if (job->next.load() >= job->count) { s->queue.pop_front(); continue; }
+        }
+        if (job->drain()) {
+          std::lock_guard<std::mutex> lock(job->mu);
+          job->finished.notify_all();
+        }
+      }
+    });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(state_->mu);
+    state_->stopping = true;
+  }
+  state_->wake.notify_all();
+  for (auto& t : state_->threads) t.join();
+}
+
+size_t WorkerPool::size() const {
+  return state_->threads.size() + 1;
+}
+
+void WorkerPool::parallelFor(size_t count, size_t grain,
+                             const std::function<void(size_t, size_t)>& fn) {
+  if (count == 0) return;
+  if (grain == 0) grain = 1;
+
+  // Small batches are not worth a hand-off.
+  if (count <= grain || state_->threads.empty()) {
+    fn(0, count);
+    return;
+  }
+
+  auto job = std::make_shared<Job>();
+  job->fn = &fn;
+  job->count = count;
+  job->grain = grain;
+
+  {
+    std::lock_guard<std::mutex> lock(state_->mu);
+    state_->queue.push_back(job);
+  }
+  state_->wake.notify_all();
+
+  job->drain();
+
+  std::unique_lock<std::mutex> lock(job->mu);
+  job->finished.wait(lock, [&] { return job->done.load() == job->count; });
+}
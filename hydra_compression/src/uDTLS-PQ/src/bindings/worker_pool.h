@@ -0,0 +1,35 @@
+// src/bindings/worker_pool.h
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+// Process-wide pool of native worker threads used to fan CPU-bound batches
+// (KEM, signature, hashing, compression) out across cores. Threads are
+// started lazily on first use, one per hardware thread.
+class WorkerPool {
+public:
+  static WorkerPool& shared();
+
+  // Calls fn(begin, end) over [0, count) split into chunks of at most `grain`
+  // items. The calling thread works on chunks too and returns once every
+  // chunk has run, so nested calls from a pool thread cannot deadlock.
+  void parallelFor(size_t count, size_t grain,
+                   const std::function<void(size_t begin, size_t end)>& fn);
+
+  size_t size() const;
+
+  ~WorkerPool();
+
+private:
+  WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
+#endif // WORKER_POOL_H
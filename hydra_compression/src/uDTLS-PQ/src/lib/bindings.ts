@@ -12,26 +12,293 @@ import type { HybridKeyPair, SubjectDN } from "./types";
 /* -------------------------------------------------------------------------- */
 /*  1.  TypeScript interface for the compiled addon                           */
 /* -------------------------------------------------------------------------- */
+
+/** KEM algorithm name (e.g. "kyber768") or a handle returned by `kemHandle` */
+export type KemAlgorithm = string | number;
+
+/** Result of one native pass through the DTLS record layer */
+export interface DtlsStepResult {
+    handshakeComplete: boolean;
+    closed: boolean;
+    /** Retransmission timer to arm, or -1 */
+    timeoutMs: number;
+    /** Datagrams to send to the peer, in order */
+    datagrams: Buffer[];
+    /** Decrypted application data, if any arrived */
+    data?: Buffer;
+    error?: string;
+}
+
+/** One entry of the batch delivered by a native UDP socket */
+export interface UdpSocketEvent {
+    type: "connect" | "message" | "close" | "error";
+    address: string;
+    port: number;
+    data?: Buffer;
+    error?: string;
+}
+
+export interface UdpSocketOptions {
+    address?: string;
+    port?: number;
+    /** Accept DTLS handshakes from any peer with this server context */
+    context?: { id: number };
+    /** Datagrams per recvmmsg/sendmmsg call */
+    batchSize?: number;
+    maxDatagram?: number;
+    mtu?: number;
+    reusePort?: boolean;
+    /** Close peers that have sent nothing for this long (default: never) */
+    idleTimeoutMs?: number;
+    /** Drop ClientHellos from new peers once this many are open (default: no cap) */
+    maxPeers?: number;
+}
+
+export interface UdpSocketStats {
+    rxPackets: number;
+    txPackets: number;
+    rxBatches: number;
+    txBatches: number;
+    dropped: number;
+    peers: number;
+}
+
+export interface DtlsServerStats extends UdpSocketStats {
+    /** Per-worker counters, one entry per SO_REUSEPORT socket */
+    workers: UdpSocketStats[];
+}
+
+/** Server-side resumption settings for createContext */
+export interface SessionCacheOptions {
+    /** Sessions kept across all shards */
+    size?: number;
+    ttlSeconds?: number;
+    shards?: number;
+    /** Issue stateless tickets as well (default true) */
+    tickets?: boolean;
+    ticketRotateSeconds?: number;
+}
+
+export interface SessionCacheStats {
+    /** Resumptions accepted / refused by OpenSSL, cache or ticket */
+    hits: number;
+    misses: number;
+    timeouts: number;
+    entries?: number;
+    cacheHits?: number;
+    cacheMisses?: number;
+    stored?: number;
+    evicted?: number;
+    expired?: number;
+    ticketsIssued?: number;
+    ticketsAccepted?: number;
+    ticketsRejected?: number;
+    keyRotations?: number;
+}
+
+/** Full option set for getSharedContext; equal settings share one native context */
+export interface SharedContextOptions {
+    isServer: boolean;
+    cert?: string | Buffer;
+    key?: string | Buffer;
+    /** OpenSSL cipher names */
+    ciphers?: string[];
+    /** Same names as setPQCipherSuites */
+    pqSuite?: 'kyber512' | 'kyber768' | 'hybrid' | 'dilithium2' | 'dilithium3';
+    /** OpenSSL constants, as for setMinMaxVersion / setVerifyMode */
+    minVersion?: number;
+    maxVersion?: number;
+    verifyMode?: number;
+    sessionCache?: boolean | SessionCacheOptions;
+    cookieExchange?: boolean | { rotateSeconds?: number };
+}
+
+export interface ContextPoolStats {
+    hits: number;
+    misses: number;
+    buildErrors: number;
+    /** Distinct configured contexts still referenced by a handle */
+    entries: number;
+}
+
+export interface IdentityCacheStats {
+    hits: number;
+    misses: number;
+    parseErrors: number;
+    /** Distinct certificates and keys currently in use by some context */
+    entries: number;
+}
+
+export interface CookieStats {
+    enabled: boolean;
+    issued: number;
+    verified: number;
+    rejected: number;
+    rotations: number;
+}
+
+export interface KeyPairPoolStats {
+    hits: number;
+    misses: number;
+    generated: number;
+    available: number;
+    depth: number;
+    lowWatermark: number;
+    highWatermark: number;
+}
+
+/** Locked, wipe-on-release memory behind every native private key and shared secret */
+export interface SecretArenaStats {
+    inUse: number;
+    allocations: number;
+    releases: number;
+    /** Requests above the largest size class, mapped individually */
+    largeAllocations: number;
+    slabs: number;
+    lockedBytes: number;
+    /** mlock refusals (RLIMIT_MEMLOCK); the memory is still wiped */
+    lockFailures: number;
+    sizeClasses: number[];
+}
+
+/**
+ * ostEncode options; mirrors OSTConfig plus `recordOrder`. Other keys are
+ * kept in the header's config, as OSTPackWriter's TypeScript path does.
+ */
+export interface OstEncodeOptions {
+    windowLength?: number;
+    labelLength?: number;
+    variableWindow?: boolean;
+    /** "huffman", "raw", "brotli", "zstd" or "lz4" */
+    compressionMethod?: string;
+    /** brotli/zstd level; 0 or unset picks the library default. */
+    compressionLevel?: number;
+    subBinning?: boolean;
+    subBinningDepth?: number;
+    /** Adds `windowBins` to the header so ostDecode can rebuild the input. */
+    recordOrder?: boolean;
+    /** Appends a window index so ostOpenPack can serve ranged reads. */
+    index?: boolean;
+}
+
+/** ostStreamCreate options; sizes are bytes of buffered text. */
+export interface OstStreamOptions extends Omit<OstEncodeOptions, "recordOrder" | "index"> {
+    /** A bin is compressed once it holds this much (default 4 MiB). */
+    blockSize?: number;
+    /** Largest bins are compressed early past this total (default 64 MiB). */
+    memoryLimit?: number;
+}
+
+/** An indexed pack opened with ostOpenPack. */
+export interface OstPackInfo {
+    /** UTF-8 length of the packed text */
+    size: number;
+    /** UTF-16 length of the packed text */
+    units: number;
+    windowLength: number;
+    windows: number;
+    bins: number;
+    compressionMethod: "huffman" | "raw";
+}
+
+export interface OstDecodeResult {
+    header: string;
+    labels: string[];
+    /** Decompressed bin contents (UTF-8), in pack order. */
+    bins: Buffer[];
+    /** The original text (UTF-8) when the pack records window order. */
+    data: Buffer | null;
+}
+
+/** OSTHelper.createUniversalCodec's integer codes. */
+export type UniversalCode = "elias-gamma" | "elias-delta" | "fibonacci" | "unary";
+
+/** BLAKE3 mode: plain hash, keyed hash (32-byte key) or derive_key (context). */
+export interface Blake3Options {
+    key?: Buffer;
+    context?: string;
+    /** Output length in bytes (default 32). */
+    dkLen?: number;
+}
+
+export type AeadAlgorithm = "aes-256-gcm" | "chacha20-poly1305";
+export type AeadKeyArg = { id: number } | Buffer;
+
+/** Per-export call metrics; latencies are histogram bucket upper edges. */
+export interface ExportMetrics {
+    calls: number;
+    errors: number;
+    totalMs: number;
+    meanUs: number;
+    p50Us: number;
+    p90Us: number;
+    p99Us: number;
+    maxUs: number;
+}
+
+export interface NativeMetrics {
+    sinceMs: number;
+    exports: Record<string, ExportMetrics>;
+}
+
 export interface NativeBindings {
     /* DTLS ------------------------------------------------------------- */
     createContext(
-        opts: { isServer: boolean; cert?: string; key?: string }
+        opts: {
+            isServer: boolean;
+            /** Buffer (PEM or DER), PEM text, or a file path; parsed once per distinct content */
+            cert?: string | Buffer;
+            key?: string | Buffer;
+            sessionCache?: boolean | SessionCacheOptions;
+            /** Stateless HMAC cookies; needs the peer address (native sockets or host/port on accept) */
+            cookieExchange?: boolean | { rotateSeconds?: number };
+        }
     ): { id: number };
     freeContext(h: { id: number }): void;
+    /** Frozen, pooled context; `shared` is true when another caller already built it */
+    getSharedContext(opts: SharedContextOptions): { id: number; shared: boolean };
 
-    createSession(ctx: { id: number }): { id: number };
-    freeSession(sess: { id: number }): void;
+    createSession(ctx: { id: number }, opts?: { mtu?: number }): { id: number };
+    freeSession(sess: { id: number }): boolean;
 
-    dtlsConnect(sess: { id: number }, host: string, port: number): number;
-    dtlsAccept(sess: { id: number }, host: string, port: number): number;
-    dtlsReceive(sess: { id: number }, len: number): Buffer;
-    dtlsSend(
-        sess: { id: number },
-        data: Buffer,
-        host: string,
-        port: number
-    ): number;
-    dtlsShutdown(sess: { id: number }): void;
+    /* Record path: datagrams in, plaintext + outbound datagrams out */
+    dtlsConnect(sess: { id: number }, host?: string, port?: number): DtlsStepResult;
+    dtlsAccept(sess: { id: number }, host?: string, port?: number): DtlsStepResult;
+    dtlsReceive(sess: { id: number }, datagram: Buffer): DtlsStepResult;
+    dtlsSend(sess: { id: number }, data: Buffer): DtlsStepResult;
+    dtlsShutdown(sess: { id: number }): DtlsStepResult;
+    dtlsHandleTimeout(sess: { id: number }): DtlsStepResult;
+
+    /* Resumption: serialized client sessions and server cache stats */
+    getSessionData(sess: { id: number }): Buffer | null;
+    setSessionData(sess: { id: number }, data: Buffer): boolean;
+    sessionReused(sess: { id: number }): boolean;
+    getSessionCacheStats(ctx: { id: number }): SessionCacheStats;
+    getCookieStats(ctx: { id: number }): CookieStats;
+    getIdentityCacheStats(): IdentityCacheStats;
+    getContextPoolStats(): ContextPoolStats;
+
+    /* Native UDP sockets: batched I/O and DTLS on an addon thread */
+    createUdpSocket(
+        opts: UdpSocketOptions,
+        onEvents: (events: UdpSocketEvent[]) => void
+    ): { id: number; port: number };
+    udpConnect(sock: { id: number }, ctx: { id: number }, host: string, port: number): void;
+    udpSend(sock: { id: number }, host: string, port: number, data: Buffer): void;
+    udpDisconnect(sock: { id: number }, host: string, port: number): void;
+    udpClose(sock: { id: number }): boolean;
+    getUdpSocketStats(sock: { id: number }): UdpSocketStats;
+
+    /* Multi-core DTLS server: one worker thread per SO_REUSEPORT socket */
+    createDtlsServer(
+        ctx: { id: number },
+        opts: Omit<UdpSocketOptions, "context" | "reusePort"> & { workers?: number },
+        onEvents: (events: UdpSocketEvent[]) => void
+    ): { id: number; port: number; workers: number };
+    dtlsServerSend(server: { id: number }, host: string, port: number, data: Buffer): boolean;
+    dtlsServerDisconnect(server: { id: number }, host: string, port: number): boolean;
+    closeDtlsServer(server: { id: number }): boolean;
+    getDtlsServerStats(server: { id: number }): DtlsServerStats;
 
     setCipherSuites(ctx: { id: number }, suites: string[]): boolean;
     setPQCipherSuites(ctx: { id: number }, algo: string): boolean;
@@ -39,9 +306,25 @@ export interface NativeBindings {
     setMinMaxVersion(ctx: { id: number }, min: number, max: number): void;
     getError(sess: { id: number }): string;
     getVersion(): string;
-    setupAutomaticRekey(id: number, intervalMs: number): void;
 
     /* Symmetric crypto -------------------------------------------------- */
+    /**
+     * AEAD keys keep their prepared cipher contexts between calls. Every
+     * `key` below also accepts a raw 32-byte AES-256-GCM key Buffer.
+     * Sealed messages are `ciphertext || tag`; IVs are 12 bytes.
+     */
+    createAeadKey(key: Buffer, algorithm?: AeadAlgorithm): { id: number };
+    freeAeadKey(key: { id: number }): boolean;
+    aeadSeal(key: AeadKeyArg, iv: Uint8Array, pt: Uint8Array, aad?: Uint8Array | null): Buffer;
+    /** null when the tag does not verify. */
+    aeadOpen(key: AeadKeyArg, iv: Uint8Array, sealed: Uint8Array, aad?: Uint8Array | null): Buffer | null;
+    /** `out` may be `pt` itself; returns the bytes written (pt.length + 16). */
+    aeadSealInto(key: AeadKeyArg, iv: Uint8Array, pt: Uint8Array, out: Uint8Array, aad?: Uint8Array | null): number;
+    /** `out` may be `sealed` itself; returns the plaintext length or -1. */
+    aeadOpenInto(key: AeadKeyArg, iv: Uint8Array, sealed: Uint8Array, out: Uint8Array, aad?: Uint8Array | null): number;
+    /** `ivs` packs one 12-byte IV per message; `aad` is shared or per message. */
+    aeadSealBatch(key: AeadKeyArg, ivs: Uint8Array, messages: Uint8Array[], aad?: Uint8Array | (Uint8Array | null)[] | null): Buffer[];
+    aeadOpenBatch(key: AeadKeyArg, ivs: Uint8Array, sealed: Uint8Array[], aad?: Uint8Array | (Uint8Array | null)[] | null): (Buffer | null)[];
     aesGcmSeal(
         key: Buffer,
         iv: Buffer,
@@ -56,13 +339,86 @@ export interface NativeBindings {
         aad: Buffer
     ): Buffer;
 
+    /* OST compression --------------------------------------------------- */
+    /** Byte-for-byte the OST1 pack OSTPackWriter.createPack builds. */
+    ostEncode(data: Buffer | string, options?: OstEncodeOptions): Buffer;
+    ostDecode(pack: Buffer): OstDecodeResult;
+    /** Compresses each bin with `method`, in parallel for large batches. */
+    ostCompressBins(bins: (Buffer | string)[], method: string, level?: number): Buffer[];
+    /** Inverse of ostCompressBins; returns the UTF-8 bin contents. */
+    ostDecompressBins(bins: Buffer[], method: string): Buffer[];
+    /** Maps a pack file (or copies a Buffer) written with `index: true`. */
+    ostOpenPack(pack: string | Buffer): { id: number };
+    ostClosePack(pack: { id: number }): boolean;
+    ostPackInfo(pack: { id: number }): OstPackInfo;
+    /** Bytes [position, position + length) of the UTF-8 text, short at the end. */
+    ostPackRead(pack: { id: number }, position: number, length: number): Buffer;
+    ostPackReadInto(pack: { id: number }, target: Buffer, position: number): number;
+    /** Incremental encoder writing a streamed pack; see OSTPackStream. */
+    ostStreamCreate(options?: OstStreamOptions): { id: number };
+    /** Pack bytes this chunk completed, often empty. */
+    ostStreamWrite(stream: { id: number }, chunk: Buffer | string): Buffer;
+    ostStreamEnd(stream: { id: number }): Buffer;
+    /** The concatenated codes, packed MSB-first; `bits` is their length. */
+    universalEncode(type: UniversalCode, values: ArrayLike<number>): { data: Buffer; bits: number };
+    /** Decodes up to `count` codes (default: all) from the first `bits` bits. */
+    universalDecode(
+        type: UniversalCode,
+        data: Buffer,
+        bits?: number,
+        count?: number
+    ): { values: Float64Array; bitsRead: number };
+
+    /* Hashing ----------------------------------------------------------- */
+    /** BLAKE3 on the widest SIMD lanes the CPU has (AVX-512/AVX2/SSE4.1/NEON). */
+    blake3(data: Buffer | string, options?: Blake3Options): Buffer;
+    blake3Create(options?: Omit<Blake3Options, "dkLen">): { id: number };
+    blake3Update(hasher: { id: number }, data: Buffer | string): void;
+    /** Digest of everything written so far; the hasher stays usable. */
+    blake3Digest(hasher: { id: number }, dkLen?: number): Buffer;
+    blake3Free(hasher: { id: number }): boolean;
+    /** Digests of all inputs back to back, `dkLen` bytes each. */
+    blake3Batch(inputs: (Buffer | string)[], options?: Blake3Options): Buffer;
+
     /* PQ crypto --------------------------------------------------------- */
-    generateKyberKeyPair(algo?: string): HybridKeyPair;
+    /** Resolves an algorithm name to a cacheable integer handle. */
+    kemHandle(algo: string): KemAlgorithm;
+    generateKyberKeyPair(algo?: KemAlgorithm): HybridKeyPair;
     kyberEncapsulate(
         pub: Buffer,
-        algo?: string
+        algo?: KemAlgorithm
     ): { ciphertext: Buffer; sharedSecret: Buffer };
-    kyberDecapsulate(prv: Buffer, ct: Buffer, algo?: string): Buffer;
+    kyberDecapsulate(prv: Buffer, ct: Buffer, algo?: KemAlgorithm): Buffer;
+    /* "Into" variants write results into caller-supplied (e.g. slab) Buffers */
+    generateKyberKeyPairInto(pubOut: Buffer, prvOut: Buffer, algo?: KemAlgorithm): void;
+    kyberEncapsulateInto(
+        pub: Buffer,
+        ctOut: Buffer,
+        ssOut: Buffer,
+        algo?: KemAlgorithm
+    ): void;
+    kyberDecapsulateInto(prv: Buffer, ct: Buffer, ssOut: Buffer, algo?: KemAlgorithm): void;
+    /* Background keypair pool (refilled by a native thread) */
+    configureKyberKeyPairPool(
+        algo: KemAlgorithm,
+        opts?: { depth?: number; lowWatermark?: number; highWatermark?: number }
+    ): void;
+    takeKyberKeyPair(algo?: KemAlgorithm): HybridKeyPair;
+    getKyberKeyPairPoolStats(algo?: KemAlgorithm): KeyPairPoolStats;
+    getSecretArenaStats(): SecretArenaStats;
+    generateKyberKeyPairAsync(algo?: KemAlgorithm): Promise<HybridKeyPair>;
+    kyberEncapsulateAsync(
+        pub: Buffer,
+        algo?: KemAlgorithm
+    ): Promise<{ ciphertext: Buffer; sharedSecret: Buffer }>;
+    kyberDecapsulateAsync(prv: Buffer, ct: Buffer, algo?: KemAlgorithm): Promise<Buffer>;
+    /** `pubs` holds N packed public keys; results are packed in the same order. */
+    kyberEncapsulateBatch(
+        pubs: Buffer,
+        algo?: KemAlgorithm
+    ): Promise<{ ciphertexts: Buffer; sharedSecrets: Buffer }>;
+    /** `prvs` holds one private key or one per ciphertext in `cts`. */
+    kyberDecapsulateBatch(prvs: Buffer, cts: Buffer, algo?: KemAlgorithm): Promise<Buffer>;
 
     generateDilithiumKeyPair(algo?: string): HybridKeyPair;
     dilithiumSign(prv: Buffer, msg: Buffer, algo?: string): Buffer;
@@ -72,6 +428,17 @@ export interface NativeBindings {
         sig: Buffer,
         algo?: string
     ): boolean;
+    /**
+     * Verifies N signatures on native worker threads. `pubs` is one key per
+     * signature (array or packed) or a single shared key. Resolves a bitmap:
+     * bit i (LSB first) is set when signature i is valid.
+     */
+    dilithiumVerifyBatch(
+        pubs: Buffer | Buffer[],
+        msgs: Buffer[],
+        sigs: Buffer[],
+        algo?: string
+    ): Promise<Buffer>;
 
     /* X.509 & misc. ----------------------------------------------------- */
     generateHybridCSR(
@@ -103,6 +470,10 @@ export interface NativeBindings {
     registerDID(doc: Buffer): Buffer;
     deactivateDID(did: string): Buffer;
 
+    /* Metrics ----------------------------------------------------------- */
+    getMetrics(): NativeMetrics;
+    resetMetrics(): void;
+
     /* Helpers ----------------------------------------------------------- */
     generateECDSAKeyPair(): HybridKeyPair;
     generateRSAKeyPair(bits: number): HybridKeyPair;
@@ -120,7 +491,7 @@ export interface NativeBindings {
 // we’ll decide at run‑time whether the native module is available
 let nativeBindings: NativeBindings;
 
-/** Tries to resolve `../build/Release/uDTLS-PQ.node` relative to this file */
+/** Tries to resolve `build/Release/openssl_pq.node` (the binding.gyp target) */
 function loadNative(): NativeBindings | null {
     try {
         const require = createRequire(import.meta.url);
@@ -132,7 +503,7 @@ function loadNative(): NativeBindings | null {
             "..",
             "build",
             "Release",
-            "uDTLS-PQ.node"
+            "openssl_pq.node"
         );
 
         return require(binPath) as NativeBindings;
@@ -150,37 +521,118 @@ function buildMock(): NativeBindings {
     const noop = () => {};
     const zero = () => Buffer.alloc(0);
     const keyPair = () => ({ publicKey: Buffer.alloc(0), privateKey: Buffer.alloc(0) });
+    const step = (): DtlsStepResult => ({
+        handshakeComplete: false, closed: false, timeoutMs: -1, datagrams: [],
+    });
 
     return {
         /* DTLS ----------------------------------------------------------- */
         createContext: () => ({ id: 1 }),
         freeContext: noop,
+        getSharedContext: () => ({ id: 1, shared: false }),
         createSession: () => ({ id: 1 }),
-        freeSession: noop,
-        dtlsConnect: () => 0,
-        dtlsAccept: () => 0,
-        dtlsReceive: zero,
-        dtlsSend: () => 0,
-        dtlsShutdown: noop,
+        freeSession: () => true,
+        dtlsConnect: step,
+        dtlsAccept: step,
+        dtlsReceive: step,
+        dtlsSend: step,
+        dtlsShutdown: () => ({ ...step(), closed: true }),
+        dtlsHandleTimeout: step,
+        getSessionData: () => null,
+        setSessionData: () => false,
+        sessionReused: () => false,
+        getSessionCacheStats: () => ({ hits: 0, misses: 0, timeouts: 0 }),
+        getCookieStats: () => ({ enabled: false, issued: 0, verified: 0, rejected: 0, rotations: 0 }),
+        getIdentityCacheStats: () => ({ hits: 0, misses: 0, parseErrors: 0, entries: 0 }),
+        getContextPoolStats: () => ({ hits: 0, misses: 0, buildErrors: 0, entries: 0 }),
+        createUdpSocket: () => ({ id: 1, port: 0 }),
+        udpConnect: noop,
+        udpSend: noop,
+        udpDisconnect: noop,
+        udpClose: () => true,
+        getUdpSocketStats: () => ({
+            rxPackets: 0, txPackets: 0, rxBatches: 0, txBatches: 0, dropped: 0, peers: 0,
+        }),
+        createDtlsServer: () => ({ id: 1, port: 0, workers: 1 }),
+        dtlsServerSend: () => false,
+        dtlsServerDisconnect: () => false,
+        closeDtlsServer: () => true,
+        getDtlsServerStats: () => ({
+            rxPackets: 0, txPackets: 0, rxBatches: 0, txBatches: 0, dropped: 0, peers: 0, workers: [],
+        }),
         setCipherSuites: () => true,
         setPQCipherSuites: () => true,
         setVerifyMode: noop,
         setMinMaxVersion: noop,
         getError: () => "No native module",
         getVersion: () => "mock‑1.0.0",
-        setupAutomaticRekey: noop,
 
         /* Symmetric crypto ---------------------------------------------- */
+        createAeadKey: () => ({ id: 1 }),
+        freeAeadKey: () => true,
+        aeadSeal: zero,
+        aeadOpen: () => null,
+        aeadSealInto: () => 0,
+        aeadOpenInto: () => -1,
+        aeadSealBatch: (_key, _ivs, messages) => messages.map(zero),
+        aeadOpenBatch: (_key, _ivs, sealed) => sealed.map(() => null),
         aesGcmSeal: () => ({ ciphertext: Buffer.alloc(0), tag: Buffer.alloc(0) }),
         aesGcmOpen: zero,
 
+        /* OST compression ----------------------------------------------- */
+        ostEncode: zero,
+        ostDecode: () => ({ header: "{}", labels: [], bins: [], data: null }),
+        ostCompressBins: (bins) => bins.map(zero),
+        ostDecompressBins: (bins) => bins.map(zero),
+        ostOpenPack: () => ({ id: 1 }),
+        ostClosePack: () => true,
+        ostPackInfo: () => ({
+            size: 0, units: 0, windowLength: 1000, windows: 0, bins: 0, compressionMethod: "huffman",
+        }),
+        ostPackRead: zero,
+        ostPackReadInto: () => 0,
+        ostStreamCreate: () => ({ id: 1 }),
+        ostStreamWrite: zero,
+        ostStreamEnd: zero,
+        universalEncode: () => ({ data: Buffer.alloc(0), bits: 0 }),
+        universalDecode: () => ({ values: new Float64Array(0), bitsRead: 0 }),
+
+        /* Hashing ------------------------------------------------------- */
+        blake3: (_data, options) => Buffer.alloc(options?.dkLen ?? 32),
+        blake3Create: () => ({ id: 1 }),
+        blake3Update: noop,
+        blake3Digest: (_hasher, dkLen) => Buffer.alloc(dkLen ?? 32),
+        blake3Free: () => true,
+        blake3Batch: (inputs, options) => Buffer.alloc(inputs.length * (options?.dkLen ?? 32)),
+
         /* PQ crypto ----------------------------------------------------- */
+        kemHandle: () => 1,
         generateKyberKeyPair: keyPair,
         kyberEncapsulate: () => ({ ciphertext: Buffer.alloc(0), sharedSecret: Buffer.alloc(32) }),
         kyberDecapsulate: zero,
+        generateKyberKeyPairInto: noop,
+        kyberEncapsulateInto: noop,
+        kyberDecapsulateInto: noop,
+        configureKyberKeyPairPool: noop,
+        takeKyberKeyPair: keyPair,
+        getKyberKeyPairPoolStats: () => ({
+            hits: 0, misses: 0, generated: 0, available: 0,
+            depth: 0, lowWatermark: 0, highWatermark: 0,
+        }),
+        getSecretArenaStats: () => ({
+            inUse: 0, allocations: 0, releases: 0, largeAllocations: 0,
+            slabs: 0, lockedBytes: 0, lockFailures: 0, sizeClasses: [],
+        }),
+        generateKyberKeyPairAsync: async () => keyPair(),
+        kyberEncapsulateAsync: async () => ({ ciphertext: Buffer.alloc(0), sharedSecret: Buffer.alloc(32) }),
+        kyberDecapsulateAsync: async () => zero(),
+        kyberEncapsulateBatch: async () => ({ ciphertexts: Buffer.alloc(0), sharedSecrets: Buffer.alloc(0) }),
+        kyberDecapsulateBatch: async () => zero(),
         generateDilithiumKeyPair: keyPair,
         dilithiumSign: zero,
         dilithiumVerify: () => true,
+        dilithiumVerifyBatch: async (_pubs: Buffer | Buffer[], msgs: Buffer[]) =>
+            Buffer.alloc(Math.ceil(msgs.length / 8), 0xff),
 
         /* X.509 & misc. -------------------------------------------------- */
         generateHybridCSR: zero,
@@ -199,6 +651,10 @@ function buildMock(): NativeBindings {
         registerDID: zero,
         deactivateDID: zero,
 
+        /* Metrics -------------------------------------------------------- */
+        getMetrics: () => ({ sinceMs: 0, exports: {} }),
+        resetMetrics: noop,
+
         /* Helpers -------------------------------------------------------- */
         generateECDSAKeyPair: keyPair,
         generateRSAKeyPair: keyPair,
@@ -209,7 +665,11 @@ function buildMock(): NativeBindings {
 /* -------------------------------------------------------------------------- */
 /*  4.  Decide which implementation we expose                                 */
 /* -------------------------------------------------------------------------- */
-nativeBindings = loadNative() ?? buildMock();
+const loaded = loadNative();
+nativeBindings = loaded ?? buildMock();
+
+/** False when the exports above are the inert mock (browser / no addon). */
+export const hasNativeBindings = loaded !== null;
 
 export { nativeBindings };
 export default nativeBindings;
@@ -95,7 +95,7 @@ export enum PQAlgorithm {
     DILITHIUM5 = 'dilithium5',
 }
 
-/** Opaque handle coming back from native `createContext(...)` */
+/** Opaque handle coming back from native `createContext(...)` / `getSharedContext(...)` */
 export class DTLSContext { constructor(public id: number) {} }
 /** Opaque handle coming back from native `createSession(...)` */
 export class DTLSSession { constructor(public id: number) {} }
@@ -130,6 +130,16 @@ export interface DTLSContextOptions {
     enableCertTransparency?: boolean;
     pskIdentityHint?: string;
     pskKey?: Buffer;
+    /** Server-side session cache and tickets, see SessionCacheOptions */
+    sessionCache?: boolean | {
+        size?: number;
+        ttlSeconds?: number;
+        shards?: number;
+        tickets?: boolean;
+        ticketRotateSeconds?: number;
+    };
+    /** Stateless HMAC cookie exchange before any per-peer handshake state */
+    cookieExchange?: boolean | { rotateSeconds?: number };
     isServer: boolean;
 }
 
@@ -1,6 +1,8 @@
 import { EventEmitter } from "node:events";
 import dgram            from "node:dgram";
 import { createRequire } from "node:module";
+import nativeBindings from "./lib/bindings";
+import type { DtlsStepResult } from "./lib/bindings";
 //  * Generate a Falcon key pair for post-quantum secure signatures
 
 
@@ -38,6 +40,10 @@ export interface DTLSOptions {
     timeout?: number;
     mtu?: number;
     autoFallback?: boolean;
+    /** Server: cache sessions and issue tickets so reconnects skip the full handshake */
+    sessionCache?: DTLSContextOptions["sessionCache"];
+    /** Client: a session saved with getSession() from an earlier connection */
+    session?: Buffer;
 }
 
 export enum ConnectionState {
@@ -65,10 +71,14 @@ export class DTLS extends EventEmitter {
         autoFallback: boolean;
         cipherSuites: any[] | string[];
         cert?: string | Buffer;
-        key?: string | Buffer
+        key?: string | Buffer;
+        sessionCache?: DTLSContextOptions["sessionCache"];
+        session?: Buffer;
     };
     private state: ConnectionState = ConnectionState.CLOSED;
     private socket?: dgram.Socket;
+    private peer?: { host: string; port: number };
+    private retransmitTimer?: NodeJS.Timeout;
 
     constructor(options: DTLSOptions) {
         super();
@@ -104,10 +114,8 @@ export class DTLS extends EventEmitter {
             throw new Error("minVersion cannot exceed maxVersion");
 
         const ctxOpts: DTLSContextOptions = {
-            cert: typeof this.opts.cert === "string"
-                ? Buffer.from(this.opts.cert)
-                : this.opts.cert,
-            key:  this.opts.key as Buffer,
+            cert: this.opts.cert,
+            key:  this.opts.key,
             ciphers: this.opts.cipherSuites,
             pqCiphers: this.pickPqSuites(),
             enableCertTransparency: true,
@@ -115,9 +123,19 @@ export class DTLS extends EventEmitter {
             maxVersion: this.mapVersion(this.opts.maxVersion),
             verifyMode: this.opts.verifyPeer ? VerifyMode.PEER : VerifyMode.NONE,
             isServer: this.opts.isServer,
+            sessionCache: this.opts.sessionCache,
         };
-// @ts-ignore
-        this.context = nativeBindings.createContext(ctxOpts);
+        // Instances with identical settings share one frozen native context.
+        // Versions, PQ suites and peer verification are not part of it yet:
+        // the enum values above are not OpenSSL constants and there is no CA
+        // store to verify against, so they stay unapplied as before.
+        this.context = nativeBindings.getSharedContext({
+            isServer: this.opts.isServer,
+            cert: ctxOpts.cert,
+            key: ctxOpts.key,
+            ciphers: ctxOpts.ciphers?.length ? ctxOpts.ciphers : undefined,
+            sessionCache: ctxOpts.sessionCache,
+        });
         if (!this.context) throw new Error("DTLS context init failed");
     }
 
@@ -160,20 +178,37 @@ export class DTLS extends EventEmitter {
         this.socket = dgram.createSocket("udp4");
 
 
-        this.session = new DTLSSession(this.context.id);
-        // @ts-ignore
-        nativeBindings.setupAutomaticRekey(this.session.id, 3600);
-        // @ts-ignore
-        const ok = nativeBindings.dtlsConnect(this.session, host, port);
-        if (!ok) {
-          //  @ts-ignore
-            const err = nativeBindings.getError(this.session) ?? "DTLS connect error";
-            return this.handleError(new Error(err));
-        }
+        this.session = nativeBindings.createSession(this.context, { mtu: this.opts.mtu });
+        this.peer = { host, port };
+        if (this.opts.session) nativeBindings.setSessionData(this.session, this.opts.session);
+
+        const res = nativeBindings.dtlsConnect(this.session, host, port);
+        if (res.error) return this.handleError(new Error(res.error));
 
         this.state = ConnectionState.HANDSHAKE;
         this.setupSocketEvents();
         if (cb) this.once("connect", cb);
+        this.flush(res);
+    }
+
+    /* ------------------------------------------------------------------ */
+    /*  Native record path output                                         */
+    /* ------------------------------------------------------------------ */
+
+    /** Sends what the record layer produced and re-arms the handshake timer */
+    private flush(res: DtlsStepResult) {
+        const { host, port } = this.peer!;
+        for (const d of res.datagrams) this.socket!.send(d, port, host);
+
+        clearTimeout(this.retransmitTimer);
+        this.retransmitTimer = undefined;
+        if (res.timeoutMs >= 0 && !res.handshakeComplete) {
+            this.retransmitTimer = setTimeout(() => {
+                const next = nativeBindings.dtlsHandleTimeout(this.session);
+                if (next.error) return this.handleError(new Error(next.error));
+                this.flush(next);
+            }, res.timeoutMs);
+        }
     }
 
     /* ------------------------------------------------------------------ */
@@ -196,18 +231,35 @@ export class DTLS extends EventEmitter {
         }
 
         try {
-            //@ts-ignore
             const res = nativeBindings.dtlsReceive(this.session, msg);
+            this.flush(res);
+            if (res.error) return this.handleError(new Error(res.error));
             if (res.handshakeComplete && this.state !== ConnectionState.CONNECTED) {
                 this.state = ConnectionState.CONNECTED;
                 this.emit("connect");
             }
-            if (res.data) this.emit("message", res.data as Buffer);
+            if (res.data) this.emit("message", res.data);
+            if (res.closed) this.close();
         } catch (e) {
             this.handleError(e as Error);
         }
     }
 
+    /* ------------------------------------------------------------------ */
+    /*  Resumption                                                        */
+    /* ------------------------------------------------------------------ */
+
+    /** Serialized session to pass as `session` on the next connect, or null */
+    getSession(): Buffer | null {
+        if (this.state !== ConnectionState.CONNECTED) return null;
+        return nativeBindings.getSessionData(this.session);
+    }
+
+    /** True when the handshake resumed an earlier session */
+    isResumed(): boolean {
+        return this.state === ConnectionState.CONNECTED && nativeBindings.sessionReused(this.session);
+    }
+
     /* ------------------------------------------------------------------ */
     /*  Send / Close                                                      */
     /* ------------------------------------------------------------------ */
@@ -216,21 +268,26 @@ export class DTLS extends EventEmitter {
         if (this.state !== ConnectionState.CONNECTED)
             throw new Error("DTLS not connected");
 
-        const buf   = typeof data === "string" ? Buffer.from(data) : data;
-        //@ts-ignore
-        const cipher= nativeBindings.aesGcmSeal(buf, buf, buf, buf); // demo only
-        //@ts-ignore
-        this.socket!.send(cipher, 0, cipher.length, this.socket!.remotePort!, this.socket!.remoteAddress!);
+        const buf = typeof data === "string" ? Buffer.from(data) : data;
+        const res = nativeBindings.dtlsSend(this.session, buf);
+        if (res.error) return this.handleError(new Error(res.error));
+        this.flush(res);
     }
 
     close() {
-        //@ts-ignore
-        try { nativeBindings.dtlsShutdown(this.session); } catch { /* ignore */ }
-        //@ts-ignore
-        nativeBindings.freeSession?.(this.session);
+        clearTimeout(this.retransmitTimer);
+        if (this.session) {
+            try {
+                const res = nativeBindings.dtlsShutdown(this.session);
+                if (this.socket && this.peer)
+                    for (const d of res.datagrams) this.socket.send(d, this.peer.port, this.peer.host);
+            } catch { /* ignore */ }
+            nativeBindings.freeSession?.(this.session);
+        }
         //@ts-ignore
         nativeBindings.freeContext?.(this.context);
         this.socket?.close();
+        this.socket = undefined;
         this.state = ConnectionState.CLOSED;
     }
 
@@ -0,0 +1,252 @@
+import { existsSync, mkdtempSync, rmSync, writeFileSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { DTLS } from '../../hydra_compression/src/uDTLS-PQ/src/udtls-pq';
+import { hasNativeBindings, nativeBindings } from '../../hydra_compression/src/uDTLS-PQ/src/lib/bindings';
+import { SecureMemoryTransport } from '../../core/transports/secure-memory-transport';
+import { NativeAESGCM } from '../../core/crypto/aead-native';
+import { OSTCompression, OSTHelper } from '../../hydra_compression/src/ost/OSTCompression';
+import { OSTPackWriter } from '../../hydra_compression/src/ost/OSTPackWriter';
+import { MemoryVFS } from '../../core/vfs/memory-vfs';
+import { OstVfsAdapter } from '../../core/vfs/adapter/ost';
+import { FileMode } from '../../core/vfs/types';
+import { blake3, blake3Batch, createBlake3, setBlake3Addon } from '../../core/crypto/hash';
+
+// The TypeScript wrappers, run against the compiled addon rather than the mock
+describe('TypeScript layers over the native module', () => {
+  const modulePath = join(__dirname, '../../hydra_compression/src/uDTLS-PQ/build/Release/openssl_pq.node');
+  const certDir = join(__dirname, '../../certs');
+  // The addon counts every call; a native branch shows up as a new call
+  const calls = (name: string) => nativeBindings.getMetrics().exports[name]?.calls ?? 0;
+  const text = Array.from({ length: 400 }, (_, i) => `line ${i % 37}: the quick brown fox ${i}\n`).join('');
+
+  test('bindings.ts loads the compiled addon', () => {
+    expect(existsSync(modulePath)).toBe(true);
+    expect(hasNativeBindings).toBe(true);
+  });
+
+  test('DTLS connects and exchanges data through the native record path', async () => {
+    const opensslPQ = require(modulePath);
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+    });
+    const server = opensslPQ.createUdpSocket({ address: '127.0.0.1', context: serverCtx }, (events: any[]) => {
+      for (const e of events) {
+        if (e.type === 'message') opensslPQ.udpSend(server, e.address, e.port, e.data);
+      }
+    });
+
+    const client = new DTLS({
+      cert: join(certDir, 'client.crt'),
+      key: join(certDir, 'client.key'),
+      verifyPeer: false,
+    });
+    const echoed = new Promise<string>((resolve, reject) => {
+      client.on('error', reject);
+      client.on('message', (data: Buffer) => resolve(data.toString()));
+      client.connect(server.port, '127.0.0.1', () => client.send('hello'));
+    });
+
+    expect(await echoed).toBe('hello');
+    client.close();
+    expect(opensslPQ.udpClose(server)).toBe(true);
+  });
+
+  test('SecureMemoryTransport pairs encrypt with the native AES-GCM scheme', async () => {
+    const server = new SecureMemoryTransport({ isServer: true });
+    const client = new SecureMemoryTransport({ isServer: false });
+    await server.init();
+    await client.init();
+
+    // pairWith verifies both handshakes in the background
+    client.pairWith(server);
+    const deadline = Date.now() + 2000;
+    while (!(client.getContext()?.verified && server.getContext()?.verified)) {
+      if (Date.now() > deadline) throw new Error('pairing did not complete');
+      await new Promise((r) => setTimeout(r, 10));
+    }
+
+    expect((client as any).aes).toBeInstanceOf(NativeAESGCM);
+    expect((server as any).aes).toBeInstanceOf(NativeAESGCM);
+
+    const received = new Promise<Uint8Array>((resolve) => server.on('message', resolve));
+    await client.send(new TextEncoder().encode('over native AES-GCM'));
+    expect(new TextDecoder().decode(await received)).toBe('over native AES-GCM');
+
+    client.close();
+    server.close();
+  });
+
+  test('OSTPackWriter.createPack writes the same bytes natively as the TypeScript layout', async () => {
+    const config = { windowLength: 64, labelLength: 3, corpus: 'fixtures', tags: ['a', 'b'] } as any;
+
+    // What createPack's TypeScript branch assembles from OSTCompression's bins
+    const { compressedBins, metadata } = await new OSTCompression(config).encode(text);
+    const labels = Array.from(compressedBins.keys());
+    const header = Buffer.from(JSON.stringify({ config: metadata.config, binSequence: labels, bins: labels }));
+    const parts: Buffer[] = [Buffer.from('OST1'), Buffer.alloc(4), header];
+    parts[1].writeUInt32BE(header.length);
+    for (const label of labels) {
+      const name = Buffer.from(label);
+      const data = compressedBins.get(label)!;
+      const lengths = Buffer.alloc(6);
+      lengths.writeUInt16BE(name.length, 0);
+      lengths.writeUInt32BE(data.length, 2);
+      parts.push(lengths.subarray(0, 2), name, lengths.subarray(2), Buffer.from(data));
+    }
+
+    const before = calls('ostEncode');
+    const pack = await OSTPackWriter.createPack(text, config);
+    expect(calls('ostEncode')).toBe(before + 1);
+    expect(Buffer.from(pack).equals(Buffer.concat(parts))).toBe(true);
+    // Keys OSTConfig does not know are kept in the header, as JSON.stringify keeps them
+    expect(nativeBindings.ostDecode(Buffer.from(pack)).header).toContain('"corpus":"fixtures","tags":["a","b"]');
+  });
+
+  test('OstVfsAdapter reads only the pack header before deciding how to open it', async () => {
+    const base = new MemoryVFS();
+    const indexed = OSTPackWriter.createIndexedPack(text);
+    const headerEnd = 8 + Buffer.from(indexed).readUInt32BE(4);
+    await base.writeFile('/indexed.ost', indexed);
+    await base.writeFile('/mapped.ost', indexed);
+    await base.writeFile('/legacy.ost', await OSTPackWriter.createPack(text));
+
+    // Count what the adapter pulls out of the base VFS, per path
+    const bytesRead: Record<string, number> = {};
+    const open = base.open.bind(base);
+    base.open = async (path, mode) => {
+      const file = await open(path, mode);
+      const read = file.read.bind(file);
+      file.read = async (buffer, length) => {
+        const n = await read(buffer, length);
+        bytesRead[path] = (bytesRead[path] ?? 0) + n;
+        return n;
+      };
+      return file;
+    };
+
+    const dir = mkdtempSync(join(tmpdir(), 'ost-vfs-'));
+    const hostFile = join(dir, 'mapped.ost');
+    writeFileSync(hostFile, indexed);
+    const vfs = new OstVfsAdapter(base, {}, { hostPath: (path) => (path === '/mapped.ost' ? hostFile : undefined) });
+
+    try {
+      for (const path of ['/indexed.ost', '/mapped.ost']) {
+        const file = await vfs.open(path, FileMode.READ);
+        const out = new Uint8Array(100);
+        await file.seek(500, 'SET');
+        expect(await file.read(out, 100)).toBe(100);
+        expect(Buffer.from(out).toString()).toBe(text.slice(500, 600));
+        await file.close();
+      }
+      expect(bytesRead['/indexed.ost']).toBe(indexed.length);
+      expect(bytesRead['/mapped.ost']).toBe(headerEnd);
+
+      // A pack without the index flag is left to the legacy reader, unopened
+      const opened = calls('ostOpenPack');
+      await (await vfs.open('/legacy.ost', FileMode.READ)).close();
+      expect(calls('ostOpenPack')).toBe(opened);
+    } finally {
+      rmSync(dir, { recursive: true, force: true });
+    }
+  });
+
+  test('OSTCompression compresses and decompresses bins through the addon', async () => {
+    const mixed = text + 'naïve café ☕ 🦊🦊 ' + text.slice(0, 300);
+    const compressor = new OSTCompression({ windowLength: 128 });
+
+    const before = calls('ostCompressBins');
+    const encoded = await compressor.encode(mixed);
+    expect(calls('ostCompressBins')).toBe(before + 1);
+
+    // Same bins as the TypeScript Huffman coder writes
+    const bins = new Map<string, string>();
+    for (let i = 0; i < mixed.length; i += 128) {
+      const window = mixed.slice(i, i + 128);
+      const label = (compressor as any).generateLabel(window);
+      bins.set(label, (bins.get(label) ?? '') + window);
+    }
+    expect(Array.from(encoded.compressedBins.keys())).toEqual(Array.from(bins.keys()));
+    for (const [label, data] of bins) {
+      const expected = (compressor as any).huffmanCompress(data) as Uint8Array;
+      expect(Buffer.from(encoded.compressedBins.get(label)!).equals(Buffer.from(expected))).toBe(true);
+    }
+
+    const decompressed = calls('ostDecompressBins');
+    await compressor.decode(encoded);
+    expect(calls('ostDecompressBins')).toBe(decompressed + 1);
+    const back = nativeBindings.ostDecompressBins(Array.from(encoded.compressedBins.values(), (b) => Buffer.from(b)), 'huffman');
+    expect(back.map((b) => b.toString('utf8'))).toEqual(Array.from(bins.values()));
+
+    // General-purpose codecs never reach the wasm modules either
+    for (const compressionMethod of ['brotli', 'zstd', 'lz4']) {
+      const codec = new OSTCompression({ windowLength: 128, compressionMethod });
+      const packed = await codec.encode(mixed);
+      await codec.decode(packed);
+      const bins = nativeBindings.ostDecompressBins(Array.from(packed.compressedBins.values(), (b) => Buffer.from(b)), compressionMethod);
+      expect(bins.map((b) => b.toString('utf8'))).toEqual(Array.from(back, (b) => b.toString('utf8')));
+    }
+  });
+
+  test('OSTHelper universal codes go through the addon and match the string codecs', () => {
+    const values = [1, 2, 3, 7, 8, 255, 1000, 65537];
+
+    for (const type of ['elias-gamma', 'elias-delta', 'unary'] as const) {
+      const codec = OSTHelper.createUniversalCodec(type);
+      const expected = values.map((n) => codec.encode(n)).join('');
+
+      const encodes = calls('universalEncode');
+      const { data, bits } = OSTHelper.encodeUniversal(type, values);
+      expect(calls('universalEncode')).toBe(encodes + 1);
+      expect(bits).toBe(expected.length);
+      expect(Array.from({ length: bits }, (_, i) => (data[i >> 3] >> (7 - (i & 7))) & 1).join('')).toBe(expected);
+
+      const decodes = calls('universalDecode');
+      expect(OSTHelper.decodeUniversal(type, data, bits)).toEqual({ values, bitsRead: bits });
+      expect(OSTHelper.decodeUniversal(type, data, bits, 3).values).toEqual(values.slice(0, 3));
+      expect(calls('universalDecode')).toBe(decodes + 2);
+      expect(Array.isArray(OSTHelper.decodeUniversal(type, data, bits).values)).toBe(true);
+    }
+
+    expect(() => OSTHelper.encodeUniversal('elias-gamma', [0])).toThrow('Elias Gamma can only encode positive integers');
+    const { data, bits } = OSTHelper.encodeUniversal('elias-gamma', [5, 6]);
+    expect(() => OSTHelper.decodeUniversal('elias-gamma', data, bits, 3)).toThrow('Not enough bits for the requested count');
+  });
+
+  test('core/crypto/hash loads the addon on first use and hashes through it', () => {
+    const hex = (b: Uint8Array) => Buffer.from(b).toString('hex');
+    const empty = 'af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262';
+    const abc = '6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85';
+
+    const oneShot = calls('blake3');
+    expect(hex(blake3(''))).toBe(empty);
+    expect(hex(blake3(new TextEncoder().encode('abc')))).toBe(abc);
+    expect(calls('blake3')).toBe(oneShot + 2);
+
+    const created = calls('blake3Create');
+    const stream = createBlake3().update('a').update(new TextEncoder().encode('bc'));
+    expect(hex(stream.digest())).toBe(abc);
+    expect(hex(stream.digest(64)).slice(0, 64)).toBe(abc);
+    stream.dispose();
+    expect(calls('blake3Create')).toBe(created + 1);
+    expect(blake3Batch(['', 'abc']).map(hex)).toEqual([empty, abc]);
+
+    // An injected addon replaces the one loaded from build/Release
+    const used: string[] = [];
+    const names = ['blake3', 'blake3Batch', 'blake3Create', 'blake3Update', 'blake3Digest', 'blake3Free'];
+    const spy = Object.fromEntries(names.map((name) => [
+      name,
+      (...args: any[]) => (used.push(name), (nativeBindings as any)[name](...args)),
+    ])) as any;
+    setBlake3Addon(spy);
+    try {
+      expect(hex(blake3(''))).toBe(empty);
+      createBlake3().update('abc').dispose();
+      expect(used).toEqual(['blake3', 'blake3Create', 'blake3Update', 'blake3Free']);
+    } finally {
+      setBlake3Addon(nativeBindings);
+    }
+  });
+});
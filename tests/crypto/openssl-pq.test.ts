@@ -1,4 +1,5 @@
-import { existsSync } from 'fs';
+import { existsSync, readFileSync, writeFileSync, unlinkSync } from 'fs';
+import { tmpdir } from 'os';
 import { join } from 'path';
 
 describe('OpenSSL PQ Native Module', () => {
@@ -90,4 +91,729 @@ describe('OpenSSL PQ Native Module', () => {
     // The decapsulated shared secret should match the encapsulated one
     expect(Buffer.compare(decapsulation, encapsulation.sharedSecret)).toBe(0);
   });
+
+  test('Async Kyber operations resolve with the same shapes', async () => {
+    const opensslPQ = require(modulePath);
+
+    const keyPair = await opensslPQ.generateKyberKeyPairAsync('kyber768');
+    expect(keyPair.publicKey).toBeInstanceOf(Buffer);
+    expect(keyPair.privateKey).toBeInstanceOf(Buffer);
+
+    const encapsulation = await opensslPQ.kyberEncapsulateAsync(keyPair.publicKey, 'kyber768');
+    expect(encapsulation.ciphertext).toBeInstanceOf(Buffer);
+    expect(encapsulation.sharedSecret).toBeInstanceOf(Buffer);
+
+    const decapsulation = await opensslPQ.kyberDecapsulateAsync(
+      keyPair.privateKey,
+      encapsulation.ciphertext,
+      'kyber768'
+    );
+    expect(Buffer.compare(decapsulation, encapsulation.sharedSecret)).toBe(0);
+
+    await expect(opensslPQ.kyberEncapsulateAsync(Buffer.alloc(3), 'kyber768')).rejects.toThrow();
+  });
+
+  test('Kyber operations accept a cached KEM handle', () => {
+    const opensslPQ = require(modulePath);
+
+    const handle = opensslPQ.kemHandle('kyber512');
+    expect(typeof handle).toBe('number');
+
+    const keyPair = opensslPQ.generateKyberKeyPair(handle);
+    const encapsulation = opensslPQ.kyberEncapsulate(keyPair.publicKey, handle);
+    const decapsulation = opensslPQ.kyberDecapsulate(keyPair.privateKey, encapsulation.ciphertext, handle);
+    expect(Buffer.compare(decapsulation, encapsulation.sharedSecret)).toBe(0);
+
+    expect(() => opensslPQ.kyberEncapsulate(keyPair.publicKey, 99)).toThrow();
+  });
+
+  test('Batched Kyber encapsulation round-trips through batched decapsulation', async () => {
+    const opensslPQ = require(modulePath);
+
+    const keyPairs = Array.from({ length: 8 }, () => opensslPQ.generateKyberKeyPair('kyber768'));
+    const publicKeys = Buffer.concat(keyPairs.map((kp) => kp.publicKey));
+    const privateKeys = Buffer.concat(keyPairs.map((kp) => kp.privateKey));
+
+    const batch = await opensslPQ.kyberEncapsulateBatch(publicKeys, 'kyber768');
+    expect(batch.ciphertexts.length % keyPairs.length).toBe(0);
+    expect(batch.sharedSecrets.length % keyPairs.length).toBe(0);
+
+    const secrets = await opensslPQ.kyberDecapsulateBatch(privateKeys, batch.ciphertexts, 'kyber768');
+    expect(Buffer.compare(secrets, batch.sharedSecrets)).toBe(0);
+  });
+
+  test('Into variants write results into caller-supplied buffers', () => {
+    const opensslPQ = require(modulePath);
+
+    const slab = Buffer.alloc(8192);
+    const publicKey = slab.subarray(0, 1184);
+    const privateKey = slab.subarray(1184, 1184 + 2400);
+    opensslPQ.generateKyberKeyPairInto(publicKey, privateKey, 'kyber768');
+
+    const ciphertext = Buffer.alloc(1088);
+    const sharedSecret = Buffer.alloc(32);
+    const decapsulated = Buffer.alloc(32);
+    opensslPQ.kyberEncapsulateInto(publicKey, ciphertext, sharedSecret, 'kyber768');
+    opensslPQ.kyberDecapsulateInto(privateKey, ciphertext, decapsulated, 'kyber768');
+    expect(Buffer.compare(decapsulated, sharedSecret)).toBe(0);
+
+    expect(() => opensslPQ.kyberEncapsulateInto(publicKey, Buffer.alloc(16), sharedSecret, 'kyber768')).toThrow();
+  });
+
+  test('Pooled Kyber keypairs are usable and counted', () => {
+    const opensslPQ = require(modulePath);
+
+    opensslPQ.configureKyberKeyPairPool('kyber512', { depth: 8, lowWatermark: 2, highWatermark: 8 });
+    const keyPair = opensslPQ.takeKyberKeyPair('kyber512');
+    const encapsulation = opensslPQ.kyberEncapsulate(keyPair.publicKey, 'kyber512');
+    const decapsulation = opensslPQ.kyberDecapsulate(keyPair.privateKey, encapsulation.ciphertext, 'kyber512');
+    expect(Buffer.compare(decapsulation, encapsulation.sharedSecret)).toBe(0);
+
+    const stats = opensslPQ.getKyberKeyPairPoolStats('kyber512');
+    expect(stats.hits + stats.misses).toBe(1);
+    expect(stats.depth).toBe(8);
+  });
+
+  test('DTLS sessions complete an in-memory handshake through the record path', () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+    const server = opensslPQ.createSession(serverCtx);
+    const client = opensslPQ.createSession(clientCtx);
+
+    opensslPQ.dtlsAccept(server);
+    let toServer = opensslPQ.dtlsConnect(client).datagrams;
+    let toClient = [];
+    let connected = false;
+    for (let round = 0; round < 10 && (toServer.length || toClient.length); round++) {
+      const nextToClient = toServer.flatMap((d) => opensslPQ.dtlsReceive(server, d).datagrams);
+      const nextToServer = toClient.flatMap((d) => {
+        const res = opensslPQ.dtlsReceive(client, d);
+        connected = connected || res.handshakeComplete;
+        return res.datagrams;
+      });
+      toServer = nextToServer;
+      toClient = nextToClient;
+    }
+    expect(connected).toBe(true);
+
+    const sent = opensslPQ.dtlsSend(client, Buffer.from('hello'));
+    const received = sent.datagrams.map((d) => opensslPQ.dtlsReceive(server, d).data);
+    expect(Buffer.concat(received).toString()).toBe('hello');
+
+    opensslPQ.freeSession(client);
+    opensslPQ.freeSession(server);
+  });
+
+  test('Native UDP sockets handshake and exchange data over loopback', async () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+
+    const server = opensslPQ.createUdpSocket({ address: '127.0.0.1', context: serverCtx }, (events: any[]) => {
+      for (const e of events) {
+        if (e.type === 'message') opensslPQ.udpSend(server, e.address, e.port, e.data);
+      }
+    });
+
+    const echoed = new Promise<string>((resolve) => {
+      const client = opensslPQ.createUdpSocket({ address: '127.0.0.1' }, (events: any[]) => {
+        for (const e of events) {
+          if (e.type === 'message') {
+            resolve(e.data.toString());
+            opensslPQ.udpClose(client);
+          }
+        }
+      });
+      opensslPQ.udpConnect(client, clientCtx, '127.0.0.1', server.port);
+      opensslPQ.udpSend(client, '127.0.0.1', server.port, Buffer.from('hello'));
+    });
+
+    expect(await echoed).toBe('hello');
+    expect(opensslPQ.getUdpSocketStats(server).rxPackets).toBeGreaterThan(0);
+    expect(opensslPQ.udpClose(server)).toBe(true);
+  });
+
+  test('UDP servers cap their peers and close the ones that go quiet', async () => {
+    const opensslPQ = require(modulePath);
+    const dgram = require('dgram');
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+
+    const serverEvents: any[] = [];
+    const server = opensslPQ.createUdpSocket(
+      { address: '127.0.0.1', context: serverCtx, maxPeers: 1, idleTimeoutMs: 300 },
+      (events: any[]) => serverEvents.push(...events),
+    );
+    const until = async (cond: () => boolean) => {
+      for (const deadline = Date.now() + 5000; !cond(); await new Promise((r) => setTimeout(r, 10))) {
+        if (Date.now() > deadline) throw new Error('timed out');
+      }
+    };
+
+    const client = opensslPQ.createUdpSocket({ address: '127.0.0.1' }, () => {});
+    opensslPQ.udpConnect(client, clientCtx, '127.0.0.1', server.port);
+    await until(() => serverEvents.some((e) => e.type === 'connect'));
+    const connectedAt = Date.now();
+
+    // A second peer's ClientHello finds the server full and gets no answer
+    const probe = opensslPQ.createSession(clientCtx);
+    const hello = opensslPQ.dtlsConnect(probe, '127.0.0.1', 1).datagrams[0];
+    const raw = dgram.createSocket('udp4');
+    let answers = 0;
+    raw.on('message', () => answers++);
+    const dropped = opensslPQ.getUdpSocketStats(server).dropped;
+    raw.send(hello, server.port, '127.0.0.1');
+    await until(() => opensslPQ.getUdpSocketStats(server).dropped > dropped);
+    expect(opensslPQ.getUdpSocketStats(server).peers).toBe(1);
+    expect(answers).toBe(0);
+
+    // The connected client never speaks again, so the server closes it
+    await until(() => serverEvents.some((e) => e.type === 'close'));
+    expect(Date.now() - connectedAt).toBeGreaterThanOrEqual(250);
+    expect(opensslPQ.getUdpSocketStats(server).peers).toBe(0);
+
+    // ... which makes room for the next ClientHello
+    raw.send(hello, server.port, '127.0.0.1');
+    await until(() => answers > 0);
+    raw.close();
+
+    opensslPQ.freeSession(probe);
+    opensslPQ.udpClose(client);
+    opensslPQ.udpClose(server);
+  });
+
+  test('DTLS server engine shards peers across worker sockets', async () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+
+    const server = opensslPQ.createDtlsServer(serverCtx, { address: '127.0.0.1', workers: 4 }, (events: any[]) => {
+      for (const e of events) {
+        if (e.type === 'message') opensslPQ.dtlsServerSend(server, e.address, e.port, e.data);
+      }
+    });
+    expect(server.workers).toBeGreaterThanOrEqual(1);
+
+    const echoes = Array.from({ length: 8 }, (_, i) => new Promise<string>((resolve) => {
+      const client = opensslPQ.createUdpSocket({ address: '127.0.0.1' }, (events: any[]) => {
+        for (const e of events) {
+          if (e.type === 'message') {
+            resolve(e.data.toString());
+            opensslPQ.udpClose(client);
+          }
+        }
+      });
+      opensslPQ.udpConnect(client, clientCtx, '127.0.0.1', server.port);
+      opensslPQ.udpSend(client, '127.0.0.1', server.port, Buffer.from(`client ${i}`));
+    }));
+
+    expect(await Promise.all(echoes)).toEqual(Array.from({ length: 8 }, (_, i) => `client ${i}`));
+    const stats = opensslPQ.getDtlsServerStats(server);
+    expect(stats.peers).toBe(8);
+    expect(stats.workers).toHaveLength(server.workers);
+    expect(opensslPQ.closeDtlsServer(server)).toBe(true);
+  });
+
+  test('Freed context handles stay invalid after their slot is reused', () => {
+    const opensslPQ = require(modulePath);
+
+    const first = opensslPQ.createContext({ isServer: false });
+    opensslPQ.freeContext(first);
+    const second = opensslPQ.createContext({ isServer: false });
+
+    expect(second.id).not.toBe(first.id);
+    expect(() => opensslPQ.setVerifyMode(first, 0)).toThrow('Invalid context');
+    expect(() => opensslPQ.setVerifyMode(second, 0)).not.toThrow();
+    opensslPQ.freeContext(second);
+  });
+
+  test('Handle ids are never reissued, even past the generation range', () => {
+    const opensslPQ = require(modulePath);
+
+    // Open/close churn on one slot; 11 generation bits would wrap at 2048
+    const first = opensslPQ.blake3Create();
+    opensslPQ.blake3Free(first);
+    const seen = new Set<number>([first.id]);
+    let last = first;
+    for (let i = 0; i < 3000; i++) {
+      last = opensslPQ.blake3Create();
+      expect(seen.has(last.id)).toBe(false);
+      seen.add(last.id);
+      if (i < 2999) opensslPQ.blake3Free(last);
+    }
+
+    expect(() => opensslPQ.blake3Update(first, 'stale')).toThrow('Invalid BLAKE3 hasher handle');
+    expect(opensslPQ.blake3Free(first)).toBe(false);
+    expect(opensslPQ.blake3Free(last)).toBe(true);
+  });
+
+  test('Clients resume sessions from the server ticket cache', () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+      sessionCache: { size: 64, ttlSeconds: 60 },
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+
+    const handshake = (saved?: Buffer) => {
+      const server = opensslPQ.createSession(serverCtx);
+      const client = opensslPQ.createSession(clientCtx);
+      if (saved) opensslPQ.setSessionData(client, saved);
+
+      opensslPQ.dtlsAccept(server);
+      let toServer = opensslPQ.dtlsConnect(client).datagrams;
+      let toClient = [];
+      for (let round = 0; round < 10 && (toServer.length || toClient.length); round++) {
+        const nextToClient = toServer.flatMap((d) => opensslPQ.dtlsReceive(server, d).datagrams);
+        toServer = toClient.flatMap((d) => opensslPQ.dtlsReceive(client, d).datagrams);
+        toClient = nextToClient;
+      }
+
+      const result = { data: opensslPQ.getSessionData(client), reused: opensslPQ.sessionReused(client) };
+      opensslPQ.dtlsShutdown(client);
+      opensslPQ.dtlsShutdown(server);
+      opensslPQ.freeSession(client);
+      opensslPQ.freeSession(server);
+      return result;
+    };
+
+    const first = handshake();
+    expect(first.reused).toBe(false);
+    expect(Buffer.isBuffer(first.data)).toBe(true);
+
+    expect(handshake(first.data).reused).toBe(true);
+    expect(opensslPQ.getSessionCacheStats(serverCtx).hits).toBe(1);
+  });
+
+  test('Cookie exchange answers unverified ClientHellos without creating peers', async () => {
+    const opensslPQ = require(modulePath);
+    const dgram = require('dgram');
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+      cookieExchange: true,
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+    const server = opensslPQ.createDtlsServer(serverCtx, { address: '127.0.0.1', workers: 1 }, () => {});
+
+    // A real ClientHello replayed from a socket that never answers the cookie.
+    const probe = opensslPQ.createSession(clientCtx);
+    const hello = opensslPQ.dtlsConnect(probe, '127.0.0.1', 1).datagrams[0];
+    const raw = dgram.createSocket('udp4');
+    const reply = new Promise((resolve) => raw.once('message', resolve));
+    raw.send(hello, server.port, '127.0.0.1');
+    await reply;
+    raw.close();
+
+    expect(opensslPQ.getCookieStats(serverCtx).issued).toBeGreaterThanOrEqual(1);
+    expect(opensslPQ.getDtlsServerStats(server).peers).toBe(0);
+
+    opensslPQ.freeSession(probe);
+    opensslPQ.closeDtlsServer(server);
+  });
+
+  test('Cookies expire two rotation periods after their secret was created', async () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+
+    const serverCtx = opensslPQ.createContext({
+      isServer: true,
+      cert: join(certDir, 'server.crt'),
+      key: join(certDir, 'server.key'),
+      cookieExchange: { rotateSeconds: 1 },
+    });
+    const clientCtx = opensslPQ.createContext({ isServer: false });
+
+    // ClientHello, HelloVerifyRequest, then the ClientHello echoing the cookie
+    const echoCookie = () => {
+      const server = opensslPQ.createSession(serverCtx);
+      const client = opensslPQ.createSession(clientCtx);
+      opensslPQ.dtlsAccept(server, '127.0.0.1', 4433);
+      const hello = opensslPQ.dtlsConnect(client, '127.0.0.1', 4434).datagrams;
+      const verifyRequest = hello.flatMap((d: Buffer) => opensslPQ.dtlsReceive(server, d).datagrams);
+      const echoed = verifyRequest.flatMap((d: Buffer) => opensslPQ.dtlsReceive(client, d).datagrams);
+      const deliver = () => {
+        for (const d of echoed) {
+          try { opensslPQ.dtlsReceive(server, d); } catch { /* a rejected cookie may fail the step */ }
+        }
+        opensslPQ.freeSession(client);
+        opensslPQ.freeSession(server);
+      };
+      return deliver;
+    };
+
+    const stats = () => opensslPQ.getCookieStats(serverCtx);
+    const fresh = echoCookie();
+    const stale = echoCookie();
+    expect(stats().issued).toBe(2);
+
+    fresh();
+    expect(stats().verified).toBe(1);
+
+    // No cookie is issued in between, so nothing rotates the secret away
+    await new Promise((r) => setTimeout(r, 2100));
+    const rejected = stats().rejected;
+    stale();
+    expect(stats().verified).toBe(1);
+    expect(stats().rejected).toBeGreaterThan(rejected);
+    expect(stats().rotations).toBe(0);
+  });
+
+  test('getMetrics counts calls and failures per export', () => {
+    const opensslPQ = require(modulePath);
+
+    opensslPQ.resetMetrics();
+    for (let i = 0; i < 10; i++) opensslPQ.generateKyberKeyPair('kyber512');
+    expect(() => opensslPQ.kyberEncapsulate()).toThrow();
+
+    const metrics = opensslPQ.getMetrics();
+    const keygen = metrics.exports.generateKyberKeyPair;
+    expect(keygen.calls).toBe(10);
+    expect(keygen.errors).toBe(0);
+    expect(keygen.p99Us).toBeGreaterThanOrEqual(keygen.p50Us);
+    expect(metrics.exports.kyberEncapsulate.errors).toBe(1);
+
+    opensslPQ.resetMetrics();
+    expect(opensslPQ.getMetrics().exports.generateKyberKeyPair).toBeUndefined();
+  });
+
+  test('Async KEM round-trips at every level and validates lengths up front', async () => {
+    const opensslPQ = require(modulePath);
+
+    for (const algo of ['kyber512', 'kyber768', 'kyber1024']) {
+      const { publicKey, privateKey } = await opensslPQ.generateKyberKeyPairAsync(algo);
+      const { ciphertext, sharedSecret } = await opensslPQ.kyberEncapsulateAsync(publicKey, algo);
+      const recovered = await opensslPQ.kyberDecapsulateAsync(privateKey, ciphertext, algo);
+      expect(recovered.equals(sharedSecret)).toBe(true);
+    }
+
+    expect(opensslPQ.kemHandle('unknown')).toBe(opensslPQ.kemHandle('kyber768'));
+    await expect(opensslPQ.kyberEncapsulateAsync(Buffer.alloc(3), 'kyber512')).rejects.toThrow('Invalid public key length');
+  });
+
+  test('Dilithium signs, verifies and batch-verifies into a bitmap', async () => {
+    const opensslPQ = require(modulePath);
+    const { publicKey, privateKey } = opensslPQ.generateDilithiumKeyPair('dilithium2');
+
+    const messages = Array.from({ length: 20 }, (_, i) => Buffer.from(`message ${i}`));
+    const signatures = messages.map((m) => opensslPQ.dilithiumSign(privateKey, m, 'dilithium2'));
+    expect(opensslPQ.dilithiumVerify(publicKey, messages[0], signatures[0], 'dilithium2')).toBe(true);
+    expect(opensslPQ.dilithiumVerify(publicKey, messages[1], signatures[0], 'dilithium2')).toBe(false);
+
+    signatures[3] = signatures[4];
+    const bits = await opensslPQ.dilithiumVerifyBatch(publicKey, messages, signatures, 'dilithium2');
+    expect(bits.length).toBe(3);
+    for (let i = 0; i < messages.length; i++) {
+      expect(((bits[i >> 3] >> (i & 7)) & 1) === 1).toBe(i !== 3);
+    }
+  });
+
+  test('createContext shares parsed identities loaded from Buffers', () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+    const cert = readFileSync(join(certDir, 'server.crt'));
+    const key = readFileSync(join(certDir, 'server.key'));
+
+    const before = opensslPQ.getIdentityCacheStats();
+    const contexts = Array.from({ length: 10 }, () =>
+      opensslPQ.createContext({ isServer: true, cert, key }));
+    contexts.push(opensslPQ.createContext({ isServer: true, cert: cert.toString(), key: key.toString() }));
+
+    const after = opensslPQ.getIdentityCacheStats();
+    expect(after.misses - before.misses).toBeLessThanOrEqual(2);
+    expect(after.hits - before.hits).toBeGreaterThanOrEqual(20);
+    expect(() => opensslPQ.createContext({ isServer: true, cert: Buffer.from('not a cert'), key })).toThrow();
+
+    contexts.forEach((ctx) => opensslPQ.freeContext(ctx));
+  });
+
+  test('getSharedContext hands out one frozen SSL_CTX per configuration', () => {
+    const opensslPQ = require(modulePath);
+    const certDir = join(__dirname, '../../certs');
+    const opts = {
+      isServer: true,
+      cert: readFileSync(join(certDir, 'server.crt')),
+      key: readFileSync(join(certDir, 'server.key')),
+      ciphers: ['ECDHE-RSA-AES128-GCM-SHA256'],
+      verifyMode: 0,
+    };
+
+    const before = opensslPQ.getContextPoolStats();
+    const handles = Array.from({ length: 50 }, () => opensslPQ.getSharedContext({ ...opts }));
+    const after = opensslPQ.getContextPoolStats();
+    expect(after.misses - before.misses).toBe(1);
+    expect(after.hits - before.hits).toBe(49);
+    expect(handles.slice(1).every((h) => h.shared)).toBe(true);
+    expect(new Set(handles.map((h) => h.id)).size).toBe(50);
+
+    expect(() => opensslPQ.setCipherSuites(handles[0], ['AES128-SHA'])).toThrow('immutable');
+    expect(opensslPQ.getSharedContext({ ...opts, verifyMode: 1 }).shared).toBe(false);
+
+    handles.forEach((h) => opensslPQ.freeContext(h));
+  });
+
+  test('Private keys and shared secrets are served from the secret arena', () => {
+    const opensslPQ = require(modulePath);
+    const before = opensslPQ.getSecretArenaStats();
+    expect(before.sizeClasses).toEqual(expect.arrayContaining([32, 1632, 2400, 3168]));
+
+    const { publicKey, privateKey } = opensslPQ.generateKyberKeyPair('kyber512');
+    const { ciphertext, sharedSecret } = opensslPQ.kyberEncapsulate(publicKey, 'kyber512');
+    const recovered = opensslPQ.kyberDecapsulate(privateKey, ciphertext, 'kyber512');
+    expect(recovered.equals(sharedSecret)).toBe(true);
+
+    const after = opensslPQ.getSecretArenaStats();
+    expect(after.allocations - before.allocations).toBe(3);
+    expect(after.slabs).toBeGreaterThan(0);
+  });
+
+  test('AEAD seal/open works in place, in batches and for both algorithms', () => {
+    const opensslPQ = require(modulePath);
+    const { randomBytes } = require('crypto');
+    const raw = randomBytes(32);
+    const iv = randomBytes(12);
+    const aad = Buffer.from('header');
+    const message = Buffer.from('secure memory transport payload');
+
+    for (const algorithm of ['aes-256-gcm', 'chacha20-poly1305']) {
+      const key = opensslPQ.createAeadKey(raw, algorithm);
+
+      const frame = Buffer.alloc(message.length + 16);
+      message.copy(frame);
+      expect(opensslPQ.aeadSealInto(key, iv, frame.subarray(0, message.length), frame, aad)).toBe(frame.length);
+      expect(opensslPQ.aeadOpen(key, iv, frame, aad).equals(message)).toBe(true);
+      expect(opensslPQ.aeadOpenInto(key, iv, frame, frame, aad)).toBe(message.length);
+      expect(frame.subarray(0, message.length).equals(message)).toBe(true);
+
+      const messages = Array.from({ length: 16 }, (_, i) => randomBytes(i * 100));
+      const ivs = randomBytes(12 * messages.length);
+      const sealed = opensslPQ.aeadSealBatch(key, ivs, messages, aad);
+      sealed[3][0] ^= 1;
+      const opened = opensslPQ.aeadOpenBatch(key, ivs, sealed, aad);
+      expect(opened[3]).toBeNull();
+      opened.forEach((pt: Buffer | null, i: number) => i !== 3 && expect(pt!.equals(messages[i])).toBe(true));
+
+      expect(opensslPQ.freeAeadKey(key)).toBe(true);
+    }
+
+    const { ciphertext, tag } = opensslPQ.aesGcmSeal(raw, iv, message, aad);
+    expect(opensslPQ.aesGcmOpen(raw, iv, ciphertext, tag, aad).equals(message)).toBe(true);
+    tag[0] ^= 1;
+    expect(() => opensslPQ.aesGcmOpen(raw, iv, ciphertext, tag, aad)).toThrow('Authentication failed');
+  });
+
+  test('ostEncode writes OST1 packs and ostDecode reads them back', () => {
+    const opensslPQ = require(modulePath);
+    const config = { windowLength: 3, labelLength: 1 };
+
+    // 'aab': b -> 0, a -> 1, label "b 1", bits 110 padded to 0xc0
+    const header = JSON.stringify({
+      config: {
+        windowLength: 3, labelLength: 1, variableWindow: false,
+        compressionMethod: 'huffman', subBinning: false, subBinningDepth: 0,
+      },
+      binSequence: ['b 1'],
+      bins: ['b 1'],
+    });
+    const table = JSON.stringify([['a', 2], ['b', 1]]);
+    const u32 = (n: number) => Buffer.from([n >>> 24, (n >>> 16) & 0xff, (n >>> 8) & 0xff, n & 0xff]);
+    const bin = Buffer.concat([u32(table.length), Buffer.from(table), Buffer.from([0xc0])]);
+    const expected = Buffer.concat([
+      Buffer.from('OST1'), u32(header.length), Buffer.from(header),
+      Buffer.from([0, 3]), Buffer.from('b 1'), u32(bin.length), bin,
+    ]);
+    expect(opensslPQ.ostEncode('aab', config).equals(expected)).toBe(true);
+    expect(opensslPQ.ostEncode(Buffer.from('aab'), config).equals(expected)).toBe(true);
+
+    const text = 'ACGTTGCA'.repeat(500) + 'héllo wörld 😀'.repeat(50);
+    const pack = opensslPQ.ostEncode(text, { windowLength: 64, recordOrder: true });
+    const decoded = opensslPQ.ostDecode(pack);
+    expect(decoded.data.toString('utf8')).toBe(text);
+    expect(decoded.bins.length).toBe(decoded.labels.length);
+    expect(opensslPQ.ostDecode(expected).data).toBeNull();
+  });
+
+  test('ostOpenPack serves ranged reads from indexed packs', () => {
+    const opensslPQ = require(modulePath);
+    const text = Array.from({ length: 4000 }, (_, i) => ['ACGT', 'héllo', '😀', '中文\n'][(i * 7) % 4]).join('');
+    const bytes = Buffer.from(text, 'utf8');
+    const pack = opensslPQ.ostEncode(text, { windowLength: 7, index: true });
+
+    // Same bins as a plain pack, and ostDecode rebuilds the text from the index
+    const plain = opensslPQ.ostDecode(opensslPQ.ostEncode(text, { windowLength: 7 }));
+    const decoded = opensslPQ.ostDecode(pack);
+    expect(decoded.bins.map((b: Buffer) => b.toString('hex'))).toEqual(plain.bins.map((b: Buffer) => b.toString('hex')));
+    expect(decoded.data.equals(bytes)).toBe(true);
+
+    const file = join(tmpdir(), `ost-pack-${process.pid}.ost`);
+    writeFileSync(file, pack);
+    try {
+      for (const source of [file, pack]) {
+        const handle = opensslPQ.ostOpenPack(source);
+        expect(opensslPQ.ostPackInfo(handle).size).toBe(bytes.length);
+        for (const [position, length] of [[0, 10], [1, 4], [333, 4096], [bytes.length - 3, 100], [bytes.length, 1]]) {
+          const expected = bytes.subarray(position, position + length);
+          expect(opensslPQ.ostPackRead(handle, position, length).equals(expected)).toBe(true);
+        }
+        const target = Buffer.alloc(bytes.length + 8);
+        expect(opensslPQ.ostPackReadInto(handle, target, 0)).toBe(bytes.length);
+        expect(opensslPQ.ostClosePack(handle)).toBe(true);
+        expect(() => opensslPQ.ostPackRead(handle, 0, 1)).toThrow();
+      }
+    } finally {
+      unlinkSync(file);
+    }
+
+    expect(() => opensslPQ.ostOpenPack(opensslPQ.ostEncode(text))).toThrow('OST pack has no index');
+  });
+
+  test('ostCompressBins round-trips brotli, zstd and lz4 bins', () => {
+    const opensslPQ = require(modulePath);
+    const { brotliDecompressSync } = require('zlib');
+    const text = Array.from({ length: 2000 }, (_, i) => ['ACGT', 'héllo', '中文\n'][(i * 5) % 3]).join(' ');
+
+    for (const method of ['brotli', 'zstd', 'lz4']) {
+      const bins = [text, Buffer.from('short'), ''];
+      const packed = opensslPQ.ostCompressBins(bins, method);
+      const unpacked = opensslPQ.ostDecompressBins(packed, method);
+      expect(unpacked.map((b: Buffer) => b.toString('utf8'))).toEqual(bins.map(String));
+
+      const pack = opensslPQ.ostEncode(text, { windowLength: 50, compressionMethod: method, recordOrder: true });
+      expect(opensslPQ.ostDecode(pack).data.toString('utf8')).toBe(text);
+    }
+
+    // Standard brotli streams
+    expect(brotliDecompressSync(opensslPQ.ostCompressBins([text], 'brotli')[0]).toString('utf8')).toBe(text);
+    expect(() => opensslPQ.ostDecompressBins([Buffer.from('not zstd')], 'zstd')).toThrow();
+    expect(() => opensslPQ.ostEncode(text, { compressionMethod: 'lz4', index: true })).toThrow();
+  });
+
+  test('ostStream packs chunked input with bounded blocks', () => {
+    const opensslPQ = require(modulePath);
+    const text = Array.from({ length: 3000 }, (_, i) => ['ACGT', 'héllo', '😀', '中文\n'][(i * 7) % 4]).join(' ');
+    const bytes = Buffer.from(text, 'utf8');
+    const expected = opensslPQ.ostDecode(opensslPQ.ostEncode(text, { windowLength: 9, recordOrder: true })).data;
+
+    // Byte chunks that split UTF-8 sequences, and blocks far below the input size
+    const stream = opensslPQ.ostStreamCreate({ windowLength: 9, blockSize: 256, memoryLimit: 1024 });
+    const parts: Buffer[] = [];
+    for (let i = 0; i < bytes.length; i += 1001) parts.push(opensslPQ.ostStreamWrite(stream, bytes.subarray(i, i + 1001)));
+    parts.push(opensslPQ.ostStreamEnd(stream));
+    const pack = Buffer.concat(parts);
+
+    const decoded = opensslPQ.ostDecode(pack);
+    expect(JSON.parse(decoded.header).stream).toBe(true);
+    expect(decoded.data.equals(expected)).toBe(true);
+    expect(() => opensslPQ.ostStreamWrite(stream, 'more')).toThrow('Invalid OST stream handle');
+    expect(() => opensslPQ.ostStreamCreate({ index: true })).toThrow('cannot be indexed');
+  });
+
+  test('universalEncode packs the same bits as the string codecs', () => {
+    const opensslPQ = require(modulePath);
+    // '0'/'1' strings as OSTHelper.createUniversalCodec writes them
+    const gamma = (n: number) => '0'.repeat(n.toString(2).length - 1) + n.toString(2);
+    const expected: Record<string, (n: number) => string> = {
+      'elias-gamma': gamma,
+      'elias-delta': (n) => gamma(n.toString(2).length) + n.toString(2).slice(1),
+      'unary': (n) => '1'.repeat(n) + '0',
+    };
+    const values = [1, 2, 3, 7, 8, 255, 1000, 65537, 2 ** 40 + 3];
+
+    for (const [type, encode] of Object.entries(expected)) {
+      const input = type === 'unary' ? values.slice(0, 6) : values;
+      const bits = input.map(encode).join('');
+      const { data, bits: length } = opensslPQ.universalEncode(type, input);
+      expect(length).toBe(bits.length);
+      const unpacked = Array.from({ length }, (_, i) => (data[i >> 3] >> (7 - (i & 7))) & 1).join('');
+      expect(unpacked).toBe(bits);
+
+      const decoded = opensslPQ.universalDecode(type, data, length);
+      expect(Array.from(decoded.values)).toEqual(input);
+      expect(decoded.bitsRead).toBe(length);
+    }
+
+    // Fibonacci decodes like the TypeScript decoder, which weighs the first bit most: "011" (2) reads back as 1
+    const fib = opensslPQ.universalEncode('fibonacci', [2, 3]);
+    expect(fib.bits).toBe(7);
+    expect(Array.from(opensslPQ.universalDecode('fibonacci', fib.data, fib.bits).values)).toEqual([1, 1]);
+
+    expect(() => opensslPQ.universalEncode('elias-gamma', [0])).toThrow('Elias Gamma can only encode positive integers');
+    expect(() => opensslPQ.universalDecode('unary', Buffer.from([0xff]), 8)).toThrow("no terminating '0'");
+  });
+
+  test('blake3 matches the reference vectors across one-shot, streaming and batch', () => {
+    const opensslPQ = require(modulePath);
+    // Inputs from the official BLAKE3 test vectors: byte i is i % 251
+    const input = (n: number) => Buffer.from(Array.from({ length: n }, (_, i) => i % 251));
+    const key = Buffer.from('whats the Elvish word for friend');
+    const context = 'BLAKE3 2019-12-27 16:29:52 test vectors context';
+    const hex = (b: Buffer) => b.toString('hex');
+
+    expect(hex(opensslPQ.blake3(Buffer.alloc(0)))).toBe('af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262');
+    expect(hex(opensslPQ.blake3(input(1)))).toBe('2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213');
+    expect(hex(opensslPQ.blake3(input(1025)))).toBe('d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444');
+    expect(hex(opensslPQ.blake3(input(102400)))).toBe('bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085');
+    expect(hex(opensslPQ.blake3(input(8193), { key }))).toBe('954a2a75420c8d6547e3ba5b98d963e6fa6491addc8c023189cc519821b4a1f5');
+    expect(hex(opensslPQ.blake3(input(2049), { context, dkLen: 64 }))).toBe(
+      '2ea477c5515cc3dd606512ee72bb3e0e758cfae7232826f35fb98ca1bcbdf273' +
+      '16d8e9e79081a80b046b60f6a263616f33ca464bd78d79fa18200d06c7fc9bff'
+    );
+    expect(hex(opensslPQ.blake3('héllo'))).toBe(hex(opensslPQ.blake3(Buffer.from('héllo'))));
+
+    // Streaming in uneven pieces; digest does not end the stream
+    const data = input(70000);
+    const hasher = opensslPQ.blake3Create({ key });
+    for (let i = 0; i < data.length; i += 3001) opensslPQ.blake3Update(hasher, data.subarray(i, i + 3001));
+    expect(hex(opensslPQ.blake3Digest(hasher, 40))).toBe(hex(opensslPQ.blake3(data, { key, dkLen: 40 })));
+    opensslPQ.blake3Update(hasher, 'tail');
+    expect(hex(opensslPQ.blake3Digest(hasher))).toBe(hex(opensslPQ.blake3(Buffer.concat([data, Buffer.from('tail')]), { key })));
+    expect(opensslPQ.blake3Free(hasher)).toBe(true);
+    expect(() => opensslPQ.blake3Update(hasher, 'more')).toThrow('Invalid BLAKE3 hasher handle');
+
+    // Batch: small inputs share SIMD passes, larger ones take the tree path
+    const inputs = Array.from({ length: 300 }, (_, i) => (i % 7 === 0 ? `segment-${i}` : input((i * 13) % 2100)));
+    for (const options of [undefined, { key }, { context, dkLen: 16 }]) {
+      const digests = opensslPQ.blake3Batch(inputs, options);
+      const dkLen = options?.dkLen ?? 32;
+      expect(digests.length).toBe(inputs.length * dkLen);
+      inputs.forEach((item, i) =>
+        expect(hex(digests.subarray(i * dkLen, (i + 1) * dkLen))).toBe(hex(opensslPQ.blake3(item, options)))
+      );
+    }
+
+    expect(() => opensslPQ.blake3('x', { key: Buffer.alloc(16) })).toThrow('key must be a 32-byte buffer');
+    expect(() => opensslPQ.blake3('x', { key, context })).toThrow('not both');
+  });
 });